@@ -35,13 +35,17 @@ API_INCLUDES = {
         "../third_party/spirv_cross",
         "../third_party/vulkan",
         "../third_party/amd_fidelityfx"
+    },
+    null = {
+        "../third_party/spirv_cross"
     }
 }
 
 API_EXCLUDES = 
 {
-    d3d12  = { RUNTIME_DIR .. "/RHI/Vulkan/**" },
-    vulkan = { RUNTIME_DIR .. "/RHI/D3D12/**" },
+    d3d12  = { RUNTIME_DIR .. "/RHI/Vulkan/**", RUNTIME_DIR .. "/RHI/Null/**" },
+    vulkan = { RUNTIME_DIR .. "/RHI/D3D12/**",  RUNTIME_DIR .. "/RHI/Null/**" },
+    null   = { RUNTIME_DIR .. "/RHI/D3D12/**",  RUNTIME_DIR .. "/RHI/Vulkan/**" },
 }
 
 API_LIBRARIES = {
@@ -86,6 +90,22 @@ API_LIBRARIES = {
 			"ffx_brixelizer_x64d",
 			"ffx_brixelizergi_x64d"
         }
+    },
+    null = {
+        release = {
+            "spirv-cross-c",
+            "spirv-cross-core",
+            "spirv-cross-cpp",
+            "spirv-cross-glsl",
+            "spirv-cross-hlsl"
+        },
+        debug = {
+            "spirv-cross-c_debug",
+            "spirv-cross-core_debug",
+            "spirv-cross-cpp_debug",
+            "spirv-cross-glsl_debug",
+            "spirv-cross-hlsl_debug"
+        }
     }
 }
 
@@ -96,6 +116,9 @@ function configure_graphics_api()
     elseif ARG_API_GRAPHICS == "vulkan" then
         API_CPP_DEFINE  = "API_GRAPHICS_VULKAN"
         EXECUTABLE_NAME = EXECUTABLE_NAME .. "_vulkan"
+    elseif ARG_API_GRAPHICS == "null" then
+        API_CPP_DEFINE  = "API_GRAPHICS_NULL"
+        EXECUTABLE_NAME = EXECUTABLE_NAME .. "_null"
     end
 end
 
@@ -51,6 +51,17 @@ static const uint  THREAD_GROUP_COUNT_Y = 8;
 static const uint  THREAD_GROUP_COUNT   = 64;
 static const float DEG_TO_RAD           = PI / 180.0f;
 
+/*------------------------------------------------------------------------------
+    LIGHT TILES
+------------------------------------------------------------------------------*/
+// maps a thread of an indirect dispatch, over the tile list in the pass constants, to its pixel
+uint2 light_tile_get_pixel(uint group_index, uint2 group_thread_id)
+{
+    uint tile_type = (uint)pass_get_f2_value().x;
+    uint tile      = buffer_light_tiles[tile_type * light_tile_capacity + group_index];
+    return uint2(tile & 0xFFFF, tile >> 16) * uint2(THREAD_GROUP_COUNT_X, THREAD_GROUP_COUNT_Y) + group_thread_id;
+}
+
 /*------------------------------------------------------------------------------
     MATH
 ------------------------------------------------------------------------------*/
@@ -263,18 +274,63 @@ float3 reconstruct_normal_z(float2 normal)
     return float3(normal, z);
 }
 
+// the normal target is r10g10b10a2, an octahedral normal in rg and the material in b
+// material indices are multiples of the texture slot count (MaterialTexture::Max, from the frame buffer), so only the slot is stored
+static const float gbuffer_material_max = 1023.0f;
+
+float2 sign_not_zero(float2 value)
+{
+    return float2(value.x >= 0.0f ? 1.0f : -1.0f, value.y >= 0.0f ? 1.0f : -1.0f);
+}
+
+float2 octahedral_encode(float3 normal)
+{
+    normal.xy /= abs(normal.x) + abs(normal.y) + abs(normal.z);
+    if (normal.z < 0.0f)
+    {
+        normal.xy = (1.0f - abs(normal.yx)) * sign_not_zero(normal.xy);
+    }
+
+    return pack(normal.xy);
+}
+
+float3 octahedral_decode(float2 value)
+{
+    value         = unpack(value);
+    float3 normal = float3(value, 1.0f - abs(value.x) - abs(value.y));
+    float fold    = saturate(-normal.z);
+    normal.xy    -= fold * sign_not_zero(normal.xy);
+
+    return normalize(normal);
+}
+
+float4 gbuffer_encode_normal(float3 normal, uint material_index)
+{
+    return float4(octahedral_encode(normal), (material_index / buffer_frame.material_texture_count) / gbuffer_material_max, 0.0f);
+}
+
+float3 gbuffer_decode_normal(float4 value)
+{
+    return octahedral_decode(value.xy);
+}
+
+uint gbuffer_decode_material_index(float4 value)
+{
+    return uint(round(value.b * gbuffer_material_max)) * buffer_frame.material_texture_count;
+}
+
 float3 get_normal(uint2 pos)
 {
     // Load returns 0 for any value accessed out of bounds, so clamp.
     pos.x = clamp(pos.x, 0, buffer_frame.resolution_render.x);
     pos.y = clamp(pos.y, 0, buffer_frame.resolution_render.y);
     
-    return tex_normal[pos].xyz;
+    return gbuffer_decode_normal(tex_normal[pos]);
 }
 
 float3 get_normal(float2 uv)
 {
-    return tex_normal.SampleLevel(samplers[sampler_point_clamp_edge], uv, 0).xyz;
+    return gbuffer_decode_normal(tex_normal.SampleLevel(samplers[sampler_point_clamp_edge], uv, 0));
 }
 
 float3 get_normal_view_space(uint2 pos)
@@ -515,6 +571,40 @@ float screen_fade(float2 uv)
     return saturate(1.0f - dot(fade, fade));
 }
 
+// upsamples a half resolution texture, the bilinear weights are scaled by depth similarity so that edges don't bleed
+float4 upsample_bilateral(Texture2D tex_half, uint2 position_out, float2 resolution_out)
+{
+    float2 resolution_half;
+    tex_half.GetDimensions(resolution_half.x, resolution_half.y);
+
+    float2 uv            = (position_out + 0.5f) / resolution_out;
+    float2 position_half = uv * resolution_half - 0.5f;
+    int2 position_base   = int2(floor(position_half));
+    float2 f             = frac(position_half);
+    float depth          = get_linear_depth(uv);
+
+    float4 color        = 0.0f;
+    float weight_total  = 0.0f;
+    [unroll]
+    for (int y = 0; y < 2; y++)
+    {
+        [unroll]
+        for (int x = 0; x < 2; x++)
+        {
+            int2 position_sample   = clamp(position_base + int2(x, y), 0, int2(resolution_half) - 1);
+            float depth_sample     = get_linear_depth((position_sample + 0.5f) / resolution_half);
+            float weight_bilinear  = (x == 0 ? 1.0f - f.x : f.x) * (y == 0 ? 1.0f - f.y : f.y);
+            float weight_depth     = 1.0f / (abs(depth - depth_sample) + 0.001f);
+            float weight           = weight_bilinear * weight_depth;
+
+            color        += tex_half[position_sample] * weight;
+            weight_total += weight;
+        }
+    }
+
+    return color / max(weight_total, FLT_MIN);
+}
+
 // Find good arbitrary axis vectors to represent U and V axes of a plane,
 // given just the normal. Ported from UnMath.h
 void find_best_axis_vectors(float3 In, out float3 Axis1, out float3 Axis2)
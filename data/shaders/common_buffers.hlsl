@@ -63,7 +63,8 @@ struct FrameBufferData
     float resolution_scale;
     
     double time;
-    float2 padding;
+    uint material_texture_count;
+    float padding;
 };
 
 // 128 byte push constant buffer used by everything in the engine
@@ -84,13 +84,13 @@ struct Surface
         float4 sample_normal   = tex_normal[position_screen];
         float4 sample_material = tex_material[position_screen];
         float sample_depth     = tex_depth[position_screen].r;
-        Material material      = buffer_materials[sample_normal.a];
+        Material material      = buffer_materials[gbuffer_decode_material_index(sample_normal)];
         
         // fill properties
         pos                   = position_screen;
         uv                    = (position_screen + 0.5f) / (resolution_out * buffer_frame.resolution_scale);
         depth                 = sample_depth;
-        normal                = sample_normal.xyz;
+        normal                = gbuffer_decode_normal(sample_normal);
         flags                 = material.flags;
         albedo                = replace_color_with_one ? 1.0f : sample_albedo.rgb;
         alpha                 = sample_albedo.a;
@@ -135,4 +135,15 @@ RWTexture2DArray<float4> tex_uav_sss                       : register(u6);
 globallycoherent RWStructuredBuffer<uint> g_atomic_counter : register(u7); // used by FidelityFX SPD
 globallycoherent RWTexture2D<float4> tex_uav_mips[12]      : register(u8); // used by FidelityFX SPD
 
+//= LIGHT TILES ===========================================================================================
+// 8x8 pixel tiles, classified from the g-buffer and consumed by indirect dispatches (one group per tile)
+static const uint light_tile_simple   = 0;
+static const uint light_tile_complex  = 1;
+static const uint light_tile_sky      = 2;
+static const uint light_tile_capacity = (7680 / 8) * (4320 / 8);
+
+RWStructuredBuffer<uint> buffer_light_tiles     : register(u23); // packed tile coordinates, one list per tile type
+RWStructuredBuffer<uint> buffer_light_tile_args : register(u24); // uint4 per tile type, dispatch group counts
+//=========================================================================================================
+
 #endif // SPARTAN_COMMON_TEXTURES
@@ -370,6 +370,152 @@ struct sampling
     }
 };
 
+// material features, matches Renderer_GbufferFeature
+static const uint feature_albedo     = 1U << 0;
+static const uint feature_normal     = 1U << 1;
+static const uint feature_surface    = 1U << 2;
+static const uint feature_emission   = 1U << 3;
+static const uint feature_alpha_test = 1U << 4;
+static const uint feature_all        = 0xFFFFFFFF;
+
+static const float g_quality_max_distance = 500.0f;
+
+// where a pixel's material textures come from, rasterized pixels use the draw's material and implicit
+// derivatives, resolved visibility buffer pixels use their draw's material and analytic derivatives
+struct material_sampler
+{
+    gbuffer_vertex vertex;
+    uint material_index;
+    float2 uv_dx;
+    float2 uv_dy;
+    bool analytic_derivatives;
+
+    float4 fetch(Surface surface, uint texture_index)
+    {
+        if (analytic_derivatives)
+            return fetch_plain(texture_index);
+
+        return sampling::smart(surface, vertex, texture_index);
+    }
+
+    float4 fetch_plain(uint texture_index)
+    {
+        if (analytic_derivatives)
+            return tex_materials[NonUniformResourceIndex(material_index + texture_index)].SampleGrad(GET_SAMPLER(sampler_anisotropic_wrap), vertex.uv, uv_dx, uv_dy);
+
+        return GET_TEXTURE(texture_index).Sample(GET_SAMPLER(sampler_anisotropic_wrap), vertex.uv);
+    }
+};
+
+// the g-buffer material evaluation, shared by the raster and the visibility buffer paths, features
+// that are not set in the mask are compiled out, the surface flags decide the rest per pixel
+struct material_evaluation
+{
+    float4 albedo;
+    float3 normal;
+    float roughness;
+    float metalness;
+    float occlusion;
+    float emission;
+
+    void initialize(Material material, float3 normal_vertex)
+    {
+        albedo    = material.color;
+        normal    = normal_vertex;
+        roughness = material.roughness;
+        metalness = material.metallness;
+        occlusion = 1.0f;
+        emission  = 0.0f;
+    }
+
+    // returns the albedo texture's alpha, so that it can also act as an alpha mask
+    float evaluate_albedo(Surface surface, inout material_sampler textures, uint features)
+    {
+        if (!((features & feature_albedo) != 0 && surface.has_texture_albedo()))
+            return 1.0f;
+
+        float4 albedo_sample = textures.fetch(surface, material_albedo);
+        float alpha          = albedo_sample.a;
+        albedo_sample.rgb    = srgb_to_linear(albedo_sample.rgb);
+        albedo              *= albedo_sample;
+
+        return alpha;
+    }
+
+    // everything past the albedo, only evaluated within g_quality_max_distance
+    void evaluate_surface(Material material, Surface surface, inout material_sampler textures, uint features)
+    {
+        // normal mapping
+        if ((features & feature_normal) != 0 && surface.has_texture_normal())
+        {
+            // get tangent space normal and apply the user defined intensity, then transform it to world space
+            float3 tangent_normal = normalize(unpack(textures.fetch(surface, material_normal).xyz));
+
+            // reconstruct z-component as this can be a BC5 two channel normal map
+            tangent_normal.z = sqrt(max(0.0, 1.0 - tangent_normal.x * tangent_normal.x - tangent_normal.y * tangent_normal.y));
+
+            tangent_normal.xy         *= saturate(max(0.012f, material.normal));
+            float3x3 tangent_to_world  = make_tangent_to_world_matrix(textures.vertex.normal, textures.vertex.tangent);
+            normal                     = normalize(mul(tangent_normal, tangent_to_world).xyz);
+        }
+
+        // roughness + metalness
+        if ((features & feature_surface) != 0)
+        {
+            float4 roughness_sample = 1.0f;
+            if (surface.has_texture_roughness())
+            {
+                roughness_sample  = textures.fetch(surface, material_roughness);
+                roughness        *= roughness_sample.g;
+            }
+
+            float is_single_texture_roughness_metalness = surface.has_single_texture_roughness_metalness() ? 1.0f : 0.0f;
+            metalness *= (1.0 - is_single_texture_roughness_metalness) + (roughness_sample.b * is_single_texture_roughness_metalness);
+
+            if (surface.has_texture_metalness() && !surface.has_single_texture_roughness_metalness())
+            {
+                metalness *= textures.fetch(surface, material_metalness).r;
+            }
+
+            // occlusion
+            if (surface.has_texture_occlusion())
+            {
+                occlusion = textures.fetch(surface, material_occlusion).r;
+            }
+        }
+
+        // emission
+        if ((features & feature_emission) != 0 && surface.has_texture_emissive())
+        {
+            float3 emissive_color  = textures.fetch_plain(material_emission).rgb;
+            emission               = luminance(emissive_color);
+            albedo.rgb            += emissive_color;
+        }
+    }
+
+    // specular anti-aliasing, widens the roughness lobe where the normal varies within a pixel
+    void filter_roughness(float3 normal_dx, float3 normal_dy)
+    {
+        static const float strength           = 1.0f;
+        static const float max_roughness_gain = 0.02f;
+
+        float roughness2         = roughness * roughness;
+        float variance           = dot(normal_dx, normal_dx) + dot(normal_dy, normal_dy);
+        float kernelRoughness2   = min(variance * strength, max_roughness_gain);
+        float filteredRoughness2 = saturate(roughness2 + kernelRoughness2);
+        roughness                = fast_sqrt(filteredRoughness2);
+    }
+};
+
+// screen space motion between the previous and the current frame, without the taa jitter
+float2 compute_velocity(float4 position_clip_current, float4 position_clip_previous)
+{
+    float2 position_ndc_current  = position_clip_current.xy / position_clip_current.w - buffer_frame.taa_jitter_current;
+    float2 position_ndc_previous = position_clip_previous.xy / position_clip_previous.w - buffer_frame.taa_jitter_previous;
+
+    return ndc_to_uv(position_ndc_current) - ndc_to_uv(position_ndc_previous);
+}
+
 gbuffer_vertex transform_to_world_space(Vertex_PosUvNorTan input, uint instance_id, matrix transform)
 {
     gbuffer_vertex vertex;
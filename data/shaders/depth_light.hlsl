@@ -32,13 +32,15 @@ struct vertex
     float2 uv       : TEXCOORD;
 };
 
-vertex main_vs(Vertex_PosUvNorTan input, uint instance_id : SV_InstanceID)
+// casters in all the slices (cascades or paraboloid faces) of a light are rendered in a single pass with
+// multiview, the rest are rendered one slice at a time, where the view id is 0 and the slice comes from the pass
+vertex main_vs(Vertex_PosUvNorTan input, uint instance_id : SV_InstanceID, uint view_id : SV_ViewID)
 {
     vertex output;
     output.uv = input.uv;
 
     float3 f3_value_2 = pass_get_f3_value2();
-    uint index_array  = (uint)f3_value_2.y;
+    uint index_array  = (uint)f3_value_2.y + view_id;
 
     Light light;
     light.Build();
@@ -30,11 +30,13 @@ static const float BASE_FOCAL_LENGTH        = 50.0; // in mm, base focal length
 static const float SENSOR_HEIGHT            = 24.0; // in mm, assuming full-frame sensor
 static const float EDGE_DETECTION_THRESHOLD = 0.1; // adjust to control edge sensitivity
 static const float HEXAGON_STRENGTH         = 0.2; // strength of hexagonal bokeh shape
+static const float COC_THRESHOLD            = 0.01; // tiles with a smaller max coc are in focus
+static const uint  TILE_SIZE                = 16;   // in output pixels, one thread group of the half resolution pass
 
-float compute_coc(float2 uv, float focus_distance, float aperture)
+groupshared uint g_tile_max_coc;
+
+float compute_coc(float2 uv, float focus_distance, float aperture, float2 resolution_out)
 {
-    float2 resolution_out;
-    tex_uav.GetDimensions(resolution_out.x, resolution_out.y);
     float2 texel_size = 1.0 / resolution_out;
 
     float depth = get_linear_depth(uv);
@@ -81,10 +83,11 @@ float gaussian_weight(float x, float sigma)
     return exp(-0.5 * (x * x) / (sigma * sigma)) / (sigma * sqrt(2.0 * 3.14159265));
 }
 
-float3 gaussian_blur(float2 uv, float coc, float2 resolution_out)
+float3 gaussian_blur(float2 uv, float coc, float2 resolution_half)
 {
-    float2 texel_size = 1.0f / resolution_out;
-    float sigma       = max(1.0, coc * BLUR_RADIUS);
+    // the blur runs at half resolution, so half the radius covers the same area
+    float2 texel_size = 1.0f / resolution_half;
+    float sigma       = max(1.0, coc * BLUR_RADIUS * 0.5f);
     float3 color      = float3(0.0, 0.0, 0.0);
     
     // adaptive sampling
@@ -131,27 +134,93 @@ float get_average_depth_circle(float2 center, float radius, uint sample_count, f
     return average_depth / sample_count;
 }
 
+float get_focal_depth(float2 resolution_out)
+{
+    const float circle_radius = 0.1f;
+    const uint  sample_count  = 10;
+    return get_average_depth_circle(float2(0.5, 0.5f), circle_radius, sample_count, resolution_out);
+}
+
 [numthreads(THREAD_GROUP_COUNT_X, THREAD_GROUP_COUNT_Y, 1)]
-void main_cs(uint3 thread_id : SV_DispatchThreadID)
+void main_cs(uint3 thread_id : SV_DispatchThreadID, uint3 group_id : SV_GroupID, uint group_index : SV_GroupIndex)
 {
+    // tex is always the full resolution input
     float2 resolution_out;
-    tex_uav.GetDimensions(resolution_out.x, resolution_out.y);
-    if (any(int2(thread_id.xy) >= resolution_out))
+    tex.GetDimensions(resolution_out.x, resolution_out.y);
+    float aperture = pass_get_f3_value().x;
+
+#if defined(TILE_MAX)
+    // each thread covers 2x2 pixels, so a group reduces a whole tile
+    if (group_index == 0)
+    {
+        g_tile_max_coc = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    float2 uv = (thread_id.xy * 2.0f + 1.0f) / resolution_out;
+    if (all(uv < 1.0f))
+    {
+        float coc = compute_coc(uv, get_focal_depth(resolution_out), aperture, resolution_out);
+        InterlockedMax(g_tile_max_coc, asuint(coc)); // positive floats keep their order as uints
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (group_index == 0)
+    {
+        tex_uav[group_id.xy] = float4(asfloat(g_tile_max_coc), 0.0f, 0.0f, 0.0f);
+    }
+#elif defined(TILE_DILATE)
+    // spread the max coc to the neighbouring tiles, so that blur can bleed across tile edges
+    float2 resolution_tiles;
+    tex_uav.GetDimensions(resolution_tiles.x, resolution_tiles.y);
+    if (any(thread_id.xy >= uint2(resolution_tiles)))
+        return;
+
+    float coc_max = 0.0f;
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+        {
+            int2 tile = clamp(int2(thread_id.xy) + int2(x, y), 0, int2(resolution_tiles) - 1);
+            coc_max   = max(coc_max, tex2[tile].x);
+        }
+    }
+
+    tex_uav[thread_id.xy] = float4(coc_max, 0.0f, 0.0f, 0.0f);
+#elif defined(UPSAMPLE)
+    if (any(thread_id.xy >= uint2(resolution_out)))
         return;
 
-    const float2 uv = (thread_id.xy + 0.5f) / resolution_out;
+    float4 color = tex[thread_id.xy];
 
-    // get focal depth from camera
-    const float circle_radius = 0.1f;
-    const uint  sample_count  = 10;
-    float focal_depth         = get_average_depth_circle(float2(0.5, 0.5f), circle_radius, sample_count, resolution_out);
-    float aperture            = pass_get_f3_value().x;
+    // in focus tiles are copied through
+    if (tex2[thread_id.xy / TILE_SIZE].x < COC_THRESHOLD)
+    {
+        tex_uav[thread_id.xy] = color;
+        return;
+    }
 
-    // do the actual blurring
-    float coc             = compute_coc(uv, focal_depth, aperture);
-    float3 blurred_color  = gaussian_blur(uv, coc, resolution_out);
-    float4 original_color = tex[thread_id.xy];
-    float3 final_color    = lerp(original_color.rgb, blurred_color, coc);
+    // the half resolution pass stores the coc in the alpha
+    float4 blurred        = upsample_bilateral(tex_frame, thread_id.xy, resolution_out);
+    tex_uav[thread_id.xy] = float4(lerp(color.rgb, blurred.rgb, blurred.a), color.a);
+#else
+    float2 resolution_half;
+    tex_uav.GetDimensions(resolution_half.x, resolution_half.y);
+    if (any(thread_id.xy >= uint2(resolution_half)))
+        return;
 
-    tex_uav[thread_id.xy] = float4(final_color, original_color.a);
+    const float2 uv = (thread_id.xy + 0.5f) / resolution_half;
+
+    // a group is exactly one tile, in focus tiles take the early out path as a whole
+    if (tex2[group_id.xy].x < COC_THRESHOLD)
+    {
+        tex_uav[thread_id.xy] = float4(tex.SampleLevel(samplers[sampler_bilinear_clamp], uv, 0).rgb, 0.0f);
+        return;
+    }
+
+    // do the actual blurring
+    float coc             = compute_coc(uv, get_focal_depth(resolution_out), aperture, resolution_out);
+    float3 blurred_color  = gaussian_blur(uv, coc, resolution_half);
+    tex_uav[thread_id.xy] = float4(blurred_color, coc);
+#endif
 }
@@ -21,7 +21,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "common.hlsl"
 //====================
 
-static const float g_quality_max_distance = 500.0f;
+// permutations compile out the features a material doesn't use, the base shader decides per pixel
+#if defined(GBUFFER_FEATURES)
+static const uint gbuffer_features = GBUFFER_FEATURES;
+#else
+static const uint gbuffer_features = feature_all;
+#endif
 
 struct gbuffer
 {
@@ -48,128 +53,58 @@ gbuffer_vertex main_vs(Vertex_PosUvNorTan input, uint instance_id : SV_InstanceI
 
 gbuffer main_ps(gbuffer_vertex vertex)
 {
-    float4 albedo   = GetMaterial().color;
-    float3 normal   = vertex.normal.xyz;
-    float roughness = GetMaterial().roughness;
-    float metalness = GetMaterial().metallness;
-    float occlusion = 1.0f;
-    float emission  = 0.0f;
-    float2 velocity = 0.0f;
-
-    // velocity
-    {
-        // convert to ndc
-        float2 position_ndc_current  = (vertex.position_clip_current.xy / vertex.position_clip_current.w);
-        float2 position_ndc_previous = (vertex.position_clip_previous.xy / vertex.position_clip_previous.w);
-
-        // remove the ndc jitter
-        position_ndc_current  -= buffer_frame.taa_jitter_current;
-        position_ndc_previous -= buffer_frame.taa_jitter_previous;
-
-        // compute the velocity
-        velocity = ndc_to_uv(position_ndc_current) - ndc_to_uv(position_ndc_previous);
-    }
-
     Material material = GetMaterial();
     Surface surface; surface.flags = material.flags;
+
+    material_sampler textures;
+    textures.vertex               = vertex;
+    textures.material_index       = pass_get_material_index();
+    textures.uv_dx                = 0.0f;
+    textures.uv_dy                = 0.0f;
+    textures.analytic_derivatives = false;
+
+    material_evaluation result;
+    result.initialize(material, vertex.normal);
  
     // alpha mask
     float alpha_mask = 1.0f;
-    if (surface.has_texture_alpha_mask())
+    if ((gbuffer_features & feature_alpha_test) != 0 && surface.has_texture_alpha_mask())
     {
         alpha_mask = GET_TEXTURE(material_mask).Sample(samplers[sampler_point_wrap], vertex.uv).r;
     }
 
-    // albedo
-    if (surface.has_texture_albedo())
-    {
-        float4 albedo_sample = sampling::smart(surface, vertex, material_albedo);
-
-        // read albedo's alpha channel as an alpha mask as well
-        alpha_mask = min(alpha_mask, albedo_sample.a);
-        
-        albedo_sample.rgb  = srgb_to_linear(albedo_sample.rgb);
-        albedo            *= albedo_sample;
-    }
+    // albedo, its alpha channel is read as an alpha mask as well
+    alpha_mask = min(alpha_mask, result.evaluate_albedo(surface, textures, gbuffer_features));
 
     // discard masked pixels
-    if (alpha_mask <= get_alpha_threshold(vertex.position))
+    if ((gbuffer_features & feature_alpha_test) != 0 && alpha_mask <= get_alpha_threshold(vertex.position))
         discard;
 
-    // compute pixel distance
-    float3 camera_to_pixel_world = buffer_frame.camera_position - vertex.position.xyz;
-    float pixel_distance         = length(camera_to_pixel_world);
-
-    if (pixel_distance < g_quality_max_distance)
+    if (length(buffer_frame.camera_position - vertex.position.xyz) < g_quality_max_distance)
     {
-        // normal mapping
-        if (surface.has_texture_normal())
-        {
-            // get tangent space normal and apply the user defined intensity, then transform it to world space
-            float3 normal_sample  = sampling::smart(surface, vertex, material_normal).xyz;
-            float3 tangent_normal = normalize(unpack(normal_sample));
-        
-            // reconstruct z-component as this can be a BC5 two channel normal map
-            tangent_normal.z = sqrt(max(0.0, 1.0 - tangent_normal.x * tangent_normal.x - tangent_normal.y * tangent_normal.y));
-        
-            float normal_intensity     = max(0.012f, GetMaterial().normal);
-            tangent_normal.xy         *= saturate(normal_intensity);
-            float3x3 tangent_to_world  = make_tangent_to_world_matrix(vertex.normal, vertex.tangent);
-            normal                     = normalize(mul(tangent_normal, tangent_to_world).xyz);
-        }
-
-        // roughness + metalness
-        {
-            float4 roughness_sample = 1.0f;
-            if (surface.has_texture_roughness())
-            {
-                roughness_sample  = sampling::smart(surface, vertex, material_roughness);
-                roughness        *= roughness_sample.g;
-            }
-            
-            float is_single_texture_roughness_metalness = surface.has_single_texture_roughness_metalness() ? 1.0f : 0.0f;
-            metalness *= (1.0 - is_single_texture_roughness_metalness) + (roughness_sample.b * is_single_texture_roughness_metalness);
-            
-            if (surface.has_texture_metalness() && !surface.has_single_texture_roughness_metalness())
-            {
-                metalness *= sampling::smart(surface, vertex, material_metalness).r;
-            }
-        }
-
-        // occlusion
-        if (surface.has_texture_occlusion())
-        {
-            occlusion = sampling::smart(surface, vertex, material_occlusion).r;
-        }
-
-        // emission
-        if (surface.has_texture_emissive())
-        {
-            float3 emissive_color  = GET_TEXTURE(material_emission).Sample(GET_SAMPLER(sampler_anisotropic_wrap), vertex.uv).rgb;
-            emission               = luminance(emissive_color);
-            albedo.rgb            += emissive_color;
-        }
-
-        // specular anti-aliasing
-        {
-            static const float strength           = 1.0f;
-            static const float max_roughness_gain = 0.02f;
-
-            float roughness2         = roughness * roughness;
-            float3 dndu              = ddx(normal), dndv = ddy(normal);
-            float variance           = (dot(dndu, dndu) + dot(dndv, dndv));
-            float kernelRoughness2   = min(variance * strength, max_roughness_gain);
-            float filteredRoughness2 = saturate(roughness2 + kernelRoughness2);
-            roughness                = fast_sqrt(filteredRoughness2);
-        }
+        result.evaluate_surface(material, surface, textures, gbuffer_features);
+        result.filter_roughness(ddx(result.normal), ddy(result.normal));
     }
 
     // write to g-buffer
     gbuffer g_buffer;
-    g_buffer.albedo   = albedo;
-    g_buffer.normal   = float4(normal, pass_get_material_index());
-    g_buffer.material = float4(roughness, metalness, emission, occlusion);
-    g_buffer.velocity = velocity;
+    g_buffer.albedo   = result.albedo;
+    g_buffer.normal   = gbuffer_encode_normal(result.normal, pass_get_material_index());
+    g_buffer.material = float4(result.roughness, result.metalness, result.emission, result.occlusion);
+    g_buffer.velocity = compute_velocity(vertex.position_clip_current, vertex.position_clip_previous);
 
     return g_buffer;
 }
+
+// fidelityfx reads world space normals directly, so they are unpacked for it
+[numthreads(THREAD_GROUP_COUNT_X, THREAD_GROUP_COUNT_Y, 1)]
+void main_cs(uint3 thread_id : SV_DispatchThreadID)
+{
+    float2 resolution;
+    tex_uav.GetDimensions(resolution.x, resolution.y);
+    if (any(thread_id.xy >= uint2(resolution)))
+        return;
+
+    // r10g10b10a2, fidelityfx maps it back to [-1, 1] with its normal unpack multiply and add
+    tex_uav[thread_id.xy] = float4(pack(gbuffer_decode_normal(tex_normal[thread_id.xy])), 0.0f);
+}
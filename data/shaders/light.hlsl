@@ -50,8 +50,12 @@ float3 subsurface_scattering(Surface surface, Light light, AngularInfo angular_i
 }
 
 [numthreads(THREAD_GROUP_COUNT_X, THREAD_GROUP_COUNT_Y, 1)]
-void main_cs(uint3 thread_id : SV_DispatchThreadID)
+void main_cs(uint3 thread_id : SV_DispatchThreadID, uint3 group_id : SV_GroupID, uint3 group_thread_id : SV_GroupThreadID)
 {
+#ifdef LIGHT_TILES
+    thread_id.xy = light_tile_get_pixel(group_id.x, group_thread_id.xy);
+#endif
+
     // create surface
     float2 resolution_out;
     tex_uav.GetDimensions(resolution_out.x, resolution_out.y);
@@ -110,6 +114,10 @@ void main_cs(uint3 thread_id : SV_DispatchThreadID)
             angular_info.Build(light, surface);
 
             // specular
+#ifdef LIGHT_SIMPLE
+            // the tile classification guarantees that none of the lobes below are needed
+            light_specular += BRDF_Specular_Isotropic(surface, angular_info);
+#else
             if (surface.anisotropic > 0.0f)
             {
                 light_specular += BRDF_Specular_Anisotropic(surface, angular_info);
@@ -136,6 +144,7 @@ void main_cs(uint3 thread_id : SV_DispatchThreadID)
             {
                 light_subsurface += subsurface_scattering(surface, light, angular_info);
             }
+#endif
         
             // diffuse
             light_diffuse += BRDF_Diffuse(surface, angular_info);
@@ -51,8 +51,12 @@ float compute_blend_factor(float alpha)
 }
 
 [numthreads(THREAD_GROUP_COUNT_X, THREAD_GROUP_COUNT_Y, 1)]
-void main_cs(uint3 thread_id : SV_DispatchThreadID)
+void main_cs(uint3 thread_id : SV_DispatchThreadID, uint3 group_id : SV_GroupID, uint3 group_thread_id : SV_GroupThreadID)
 {
+#ifdef LIGHT_TILES
+    thread_id.xy = light_tile_get_pixel(group_id.x, group_thread_id.xy);
+#endif
+
     // create surface
     float2 resolution_out;
     tex_uav.GetDimensions(resolution_out.x, resolution_out.y);
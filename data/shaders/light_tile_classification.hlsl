@@ -0,0 +1,73 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========
+#include "common.hlsl"
+//====================
+
+groupshared uint g_tile_features;
+
+static const uint tile_feature_sky     = 1U << 0;
+static const uint tile_feature_lit     = 1U << 1;
+static const uint tile_feature_complex = 1U << 2;
+
+[numthreads(THREAD_GROUP_COUNT_X, THREAD_GROUP_COUNT_Y, 1)]
+void main_cs(uint3 thread_id : SV_DispatchThreadID, uint3 group_id : SV_GroupID, uint group_index : SV_GroupIndex)
+{
+    if (group_index == 0)
+    {
+        g_tile_features = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // gather the features of the pixels in this tile
+    float2 resolution;
+    tex_albedo.GetDimensions(resolution.x, resolution.y);
+    if (all(thread_id.xy < uint2(resolution)))
+    {
+        uint features = tile_feature_sky;
+        if (tex_albedo[thread_id.xy].a != 0.0f)
+        {
+            Material material = buffer_materials[gbuffer_decode_material_index(tex_normal[thread_id.xy])];
+            bool is_complex   = material.anisotropic > 0.0f || material.clearcoat > 0.0f || material.sheen > 0.0f || material.subsurface_scattering > 0.0f;
+            features          = tile_feature_lit | (is_complex ? tile_feature_complex : 0);
+        }
+
+        InterlockedOr(g_tile_features, features);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // append the tile to the list of the cheapest shader that can light all of its pixels
+    if (group_index == 0 && g_tile_features != 0)
+    {
+        uint tile_type = light_tile_sky;
+        if (g_tile_features & tile_feature_complex)
+        {
+            tile_type = light_tile_complex;
+        }
+        else if (g_tile_features & tile_feature_lit)
+        {
+            tile_type = light_tile_simple;
+        }
+
+        uint tile_index;
+        InterlockedAdd(buffer_light_tile_args[tile_type * 4], 1, tile_index);
+        buffer_light_tiles[tile_type * light_tile_capacity + tile_index] = group_id.x | (group_id.y << 16);
+    }
+}
@@ -29,6 +29,7 @@ static const float  g_velocity_scale          = 1.0f;  // adjust this to control
 static const float  g_velocity_threshold      = 0.01f; // threshold for skipping low-motion pixels
 static const float  g_adaptive_threshold      = 0.1f;  // threshold for max adaptive sampling
 static const float  g_depth_scale             = 1.0f;  // adjust this to control depth difference sensitivity
+static const uint   g_tile_size               = 16;    // in output pixels, one thread group of the half resolution pass
 
 groupshared uint g_tile_max_velocity_sqr;
 
@@ -52,6 +53,16 @@ float2 get_velocity_3x3_average(float2 uv, float2 resolution_out)
     return total_velocity / float(sample_count);
 }
 
+float2 get_velocity(float2 uv, float2 resolution)
+{
+    // compute motion blur strength from camera's shutter speed
+    float camera_shutter_speed = pass_get_f3_value().x;
+    float motion_blur_strength = saturate(camera_shutter_speed);
+
+    // scale velocity by the motion blur strength, delta time, and additional scale factor
+    return get_velocity_3x3_average(uv, resolution) * motion_blur_strength * g_velocity_scale / (buffer_frame.delta_time + FLT_MIN);
+}
+
 uint get_adaptive_sample_count(float2 velocity)
 {
     float velocity_length = length(velocity);
@@ -60,70 +71,115 @@ uint get_adaptive_sample_count(float2 velocity)
 }
 
 [numthreads(THREAD_GROUP_COUNT_X, THREAD_GROUP_COUNT_Y, 1)]
-void main_cs(uint3 thread_id : SV_DispatchThreadID, uint3 group_thread_id : SV_GroupThreadID, uint group_index : SV_GroupIndex)
+void main_cs(uint3 thread_id : SV_DispatchThreadID, uint3 group_id : SV_GroupID, uint group_index : SV_GroupIndex)
 {
+    // tex is always the full resolution input
     float2 resolution_out;
-    tex_uav.GetDimensions(resolution_out.x, resolution_out.y);
-    float2 uv      = (thread_id.xy + 0.5f) / resolution_out;
-    float4 color   = tex[thread_id.xy];
-    float2 velocity = get_velocity_3x3_average(uv, resolution_out);
-    
-    // compute motion blur strength from camera's shutter speed
-    float camera_shutter_speed = pass_get_f3_value().x;
-    float motion_blur_strength = saturate(camera_shutter_speed);
-    
-    // scale velocity by the motion blur strength, delta time, and additional scale factor
-    velocity *= motion_blur_strength * g_velocity_scale / (buffer_frame.delta_time + FLT_MIN);
-    
-    // Compute max velocity squared for the tile
+    tex.GetDimensions(resolution_out.x, resolution_out.y);
+
+#if defined(TILE_MAX)
+    // each thread covers 2x2 pixels, so a group reduces a whole tile
     if (group_index == 0)
     {
         g_tile_max_velocity_sqr = 0;
     }
     GroupMemoryBarrierWithGroupSync();
-    
-    uint velocity_sqr = (uint)(dot(velocity, velocity) * 1000000.0f); // Scale up and convert to integer
+
+    float2 uv       = (thread_id.xy * 2.0f + 1.0f) / resolution_out;
+    float2 velocity = all(uv < 1.0f) ? get_velocity(uv, resolution_out) : 0.0f;
+    uint velocity_sqr = asuint(dot(velocity, velocity)); // positive floats keep their order as uints
     InterlockedMax(g_tile_max_velocity_sqr, velocity_sqr);
-    
     GroupMemoryBarrierWithGroupSync();
-    
-    // skip blur calculation for low-motion tiles
-    if (sqrt(float(g_tile_max_velocity_sqr) / 1000000.0f) < g_velocity_threshold)
+
+    // the thread that holds the longest velocity writes it out
+    if (velocity_sqr == g_tile_max_velocity_sqr)
+    {
+        tex_uav[group_id.xy] = float4(velocity, 0.0f, 0.0f);
+    }
+#elif defined(TILE_DILATE)
+    // spread the longest velocity to the neighbouring tiles, so that moving objects can smear over static ones
+    float2 resolution_tiles;
+    tex_uav.GetDimensions(resolution_tiles.x, resolution_tiles.y);
+    if (any(thread_id.xy >= uint2(resolution_tiles)))
+        return;
+
+    float2 velocity_max = 0.0f;
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+        {
+            int2 tile       = clamp(int2(thread_id.xy) + int2(x, y), 0, int2(resolution_tiles) - 1);
+            float2 velocity = tex2[tile].xy;
+            velocity_max    = dot(velocity, velocity) > dot(velocity_max, velocity_max) ? velocity : velocity_max;
+        }
+    }
+
+    tex_uav[thread_id.xy] = float4(velocity_max, 0.0f, 0.0f);
+#elif defined(UPSAMPLE)
+    if (any(thread_id.xy >= uint2(resolution_out)))
+        return;
+
+    float4 color = tex[thread_id.xy];
+
+    // static tiles are copied through
+    if (length(tex2[thread_id.xy / g_tile_size].xy) < g_velocity_threshold)
     {
         tex_uav[thread_id.xy] = color;
         return;
     }
-    
+
+    // the half resolution pass stores how much of the blurred color to use in the alpha
+    float4 blurred        = upsample_bilateral(tex_frame, thread_id.xy, resolution_out);
+    tex_uav[thread_id.xy] = float4(lerp(color.rgb, blurred.rgb, blurred.a), color.a);
+#else
+    float2 resolution_half;
+    tex_uav.GetDimensions(resolution_half.x, resolution_half.y);
+    if (any(thread_id.xy >= uint2(resolution_half)))
+        return;
+
+    float2 uv    = (thread_id.xy + 0.5f) / resolution_half;
+    float4 color = tex.SampleLevel(samplers[sampler_bilinear_clamp], uv, 0);
+
+    // a group is exactly one tile, static tiles take the early out path as a whole
+    float2 velocity_tile = tex2[group_id.xy].xy;
+    if (length(velocity_tile) < g_velocity_threshold)
+    {
+        tex_uav[thread_id.xy] = float4(color.rgb, 0.0f);
+        return;
+    }
+
     // skip blur calculation for low-motion pixels
+    float2 velocity = get_velocity(uv, resolution_out);
     if (length(velocity) < g_velocity_threshold)
     {
-        tex_uav[thread_id.xy] = color;
+        tex_uav[thread_id.xy] = float4(color.rgb, 0.0f);
         return;
     }
-    
-    // determine adaptive sample count
-    uint sample_count = get_adaptive_sample_count(velocity);
-    
+
+    // the sample count follows the dilated tile velocity, so the whole group loops the same number of times
+    uint sample_count = get_adaptive_sample_count(velocity_tile);
+
     float total_weight = 1.0f;
     float center_depth = get_linear_depth(uv);
-    
+
     [loop] // for variable iteration count
     for (uint i = 1; i < sample_count; ++i)
     {
         float  t             = (float(i) / float(sample_count - 1) - 0.5f);
         float2 sample_offset = velocity * t;
         float2 sample_uv     = uv + sample_offset;
-        
-        float sample_depth = get_linear_depth(sample_uv);
+
+        float sample_depth     = get_linear_depth(sample_uv);
         float depth_difference = abs(center_depth - sample_depth);
-        float depth_weight = exp(-depth_difference * g_depth_scale);
-        
+        float depth_weight     = exp(-depth_difference * g_depth_scale);
+
         float4 sample_color = tex.SampleLevel(samplers[sampler_bilinear_clamp], sample_uv, 0);
-        color += sample_color * depth_weight;
-        total_weight += depth_weight;
+        color              += sample_color * depth_weight;
+        total_weight       += depth_weight;
     }
-    
+
     // normalize the accumulated color
     color /= total_weight;
     tex_uav[thread_id.xy] = float4(color.rgb, 1.0f);
+#endif
 }
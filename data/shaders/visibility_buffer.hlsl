@@ -0,0 +1,199 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define TRANSFORM_IGNORE_NORMALS
+#define TRANSFORM_IGNORE_PREVIOUS_POSITION
+
+//= INCLUDES =========
+#include "common.hlsl"
+//====================
+
+// a visibility sample packs the draw (+1, so that 0 means empty) and the triangle into 32 bits
+static const uint visibility_primitive_bits = 20;
+static const uint visibility_primitive_mask = (1U << visibility_primitive_bits) - 1;
+
+struct VisibilityDraw
+{
+    matrix transform;
+    matrix transform_previous;
+
+    uint material_index;
+    uint index_offset;
+    uint vertex_offset;
+    uint geometry;
+};
+
+Texture2D<uint> tex_visibility                             : register(t26);
+RWByteAddressBuffer buffer_visibility_indices              : register(u20);
+RWByteAddressBuffer buffer_visibility_vertices             : register(u21);
+RWStructuredBuffer<VisibilityDraw> buffer_visibility_draws : register(u22);
+
+// raster
+
+gbuffer_vertex main_vs(Vertex_PosUvNorTan input, uint instance_id : SV_InstanceID)
+{
+    // identical to the depth prepass, so that the depth equality test holds
+    gbuffer_vertex vertex = transform_to_world_space(input, instance_id, buffer_pass.transform);
+    return transform_to_clip_space(vertex);
+}
+
+uint main_ps(gbuffer_vertex vertex, uint primitive_id : SV_PrimitiveID) : SV_Target0
+{
+    uint draw_index = (uint)pass_get_f3_value().x;
+    return ((draw_index + 1) << visibility_primitive_bits) | (primitive_id & visibility_primitive_mask);
+}
+
+// resolve
+
+struct visibility_vertex
+{
+    float3 position;
+    float2 uv;
+    float3 normal;
+    float3 tangent;
+};
+
+uint load_index(uint index)
+{
+    // the index stride of the bound page is 2 or 4 bytes
+    uint stride  = (uint)pass_get_f3_value().y;
+    uint address = index * stride;
+    uint word    = buffer_visibility_indices.Load(address & ~3U);
+
+    return stride == 4 ? word : ((address & 2U) ? (word >> 16) : (word & 0xFFFF));
+}
+
+visibility_vertex load_vertex(uint index)
+{
+    // matches RHI_Vertex_PosTexNorTan (44 bytes)
+    uint address = index * 44;
+
+    visibility_vertex vertex;
+    vertex.position = asfloat(buffer_visibility_vertices.Load3(address));
+    vertex.uv       = asfloat(buffer_visibility_vertices.Load2(address + 12));
+    vertex.normal   = asfloat(buffer_visibility_vertices.Load3(address + 20));
+    vertex.tangent  = asfloat(buffer_visibility_vertices.Load3(address + 32));
+
+    return vertex;
+}
+
+// perspective correct barycentrics of a point, from the clip space positions of a triangle
+float3 compute_barycentrics(float4 p0, float4 p1, float4 p2, float2 position_ndc)
+{
+    float3 inv_w = 1.0f / float3(p0.w, p1.w, p2.w);
+    float2 ndc0  = p0.xy * inv_w.x;
+    float2 ndc1  = p1.xy * inv_w.y;
+    float2 ndc2  = p2.xy * inv_w.z;
+
+    // screen space barycentrics
+    float2 e0    = ndc1 - ndc0;
+    float2 e1    = ndc2 - ndc0;
+    float2 e2    = position_ndc - ndc0;
+    float denom  = e0.x * e1.y - e1.x * e0.y;
+    float b1     = (e2.x * e1.y - e1.x * e2.y) / denom;
+    float b2     = (e0.x * e2.y - e2.x * e0.y) / denom;
+    float3 b     = float3(1.0f - b1 - b2, b1, b2);
+
+    // perspective correction
+    b *= inv_w;
+    return b / (b.x + b.y + b.z);
+}
+
+float3 interpolate(float3 b, float3 a0, float3 a1, float3 a2) { return a0 * b.x + a1 * b.y + a2 * b.z; }
+float2 interpolate(float3 b, float2 a0, float2 a1, float2 a2) { return a0 * b.x + a1 * b.y + a2 * b.z; }
+
+[numthreads(THREAD_GROUP_COUNT_X, THREAD_GROUP_COUNT_Y, 1)]
+void main_cs(uint3 thread_id : SV_DispatchThreadID)
+{
+    float2 resolution = buffer_frame.resolution_render;
+    if (any(thread_id.xy >= uint2(resolution)))
+        return;
+
+    uint visibility = tex_visibility[thread_id.xy];
+    if (visibility == 0)
+        return;
+
+    // only the draws that live in the currently bound geometry pages
+    VisibilityDraw draw = buffer_visibility_draws[(visibility >> visibility_primitive_bits) - 1];
+    if (draw.geometry != (uint)pass_get_f3_value().x)
+        return;
+
+    // fetch the triangle
+    uint index_base = draw.index_offset + (visibility & visibility_primitive_mask) * 3;
+    visibility_vertex v0 = load_vertex(draw.vertex_offset + load_index(index_base + 0));
+    visibility_vertex v1 = load_vertex(draw.vertex_offset + load_index(index_base + 1));
+    visibility_vertex v2 = load_vertex(draw.vertex_offset + load_index(index_base + 2));
+
+    // transform it the same way the raster pass did
+    float3 p0 = mul(float4(v0.position, 1.0f), draw.transform).xyz;
+    float3 p1 = mul(float4(v1.position, 1.0f), draw.transform).xyz;
+    float3 p2 = mul(float4(v2.position, 1.0f), draw.transform).xyz;
+    float4 c0 = mul(float4(p0, 1.0f), buffer_frame.view_projection);
+    float4 c1 = mul(float4(p1, 1.0f), buffer_frame.view_projection);
+    float4 c2 = mul(float4(p2, 1.0f), buffer_frame.view_projection);
+
+    // barycentrics at this pixel and its right and bottom neighbours, for analytic derivatives
+    float2 uv_screen    = (thread_id.xy + 0.5f) / resolution;
+    float2 position_ndc = float2(uv_screen.x * 2.0f - 1.0f, 1.0f - uv_screen.y * 2.0f);
+    float2 pixel_ndc    = float2(2.0f, -2.0f) / resolution;
+    float3 b            = compute_barycentrics(c0, c1, c2, position_ndc);
+    float3 b_dx         = compute_barycentrics(c0, c1, c2, position_ndc + float2(pixel_ndc.x, 0.0f));
+    float3 b_dy         = compute_barycentrics(c0, c1, c2, position_ndc + float2(0.0f, pixel_ndc.y));
+
+    Material material = buffer_materials[draw.material_index];
+    Surface surface; surface.flags = material.flags;
+
+    // attributes
+    float2 uv = interpolate(b, v0.uv, v1.uv, v2.uv);
+    material_sampler textures;
+    textures.vertex               = (gbuffer_vertex)0;
+    textures.vertex.position      = interpolate(b, p0, p1, p2);
+    textures.vertex.normal        = normalize(mul(interpolate(b, v0.normal, v1.normal, v2.normal), (float3x3)draw.transform));
+    textures.vertex.tangent       = normalize(mul(interpolate(b, v0.tangent, v1.tangent, v2.tangent), (float3x3)draw.transform));
+    textures.vertex.uv            = uv * material.tiling + material.offset;
+    textures.material_index       = draw.material_index;
+    textures.uv_dx                = (interpolate(b_dx, v0.uv, v1.uv, v2.uv) - uv) * material.tiling;
+    textures.uv_dy                = (interpolate(b_dy, v0.uv, v1.uv, v2.uv) - uv) * material.tiling;
+    textures.analytic_derivatives = true;
+
+    material_evaluation result;
+    result.initialize(material, textures.vertex.normal);
+    result.evaluate_albedo(surface, textures, feature_all);
+
+    if (length(buffer_frame.camera_position - textures.vertex.position) < g_quality_max_distance)
+    {
+        result.evaluate_surface(material, surface, textures, feature_all);
+
+        // the analytic derivatives of the vertex normal stand in for ddx/ddy
+        float3 normal_dx = normalize(mul(interpolate(b_dx, v0.normal, v1.normal, v2.normal), (float3x3)draw.transform)) - textures.vertex.normal;
+        float3 normal_dy = normalize(mul(interpolate(b_dy, v0.normal, v1.normal, v2.normal), (float3x3)draw.transform)) - textures.vertex.normal;
+        result.filter_roughness(normal_dx, normal_dy);
+    }
+
+    // velocity
+    float3 position_previous = mul(float4(interpolate(b, v0.position, v1.position, v2.position), 1.0f), draw.transform_previous).xyz;
+    float4 clip_current      = mul(float4(textures.vertex.position, 1.0f), buffer_frame.view_projection);
+    float4 clip_previous     = mul(float4(position_previous, 1.0f), buffer_frame.view_projection_previous);
+
+    // write to g-buffer
+    tex_uav[thread_id.xy]  = result.albedo;
+    tex_uav2[thread_id.xy] = gbuffer_encode_normal(result.normal, draw.material_index);
+    tex_uav3[thread_id.xy] = float4(result.roughness, result.metalness, result.emission, result.occlusion);
+    tex_uav4[thread_id.xy] = float4(compute_velocity(clip_current, clip_previous), 0.0f, 0.0f);
+}
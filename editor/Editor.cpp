@@ -276,7 +276,12 @@ void Editor::Tick()
             if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
             {
                 ImGui::UpdatePlatformWindows();
-                ImGui::RenderPlatformWindowsDefault();
+
+                // skipped along with the main window when the renderer has nothing to show
+                if (!Spartan::Renderer::IsIdle())
+                {
+                    ImGui::RenderPlatformWindowsDefault();
+                }
             }
         }
     }
@@ -72,11 +72,8 @@ class EditorHelper
 
     static void SaveWorld(const std::string& file_path)
     {
-        // save the scene asynchronously
-        Spartan::ThreadPool::AddTask([file_path]()
-        {
-            Spartan::World::SaveToFile(file_path);
-        });
+        // the world is snapshotted on the next tick and written in the background
+        Spartan::World::SaveToFileAsync(file_path);
     }
 
     static Editor* editor;
@@ -91,6 +88,7 @@ namespace ImGuiSp
         Model,
         Audio,
         Material,
+        Prefab,
         Undefined
     };
 
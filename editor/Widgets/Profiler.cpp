@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =======================
 #include "Profiler.h"
 #include "../ImGui/ImGuiExtension.h"
+#include "Profiling/Benchmark.h"
 //==================================
 
 //= NAMESPACES ===============
@@ -49,7 +50,14 @@ namespace
 
         // text
         ImGui::SetCursorPos(ImVec2(pos.x + m_tree_depth_stride * time_block.GetTreeDepth(), pos.y));
-        ImGui::Text("%s - %.2f ms", name, duration);
+        if (time_block.GetType() == Spartan::TimeBlockType::Cpu)
+        {
+            ImGui::Text("%s - %.2f ms - %u draws, %u barriers, %u pipelines", name, duration, time_block.GetDrawCalls(), time_block.GetBarriers(), time_block.GetPipelineBinds());
+        }
+        else
+        {
+            ImGui::Text("%s - %.2f ms", name, duration);
+        }
     }
 
     int mode_hardware = 0; // 0: gpu, 1: cpu
@@ -111,6 +119,19 @@ void Profiler::OnTickVisible()
         ImGui::SliderFloat("##update_interval", &interval, 0.0f, 0.5f, "Update Interval = %.2f");
         Spartan::Profiler::SetUpdateInterval(interval);
 
+        // results go to the console
+        #ifdef DEBUG
+        if (ImGuiSp::button("Benchmark Entities"))
+        {
+            Spartan::Benchmark::Entities();
+        }
+        ImGui::SameLine();
+        if (ImGuiSp::button("Benchmark Instances"))
+        {
+            Spartan::Benchmark::Instances();
+        }
+        #endif
+
         ImGui::Separator();
     }
 
@@ -177,6 +177,12 @@ void Properties::OnTickVisible()
         ShowMaterial(m_inspected_material.lock().get());
     }
 
+    // the panel writes straight into the components, so any edit has to wake up the on-demand renderer
+    if (GImGui->ActiveIdHasBeenEditedThisFrame)
+    {
+        Renderer::SetSceneDirty();
+    }
+
     ImGui::PopItemWidth();
 }
 
@@ -412,6 +412,9 @@ void RenderOptions::OnTickVisible()
             option_check_box("AABBs",                   Renderer_Option::Aabb);
             option_check_box("Wireframe",               Renderer_Option::Wireframe);
             option_check_box("Occlusion Culling (WIP)", Renderer_Option::OcclusionCulling);
+            option_check_box("Render Thread",           Renderer_Option::RenderThread, "Records frames on a dedicated thread, overlapping with the simulation (outside of the editor)");
+            option_check_box("Visibility Buffer",       Renderer_Option::VisibilityBuffer, "Simple opaque meshes write triangle ids and are shaded by a compute pass, instead of the g-buffer pass");
+            option_check_box("On-demand Rendering",     Renderer_Option::OnDemandRendering, "The editor only renders the world when something in it changed");
         }
 
         ImGui::EndTable();
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "AssetBrowser.h"
 #include "WorldViewer.h"
 #include "RHI/RHI_Device.h"
+#include "World/Prefab.h"
 #include "../ImGui/ImGuiExtension.h"
 #include "../ImGui/Implementation/ImGui_TransformGizmo.h"
 #include "Settings.h"
@@ -40,6 +41,7 @@ namespace
     bool first_frame         = true;
     uint32_t width_previous  = 0;
     uint32_t height_previous = 0;
+    bool pick_pending        = false;
 }
 
 Viewport::Viewport(Editor* editor) : Widget(editor)
@@ -100,13 +102,29 @@ void Viewport::OnTickVisible()
         m_editor->GetWidget<AssetBrowser>()->ShowMeshImportDialog(get<const char*>(payload->data));
     }
 
+    // handle prefab drop
+    if (auto payload = ImGuiSp::receive_drag_drop_payload(ImGuiSp::DragPayloadType::Prefab))
+    {
+        if (shared_ptr<Prefab> prefab = Prefab::Load(get<const char*>(payload->data)))
+        {
+            m_editor->GetWidget<WorldViewer>()->SetSelectedEntity(prefab->Instantiate());
+        }
+    }
+
     shared_ptr<Camera> camera = Renderer::GetCamera();
 
     // mouse picking
     if (camera && ImGui::IsMouseClicked(0) && ImGui::IsItemHovered() && ImGui::TransformGizmo::allow_picking())
     {
         camera->Pick();
+        pick_pending = true;
+    }
+
+    // the pick can wait on a gpu readback, so the selection is applied once it resolves
+    if (camera && pick_pending && !camera->IsPicking())
+    {
         m_editor->GetWidget<WorldViewer>()->SetSelectedEntity(camera->GetSelectedEntity());
+        pick_pending = false;
     }
 
     // entity transform gizmo (will only show if an entity has been picked)
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "TitleBar.h"
 #include "Viewport.h"
 #include "World/Entity.h"
+#include "World/Prefab.h"
 #include "World/Components/Light.h"
 #include "World/Components/AudioSource.h"
 #include "World/Components/AudioListener.h"
@@ -381,6 +382,12 @@ void WorldViewer::PopupContextMenu() const
     {
         ActionEntityDelete(selected_entity);
     }
+
+    if (ImGui::MenuItem("Create Prefab") && on_entity)
+    {
+        const string file_path = Spartan::ResourceCache::GetProjectDirectory() + selected_entity->GetObjectName() + Spartan::EXTENSION_PREFAB;
+        Spartan::Prefab::Create(selected_entity.get(), file_path);
+    }
     ImGui::Separator();
 
     // EMPTY
@@ -460,6 +460,7 @@ void FileDialog::ItemDrag(FileDialogItem* item) const
         if (FileSystem::IsSupportedImageFile(item->GetPath())) { set_payload(ImGuiSp::DragPayloadType::Texture,  item->GetPath()); }
         if (FileSystem::IsSupportedAudioFile(item->GetPath())) { set_payload(ImGuiSp::DragPayloadType::Audio,    item->GetPath()); }
         if (FileSystem::IsEngineMaterialFile(item->GetPath())) { set_payload(ImGuiSp::DragPayloadType::Material, item->GetPath()); }
+        if (FileSystem::IsEnginePrefabFile(item->GetPath()))   { set_payload(ImGuiSp::DragPayloadType::Prefab,   item->GetPath()); }
 
         // Preview
         ImGuiSp::image(item->GetTexture(), 50);
@@ -117,9 +117,9 @@ namespace Spartan
             SetResourceFilePath(file_path);
         }
 
-        // load
-        loaded        = (m_playMode == PlayMode::Memory) ? CreateSound(GetResourceFilePath()) : CreateStream(GetResourceFilePath());
-        m_object_size = estimate_memory_usage(static_cast<FMOD::Sound*>(m_fmod_sound));
+        // load, this only queues the sound, fmod reads and decodes it on its own thread
+        loaded  = (m_playMode == PlayMode::Memory) ? CreateSound(GetResourceFilePath()) : CreateStream(GetResourceFilePath());
+        m_state = loaded ? AudioClipState::Loading : AudioClipState::Failed;
 
         #endif
 
@@ -142,11 +142,25 @@ namespace Spartan
         return true;
     }
 
+    bool AudioClip::SaveToMemory(vector<byte>* data)
+    {
+        #if defined(_MSC_VER)
+
+        FileStream stream;
+        stream.Write(GetResourceFilePath());
+        *data = stream.GetData();
+
+        return true;
+        #else
+        return false;
+        #endif
+    }
+
     void AudioClip::Play(const bool loop, const bool is_3d)
     {
         #if defined(_MSC_VER)
 
-        if (IsPlaying())
+        if (IsPlaying() || !IsReady())
             return;
  
         Audio::PlaySound(m_fmod_sound, m_fmod_channel);
@@ -322,7 +336,7 @@ namespace Spartan
     bool AudioClip::Update()
     {
         #if defined(_MSC_VER)
-        if (!m_entity)
+        if (!m_entity || !m_fmod_channel)
             return true;
 
         const Vector3 pos = m_entity->GetPosition();
@@ -364,18 +378,42 @@ namespace Spartan
         return is_paused;
     }
 
+    AudioClipState AudioClip::GetState()
+    {
+        #if defined(_MSC_VER)
+        if (m_state != AudioClipState::Loading)
+            return m_state;
+
+        FMOD::Sound* sound        = static_cast<FMOD::Sound*>(m_fmod_sound);
+        FMOD_OPENSTATE open_state = FMOD_OPENSTATE_LOADING;
+        sound->getOpenState(&open_state, nullptr, nullptr, nullptr);
+
+        if (open_state == FMOD_OPENSTATE_ERROR)
+        {
+            SP_LOG_ERROR("Failed to load \"%s\"", GetResourceFilePath().c_str());
+            m_state = AudioClipState::Failed;
+        }
+        // streams report playing/seeking once opened, anything else than loading means it's usable
+        else if (open_state != FMOD_OPENSTATE_LOADING)
+        {
+            // the sound can only be modified once fmod is done with it
+            Audio::HandleErrorFmod(sound->set3DMinMaxDistance(m_distance_min, m_distance_max));
+            m_object_size = estimate_memory_usage(sound);
+            m_state       = AudioClipState::Ready;
+        }
+        #endif
+
+        return m_state;
+    }
+
     bool AudioClip::CreateSound(const string& file_path)
     {
         #if defined(_MSC_VER)
         // Create sound
         if (!Audio::CreateSound(file_path, GetSoundMode(), m_fmod_sound))
             return false;
-
-        // Set 3D min max distance
-        if (!Audio::HandleErrorFmod(static_cast<FMOD::Sound*>(m_fmod_sound)->set3DMinMaxDistance(m_distance_min, m_distance_max)))
-            return false;
-
         #endif
+
         return true;
     }
 
@@ -385,10 +423,6 @@ namespace Spartan
         // Create sound
         if (!Audio::CreateStream(file_path, GetSoundMode(), m_fmod_sound))
             return false;
-
-        // Set 3D min max distance
-        if (!Audio::HandleErrorFmod(static_cast<FMOD::Sound*>(m_fmod_sound)->set3DMinMaxDistance(m_distance_min, m_distance_max)))
-            return false;
         #endif
 
         return true;
@@ -401,6 +435,7 @@ namespace Spartan
         sound_mode              |= FMOD_2D;
         sound_mode              |= FMOD_3D_LINEARROLLOFF;
         sound_mode              |= FMOD_LOOP_OFF;
+        sound_mode              |= FMOD_NONBLOCKING;
 
         #endif
         return sound_mode;
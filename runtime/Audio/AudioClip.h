@@ -34,6 +34,14 @@ namespace Spartan
         Stream
     };
 
+    enum class AudioClipState
+    {
+        Unloaded,
+        Loading,
+        Ready,
+        Failed
+    };
+
     class SP_CLASS AudioClip : public IResource
     {
     public:
@@ -43,6 +51,7 @@ namespace Spartan
         //= IResource ===========================================
         bool LoadFromFile(const std::string& file_path) override;
         bool SaveToFile(const std::string& file_path) override;
+        bool SaveToMemory(std::vector<std::byte>* data) override;
         //=======================================================
 
         void Play(const bool loop, const bool is_3d);
@@ -81,6 +90,10 @@ namespace Spartan
         bool IsPlaying();
         bool IsPaused();
 
+        // sounds are opened asynchronously by fmod, the state is polled on query
+        AudioClipState GetState();
+        bool IsReady() { return GetState() == AudioClipState::Ready; }
+
         void ResetChannel() { m_fmod_channel = nullptr; }
 
     private:
@@ -96,5 +109,6 @@ namespace Spartan
         PlayMode m_playMode  = PlayMode::Memory;
         float m_distance_min = 0.1f;
         float m_distance_max = 1000.0f;
+        AudioClipState m_state = AudioClipState::Unloaded;
     };
 }
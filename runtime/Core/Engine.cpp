@@ -120,11 +120,27 @@ namespace Spartan
         Window::Tick();
         Input::Tick();
         Audio::Tick();
-        Physics::Tick();
-        World::Tick();
-        Renderer::Tick();
+        if (Renderer::IsRenderThreadEnabled())
+        {
+            // the render thread records the previous simulation step while this one is computed
+            Renderer::Tick();
+            Physics::Tick();
+            World::Tick();
+            Renderer::Synchronize();
+        }
+        else
+        {
+            Physics::Tick();
+            World::Tick();
+            Renderer::Tick();
+        }
 
         // post-tick
+        {
+            // throttle when there is nothing to show, or when the editor is in the background
+            bool in_background = Engine::IsFlagSet(EngineMode::Editor) && !Window::IsFocused();
+            Timer::SetThrottled(Window::IsMinimized() || Renderer::IsIdle() || in_background);
+        }
         Timer::PostTick();
         Profiler::PostTick();
     }
@@ -19,10 +19,20 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ============
+//= INCLUDES ==============
 #include "pch.h"
 #include <SDL_misc.h>
-//=======================
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#undef CreateDirectory
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+//=========================
 
 //= NAMESPACES =====
 using namespace std;
@@ -673,4 +683,67 @@ namespace Spartan
             return true;
         }
     }
+
+    const byte* FileSystem::MapFile(const string& path, uint64_t* size_out)
+    {
+        SP_ASSERT(size_out != nullptr);
+        *size_out = 0;
+
+        void* data = nullptr;
+        uint64_t size = 0;
+
+        #ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        LARGE_INTEGER file_size = {};
+        if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+        {
+            // the view keeps the mapping alive, so both handles can be closed right away
+            if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+            {
+                data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                size = static_cast<uint64_t>(file_size.QuadPart);
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+        #else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file == -1)
+            return nullptr;
+
+        struct stat file_stat = {};
+        if (fstat(file, &file_stat) == 0 && file_stat.st_size > 0)
+        {
+            // the mapping stays valid after the descriptor is closed
+            data = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            data = data == MAP_FAILED ? nullptr : data;
+            size = static_cast<uint64_t>(file_stat.st_size);
+        }
+        close(file);
+        #endif
+
+        if (!data)
+        {
+            SP_LOG_ERROR("Failed to map \"%s\"", path.c_str());
+            return nullptr;
+        }
+
+        *size_out = size;
+        return static_cast<const byte*>(data);
+    }
+
+    void FileSystem::UnmapFile(const byte* data, const uint64_t size)
+    {
+        if (!data)
+            return;
+
+        #ifdef _WIN32
+        UnmapViewOfFile(data);
+        #else
+        munmap(const_cast<byte*>(data), static_cast<size_t>(size));
+        #endif
+    }
 }
@@ -89,6 +89,10 @@ namespace Spartan
         static bool Delete(const std::string& path);
         static bool CreateDirectory(const std::string& path);
         static bool CopyFileFromTo(const std::string& source, const std::string& destination);
+
+        // memory mapping (read only)
+        static const std::byte* MapFile(const std::string& path, uint64_t* size_out);
+        static void UnmapFile(const std::byte* data, const uint64_t size);
     };
 
     static const char* EXTENSION_WORLD    = ".world";
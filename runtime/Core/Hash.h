@@ -0,0 +1,132 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES =======
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+//==================
+
+namespace Spartan
+{
+    // 128-bit content hash (murmurhash3 x64), used to recognize identical resources by what they contain
+    struct hash_128
+    {
+        uint64_t low  = 0;
+        uint64_t high = 0;
+
+        bool IsDefined() const                        { return low != 0 || high != 0; }
+        bool operator==(const hash_128& other) const { return low == other.low && high == other.high; }
+        bool operator!=(const hash_128& other) const { return !(*this == other); }
+    };
+
+    struct hash_128_hasher
+    {
+        size_t operator()(const hash_128& hash) const { return static_cast<size_t>(hash.low ^ (hash.high * 0x9e3779b97f4a7c15ULL)); }
+    };
+
+    namespace hash_detail
+    {
+        inline uint64_t rotl(const uint64_t x, const int r) { return (x << r) | (x >> (64 - r)); }
+
+        inline uint64_t fmix(uint64_t k)
+        {
+            k ^= k >> 33;
+            k *= 0xff51afd7ed558ccdULL;
+            k ^= k >> 33;
+            k *= 0xc4ceb9fe1a85ec53ULL;
+            k ^= k >> 33;
+            return k;
+        }
+    }
+
+    // pass a previous result as the seed to hash several buffers as one
+    inline hash_128 hash_compute(const void* data, const uint64_t size, const hash_128& seed = {})
+    {
+        using namespace hash_detail;
+
+        const uint8_t* bytes       = static_cast<const uint8_t*>(data);
+        const uint64_t c1          = 0x87c37b91114253d5ULL;
+        const uint64_t c2          = 0x4cf5ad432745937fULL;
+        const uint64_t block_count = size / 16;
+        const uint64_t tail_size   = size & 15;
+        uint64_t h1                = seed.low;
+        uint64_t h2                = seed.high;
+
+        for (uint64_t i = 0; i < block_count; i++)
+        {
+            uint64_t k1, k2;
+            memcpy(&k1, bytes + i * 16, sizeof(uint64_t));
+            memcpy(&k2, bytes + i * 16 + 8, sizeof(uint64_t));
+
+            k1 *= c1; k1 = rotl(k1, 31); k1 *= c2; h1 ^= k1;
+            h1  = rotl(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+            k2 *= c2; k2 = rotl(k2, 33); k2 *= c1; h2 ^= k2;
+            h2  = rotl(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+        }
+
+        // tail
+        const uint8_t* tail = bytes + block_count * 16;
+        uint64_t k1         = 0;
+        uint64_t k2         = 0;
+        for (uint64_t i = tail_size; i > 8; i--)
+        {
+            k2 ^= static_cast<uint64_t>(tail[i - 1]) << ((i - 9) * 8);
+        }
+        for (uint64_t i = tail_size < 8 ? tail_size : 8; i > 0; i--)
+        {
+            k1 ^= static_cast<uint64_t>(tail[i - 1]) << ((i - 1) * 8);
+        }
+        if (tail_size > 8) { k2 *= c2; k2 = rotl(k2, 33); k2 *= c1; h2 ^= k2; }
+        if (tail_size > 0) { k1 *= c1; k1 = rotl(k1, 31); k1 *= c2; h1 ^= k1; }
+
+        // finalization
+        h1 ^= size; h2 ^= size;
+        h1 += h2;   h2 += h1;
+        h1  = fmix(h1);
+        h2  = fmix(h2);
+        h1 += h2;   h2 += h1;
+
+        return { h1, h2 };
+    }
+
+    template<typename T>
+    hash_128 hash_compute(const T& value, const hash_128& seed = {})
+    {
+        return hash_compute(&value, sizeof(T), seed);
+    }
+
+    // 64-bit fnv-1a for names, constexpr so that literals are hashed at compile time
+    constexpr uint64_t hash_name(const std::string_view name)
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (const char c : name)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3ULL;
+        }
+
+        return hash;
+    }
+}
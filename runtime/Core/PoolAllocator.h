@@ -0,0 +1,248 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Definitions.h"
+//======================
+
+namespace Spartan
+{
+    // fixed size blocks carved out of slabs, one pool per type, so types that happen to share a size don't share memory
+    // each thread keeps a small free list so that most allocations don't touch the mutex
+    template<typename T>
+    class SlabPool
+    {
+    public:
+        static void* Allocate()
+        {
+            ThreadCache& cache = thread_cache;
+            if (cache.flushed)
+                return AllocateShared();
+
+            if (!cache.head)
+            {
+                Refill(cache);
+            }
+
+            Node* node = cache.head;
+            cache.head = node->next;
+            cache.count--;
+
+            return node;
+        }
+
+        static void Free(void* block)
+        {
+            ThreadCache& cache = thread_cache;
+            Node* node         = static_cast<Node*>(block);
+
+            // the thread is exiting, its cache is gone
+            if (cache.flushed)
+            {
+                FreeShared(node);
+                return;
+            }
+
+            // a thread can free blocks it never allocated
+            if (!cache.head)
+            {
+                static_cast<void>(&thread_cache_flush);
+            }
+
+            node->next = cache.head;
+            cache.head = node;
+            cache.count++;
+
+            // hand a batch back so that memory freed here can be reused by other threads
+            if (cache.count >= batch_size * 2)
+            {
+                Release(cache);
+            }
+        }
+
+    private:
+        union Node
+        {
+            Node* next;
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        // trivially destructible, so that it's still usable while other thread locals are being destroyed
+        struct ThreadCache
+        {
+            Node* head     = nullptr;
+            uint32_t count = 0;
+            bool flushed   = false;
+        };
+
+        // hands a thread's cached blocks back to the pool when the thread exits, it's constructed
+        // when the cache first receives blocks, so threads that never touch the pool don't register it
+        struct ThreadCacheFlush
+        {
+            ~ThreadCacheFlush()
+            {
+                ThreadCache& cache = thread_cache;
+                while (cache.head)
+                {
+                    Release(cache);
+                }
+                cache.flushed = true;
+            }
+        };
+
+        struct Shared
+        {
+            std::mutex mutex;
+            Node* head = nullptr;
+            std::vector<std::unique_ptr<Node[]>> slabs;
+        };
+
+        static void Grow(Shared& shared)
+        {
+            std::unique_ptr<Node[]>& slab = shared.slabs.emplace_back(std::make_unique<Node[]>(slab_size));
+            for (uint32_t i = 0; i < slab_size; i++)
+            {
+                slab[i].next = shared.head;
+                shared.head  = &slab[i];
+            }
+        }
+
+        static void Refill(ThreadCache& cache)
+        {
+            // the first odr-use constructs it, which registers the flush for this thread
+            static_cast<void>(&thread_cache_flush);
+
+            Shared& shared = GetShared();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            // grow by a slab if the shared list can't cover a batch
+            if (!shared.head)
+            {
+                Grow(shared);
+            }
+
+            for (uint32_t i = 0; i < batch_size && shared.head; i++)
+            {
+                Node* node  = shared.head;
+                shared.head = node->next;
+                node->next  = cache.head;
+                cache.head  = node;
+                cache.count++;
+            }
+        }
+
+        static void Release(ThreadCache& cache)
+        {
+            Shared& shared = GetShared();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            for (uint32_t i = 0; i < batch_size && cache.head; i++)
+            {
+                Node* node  = cache.head;
+                cache.head  = node->next;
+                node->next  = shared.head;
+                shared.head = node;
+                cache.count--;
+            }
+        }
+
+        static void* AllocateShared()
+        {
+            Shared& shared = GetShared();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            if (!shared.head)
+            {
+                Grow(shared);
+            }
+
+            Node* node  = shared.head;
+            shared.head = node->next;
+
+            return node;
+        }
+
+        static void FreeShared(Node* node)
+        {
+            Shared& shared = GetShared();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            node->next  = shared.head;
+            shared.head = node;
+        }
+
+        // never destroyed, objects can outlive any other static (e.g. entities held by the world)
+        static Shared& GetShared()
+        {
+            static Shared* shared = new Shared();
+            return *shared;
+        }
+
+        static constexpr uint32_t slab_size  = 256;
+        static constexpr uint32_t batch_size = 32;
+        static inline thread_local ThreadCache thread_cache;
+        static inline thread_local ThreadCacheFlush thread_cache_flush;
+    };
+
+    // std compatible allocator, meant for std::allocate_shared() so that the object
+    // and its control block end up in the same pooled block, allocate_shared() rebinds
+    // it to a control block type that is unique to T, so every T gets its own pool
+    template<typename T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        PoolAllocator() = default;
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>&) {}
+
+        T* allocate(const size_t count)
+        {
+            if (count == 1)
+                return static_cast<T*>(SlabPool<T>::Allocate());
+
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        void deallocate(T* object, const size_t count)
+        {
+            if (count == 1)
+            {
+                SlabPool<T>::Free(object);
+                return;
+            }
+
+            ::operator delete(object, std::align_val_t(alignof(T)));
+        }
+
+        template<typename U>
+        bool operator==(const PoolAllocator<U>&) const { return true; }
+        template<typename U>
+        bool operator!=(const PoolAllocator<U>&) const { return false; }
+    };
+}
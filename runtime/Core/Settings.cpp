@@ -82,6 +82,9 @@ namespace Spartan
                 case Renderer_Option::ResolutionScale:             return "ResolutionScale";
                 case Renderer_Option::DynamicResolution:           return "DynamicResolution";
                 case Renderer_Option::OcclusionCulling:            return "OcclusionCulling";
+                case Renderer_Option::RenderThread:                return "RenderThread";
+                case Renderer_Option::VisibilityBuffer:            return "VisibilityBuffer";
+                case Renderer_Option::OnDemandRendering:           return "OnDemandRendering";
                 default:
                 {
                     SP_ASSERT_MSG(false, "Renderer_Option not handled");
@@ -35,10 +35,11 @@ namespace Spartan
     {
     public:
         SpartanObject();
+        virtual ~SpartanObject() = default;
         
         // name
-        const std::string& GetObjectName() const    { return m_object_name; }
-        void SetObjectName(const std::string& name) { m_object_name = name; }
+        const std::string& GetObjectName() const            { return m_object_name; }
+        virtual void SetObjectName(const std::string& name) { m_object_name = name; }
 
         // id
         const uint64_t GetObjectId() const  { return m_object_id; }
@@ -46,6 +46,8 @@ namespace Spartan
         float fps_max            = 10000.0f;
         float fps_limit          = fps_min;
         float fps_limit_previous = fps_limit;
+        float fps_throttled      = 10.0f; // used while there is nothing to show, input is still polled so it has to be responsive enough
+        bool is_throttled        = false;
 
         // misc
         chrono::steady_clock::time_point last_tick_time;
@@ -66,9 +68,16 @@ namespace Spartan
         }
 
         // fps limit
-        double target_ms = 1000.0 / fps_limit;
+        double target_ms = 1000.0 / (is_throttled ? min(fps_throttled, fps_limit) : fps_limit);
         while (delta_time_ms < target_ms)
         {
+            // sleep through most of the wait and spin through the rest, sleeping is not precise enough for frame pacing
+            const double spin_ms = 2.0;
+            if (target_ms - delta_time_ms > spin_ms)
+            {
+                this_thread::sleep_for(chrono::duration<double, milli>(target_ms - delta_time_ms - spin_ms));
+            }
+
             delta_time_ms = static_cast<double>(chrono::duration<double, milli>(chrono::steady_clock::now() - last_tick_time).count());
         }
 
@@ -126,6 +135,11 @@ namespace Spartan
         }
     }
 
+    void Timer::SetThrottled(const bool throttled)
+    {
+        is_throttled = throttled;
+    }
+
     double Timer::GetTimeMs()
     {
         return time_ms;
@@ -45,6 +45,7 @@ namespace Spartan
         static float GetFpsLimit();
         static FpsLimitType GetFpsLimitType();
         static void OnVsyncToggled(const bool enabled);
+        static void SetThrottled(const bool throttled);
 
         // Times
         static double GetTimeMs();
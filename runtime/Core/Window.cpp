@@ -397,6 +397,11 @@ namespace Spartan
         return SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED;
     }
 
+    bool Window::IsFocused()
+    {
+        return SDL_GetWindowFlags(window) & SDL_WINDOW_INPUT_FOCUS;
+    }
+
     bool Window::IsFullScreen()
     {
         return SDL_GetWindowFlags(window) & SDL_WINDOW_FULLSCREEN;
@@ -56,6 +56,7 @@ namespace Spartan
         static void* GetHandleRaw();
         static void Close();
         static bool IsMinimized();
+        static bool IsFocused();
         static bool IsFullScreen();
         static bool WantsToClose();
 
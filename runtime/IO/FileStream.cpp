@@ -31,7 +31,7 @@ using namespace std;
 
 namespace Spartan
 {
-    FileStream::FileStream(const string& path, uint32_t flags)
+    FileStream::FileStream(const string& path, uint32_t flags) : out(m_file_out), in(m_file_in)
     {
         m_is_open = false;
         m_flags   = flags;
@@ -43,8 +43,8 @@ namespace Spartan
 
         if (m_flags & FileStream_Write)
         {
-            out.open(path, ios_flags);
-            if (out.fail())
+            m_file_out.open(path, ios_flags);
+            if (m_file_out.fail())
             {
                 SP_LOG_ERROR("Failed to open \"%s\" for writing", path.c_str());
                 return;
@@ -52,8 +52,8 @@ namespace Spartan
         }
         else if (m_flags & FileStream_Read)
         {
-            in.open(path, ios_flags);
-            if(in.fail())
+            m_file_in.open(path, ios_flags);
+            if(m_file_in.fail())
             {
                 SP_LOG_ERROR("Failed to open \"%s\" for reading", path.c_str());
                 return;
@@ -63,6 +63,17 @@ namespace Spartan
         m_is_open = true;
     }
 
+    FileStream::FileStream(const vector<byte>& data) : m_memory(ios::in | ios::out | ios::binary), out(m_memory), in(m_memory)
+    {
+        m_flags   = FileStream_Read | FileStream_Write | FileStream_Memory;
+        m_is_open = true;
+
+        if (!data.empty())
+        {
+            m_memory.write(reinterpret_cast<const char*>(data.data()), data.size());
+        }
+    }
+
     FileStream::~FileStream()
     {
         Close();
@@ -70,18 +81,30 @@ namespace Spartan
 
     void FileStream::Close()
     {
+        if (m_flags & FileStream_Memory)
+            return;
+
         if (m_flags & FileStream_Write)
         {
-            out.flush();
-            out.close();
+            m_file_out.flush();
+            m_file_out.close();
         }
         else if (m_flags & FileStream_Read)
         {
-            in.clear();
-            in.close();
+            m_file_in.clear();
+            m_file_in.close();
         }
     }
 
+    vector<byte> FileStream::GetData() const
+    {
+        SP_ASSERT_MSG((m_flags & FileStream_Memory) != 0, "Only memory streams hold their data");
+
+        const string data = m_memory.str();
+        const byte* begin = reinterpret_cast<const byte*>(data.data());
+        return vector<byte>(begin, begin + data.size());
+    }
+
     void FileStream::Write(const string& value)
     {
         const auto length = static_cast<uint32_t>(value.length());
@@ -115,6 +138,13 @@ namespace Spartan
         out.write(reinterpret_cast<const char*>(&value[0]), sizeof(uint32_t) * length);
     }
 
+    void FileStream::Write(const vector<float>& value)
+    {
+        const auto length = static_cast<uint32_t>(value.size());
+        Write(length);
+        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(float) * length);
+    }
+
     void FileStream::Write(const vector<unsigned char>& value)
     {
         const auto size = static_cast<uint32_t>(value.size());
@@ -126,7 +156,7 @@ namespace Spartan
     {
         const auto size = static_cast<uint32_t>(value.size());
         Write(size);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(std::byte) * size);
+        out.write(reinterpret_cast<const char*>(value.data()), sizeof(std::byte) * size);
     }
 
     void FileStream::Write(const atomic<bool>& value)
@@ -134,6 +164,11 @@ namespace Spartan
         out.write(reinterpret_cast<const char*>(&value), sizeof(bool));
     }
 
+    void FileStream::Write(const byte* data, const uint64_t size)
+    {
+        out.write(reinterpret_cast<const char*>(data), size);
+    }
+
     void FileStream::Skip(uint64_t n)
     {
         // Set the seek cursor to offset n from the current position
@@ -204,6 +239,21 @@ namespace Spartan
         in.read(reinterpret_cast<char*>(vec->data()), sizeof(uint32_t) * length);
     }
 
+    void FileStream::Read(vector<float>* vec)
+    {
+        if (!vec)
+            return;
+
+        vec->clear();
+
+        const auto length = ReadAs<uint32_t>();
+
+        vec->reserve(length);
+        vec->resize(length);
+
+        in.read(reinterpret_cast<char*>(vec->data()), sizeof(float) * length);
+    }
+
     void FileStream::Read(vector<unsigned char>* vec)
     {
         if (!vec)
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================
 #include <vector>
 #include <fstream>
+#include <sstream>
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 #include "../Math/Vector4.h"
@@ -39,6 +40,7 @@ namespace Spartan
         FileStream_Read   = 1 << 0,
         FileStream_Write  = 1 << 1,
         FileStream_Append = 1 << 2,
+        FileStream_Memory = 1 << 3
     };
 
     class SP_CLASS FileStream
@@ -47,6 +49,10 @@ namespace Spartan
         FileStream(const std::string& path, uint32_t flags);
         ~FileStream();
 
+        // memory backed, for serialized data that is kept or compared in ram, it can be read back after writing
+        FileStream(const std::vector<std::byte>& data = {});
+        std::vector<std::byte> GetData() const;
+
         auto IsOpen() const { return m_is_open; }
         void Close();
 
@@ -83,9 +89,11 @@ namespace Spartan
         void Write(const std::vector<std::string>& value);
         void Write(const std::vector<RHI_Vertex_PosTexNorTan>& value);
         void Write(const std::vector<uint32_t>& value);
+        void Write(const std::vector<float>& value);
         void Write(const std::vector<unsigned char>& value);
         void Write(const std::vector<std::byte>& value);
         void Write(const std::atomic<bool>& value);
+        void Write(const std::byte* data, const uint64_t size); // raw, without a size prefix
         void Skip(uint64_t n);
         //===========================================================
         
@@ -122,6 +130,7 @@ namespace Spartan
         void Read(std::vector<std::string>* vec);
         void Read(std::vector<RHI_Vertex_PosTexNorTan>* vec);
         void Read(std::vector<uint32_t>* vec);
+        void Read(std::vector<float>* vec);
         void Read(std::vector<unsigned char>* vec);
         void Read(std::vector<std::byte>* vec);
         void Read(std::atomic<bool>* value);
@@ -155,8 +164,11 @@ namespace Spartan
         //=====================================================
 
     private:
-        std::ofstream out;
-        std::ifstream in;
+        std::ofstream m_file_out;
+        std::ifstream m_file_in;
+        std::stringstream m_memory;
+        std::ostream& out;
+        std::istream& in;
         uint32_t m_flags;
         bool m_is_open;
     };
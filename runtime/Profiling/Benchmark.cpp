@@ -0,0 +1,157 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============================
+#include "pch.h"
+#include "Benchmark.h"
+#include "../Core/PoolAllocator.h"
+#include "../World/Entity.h"
+#include "../World/Components/Renderable.h"
+#include "../World/Components/Constraint.h"
+//=========================================
+
+#ifdef DEBUG
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    void Benchmark::Entities(const uint32_t entity_count)
+    {
+        SP_ASSERT(entity_count != 0);
+
+        // allocation throughput, the first pooled pass grows the slabs, so the second one is measured
+        float ms_pool = 0.0f;
+        float ms_heap = 0.0f;
+        {
+            vector<shared_ptr<Entity>> objects;
+            objects.reserve(entity_count);
+
+            for (uint32_t pass = 0; pass < 2; pass++)
+            {
+                const Stopwatch timer;
+                for (uint32_t i = 0; i < entity_count; i++)
+                {
+                    objects.emplace_back(allocate_shared<Entity>(PoolAllocator<Entity>()));
+                }
+                objects.clear();
+                ms_pool = timer.GetElapsedTimeMs();
+            }
+
+            const Stopwatch timer;
+            for (uint32_t i = 0; i < entity_count; i++)
+            {
+                objects.emplace_back(make_shared<Entity>());
+            }
+            objects.clear();
+            ms_heap = timer.GetElapsedTimeMs();
+        }
+
+        // entities allocated the way World::CreateEntity() does, but kept out of the world
+        vector<shared_ptr<Entity>> entities;
+        entities.reserve(entity_count);
+
+        Stopwatch timer;
+        for (uint32_t i = 0; i < entity_count; i++)
+        {
+            shared_ptr<Entity> entity = entities.emplace_back(allocate_shared<Entity>(PoolAllocator<Entity>()));
+            entity->Initialize();
+            entity->AddComponent<Renderable>();
+            entity->AddComponent<Constraint>();
+        }
+        const float ms_create = timer.GetElapsedTimeMs();
+
+        // the same loop World::Tick() runs, this is where scattered entities and components cost cache misses
+        timer.Start();
+        for (shared_ptr<Entity>& entity : entities)
+        {
+            entity->Tick();
+        }
+        const float ms_tick = timer.GetElapsedTimeMs();
+
+        timer.Start();
+        entities.clear();
+        const float ms_remove = timer.GetElapsedTimeMs();
+
+        SP_LOG_INFO("%u entities: allocation %.2f ms (heap %.2f ms), creation %.2f ms, tick %.2f ms, removal %.2f ms",
+            entity_count, ms_pool, ms_heap, ms_create, ms_tick, ms_remove);
+    }
+
+    void Benchmark::Instances(const uint32_t instance_count)
+    {
+        SP_ASSERT(instance_count != 0);
+
+        shared_ptr<Entity> entity = allocate_shared<Entity>(PoolAllocator<Entity>());
+        entity->Initialize();
+        shared_ptr<Renderable> renderable = entity->AddComponent<Renderable>();
+
+        // a square grid with a couple of units between instances, so that they spread over many cells
+        const uint32_t side = static_cast<uint32_t>(ceil(sqrt(static_cast<float>(instance_count))));
+        auto position = [side](const uint32_t i)
+        {
+            return Math::Vector3(static_cast<float>(i % side) * 2.0f, 0.0f, static_cast<float>(i / side) * 2.0f);
+        };
+
+        vector<uint32_t> handles(instance_count);
+        Stopwatch timer;
+        for (uint32_t i = 0; i < instance_count; i++)
+        {
+            handles[i] = renderable->AddInstance(Math::Matrix::CreateTranslation(position(i)));
+        }
+        const float ms_add = timer.GetElapsedTimeMs();
+
+        timer.Start();
+        renderable->UpdateProxy();
+        const float ms_add_proxy = timer.GetElapsedTimeMs();
+
+        // a small move keeps the instances in their cells, so they are updated in place
+        const uint32_t update_count = max(instance_count / 100, 1U);
+        timer.Start();
+        for (uint32_t i = 0; i < update_count; i++)
+        {
+            const uint32_t index = (i * 100) % instance_count;
+            renderable->UpdateInstance(handles[index], Math::Matrix::CreateTranslation(position(index) + Math::Vector3(0.01f, 0.0f, 0.0f)));
+        }
+        const float ms_update = timer.GetElapsedTimeMs();
+
+        timer.Start();
+        renderable->UpdateProxy();
+        const float ms_update_proxy = timer.GetElapsedTimeMs();
+
+        timer.Start();
+        for (uint32_t i = 0; i < instance_count; i++)
+        {
+            renderable->RemoveInstance(handles[i]);
+        }
+        const float ms_remove = timer.GetElapsedTimeMs();
+
+        timer.Start();
+        renderable->UpdateProxy();
+        const float ms_remove_proxy = timer.GetElapsedTimeMs();
+
+        SP_LOG_INFO("%u instances: add %.2f ms (proxy %.2f ms), update %u %.2f ms (proxy %.2f ms), removal %.2f ms (proxy %.2f ms)",
+            instance_count, ms_add, ms_add_proxy, update_count, ms_update, ms_update_proxy, ms_remove, ms_remove_proxy);
+    }
+}
+
+#endif
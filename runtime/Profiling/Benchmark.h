@@ -0,0 +1,44 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include "Definitions.h"
+//======================
+
+// debug builds only, the benchmarks build their own entities and log the timings, the world is left untouched
+#ifdef DEBUG
+namespace Spartan
+{
+    class SP_CLASS Benchmark
+    {
+    public:
+        // creates, ticks and removes entities with a couple of components, along with
+        // the raw allocation throughput of the entity pool compared to the general purpose heap
+        static void Entities(const uint32_t entity_count = 10000);
+
+        // adds instances to a renderable, updates a percent of them, then removes them, along with the cost of
+        // the proxy copy the renderer does after each step, the gpu upload isn't included
+        static void Instances(const uint32_t instance_count = 1000000);
+    };
+}
+#endif
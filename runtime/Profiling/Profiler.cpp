@@ -28,6 +28,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_SwapChain.h"
 #include "../Core/ThreadPool.h"
 #include "../Rendering/Renderer.h"
+#include "../Rendering/GeometryPool.h"
+#include "../Rendering/Mesh.h"
 #include "../Resource/ResourceCache.h"
 #include "../Display/Display.h"
 //====================================
@@ -57,6 +59,26 @@ namespace Spartan
     uint32_t Profiler::m_rhi_bindings_render_target     = 0;
     uint32_t Profiler::m_rhi_bindings_texture_storage   = 0;
     uint32_t Profiler::m_rhi_bindings_descriptor_set    = 0;
+    uint32_t Profiler::m_rhi_clears                     = 0;
+    uint32_t Profiler::m_rhi_transfers                  = 0;
+
+    // metrics - occlusion culling
+    uint32_t Profiler::m_occlusion_occluders = 0;
+    uint32_t Profiler::m_occlusion_tested    = 0;
+    uint32_t Profiler::m_occlusion_culled    = 0;
+    float Profiler::m_occlusion_time         = 0.0f;
+
+    // metrics - shadows
+    uint32_t Profiler::m_shadow_casters_considered = 0;
+    uint32_t Profiler::m_shadow_casters_drawn      = 0;
+
+    // metrics - visibility buffer
+    uint32_t Profiler::m_visibility_buffer_draws = 0;
+
+    // metrics - light tiles
+    uint32_t Profiler::m_light_tiles_simple  = 0;
+    uint32_t Profiler::m_light_tiles_complex = 0;
+    uint32_t Profiler::m_light_tiles_sky     = 0;
 
     // metrics - time
     float Profiler::m_time_frame_avg  = 0.0f;
@@ -303,6 +325,10 @@ namespace Spartan
         if (!Profiler::IsGpuTimingEnabled() || !poll)
             return;
 
+        // the time block stack is not thread safe, so when there is a render thread, it owns it
+        if (Renderer::IsRenderThreadEnabled() && !Renderer::IsCallerRenderThread())
+            return;
+
         const bool can_profile_cpu = (type == TimeBlockType::Cpu) && profile_cpu;
         const bool can_profile_gpu = (type == TimeBlockType::Gpu) && profile_gpu;
 
@@ -320,6 +346,9 @@ namespace Spartan
 
     void Profiler::TimeBlockEnd()
     {
+        if (Renderer::IsRenderThreadEnabled() && !Renderer::IsCallerRenderThread())
+            return;
+
         if (TimeBlock* time_block = GetLastIncompleteTimeBlock())
         {
             time_block->End();
@@ -457,6 +486,13 @@ namespace Spartan
         const uint32_t material_count = ResourceCache::GetResourceCount(ResourceType::Material);
         const uint32_t pipeline_count = RHI_Device::GetPipelineCount();
 
+        // cpu side geometry that is still resident (most of it is released after the gpu upload)
+        uint64_t mesh_cpu_memory = 0;
+        for (const shared_ptr<IResource>& resource : ResourceCache::GetByType(ResourceType::Mesh))
+        {
+            mesh_cpu_memory += static_pointer_cast<Mesh>(resource)->GetMemoryUsage();
+        }
+
         // get the graphics driver vendor
         string api_vendor_name = "NVIDIA";
         if (RHI_Device::GetPrimaryPhysicalDevice()->IsAmd())
@@ -498,7 +534,8 @@ namespace Spartan
             << "Output:\t\t\t" << static_cast<uint32_t>(Renderer::GetResolutionOutput().x) << "x" << static_cast<int>(Renderer::GetResolutionOutput().y) << endl
             << "Viewport:\t\t" << static_cast<uint32_t>(Renderer::GetViewport().width)     << "x" << static_cast<int>(Renderer::GetViewport().height)    << endl
             << "HDR:\t\t\t\t"  << (Renderer::GetSwapChain()->IsHdr() ? "Enabled" : "Disabled") << endl
-            << "Max nits:\t\t" << Display::GetLuminanceMax() << endl;
+            << "Max nits:\t\t" << Display::GetLuminanceMax() << endl
+            << "Frames:\t\t\t" << Renderer::GetFrameNumScene() << "/" << Renderer::GetFrameNum() << " (world/total)" << endl;
 
         // cpu
         oss_metrics << endl << "CPU" << endl
@@ -516,12 +553,48 @@ namespace Spartan
             << "Bindings:\t\t\t" << m_rhi_pipeline_bindings << endl
             << "Barriers:\t\t\t" << m_rhi_pipeline_barriers << endl;
 
+        // clears and transfers, render pass clears are included
+        oss_metrics << "\nClears and transfers\n"
+            << "Clears:\t\t\t\t" << m_rhi_clears << endl
+            << "Transfers:\t\t\t" << m_rhi_transfers << endl;
+
+        // occlusion culling
+        oss_metrics << "\nOcclusion culling\n"
+            << "Occluders:\t\t" << m_occlusion_occluders << endl
+            << "Culled:\t\t\t"  << m_occlusion_culled << "/" << m_occlusion_tested << endl
+            << "Time:\t\t\t\t" << m_occlusion_time << " ms" << endl;
+
+        // shadows
+        oss_metrics << "\nShadows\n"
+            << "Casters:\t\t\t" << m_shadow_casters_drawn << "/" << m_shadow_casters_considered << endl;
+
+        // visibility buffer, raster bandwidth is 4 bytes per pixel instead of the g-buffer's 16
+        // both pay another 4 when ssr or gi need unpacked normals (the default), see gbuffer_normal_unpacked
+        if (Renderer::GetOption<bool>(Renderer_Option::VisibilityBuffer))
+        {
+            const Math::Vector2& resolution = Renderer::GetResolutionRender();
+            float pixels_mb                 = resolution.x * resolution.y / (1024.0f * 1024.0f);
+            float unpacked_normals          = (Renderer::GetOption<bool>(Renderer_Option::ScreenSpaceReflections) || Renderer::GetOption<bool>(Renderer_Option::GlobalIllumination)) ? 4.0f : 0.0f;
+
+            oss_metrics << "\nVisibility buffer\n"
+                << "Draws:\t\t\t" << m_visibility_buffer_draws << endl
+                << "Raster:\t\t\t" << pixels_mb * (4.0f + unpacked_normals) << " MB (g-buffer: " << pixels_mb * (16.0f + unpacked_normals) << " MB)" << endl;
+        }
+
+        // light tiles, counts lag a few frames behind since they are read back from the gpu
+        oss_metrics << "\nLight tiles\n"
+            << "Simple:\t\t\t"  << m_light_tiles_simple  << endl
+            << "Complex:\t\t" << m_light_tiles_complex << endl
+            << "Sky:\t\t\t\t"  << m_light_tiles_sky     << endl;
+
         // resources
         oss_metrics << "\nResources\n"
             << "Textures:\t\t\t\t\t\t\t\t"  << texture_count          << endl
             << "Materials:\t\t\t\t\t\t\t"   << material_count         << endl
             << "Pipelines:\t\t\t\t\t\t\t\t" << pipeline_count         << endl
-            << "Descriptor set capacity:\t" << m_descriptor_set_count << "/" << rhi_max_descriptor_set_count;
+            << "Descriptor set capacity:\t" << m_descriptor_set_count << "/" << rhi_max_descriptor_set_count << endl
+            << "Mesh data (CPU):\t\t\t\t" << mesh_cpu_memory / 1024 / 1024 << " MB" << endl
+            << "Geometry pool:\t\t\t\t\t" << GeometryPool::GetMemoryUsed() / 1024 / 1024 << "/" << GeometryPool::GetMemoryAllocated() / 1024 / 1024 << " MB - " << GeometryPool::GetPageCount() << " pages";
 
         // draw at the top-left of the screen
         metrics_str = oss_metrics.str();
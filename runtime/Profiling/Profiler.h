@@ -83,6 +83,26 @@ namespace Spartan
         static uint32_t m_rhi_bindings_render_target;
         static uint32_t m_rhi_bindings_texture_storage;
         static uint32_t m_rhi_bindings_descriptor_set;
+        static uint32_t m_rhi_clears;
+        static uint32_t m_rhi_transfers;
+
+        // metrics - occlusion culling
+        static uint32_t m_occlusion_occluders;
+        static uint32_t m_occlusion_tested;
+        static uint32_t m_occlusion_culled;
+        static float m_occlusion_time;
+
+        // metrics - shadows
+        static uint32_t m_shadow_casters_considered;
+        static uint32_t m_shadow_casters_drawn;
+
+        // metrics - visibility buffer
+        static uint32_t m_visibility_buffer_draws;
+
+        // metrics - light tiles
+        static uint32_t m_light_tiles_simple;
+        static uint32_t m_light_tiles_complex;
+        static uint32_t m_light_tiles_sky;
 
         // metrics - time
         static float m_time_frame_avg ;
@@ -130,6 +150,8 @@ namespace Spartan
             m_rhi_bindings_render_target     = 0;
             m_rhi_bindings_texture_storage   = 0;
             m_rhi_bindings_descriptor_set    = 0;
+            m_rhi_clears                     = 0;
+            m_rhi_transfers                  = 0;
         }
 
         static TimeBlock* GetNewTimeBlock();
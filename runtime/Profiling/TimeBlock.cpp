@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_Device.h"
 #include "../RHI/RHI_CommandList.h"
 #include "../Rendering/Renderer.h"
+#include "Profiler.h"
 //=================================
 
 //= NAMESPACES =====
@@ -57,6 +58,11 @@ namespace Spartan
         if (type == TimeBlockType::Cpu)
         {
             m_start = chrono::high_resolution_clock::now();
+
+            // snapshot the rhi counters, the difference at End() is the work of this block
+            m_draw_calls     = Profiler::m_rhi_draw;
+            m_barriers       = Profiler::m_rhi_pipeline_barriers;
+            m_pipeline_binds = Profiler::m_rhi_pipeline_bindings;
         }
         else if (type == TimeBlockType::Gpu)
         {
@@ -82,6 +88,10 @@ namespace Spartan
             {
                 const chrono::duration<double, milli> ms = m_end - m_start;
                 m_duration = static_cast<float>(ms.count());
+
+                m_draw_calls     = Profiler::m_rhi_draw              - m_draw_calls;
+                m_barriers       = Profiler::m_rhi_pipeline_barriers - m_barriers;
+                m_pipeline_binds = Profiler::m_rhi_pipeline_bindings - m_pipeline_binds;
             }
             else if (m_type == TimeBlockType::Gpu)
             {
@@ -101,6 +111,9 @@ namespace Spartan
         m_max_tree_depth = 0;
         m_type           = TimeBlockType::Undefined;
         m_is_complete    = false;
+        m_draw_calls     = 0;
+        m_barriers       = 0;
+        m_pipeline_binds = 0;
     }
 
     uint32_t TimeBlock::FindTreeDepth(const TimeBlock* time_block, uint32_t depth /*= 0*/)
@@ -56,6 +56,9 @@ namespace Spartan
         float GetDuration()          const { return m_duration; }
         bool IsComplete()            const { return m_is_complete; }
         uint32_t GetId()             const { return m_id; }
+        uint32_t GetDrawCalls()      const { return m_draw_calls; }
+        uint32_t GetBarriers()       const { return m_barriers; }
+        uint32_t GetPipelineBinds()  const { return m_pipeline_binds; }
 
     private:    
         static uint32_t FindTreeDepth(const TimeBlock* time_block, uint32_t depth = 0);
@@ -76,5 +79,10 @@ namespace Spartan
         // CPU timing
         std::chrono::high_resolution_clock::time_point m_start;
         std::chrono::high_resolution_clock::time_point m_end;
+
+        // rhi work issued while the (cpu) block was active
+        uint32_t m_draw_calls     = 0;
+        uint32_t m_barriers       = 0;
+        uint32_t m_pipeline_binds = 0;
     };
 }
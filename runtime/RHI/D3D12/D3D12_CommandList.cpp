@@ -196,6 +196,26 @@ namespace Spartan
         SP_ASSERT(source->GetHeight() == destination->GetHeight());
     }
 
+    void RHI_CommandList::Copy(RHI_Texture* source, RHI_Buffer* destination, const uint64_t destination_offset, const uint32_t mip_index, const uint32_t array_index, const uint32_t x, const uint32_t y, uint32_t width, uint32_t height)
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
+
+    void RHI_CommandList::Copy(RHI_Buffer* source, const uint64_t source_offset, RHI_Buffer* destination, const uint64_t destination_offset, const uint64_t size)
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
+
+    void RHI_CommandList::Copy(RHI_GeometryBuffer* source, const uint32_t element_offset, const uint32_t element_count, RHI_Buffer* destination, const uint64_t destination_offset)
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
+
+    void RHI_CommandList::Copy(RHI_Buffer* source, const uint64_t source_offset, RHI_GeometryBuffer* destination, const vector<pair<uint32_t, uint32_t>>& ranges)
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
+
     void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
     {
         SP_ASSERT(m_state == RHI_CommandListState::Recording);
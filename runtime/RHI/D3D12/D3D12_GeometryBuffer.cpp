@@ -39,4 +39,24 @@ namespace Spartan
     {
 
     }
+
+    void RHI_GeometryBuffer::Update(const void* data, const uint32_t element_offset, const uint32_t element_count)
+    {
+
+    }
+
+    void RHI_GeometryBuffer::Update(const void* data, const vector<pair<uint32_t, uint32_t>>& ranges)
+    {
+
+    }
+
+    void RHI_GeometryBuffer::Copy(const RHI_GeometryBuffer* source, const uint32_t element_count)
+    {
+
+    }
+
+    void RHI_GeometryBuffer::Read(void* data, const uint32_t element_offset, const uint32_t element_count) const
+    {
+
+    }
 }
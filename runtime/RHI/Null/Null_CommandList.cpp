@@ -0,0 +1,926 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "pch.h"
+#include "../RHI_Device.h"
+#include "../RHI_Queue.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_GeometryBuffer.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_Buffer.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_RasterizerState.h"
+#include "../Rendering/Renderer.h"
+#include "../../Profiling/Profiler.h"
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+// commands are validated and tracked like on a real device (state, layouts, descriptors, profiler counters)
+// but nothing is recorded, so the cpu cost of the renderer can be measured without a gpu
+
+namespace Spartan
+{
+    namespace descriptor_sets
+    {
+        bool bind_dynamic = false;
+
+        void set_dynamic(RHI_DescriptorSetLayout* layout)
+        {
+            // this is where descriptor sets get created/updated
+            SP_ASSERT(layout->GetDescriptorSet()->GetResource() != nullptr);
+
+            // get dynamic offsets
+            array<uint32_t, 10> dynamic_offsets;
+            uint32_t dynamic_offset_count = 0;
+            layout->GetDynamicOffsets(&dynamic_offsets, &dynamic_offset_count);
+
+            bind_dynamic = false;
+            Profiler::m_rhi_bindings_descriptor_set++;
+        }
+
+        void set_bindless()
+        {
+            Profiler::m_rhi_bindings_descriptor_set++;
+        }
+    }
+
+    namespace queries
+    {
+        namespace timestamp
+        {
+            const uint32_t query_count = 128;
+        }
+
+        namespace occlusion
+        {
+            uint32_t index              = 0;
+            uint32_t index_active       = 0;
+            bool occlusion_query_active = false;
+            unordered_map<uint64_t, uint32_t> id_to_index;
+        }
+    }
+
+    RHI_CommandList::RHI_CommandList(void* cmd_pool, const char* name)
+    {
+        m_rhi_resource          = static_cast<void*>(this);
+        m_rhi_cmd_pool_resource = cmd_pool;
+
+        // semaphores
+        m_rendering_complete_semaphore          = make_shared<RHI_Semaphore>(false, name);
+        m_rendering_complete_semaphore_timeline = make_shared<RHI_Semaphore>(true, name);
+    }
+
+    RHI_CommandList::~RHI_CommandList()
+    {
+        m_rhi_resource = nullptr;
+    }
+
+    void RHI_CommandList::Begin(const RHI_Queue* queue)
+    {
+        if (m_state == RHI_CommandListState::Recording)
+        {
+            SP_LOG_WARNING("Discarding all previously recorded commands as the command list is already in recording state...");
+        }
+
+        // set states
+        m_state     = RHI_CommandListState::Recording;
+        m_pso       = RHI_PipelineState();
+        m_cull_mode = RHI_CullMode::Max;
+
+        // set dynamic states
+        if (queue->GetType() == RHI_Queue_Type::Graphics)
+        {
+            // cull mode
+            SetCullMode(RHI_CullMode::Back);
+
+            // scissor rectangle
+            Math::Rectangle scissor_rect;
+            scissor_rect.left   = 0.0f;
+            scissor_rect.top    = 0.0f;
+            scissor_rect.right  = static_cast<float>(m_pso.GetWidth());
+            scissor_rect.bottom = static_cast<float>(m_pso.GetHeight());
+            SetScissorRectangle(scissor_rect);
+        }
+
+        // queries
+        if (queue->GetType() != RHI_Queue_Type::Copy)
+        {
+            m_timestamp_index = 0;
+        }
+    }
+
+    void RHI_CommandList::Submit(RHI_Queue* queue, const uint64_t swapchain_id)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // end
+        RenderPassEnd();
+
+        // when minimized, or when entering/exiting fullscreen mode, the swapchain
+        // won't present, and won't wait for this semaphore, so we need to reset it
+        if (m_rendering_complete_semaphore->IsSignaled())
+        {
+            m_rendering_complete_semaphore = make_shared<RHI_Semaphore>(false, m_rendering_complete_semaphore_timeline->GetObjectName().c_str());
+        }
+
+        queue->Submit(
+            m_rhi_resource,                               // cmd buffer
+            0,                                            // wait flags
+            m_rendering_complete_semaphore.get(),         // signal semaphore
+            m_rendering_complete_semaphore_timeline.get() // signal semaphore
+        );
+
+        m_swapchain_id = swapchain_id;
+        m_state        = RHI_CommandListState::Submitted;
+    }
+
+    void RHI_CommandList::SetPipelineState(RHI_PipelineState& pso)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // early exit if the pipeline state hasn't changed
+        pso.Prepare();
+        if (m_pso.GetHash() == pso.GetHash())
+            return;
+
+        // get (or create) a pipeline which matches the requested pipeline state
+        m_pso = pso;
+        RHI_Device::GetOrCreatePipeline(m_pso, m_pipeline, m_descriptor_layout_current);
+
+        // bind pipeline
+        {
+            SP_ASSERT(m_pipeline != nullptr);
+            SP_ASSERT(m_pipeline->GetResource_Pipeline() != nullptr);
+
+            // profile
+            Profiler::m_rhi_pipeline_bindings++;
+
+            // set some dynamic states
+            if (m_pso.IsGraphics())
+            {
+                // cull mode
+                if (m_pso.rasterizer_state->GetPolygonMode() == RHI_PolygonMode::Wireframe)
+                {
+                    SetCullMode(RHI_CullMode::None);
+                }
+
+                // scissor rectangle
+                Math::Rectangle scissor_rect;
+                scissor_rect.left   = 0.0f;
+                scissor_rect.top    = 0.0f;
+                scissor_rect.right  = static_cast<float>(m_pso.GetWidth());
+                scissor_rect.bottom = static_cast<float>(m_pso.GetHeight());
+                SetScissorRectangle(scissor_rect);
+
+                // vertex and index buffer state
+                m_buffer_id_index  = 0;
+                m_buffer_id_vertex = 0;
+            }
+        }
+
+        // bind descriptors
+        {
+            // set bindless descriptors
+            descriptor_sets::set_bindless();
+
+            // set standard resources (dynamic descriptors)
+            Renderer::SetStandardResources(this);
+            descriptor_sets::set_dynamic(m_descriptor_layout_current);
+        }
+
+        RenderPassBegin();
+    }
+
+    void RHI_CommandList::RenderPassBegin()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        RenderPassEnd();
+
+        if (!m_pso.IsGraphics())
+            return;
+
+        // color attachments
+        if (RHI_SwapChain* swapchain = m_pso.render_target_swapchain)
+        {
+            swapchain->SetLayout(RHI_Image_Layout::Attachment, this);
+            SP_ASSERT(swapchain->GetRhiRtv() != nullptr);
+        }
+        else
+        { 
+            for (uint32_t i = 0; i < rhi_max_render_target_count; i++)
+            {
+                RHI_Texture* rt = m_pso.render_target_color_textures[i];
+
+                if (rt == nullptr)
+                    break;
+
+                SP_ASSERT_MSG(rt->IsRtv(), "The texture wasn't created with the RHI_Texture_RenderTarget flag and/or isn't a color format");
+                rt->SetLayout(RHI_Image_Layout::Attachment, this);
+            }
+        }
+
+        // depth-stencil attachment
+        if (RHI_Texture* rt = m_pso.render_target_depth_texture)
+        {
+            SP_ASSERT(rt->IsDsv());
+            rt->SetLayout(RHI_Image_Layout::Attachment, this);
+        }
+
+        // variable rate shading
+        if (m_pso.vrs_input_texture)
+        {
+            m_pso.vrs_input_texture->SetLayout(RHI_Image_Layout::Shading_Rate_Attachment, this);
+        }
+
+        // begin render pass
+        InsertPendingBarrierGroup();
+
+        // set dynamic states
+        {
+            // variable rate shading
+            RHI_Device::SetVariableRateShading(this, m_pso.vrs_input_texture != nullptr);
+
+            // set viewport
+            RHI_Viewport viewport = RHI_Viewport(
+                0.0f, 0.0f,
+                static_cast<float>(m_pso.GetWidth()),
+                static_cast<float>(m_pso.GetHeight())
+            );
+            SetViewport(viewport);
+        }
+
+        m_render_pass_active  = true;
+        m_ignore_clear_values = true;
+    }
+
+    void RHI_CommandList::RenderPassEnd()
+    {
+        if (!m_render_pass_active)
+            return;
+
+        m_render_pass_active = false;
+
+        if (m_pso.render_target_swapchain)
+        {
+            m_pso.render_target_swapchain->SetLayout(RHI_Image_Layout::Present_Source, this);
+        }
+    }
+
+    void RHI_CommandList::ClearPipelineStateRenderTargets(RHI_PipelineState& pipeline_state)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::ClearTexture(
+        RHI_Texture* texture,
+        const Color& clear_color     /*= rhi_color_load*/,
+        const float clear_depth      /*= rhi_depth_load*/,
+        const uint32_t clear_stencil /*= rhi_stencil_load*/
+    )
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG((texture->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearBlit flag");
+        SP_ASSERT(texture && texture->GetRhiSrv());
+
+        // one of the required layouts for clear functions
+        texture->SetLayout(RHI_Image_Layout::Transfer_Destination, this);
+    }
+
+    void RHI_CommandList::Draw(const uint32_t vertex_count, const uint32_t vertex_start_index /*= 0*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        PreDraw();
+
+        Profiler::m_rhi_draw++;
+    }
+
+    void RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset, const uint32_t instance_start_index, const uint32_t instance_count)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        PreDraw();
+
+        Profiler::m_rhi_draw++;
+    }
+
+    void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z /*= 1*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        PreDraw();
+    }
+
+    void RHI_CommandList::DispatchIndirect(RHI_Buffer* buffer, const uint32_t offset)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(buffer != nullptr);
+
+        PreDraw();
+    }
+
+    void RHI_CommandList::Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips, const float source_scaling)
+    {
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0,      "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT_MSG((destination->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        if (blit_mips)
+        {
+            SP_ASSERT_MSG(source->GetMipCount() == destination->GetMipCount(),
+                "If the mips are blitted, then the mip count between the source and the destination textures must match");
+        }
+
+        // save the initial layouts
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_source      = source->GetLayouts();
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_destination = destination->GetLayouts();
+
+        // transition to blit appropriate layouts
+        source->SetLayout(RHI_Image_Layout::Transfer_Source, this);
+        destination->SetLayout(RHI_Image_Layout::Transfer_Destination, this);
+
+        // transition to the initial layouts
+        if (blit_mips)
+        {
+            for (uint32_t i = 0; i < source->GetMipCount(); i++)
+            {
+                source->SetLayout(layouts_initial_source[i], this, i, 1);
+                destination->SetLayout(layouts_initial_destination[i], this, i, 1);
+            }
+        }
+        else
+        {
+            source->SetLayout(layouts_initial_source[0], this);
+            destination->SetLayout(layouts_initial_destination[0], this);
+        }
+    }
+
+    void RHI_CommandList::Blit(RHI_Texture* source, RHI_SwapChain* destination)
+    {
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT_MSG(source->GetWidth() <= destination->GetWidth() && source->GetHeight() <= destination->GetHeight(),
+            "The source texture dimension(s) are larger than the those of the destination texture");
+
+        // save the initial layout
+        RHI_Image_Layout source_layout_initial = source->GetLayout(0);
+
+        // transition to blit appropriate layouts
+        source->SetLayout(RHI_Image_Layout::Transfer_Source,           this);
+        destination->SetLayout(RHI_Image_Layout::Transfer_Destination, this);
+
+        // transition to the initial layouts
+        source->SetLayout(source_layout_initial, this);
+        destination->SetLayout(RHI_Image_Layout::Present_Source, this);
+    }
+
+    void RHI_CommandList::Copy(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips)
+    {
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT_MSG((destination->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT(source->GetWidth() == destination->GetWidth());
+        SP_ASSERT(source->GetHeight() == destination->GetHeight());
+        SP_ASSERT(source->GetFormat() == destination->GetFormat());
+        if (blit_mips)
+        {
+            SP_ASSERT_MSG(source->GetMipCount() == destination->GetMipCount(),
+                "If the mips are blitted, then the mip count between the source and the destination textures must match");
+        }
+
+        // save the initial layouts
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_source      = source->GetLayouts();
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_destination = destination->GetLayouts();
+
+        // transition to blit appropriate layouts
+        source->SetLayout(RHI_Image_Layout::Transfer_Source, this);
+        destination->SetLayout(RHI_Image_Layout::Transfer_Destination, this);
+
+        // transition to the initial layouts
+        if (blit_mips)
+        {
+            for (uint32_t i = 0; i < source->GetMipCount(); i++)
+            {
+                source->SetLayout(layouts_initial_source[i], this, i, 1);
+                destination->SetLayout(layouts_initial_destination[i], this, i, 1);
+            }
+        }
+        else
+        {
+            source->SetLayout(layouts_initial_source[0], this);
+            destination->SetLayout(layouts_initial_destination[0], this);
+        }
+    }
+
+    void RHI_CommandList::Copy(RHI_Texture* source, RHI_SwapChain* destination)
+    {
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT(source->GetWidth() == destination->GetWidth());
+        SP_ASSERT(source->GetHeight() == destination->GetHeight());
+        SP_ASSERT(source->GetFormat() == destination->GetFormat());
+
+        // transition to copy appropriate layouts
+        RHI_Image_Layout layout_initial_source = source->GetLayout(0);
+        source->SetLayout(RHI_Image_Layout::Transfer_Source, this);
+        destination->SetLayout(RHI_Image_Layout::Transfer_Destination, this);
+
+        // transition to the initial layout
+        source->SetLayout(layout_initial_source, this);
+        destination->SetLayout(RHI_Image_Layout::Present_Source, this);
+    }
+
+    void RHI_CommandList::Copy(RHI_Texture* source, RHI_Buffer* destination, const uint64_t destination_offset, const uint32_t mip_index, const uint32_t array_index, const uint32_t x, const uint32_t y, uint32_t width, uint32_t height)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT(mip_index < source->GetMipCount() && array_index < source->GetArrayLength());
+
+        const uint32_t mip_width  = max(1u, source->GetWidth() >> mip_index);
+        const uint32_t mip_height = max(1u, source->GetHeight() >> mip_index);
+        width                     = width  != 0 ? width  : mip_width;
+        height                    = height != 0 ? height : mip_height;
+        SP_ASSERT(x + width <= mip_width && y + height <= mip_height);
+
+        RHI_Image_Layout layout_initial = source->GetLayout(mip_index);
+        InsertBarrierTexture(source, mip_index, 1, source->GetArrayLength(), layout_initial, RHI_Image_Layout::Transfer_Source);
+
+        // nothing is ever rendered, so the region reads back as zeros
+        const uint64_t size = RHI_Texture::CalculateMipSize(width, height, 1, source->GetFormat(), source->GetBitsPerChannel(), source->GetChannelCount());
+        memset(static_cast<std::byte*>(destination->GetMappedData()) + destination_offset, 0, static_cast<size_t>(size));
+        Profiler::m_rhi_pipeline_barriers++;
+
+        InsertBarrierTexture(source, mip_index, 1, source->GetArrayLength(), RHI_Image_Layout::Transfer_Source, layout_initial);
+    }
+
+    void RHI_CommandList::Copy(RHI_Buffer* source, const uint64_t source_offset, RHI_Buffer* destination, const uint64_t destination_offset, const uint64_t size)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(source != nullptr && destination != nullptr);
+        SP_ASSERT(size != 0);
+
+        RenderPassEnd();
+
+        // buffers live in host memory, so the copy is real
+        memcpy(
+            static_cast<std::byte*>(destination->GetMappedData()) + destination_offset,
+            static_cast<std::byte*>(source->GetMappedData()) + source_offset,
+            static_cast<size_t>(size)
+        );
+
+        Profiler::m_rhi_pipeline_barriers += 2;
+    }
+
+    void RHI_CommandList::Copy(RHI_GeometryBuffer* source, const uint32_t element_offset, const uint32_t element_count, RHI_Buffer* destination, const uint64_t destination_offset)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(source != nullptr && destination != nullptr);
+        SP_ASSERT(element_count != 0 && element_offset + element_count <= source->GetElementCount());
+
+        RenderPassEnd();
+
+        // buffers live in host memory, so the copy is real
+        memcpy(
+            static_cast<std::byte*>(destination->GetMappedData()) + destination_offset,
+            static_cast<std::byte*>(RHI_Device::MemoryGetMappedDataFromBuffer(source->GetRhiResource())) + static_cast<uint64_t>(element_offset) * source->GetStride(),
+            static_cast<size_t>(element_count) * source->GetStride()
+        );
+
+        Profiler::m_rhi_pipeline_barriers += 2;
+    }
+
+    void RHI_CommandList::Copy(RHI_Buffer* source, const uint64_t source_offset, RHI_GeometryBuffer* destination, const vector<pair<uint32_t, uint32_t>>& ranges)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(source != nullptr && destination != nullptr);
+        SP_ASSERT(!ranges.empty());
+
+        RenderPassEnd();
+
+        // buffers live in host memory, so the copy is real
+        uint64_t offset = source_offset;
+        for (const auto& [element_offset, element_count] : ranges)
+        {
+            SP_ASSERT_MSG(element_offset + element_count <= destination->GetElementCount(), "Copy is out of bounds");
+
+            const uint64_t size = static_cast<uint64_t>(element_count) * destination->GetStride();
+            memcpy(
+                static_cast<std::byte*>(RHI_Device::MemoryGetMappedDataFromBuffer(destination->GetRhiResource())) + static_cast<uint64_t>(element_offset) * destination->GetStride(),
+                static_cast<std::byte*>(source->GetMappedData()) + offset,
+                static_cast<size_t>(size)
+            );
+            offset += size;
+        }
+
+        Profiler::m_rhi_pipeline_barriers += 2;
+    }
+
+    void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(viewport.width != 0);
+        SP_ASSERT(viewport.height != 0);
+    }
+
+    void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissor_rectangle) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::SetCullMode(const RHI_CullMode cull_mode)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        m_cull_mode = cull_mode;
+    }
+
+    void RHI_CommandList::SetBufferVertex(const RHI_GeometryBuffer* buffer, const uint32_t binding /*= 0*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(buffer != nullptr);
+        SP_ASSERT(buffer->GetRhiResource() != nullptr);
+
+        if (m_buffer_id_vertex == buffer->GetObjectId())
+            return;
+
+        m_buffer_id_vertex = buffer->GetObjectId();
+        Profiler::m_rhi_bindings_buffer_vertex++;
+    }
+
+    void RHI_CommandList::SetBufferIndex(const RHI_GeometryBuffer* buffer)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(buffer != nullptr);
+        SP_ASSERT(buffer->GetRhiResource() != nullptr);
+
+        if (m_buffer_id_index == buffer->GetObjectId())
+            return;
+
+        m_buffer_id_index = buffer->GetObjectId();
+        Profiler::m_rhi_bindings_buffer_index++;
+    }
+
+    void RHI_CommandList::PushConstants(const uint32_t offset, const uint32_t size, const void* data)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(size <= RHI_Device::PropertyGetMaxPushConstantSize());
+        SP_ASSERT(data != nullptr);
+    }
+
+    void RHI_CommandList::SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting constant buffer \"%s\" within a render pass", constant_buffer->GetObjectName().c_str());
+            return;
+        }
+
+        // set (will only happen if it's not already set)
+        m_descriptor_layout_current->SetConstantBuffer(slot, constant_buffer);
+
+        descriptor_sets::bind_dynamic = true;
+    }
+
+    void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting sampler \"%s\" within a render pass", sampler->GetObjectName().c_str());
+            return;
+        }
+
+        // set (will only happen if it's not already set)
+        m_descriptor_layout_current->SetSampler(slot, sampler);
+    }
+
+    void RHI_CommandList::SetTexture(const uint32_t slot, RHI_Texture* texture, const uint32_t mip_index /*= all_mips*/, uint32_t mip_range /*= 0*/, const bool uav /*= false*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (mip_index != rhi_all_mips)
+        {
+            SP_ASSERT_MSG(mip_range != 0, "If a mip was specified, then mip_range can't be 0");
+        }
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting texture \"%s\" within a render pass", texture->GetObjectName().c_str());
+            return;
+        }
+
+        // if the texture is null or it's still loading, ignore it
+        if (!texture || !texture->IsReadyForUse())
+            return;
+
+        // get some texture info
+        const uint32_t mip_count        = texture->GetMipCount();
+        const bool mip_specified        = mip_index != rhi_all_mips;
+        const uint32_t mip_start        = mip_specified ? mip_index : 0;
+        RHI_Image_Layout current_layout = texture->GetLayout(mip_start);
+
+        SP_ASSERT_MSG(current_layout != RHI_Image_Layout::Max && current_layout != RHI_Image_Layout::Preinitialized, "Invalid layout");
+
+        // transition to appropriate layout (if needed), layouts are tracked so that barrier counts match a real device
+        {
+            RHI_Image_Layout target_layout = RHI_Image_Layout::Max;
+            if (uav)
+            {
+                SP_ASSERT(texture->IsUav());
+                target_layout = RHI_Image_Layout::General;
+            }
+            else
+            {
+                SP_ASSERT(texture->IsSrv());
+                target_layout = RHI_Image_Layout::Shader_Read;
+            }
+
+            // determine if a layout transition is needed
+            bool transition_required = current_layout != target_layout;
+            {
+                bool rest_mips_have_same_layout = true;
+                array<RHI_Image_Layout, rhi_max_mip_count> layouts = texture->GetLayouts();
+                for (uint32_t i = mip_start; i < mip_start + mip_count; i++)
+                {
+                    if (target_layout != layouts[i])
+                    {
+                        rest_mips_have_same_layout = false;
+                        break;
+                    }
+                }
+
+                transition_required = !rest_mips_have_same_layout ? true : transition_required;
+            }
+
+            // transition
+            if (transition_required)
+            {
+                texture->SetLayout(target_layout, this, mip_index, mip_range);
+            }
+        }
+
+        // set (will only happen if it's not already set)
+        m_descriptor_layout_current->SetTexture(slot, texture, mip_index, mip_range);
+
+        descriptor_sets::bind_dynamic = true;
+    }
+
+    void RHI_CommandList::SetBuffer(const uint32_t slot, RHI_Buffer* buffer) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting buffer \"%s\" within a render pass", buffer->GetObjectName().c_str());
+            return;
+        }
+
+        m_descriptor_layout_current->SetBuffer(slot, buffer);
+
+        descriptor_sets::bind_dynamic = true;
+    }
+
+    void RHI_CommandList::SetBuffer(const uint32_t slot, RHI_GeometryBuffer* buffer) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting buffer \"%s\" within a render pass", buffer->GetObjectName().c_str());
+            return;
+        }
+
+        m_descriptor_layout_current->SetBuffer(slot, buffer);
+
+        descriptor_sets::bind_dynamic = true;
+    }
+
+    void RHI_CommandList::BeginMarker(const char* name)
+    {
+        if (Profiler::IsGpuMarkingEnabled())
+        {
+            RHI_Device::MarkerBegin(this, name, Vector4::Zero);
+        }
+    }
+
+    void RHI_CommandList::EndMarker()
+    {
+        if (Profiler::IsGpuMarkingEnabled())
+        {
+            RHI_Device::MarkerEnd(this);
+        }
+    }
+    
+    uint32_t RHI_CommandList::BeginTimestamp()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG(m_timestamp_index + 1 < queries::timestamp::query_count, "index out of range");
+
+        return m_timestamp_index++;
+    }
+
+    void RHI_CommandList::EndTimestamp()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        m_timestamp_index++;
+    }
+
+    float RHI_CommandList::GetTimestampResult(const uint32_t index_timestamp)
+    {
+        SP_ASSERT_MSG(index_timestamp + 1 < queries::timestamp::query_count, "index out of range");
+
+        // no gpu, no gpu time
+        return 0.0f;
+    }
+
+    void RHI_CommandList::BeginOcclusionQuery(const uint64_t entity_id)
+    {
+        SP_ASSERT_MSG(m_pso.IsGraphics(), "Occlusion queries are only supported in graphics pipelines");
+
+        queries::occlusion::index_active = queries::occlusion::id_to_index[entity_id];
+        if (queries::occlusion::index_active == 0)
+        {
+            queries::occlusion::index_active           = ++queries::occlusion::index;
+            queries::occlusion::id_to_index[entity_id] = queries::occlusion::index;
+        }
+
+        if (!m_render_pass_active)
+        {
+            RenderPassBegin();
+        }
+
+        queries::occlusion::occlusion_query_active = true;
+    }
+
+    void RHI_CommandList::EndOcclusionQuery()
+    {
+        queries::occlusion::occlusion_query_active = false;
+    }
+
+    bool RHI_CommandList::GetOcclusionQueryResult(const uint64_t entity_id)
+    {
+        // nothing is rasterized, so treat everything as visible, the renderer then does the full amount of work
+        return false;
+    }
+
+    void RHI_CommandList::UpdateOcclusionQueries()
+    {
+
+    }
+
+    void RHI_CommandList::BeginTimeblock(const char* name, const bool gpu_marker, const bool gpu_timing)
+    {
+        SP_ASSERT_MSG(m_timeblock_active == nullptr, "The previous time block is still active");
+        SP_ASSERT(name != nullptr);
+
+        // allowed timing ?
+        {
+            // cpu
+            Profiler::TimeBlockStart(name, TimeBlockType::Cpu, this);
+
+            // gpu
+            if (Profiler::IsGpuTimingEnabled() && gpu_timing)
+            {
+                Profiler::TimeBlockStart(name, TimeBlockType::Gpu, this);
+            }
+        }
+
+        // allowed marking ?
+        if (Profiler::IsGpuMarkingEnabled() && gpu_marker)
+        {
+            RHI_Device::MarkerBegin(this, name, Vector4::Zero);
+        }
+
+        m_timeblock_active = name;
+    }
+
+    void RHI_CommandList::EndTimeblock()
+    {
+        SP_ASSERT_MSG(m_timeblock_active != nullptr, "A time block wasn't started");
+
+        // allowed markers ?
+        if (Profiler::IsGpuTimingEnabled())
+        {
+            RHI_Device::MarkerEnd(this);
+        }
+
+        // allowed timing
+        {
+            if (Profiler::IsGpuTimingEnabled())
+            {
+                Profiler::TimeBlockEnd(); // gpu
+            }
+
+            Profiler::TimeBlockEnd(); // cpu
+        }
+
+        m_timeblock_active = nullptr;
+    }
+
+    void RHI_CommandList::InsertBarrierTexture(
+        void* image,
+        const uint32_t aspect_mask,
+        const uint32_t mip_index,
+        const uint32_t mip_range,
+        const uint32_t array_length,
+        const RHI_Image_Layout layout_old,
+        const RHI_Image_Layout layout_new,
+        const bool is_depth
+    )
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(image != nullptr);
+
+        // same grouping rules as the other backends, so that the barrier count is representative
+        if (!m_render_pass_active)
+        {
+            bool immediate_barrier = layout_old == RHI_Image_Layout::Max                  ||
+                                     layout_old == RHI_Image_Layout::Preinitialized       ||
+                                     layout_old == RHI_Image_Layout::Transfer_Source      || layout_new == RHI_Image_Layout::Transfer_Source      ||
+                                     layout_old == RHI_Image_Layout::Transfer_Destination || layout_new == RHI_Image_Layout::Transfer_Destination ||
+                                     layout_old == RHI_Image_Layout::Present_Source       || layout_new == RHI_Image_Layout::Present_Source;
+
+            if (!immediate_barrier)
+            { 
+                m_image_barriers.emplace_back(image, aspect_mask, mip_index, mip_range, array_length, layout_old, layout_new, is_depth);
+                return;
+            }
+        }
+
+        RenderPassEnd(); // you can't have a barrier inside a render pass
+        Profiler::m_rhi_pipeline_barriers++;
+    }
+
+    void RHI_CommandList::InsertBarrierTexture(RHI_Texture* texture, const uint32_t mip_start, const uint32_t mip_range, const uint32_t array_length, const RHI_Image_Layout layout_old, const RHI_Image_Layout layout_new)
+    {
+        SP_ASSERT(texture != nullptr);
+        InsertBarrierTexture(texture->GetRhiResource(), 0, mip_start, mip_range, array_length, layout_old, layout_new, texture->IsDsv());
+    }
+
+    void RHI_CommandList::InsertBarrierTextureReadWrite(RHI_Texture* texture)
+    {
+        SP_ASSERT(texture != nullptr);
+        InsertBarrierTexture(texture->GetRhiResource(), 0, 0, 1, 1, texture->GetLayout(0), texture->GetLayout(0), texture->IsDsv());
+    }
+
+    void RHI_CommandList::InsertBarrierBufferReadWrite(RHI_Buffer* buffer)
+    {
+        SP_ASSERT(buffer != nullptr);
+
+        RenderPassEnd();
+        Profiler::m_rhi_pipeline_barriers++;
+    }
+
+    void RHI_CommandList::InsertPendingBarrierGroup()
+    {
+        if (!m_image_barriers.empty())
+        {
+            m_image_barriers.clear();
+
+            RenderPassEnd();
+            Profiler::m_rhi_pipeline_barriers++;
+        }
+    }
+
+    void RHI_CommandList::PreDraw()
+    {
+        InsertPendingBarrierGroup();
+
+        if (!m_render_pass_active && m_pso.IsGraphics())
+        {
+            RenderPassBegin();
+        }
+
+        if (descriptor_sets::bind_dynamic)
+        {
+            descriptor_sets::set_dynamic(m_descriptor_layout_current);
+        }
+    }
+}
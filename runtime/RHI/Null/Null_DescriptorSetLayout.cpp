@@ -0,0 +1,73 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_Device.h"
+//=====================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_DescriptorSetLayout::~RHI_DescriptorSetLayout()
+    {
+        if (m_rhi_resource)
+        {
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::DescriptorSetLayout, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+    }
+
+    void RHI_DescriptorSetLayout::CreateRhiResource(vector<RHI_Descriptor> descriptors)
+    {
+        SP_ASSERT(m_rhi_resource == nullptr);
+
+        // remove certain descriptors
+        descriptors.erase
+        (
+            remove_if(descriptors.begin(), descriptors.end(), [](RHI_Descriptor& descriptor)
+            { 
+                    return descriptor.type == RHI_Descriptor_Type::PushConstantBuffer ||          // push constants are not part of the descriptor set layout
+                          (descriptor.as_array && descriptor.array_length == rhi_max_array_size); // binldess arrays have their own layout
+            }),
+            descriptors.end()
+        );
+
+        // ensure unique binding numbers, same validation as a real device
+        {
+            unordered_set<uint32_t> unique_bindings;
+            for (const RHI_Descriptor& descriptor : descriptors)
+            {
+                SP_ASSERT_MSG(unique_bindings.insert(descriptor.slot).second, "Duplicate binding");
+            }
+        }
+
+        m_rhi_resource = static_cast<void*>(this);
+
+        // name
+        RHI_Device::SetResourceName(m_rhi_resource, RHI_Resource_Type::DescriptorSetLayout, m_object_name);
+    }
+}
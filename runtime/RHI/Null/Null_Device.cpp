@@ -0,0 +1,658 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "pch.h"
+#include "../Rendering/Renderer.h"
+#include "../../Profiling/Profiler.h"
+#include "../RHI_Device.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Queue.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_Shader.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_Pipeline.h"
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    namespace
+    {
+        mutex mutex_deletion_queue;
+        unordered_map<RHI_Resource_Type, vector<void*>> deletion_queue;
+
+        // what a real device would report as available video memory
+        const uint64_t device_memory = 8ull * 1024 * 1024 * 1024;
+    }
+
+    namespace queues
+    {
+        array<shared_ptr<RHI_Queue>, static_cast<uint32_t>(RHI_Queue_Type::Max)> regular;   // graphics, compute, and copy
+        array<shared_ptr<RHI_Queue>, static_cast<uint32_t>(RHI_Queue_Type::Max)> immediate; // graphics, compute, and copy
+
+        // sync for immediate execution
+        mutex mutex_immediate_execution;
+        condition_variable condition_variable_immediate_execution;
+        bool is_immediate_executing = false;
+        RHI_Queue* queue            = nullptr;
+
+        void destroy()
+        {
+            regular.fill(nullptr);
+            immediate.fill(nullptr);
+        }
+    }
+
+    namespace memory
+    {
+        // every buffer and texture is an allocation, the allocation itself is the resource handle
+        struct allocation
+        {
+            void* data    = nullptr;
+            uint64_t size = 0;
+        };
+
+        atomic<uint64_t> bytes_used = 0;
+
+        void* create(const uint64_t size, const bool host_visible)
+        {
+            allocation* alloc = new allocation();
+            alloc->size       = size;
+            alloc->data       = host_visible ? calloc(1, static_cast<size_t>(size)) : nullptr;
+            bytes_used       += size;
+
+            return static_cast<void*>(alloc);
+        }
+
+        void destroy(void*& resource)
+        {
+            if (!resource)
+                return;
+
+            allocation* alloc = static_cast<allocation*>(resource);
+            bytes_used       -= alloc->size;
+            free(alloc->data);
+            delete alloc;
+            resource = nullptr;
+        }
+    }
+
+    namespace descriptors
+    {
+        mutex descriptor_pipeline_mutex;
+        uint32_t allocated_descriptor_sets = 0;
+
+        // cache
+        unordered_map<uint64_t, RHI_DescriptorSet> sets;
+        unordered_map<uint64_t, shared_ptr<RHI_DescriptorSetLayout>> layouts;
+        unordered_map<uint64_t, shared_ptr<RHI_Pipeline>> pipelines;
+        unordered_map<uint64_t, vector<RHI_Descriptor>> descriptor_cache;
+
+        void merge_descriptors(vector<RHI_Descriptor>& base_descriptors, const std::vector<RHI_Descriptor>& additional_descriptors)
+        {
+            for (const RHI_Descriptor& descriptor_additional : additional_descriptors)
+            {
+                bool updated_existing = false;
+                for (RHI_Descriptor& descriptor_base : base_descriptors)
+                {
+                    if (descriptor_base.slot == descriptor_additional.slot)
+                    {
+                        descriptor_base.stage |= descriptor_additional.stage;
+                        updated_existing = true;
+                        break;
+                    }
+                }
+
+                // if no updating took place, this is an additional shader only resource, add it
+                if (!updated_existing)
+                {
+                    base_descriptors.emplace_back(descriptor_additional);
+                }
+            }
+        }
+
+        void get_descriptors_from_pipeline_state(RHI_PipelineState& pipeline_state, vector<RHI_Descriptor>& descriptors)
+        {
+            pipeline_state.Prepare();
+
+            // use the hash of the pipeline state as the key for the cache
+            uint64_t pipeline_state_hash = pipeline_state.GetHash();
+
+            // check if descriptors for this pipeline state are already cached
+            auto cached_descriptors = descriptor_cache.find(pipeline_state_hash);
+            if (cached_descriptors != descriptor_cache.end())
+            {
+                // fetch from cache
+                descriptors = cached_descriptors->second;
+                return;
+            }
+
+            // if not cached, generate descriptors
+            descriptors.clear();
+
+            if (pipeline_state.IsCompute())
+            {
+                SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Compute]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                descriptors = pipeline_state.shaders[RHI_Shader_Type::Compute]->GetDescriptors();
+            }
+            else if (pipeline_state.IsGraphics())
+            {
+                SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Vertex]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                descriptors = pipeline_state.shaders[RHI_Shader_Type::Vertex]->GetDescriptors();
+
+                if (pipeline_state.shaders[RHI_Shader_Type::Pixel])
+                {
+                    SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Pixel]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                    merge_descriptors(descriptors, pipeline_state.shaders[RHI_Shader_Type::Pixel]->GetDescriptors());
+                }
+
+                if (pipeline_state.shaders[RHI_Shader_Type::Hull])
+                {
+                    SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Hull]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                    merge_descriptors(descriptors, pipeline_state.shaders[RHI_Shader_Type::Hull]->GetDescriptors());
+                }
+
+                if (pipeline_state.shaders[RHI_Shader_Type::Domain])
+                {
+                    SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Domain]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                    merge_descriptors(descriptors, pipeline_state.shaders[RHI_Shader_Type::Domain]->GetDescriptors());
+                }
+            }
+
+            // sort descriptors by slot, dynamic offsets are expected in that order
+            sort(descriptors.begin(), descriptors.end(), [](const RHI_Descriptor& a, const RHI_Descriptor& b)
+            {
+                return a.slot < b.slot;
+            });
+
+            // cache the newly created descriptors
+            descriptor_cache[pipeline_state_hash] = descriptors;
+        }
+
+        shared_ptr<RHI_DescriptorSetLayout> get_or_create_descriptor_set_layout(RHI_PipelineState& pipeline_state)
+        {
+            // get descriptors from pipeline state
+            vector<RHI_Descriptor> descriptors;
+            get_descriptors_from_pipeline_state(pipeline_state, descriptors);
+
+            // compute a hash for the descriptors
+            uint64_t hash = 0;
+            for (RHI_Descriptor& descriptor : descriptors)
+            {
+                hash = rhi_hash_combine(hash, static_cast<uint64_t>(descriptor.slot));
+                hash = rhi_hash_combine(hash, static_cast<uint64_t>(descriptor.stage));
+            }
+
+            // search for a descriptor set layout which matches this hash
+            auto it     = layouts.find(hash);
+            bool cached = it != layouts.end();
+
+            // if there is no descriptor set layout for this particular hash, create one
+            if (!cached)
+            {
+                it = layouts.emplace(make_pair(hash, make_shared<RHI_DescriptorSetLayout>(descriptors, pipeline_state.name))).first;
+            }
+            shared_ptr<RHI_DescriptorSetLayout> descriptor_set_layout = it->second;
+
+            if (cached)
+            {
+                descriptor_set_layout->ClearDescriptorData();
+            }
+
+            return descriptor_set_layout;
+        }
+
+        namespace bindless
+        {
+            // the handles only need to be valid, their addresses serve that purpose
+            array<uint8_t, 3> sets;
+            array<uint8_t, 3> layouts;
+        }
+
+        void release()
+        {
+            sets.clear();
+            layouts.clear();
+            pipelines.clear();
+            descriptor_cache.clear();
+        }
+    }
+
+    void RHI_Device::Initialize()
+    {
+        // physical device
+        PhysicalDeviceDetect();
+        PhysicalDeviceSelectPrimary();
+
+        // properties, typical desktop limits so that resources are laid out like on a real device
+        m_timestamp_period                     = 1.0f;
+        m_min_uniform_buffer_offset_alignment  = 256;
+        m_min_storage_buffer_offset_alignment  = 256;
+        m_max_texture_1d_dimension             = 16384;
+        m_max_texture_2d_dimension             = 16384;
+        m_max_texture_3d_dimension             = 2048;
+        m_max_texture_cube_dimension           = 16384;
+        m_max_texture_array_layers             = 2048;
+        m_max_push_constant_size               = 128;
+        m_max_shading_rate_texel_size_x        = 16;
+        m_max_shading_rate_texel_size_y        = 16;
+        m_optimal_buffer_copy_offset_alignment = 256;
+        m_is_shading_rate_supported            = false;
+
+        // create queues
+        {
+            queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Graphics)] = make_shared<RHI_Queue>(RHI_Queue_Type::Graphics, "graphics");
+            queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Compute)]  = make_shared<RHI_Queue>(RHI_Queue_Type::Compute,  "compute");
+            queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Copy)]     = make_shared<RHI_Queue>(RHI_Queue_Type::Copy,     "copy");
+
+            queues::immediate[static_cast<uint32_t>(RHI_Queue_Type::Graphics)] = make_shared<RHI_Queue>(RHI_Queue_Type::Graphics, "graphics");
+            queues::immediate[static_cast<uint32_t>(RHI_Queue_Type::Compute)]  = make_shared<RHI_Queue>(RHI_Queue_Type::Compute,  "compute");
+            queues::immediate[static_cast<uint32_t>(RHI_Queue_Type::Copy)]     = make_shared<RHI_Queue>(RHI_Queue_Type::Copy,     "copy");
+        }
+
+        CreateDescriptorPool();
+
+        RHI_Context::api_version_str = "1.0.0";
+        SP_LOG_INFO("Null device, commands are recorded but never executed");
+    }
+
+    void RHI_Device::Tick(const uint64_t frame_count)
+    {
+        // queues
+        for (uint32_t i = 0; i < static_cast<uint32_t>(queues::regular.size()); i++)
+        {
+            queues::regular[i]->NextCommandList();
+        }
+    }
+
+    void RHI_Device::Destroy()
+    {
+        // destroy queues
+        QueueWaitAll();
+        queues::destroy();
+
+        // descriptors
+        descriptors::release();
+
+        // the destructor of all the resources enqueues their memory for de-allocation
+        RHI_Device::DeletionQueueParse();
+
+        if (memory::bytes_used != 0)
+        {
+            SP_LOG_WARNING("%llu bytes were not freed", static_cast<unsigned long long>(memory::bytes_used.load()));
+        }
+    }
+
+    // physical device
+
+    void RHI_Device::PhysicalDeviceDetect()
+    {
+        PhysicalDeviceRegister(PhysicalDevice
+        (
+            0,                             // api version
+            0,                             // driver version
+            0,                             // vendor id
+            RHI_PhysicalDevice_Type::Cpu,  // type
+            "Null",                        // name
+            device_memory,                 // memory
+            nullptr                        // data
+        ));
+    }
+
+    void RHI_Device::PhysicalDeviceSelectPrimary()
+    {
+        PhysicalDeviceSetPrimary(0);
+    }
+
+    // queues
+
+    uint32_t RHI_Device::QueueGetIndex(const RHI_Queue_Type type)
+    {
+        return static_cast<uint32_t>(type);
+    }
+
+    RHI_Queue* RHI_Device::GetQueue(const RHI_Queue_Type type)
+    {
+        if (type == RHI_Queue_Type::Graphics)
+            return queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Graphics)].get();
+
+        if (type == RHI_Queue_Type::Compute)
+            return queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Compute)].get();
+
+        return nullptr;
+    }
+
+    void* RHI_Device::GetQueueRhiResource(const RHI_Queue_Type type)
+    {
+        if (type == RHI_Queue_Type::Max)
+            return nullptr;
+
+        return static_cast<void*>(queues::regular[static_cast<uint32_t>(type)].get());
+    }
+
+    void RHI_Device::QueueWaitAll()
+    {
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            queues::regular[i]->Wait();
+        }
+    }
+
+    // deletion queue
+
+    void RHI_Device::DeletionQueueAdd(const RHI_Resource_Type resource_type, void* resource)
+    {
+        lock_guard<mutex> guard(mutex_deletion_queue);
+        deletion_queue[resource_type].emplace_back(resource);
+    }
+
+    void RHI_Device::DeletionQueueParse()
+    {
+        lock_guard<mutex> guard(mutex_deletion_queue);
+       
+        for (const auto& it : deletion_queue)
+        {
+            for (void* resource : it.second)
+            {
+                RHI_Resource_Type resource_type = it.first;
+
+                // only memory and semaphore counters are owned by the device, everything else is just a handle
+                switch (resource_type)
+                {
+                    case RHI_Resource_Type::Texture:   MemoryTextureDestroy(resource);                       break;
+                    case RHI_Resource_Type::Buffer:    MemoryBufferDestroy(resource);                        break;
+                    case RHI_Resource_Type::Semaphore: delete static_cast<atomic<uint64_t>*>(resource);      break;
+                    default:                                                                                 break;
+                }
+
+                // delete descriptor sets which are now invalid (because they are referring to a deleted resource)
+                if (resource_type == RHI_Resource_Type::TextureView || resource_type == RHI_Resource_Type::Buffer || resource_type == RHI_Resource_Type::Sampler)
+                {
+                    for (auto it = descriptors::sets.begin(); it != descriptors::sets.end();)
+                    {
+                        if (it->second.IsReferingToResource(resource))
+                        {
+                            it = descriptors::sets.erase(it);
+                        }
+                        else
+                        {
+                            ++it;
+                        }
+                    }
+                }
+            }
+        }
+
+        deletion_queue.clear();
+    }
+
+    bool RHI_Device::DeletionQueueNeedsToParse()
+    {
+        return deletion_queue.size() > 5;
+    }
+
+    // descriptors
+
+    void RHI_Device::CreateDescriptorPool()
+    {
+        descriptors::allocated_descriptor_sets = 0;
+        Profiler::m_descriptor_set_count       = 0;
+    }
+
+    void RHI_Device::AllocateDescriptorSet(void*& resource, RHI_DescriptorSetLayout* descriptor_set_layout, const vector<RHI_Descriptor>& descriptors_)
+    {
+        // verify that an allocation is possible, same limits as a real descriptor pool
+        {
+            SP_ASSERT_MSG(descriptors::allocated_descriptor_sets < rhi_max_descriptor_set_count, "Reached descriptor set limit");
+
+            uint32_t textures                 = 0;
+            uint32_t storage_textures         = 0;
+            uint32_t storage_buffers          = 0;
+            uint32_t dynamic_constant_buffers = 0;
+            uint32_t samplers                 = 0;
+            for (const RHI_Descriptor& descriptor : descriptors_)
+            {
+                if (descriptor.type == RHI_Descriptor_Type::Sampler)
+                {
+                    samplers++;
+                }
+                else if (descriptor.type == RHI_Descriptor_Type::Texture)
+                {
+                    textures++;
+                }
+                else if (descriptor.type == RHI_Descriptor_Type::TextureStorage)
+                {
+                    storage_textures++;
+                }
+                else if (descriptor.type == RHI_Descriptor_Type::StructuredBuffer)
+                {
+                    storage_buffers++;
+                }
+                else if (descriptor.type == RHI_Descriptor_Type::ConstantBuffer)
+                {
+                    dynamic_constant_buffers++;
+                }
+            }
+
+            SP_ASSERT_MSG(samplers                 <= rhi_max_array_size, "Descriptor set requires more samplers");
+            SP_ASSERT_MSG(textures                 <= rhi_max_array_size, "Descriptor set requires more textures");
+            SP_ASSERT_MSG(storage_textures         <= rhi_max_array_size, "Descriptor set requires more storage textures");
+            SP_ASSERT_MSG(storage_buffers          <= rhi_max_array_size, "Descriptor set requires more dynamic storage buffers");
+            SP_ASSERT_MSG(dynamic_constant_buffers <= rhi_max_array_size, "Descriptor set requires more dynamic constant buffers");
+        }
+
+        // allocate
+        SP_ASSERT(resource == nullptr);
+        SP_ASSERT(descriptor_set_layout->GetRhiResource() != nullptr);
+        resource = static_cast<void*>(descriptor_set_layout);
+
+        // track allocations
+        descriptors::allocated_descriptor_sets++;
+        Profiler::m_descriptor_set_count++;
+    }
+
+    void* RHI_Device::GetDescriptorSet(const RHI_Device_Resource resource_type)
+    {
+        return static_cast<void*>(&descriptors::bindless::sets[static_cast<uint32_t>(resource_type)]);
+    }
+
+    void* RHI_Device::GetDescriptorSetLayout(const RHI_Device_Resource resource_type)
+    {
+        return static_cast<void*>(&descriptors::bindless::layouts[static_cast<uint32_t>(resource_type)]);
+    }
+
+    unordered_map<uint64_t, RHI_DescriptorSet>& RHI_Device::GetDescriptorSets()
+    {
+        return descriptors::sets;
+    }
+
+    uint32_t RHI_Device::GetDescriptorType(const RHI_Descriptor& descriptor)
+    {
+        return static_cast<uint32_t>(descriptor.type);
+    }
+
+    void RHI_Device::UpdateBindlessResources(const array<shared_ptr<RHI_Sampler>, static_cast<uint32_t>(Renderer_Sampler::Max)>* samplers, array<RHI_Texture*, rhi_max_array_size>* textures)
+    {
+        // nothing to write to, the bindless sets always exist
+    }
+
+    // pipelines
+
+    void RHI_Device::GetOrCreatePipeline(RHI_PipelineState& pso, RHI_Pipeline*& pipeline, RHI_DescriptorSetLayout*& descriptor_set_layout)
+    {
+        pso.Prepare();
+
+        lock_guard<mutex> lock(descriptors::descriptor_pipeline_mutex);
+
+        descriptor_set_layout = descriptors::get_or_create_descriptor_set_layout(pso).get();
+
+        // if no pipeline exists, create one
+        uint64_t hash = pso.GetHash();
+        auto it = descriptors::pipelines.find(hash);
+        if (it == descriptors::pipelines.end())
+        {
+            it = descriptors::pipelines.emplace(make_pair(hash, make_shared<RHI_Pipeline>(pso, descriptor_set_layout))).first;
+        }
+
+        pipeline = it->second.get();
+    }
+
+    uint32_t RHI_Device::GetPipelineCount()
+    {
+        return static_cast<uint32_t>(descriptors::pipelines.size());
+    }
+
+    // memory
+
+    void* RHI_Device::MemoryGetMappedDataFromBuffer(void* resource)
+    {
+        return resource ? static_cast<memory::allocation*>(resource)->data : nullptr;
+    }
+
+    void RHI_Device::MemoryBufferCreate(void*& resource, const uint64_t size, uint32_t usage, uint32_t memory_property_flags, const void* data_initial, const char* name)
+    {
+        SP_ASSERT(resource == nullptr);
+
+        // buffers are always backed by host memory, the cpu writes to them through the mapped pointer
+        resource = memory::create(size, true);
+
+        if (data_initial)
+        {
+            memcpy(MemoryGetMappedDataFromBuffer(resource), data_initial, static_cast<size_t>(size));
+        }
+    }
+
+    void RHI_Device::MemoryBufferDestroy(void*& resource)
+    {
+        memory::destroy(resource);
+    }
+
+    void RHI_Device::MemoryTextureCreate(RHI_Texture* texture)
+    {
+        // compute the size the image would occupy
+        uint64_t size = 0;
+        for (uint32_t array_index = 0; array_index < texture->GetArrayLength(); array_index++)
+        {
+            for (uint32_t mip_index = 0; mip_index < texture->GetMipCount(); mip_index++)
+            {
+                const uint32_t mip_width  = max(1u, texture->GetWidth() >> mip_index);
+                const uint32_t mip_height = max(1u, texture->GetHeight() >> mip_index);
+                const uint32_t mip_depth  = texture->GetResourceType() == ResourceType::Texture3d ? max(1u, texture->GetDepth() >> mip_index) : 1;
+
+                size += RHI_Texture::CalculateMipSize(mip_width, mip_height, mip_depth, texture->GetFormat(), texture->GetBitsPerChannel(), texture->GetChannelCount());
+            }
+        }
+
+        // only mappable textures are ever touched by the cpu, so only those get real memory
+        const bool mappable       = texture->GetFlags() & RHI_Texture_Mappable;
+        texture->GetRhiResource() = memory::create(size, mappable);
+
+        // get mapped data pointer
+        if (mappable)
+        {
+            void*& mapped_data = texture->GetMappedData();
+            mapped_data        = MemoryGetMappedDataFromBuffer(texture->GetRhiResource());
+        }
+    }
+
+    void RHI_Device::MemoryTextureDestroy(void*& resource)
+    {
+        memory::destroy(resource);
+    }
+
+    void RHI_Device::MemoryMap(void* resource, void*& mapped_data)
+    {
+        mapped_data = MemoryGetMappedDataFromBuffer(resource);
+    }
+
+    void RHI_Device::MemoryUnmap(void* resource)
+    {
+
+    }
+
+    uint32_t RHI_Device::MemoryGetUsageMb()
+    {
+        return static_cast<uint32_t>(memory::bytes_used / 1024 / 1024);
+    }
+
+    uint32_t RHI_Device::MemoryGetBudgetMb()
+    {
+        return static_cast<uint32_t>(device_memory / 1024 / 1024);
+    }
+
+    // immediate command list
+
+    RHI_CommandList* RHI_Device::CmdImmediateBegin(const RHI_Queue_Type queue_type)
+    {
+        // wait until it's safe to proceed
+        unique_lock<mutex> lock(queues::mutex_immediate_execution);
+        queues::condition_variable_immediate_execution.wait(lock, [] { return !queues::is_immediate_executing; });
+        queues::is_immediate_executing = true;
+
+        // get command pool
+        queues::queue = queues::immediate[static_cast<uint32_t>(queue_type)].get();
+        queues::queue->NextCommandList();
+        queues::queue->GetCommandList()->Begin(queues::queue);
+
+        return queues::queue->GetCommandList();
+    }
+
+    void RHI_Device::CmdImmediateSubmit(RHI_CommandList* cmd_list)
+    {
+        cmd_list->Submit(queues::queue, 0);
+        cmd_list->WaitForExecution();
+
+        // signal that it's safe to proceed with the next ImmediateBegin()
+        queues::is_immediate_executing = false;
+        queues::condition_variable_immediate_execution.notify_one();
+    }
+
+    // markers
+
+    void RHI_Device::MarkerBegin(RHI_CommandList* cmd_list, const char* name, const Math::Vector4& color)
+    {
+
+    }
+
+    void RHI_Device::MarkerEnd(RHI_CommandList* cmd_list)
+    {
+
+    }
+
+    // misc
+
+    void RHI_Device::SetResourceName(void* resource, const RHI_Resource_Type resource_type, const std::string name)
+    {
+
+    }
+
+    void RHI_Device::SetVariableRateShading(const RHI_CommandList* cmd_list, const bool enabled)
+    {
+        if (!m_is_shading_rate_supported)
+            return;
+    }
+}
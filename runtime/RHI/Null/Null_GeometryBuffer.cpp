@@ -0,0 +1,127 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_GeometryBuffer.h"
+#include "../RHI_CommandList.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_GeometryBuffer::~RHI_GeometryBuffer()
+    {
+        if (m_rhi_resource)
+        {
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::Buffer, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+    }
+
+    void RHI_GeometryBuffer::RHI_CreateResource(const void* indices)
+    {
+        // destroy previous buffer
+        if (m_rhi_resource)
+        {
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::Buffer, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+
+        m_is_mappable = indices == nullptr && !m_is_empty;
+
+        // everything lives in host memory, so the initial data is copied directly instead of staged
+        RHI_Device::MemoryBufferCreate(m_rhi_resource, m_object_size, 0, 0, indices, m_object_name.c_str());
+
+        if (m_is_mappable)
+        {
+            m_mapped_data = RHI_Device::MemoryGetMappedDataFromBuffer(m_rhi_resource);
+        }
+
+        // set debug name
+        RHI_Device::SetResourceName(m_rhi_resource, RHI_Resource_Type::Buffer, m_object_name);
+    }
+
+    void RHI_GeometryBuffer::Update(const void* data, const uint32_t element_offset, const uint32_t element_count)
+    {
+        SP_ASSERT(m_rhi_resource != nullptr);
+        SP_ASSERT(data != nullptr && element_count != 0);
+        SP_ASSERT_MSG(element_offset + element_count <= m_element_count, "Update is out of bounds");
+
+        const uint64_t size = static_cast<uint64_t>(element_count) * m_stride;
+
+        // go through an immediate command list, like the other backends, so that the submission is accounted for
+        RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Copy);
+        std::byte* destination    = static_cast<std::byte*>(RHI_Device::MemoryGetMappedDataFromBuffer(m_rhi_resource));
+        memcpy(destination + static_cast<uint64_t>(element_offset) * m_stride, data, size);
+        RHI_Device::CmdImmediateSubmit(cmd_list);
+    }
+
+    void RHI_GeometryBuffer::Update(const void* data, const vector<pair<uint32_t, uint32_t>>& ranges)
+    {
+        SP_ASSERT(m_rhi_resource != nullptr);
+        SP_ASSERT(data != nullptr && !ranges.empty());
+
+        RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Copy);
+        std::byte* destination    = static_cast<std::byte*>(RHI_Device::MemoryGetMappedDataFromBuffer(m_rhi_resource));
+        const std::byte* source   = static_cast<const std::byte*>(data);
+        for (const auto& [element_offset, element_count] : ranges)
+        {
+            SP_ASSERT_MSG(element_offset + element_count <= m_element_count, "Update is out of bounds");
+
+            const uint64_t size = static_cast<uint64_t>(element_count) * m_stride;
+            memcpy(destination + static_cast<uint64_t>(element_offset) * m_stride, source, size);
+            source += size;
+        }
+        RHI_Device::CmdImmediateSubmit(cmd_list);
+    }
+
+    void RHI_GeometryBuffer::Copy(const RHI_GeometryBuffer* source, const uint32_t element_count)
+    {
+        SP_ASSERT(m_rhi_resource != nullptr && m_is_empty);
+        SP_ASSERT(source != nullptr && source->m_rhi_resource != nullptr && source->m_is_empty);
+        SP_ASSERT(source->m_stride == m_stride && element_count != 0);
+        SP_ASSERT_MSG(element_count <= m_element_count && element_count <= source->m_element_count, "Copy is out of bounds");
+
+        RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Copy);
+        memcpy(RHI_Device::MemoryGetMappedDataFromBuffer(m_rhi_resource), RHI_Device::MemoryGetMappedDataFromBuffer(source->m_rhi_resource), static_cast<uint64_t>(element_count) * m_stride);
+        RHI_Device::CmdImmediateSubmit(cmd_list);
+    }
+
+    void RHI_GeometryBuffer::Read(void* data, const uint32_t element_offset, const uint32_t element_count) const
+    {
+        SP_ASSERT(m_rhi_resource != nullptr && m_is_empty);
+        SP_ASSERT(data != nullptr && element_count != 0);
+        SP_ASSERT_MSG(element_offset + element_count <= m_element_count, "Read is out of bounds");
+
+        const uint64_t size = static_cast<uint64_t>(element_count) * m_stride;
+
+        RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Copy);
+        const std::byte* source   = static_cast<const std::byte*>(RHI_Device::MemoryGetMappedDataFromBuffer(m_rhi_resource));
+        memcpy(data, source + static_cast<uint64_t>(element_offset) * m_stride, size);
+        RHI_Device::CmdImmediateSubmit(cmd_list);
+    }
+}
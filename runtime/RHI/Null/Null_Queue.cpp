@@ -0,0 +1,127 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Queue.h"
+#include "../RHI_Semaphore.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        uint64_t timeline_value = 0;
+        array<mutex, 3> mutexes;
+
+        mutex& get_mutex(RHI_Queue* queue)
+        {
+            return mutexes[static_cast<uint32_t>(queue->GetType())];
+        }
+    }
+
+    RHI_Queue::RHI_Queue(const RHI_Queue_Type queue_type, const char* name) : SpartanObject()
+    {
+        m_object_name = name;
+        m_type        = queue_type;
+
+        // command pools, there is nothing to allocate from so they are just handles
+        m_rhi_resources[0] = static_cast<void*>(&m_cmd_lists_0);
+        m_rhi_resources[1] = static_cast<void*>(&m_cmd_lists_1);
+
+        // command lists
+        for (uint32_t i = 0; i < cmd_lists_per_pool; i++)
+        {
+            string name = m_object_name + "_cmd_pool_0_" + to_string(i);
+            m_cmd_lists_0[i] = make_shared<RHI_CommandList>(m_rhi_resources[0], name.c_str());
+
+            name = m_object_name + "_cmd_pool_1_" + to_string(i);
+            m_cmd_lists_1[i] = make_shared<RHI_CommandList>(m_rhi_resources[1], name.c_str());
+        }
+    }
+
+    RHI_Queue::~RHI_Queue()
+    {
+        Wait();
+    }
+
+    void RHI_Queue::NextCommandList()
+    {
+        if (m_first_tick)
+        {
+            m_first_tick = false;
+        }
+
+        m_index++;
+
+        // if we have no more command lists, switch to the other pool
+        if (m_index == cmd_lists_per_pool)
+        {
+            // switch command pool
+            m_index         = 0;
+            m_using_pool_a  = !m_using_pool_a;
+            auto& cmd_lists = m_using_pool_a ? m_cmd_lists_0 : m_cmd_lists_1;
+
+            // wait, this only updates the command list states since execution is instant
+            for (shared_ptr<RHI_CommandList> cmd_list : cmd_lists)
+            {
+                if (cmd_list->GetState() == RHI_CommandListState::Submitted)
+                {
+                    cmd_list->WaitForExecution();
+                }
+            }
+        }
+    }
+
+    void RHI_Queue::Wait()
+    {
+        lock_guard<mutex> lock(get_mutex(this));
+    }
+
+    void RHI_Queue::Submit(void* cmd_buffer, const uint32_t wait_flags, RHI_Semaphore* semaphore, RHI_Semaphore* semaphore_timeline)
+    {
+        // validate
+        SP_ASSERT(cmd_buffer != nullptr);
+        SP_ASSERT(semaphore != nullptr);
+        SP_ASSERT(semaphore_timeline != nullptr);
+
+        lock_guard<mutex> lock(get_mutex(this));
+
+        // there is no gpu work to wait for, so the timeline reaches the new value right away
+        uint64_t value = ++timeline_value;
+        semaphore_timeline->SetWaitValue(value);
+        semaphore_timeline->Signal(value);
+        semaphore->SetSignaled(true);
+    }
+
+    void RHI_Queue::Present(void* swapchain, const uint32_t image_index, vector<RHI_Semaphore*>& wait_semaphores)
+    {
+        SP_ASSERT(swapchain != nullptr);
+
+        lock_guard<mutex> lock(get_mutex(this));
+    }
+}
@@ -0,0 +1,78 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Device.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Implementation.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_Semaphore::RHI_Semaphore(bool is_timeline /*= false*/, const char* name /*= nullptr*/)
+    {
+        m_is_timeline = is_timeline;
+
+        // the counter of a timeline semaphore, binary semaphores simply ignore it
+        m_rhi_resource = static_cast<void*>(new atomic<uint64_t>(0));
+
+        if (name)
+        {
+            m_object_name = name;
+            RHI_Device::SetResourceName(m_rhi_resource, RHI_Resource_Type::Semaphore, name);
+        }
+    }
+
+    RHI_Semaphore::~RHI_Semaphore()
+    {
+        if (!m_rhi_resource)
+            return;
+
+        RHI_Device::DeletionQueueAdd(RHI_Resource_Type::Semaphore, m_rhi_resource);
+        m_rhi_resource = nullptr;
+    }
+
+    void RHI_Semaphore::Wait(const uint64_t value, const uint64_t timeout /*= std::numeric_limits<uint64_t>::max()*/) 
+    {
+        SP_ASSERT(m_is_timeline);
+
+        // work "completes" on submission, so by the time anyone waits the value has been reached
+    }
+
+    void RHI_Semaphore::Signal(const uint64_t value) const
+    {
+        SP_ASSERT(m_is_timeline);
+
+        static_cast<atomic<uint64_t>*>(m_rhi_resource)->store(value);
+    }
+
+    uint64_t RHI_Semaphore::GetValue() const
+    {
+        SP_ASSERT(m_is_timeline);
+
+        return static_cast<atomic<uint64_t>*>(m_rhi_resource)->load();
+    }
+}
@@ -0,0 +1,259 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "Window.h"
+#include "../RHI_Device.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Fence.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Queue.h"
+#include "../Display/Display.h"
+#include "../Rendering/Renderer.h"
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    RHI_SwapChain::RHI_SwapChain(
+        void* sdl_window,
+        const uint32_t width,
+        const uint32_t height,
+        const RHI_Present_Mode present_mode,
+        const uint32_t buffer_count,
+        const bool hdr,
+        const char* name
+    )
+    {
+        SP_ASSERT_MSG(RHI_Device::IsValidResolution(width, height), "Invalid resolution");
+        SP_ASSERT_MSG(buffer_count >= 2, "Buffer count can't be less than 2");
+
+        m_format       = hdr ? format_hdr : format_sdr;
+        m_buffer_count = buffer_count;
+        m_width        = width;
+        m_height       = height;
+        m_sdl_window   = sdl_window;
+        m_object_name  = name;
+        m_present_mode = present_mode;
+
+        Create();
+        AcquireNextImage();
+
+        SP_SUBSCRIBE_TO_EVENT(EventType::WindowResized, SP_EVENT_HANDLER(ResizeToWindowSize));
+    }
+
+    RHI_SwapChain::~RHI_SwapChain()
+    {
+        Destroy();
+    }
+
+    void RHI_SwapChain::Create()
+    {
+        SP_ASSERT(m_sdl_window != nullptr);
+
+        // images, nothing is ever displayed so they are just handles
+        {
+            for (uint32_t i = 0; i < m_buffer_count; i++)
+            {
+                m_rhi_rt[i]  = static_cast<void*>(&m_rhi_rt[i]);
+                m_rhi_rtv[i] = static_cast<void*>(&m_rhi_rtv[i]);
+            }
+
+            // transition layouts, this keeps the layout tracking identical to the other backends
+            if (RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Graphics))
+            {
+                for (uint32_t i = 0; i < m_buffer_count; i++)
+                {
+                    cmd_list->InsertBarrierTexture(
+                        m_rhi_rt[i],
+                        0,
+                        0,
+                        1,
+                        1,
+                        RHI_Image_Layout::Max,
+                        RHI_Image_Layout::Attachment,
+                        false
+                    );
+
+                    m_layouts[i] = RHI_Image_Layout::Attachment;
+                }
+
+                // end/flush
+                RHI_Device::CmdImmediateSubmit(cmd_list);
+            }
+        }
+
+        m_rhi_surface   = m_sdl_window;
+        m_rhi_swapchain = static_cast<void*>(this);
+
+        for (uint32_t i = 0; i < m_buffer_count; i++)
+        {
+            string name                   = (string("swapchain_image_acquired_") + to_string(i));
+            m_image_acquired_semaphore[i] = make_shared<RHI_Semaphore>(false, name.c_str());
+            m_image_acquired_fence[i]     = make_shared<RHI_Fence>(name.c_str());
+        }
+    }
+
+    void RHI_SwapChain::Destroy()
+    {
+        m_rhi_rt.fill(nullptr);
+        m_rhi_rtv.fill(nullptr);
+        m_image_acquired_semaphore.fill(nullptr);
+
+        RHI_Device::QueueWaitAll();
+
+        m_rhi_swapchain = nullptr;
+        m_rhi_surface   = nullptr;
+    }
+
+    void RHI_SwapChain::Resize(const uint32_t width, const uint32_t height, const bool force /*= false*/)
+    {
+        SP_ASSERT(RHI_Device::IsValidResolution(width, height));
+
+        // only resize if needed
+        if (!force)
+        {
+            if (m_width == width && m_height == height)
+                return;
+        }
+
+        // save new dimensions
+        m_width  = width;
+        m_height = height;
+
+        // reset indices
+        m_image_index = numeric_limits<uint32_t>::max();
+        m_sync_index  = numeric_limits<uint32_t>::max();
+
+        Destroy();
+        Create();
+        AcquireNextImage();
+
+        SP_LOG_INFO("Resolution has been set to %dx%d", width, height);
+    }
+
+    void RHI_SwapChain::ResizeToWindowSize()
+    {
+        Resize(Window::GetWidth(), Window::GetHeight());
+    }
+
+    void RHI_SwapChain::AcquireNextImage()
+    {
+        if (m_sync_index != numeric_limits<uint32_t>::max())
+        {
+            m_image_acquired_fence[m_sync_index]->Wait();
+            m_image_acquired_fence[m_sync_index]->Reset();
+        }
+
+        // get sync objects
+        m_sync_index  = (m_sync_index + 1) % m_buffer_count;
+        m_image_index = (m_image_index + 1) % m_buffer_count;
+    }
+
+    void RHI_SwapChain::Present()
+    {
+        SP_ASSERT(m_layouts[m_image_index] == RHI_Image_Layout::Present_Source);
+
+        m_wait_semaphores.clear();
+        RHI_Queue* queue = RHI_Device::GetQueue(RHI_Queue_Type::Graphics);
+
+        // semaphores from command lists
+        RHI_CommandList* cmd_list       = queue->GetCommandList();
+        bool presents_to_this_swapchain = cmd_list->GetSwapchainId() == m_object_id;
+        bool has_work_to_present        = cmd_list->GetState() == RHI_CommandListState::Submitted;
+        if (presents_to_this_swapchain && has_work_to_present)
+        {
+            RHI_Semaphore* semaphore = cmd_list->GetRenderingCompleteSemaphore();
+            if (semaphore->IsSignaled())
+            {
+                semaphore->SetSignaled(false);
+            }
+
+            m_wait_semaphores.emplace_back(semaphore);
+        }
+
+        // image acquired semaphore
+        m_wait_semaphores.emplace_back(m_image_acquired_semaphore[m_sync_index].get());
+
+        // present
+        queue->Present(m_rhi_swapchain, m_image_index, m_wait_semaphores);
+        AcquireNextImage();
+    }
+
+    void RHI_SwapChain::SetLayout(const RHI_Image_Layout& layout, RHI_CommandList* cmd_list)
+    {
+        if (m_layouts[m_image_index] == layout)
+            return;
+
+        cmd_list->InsertBarrierTexture(
+            m_rhi_rt[m_image_index],
+            0, 0, 1, 1,
+            m_layouts[m_image_index],
+            layout,
+            false
+        );
+
+        m_layouts[m_image_index] = layout;
+    }
+
+    void RHI_SwapChain::SetHdr(const bool enabled)
+    {
+        if (enabled)
+        {
+            SP_ASSERT_MSG(Display::GetHdr(), "This display doesn't support HDR");
+        }
+
+        RHI_Format new_format = enabled ? format_hdr : format_sdr;
+
+        if (new_format != m_format)
+        {
+            m_format = new_format;
+            Resize(m_width, m_height, true);
+        }
+    }
+
+    void RHI_SwapChain::SetVsync(const bool enabled)
+    {
+        if ((m_present_mode == RHI_Present_Mode::Fifo) != enabled)
+        {
+            m_present_mode = enabled ? RHI_Present_Mode::Fifo : RHI_Present_Mode::Immediate;
+            Resize(m_width, m_height, true);
+            Timer::OnVsyncToggled(enabled);
+            SP_LOG_INFO("VSync has been %s", enabled ? "enabled" : "disabled");
+        }
+    }
+
+    bool RHI_SwapChain::GetVsync()
+    {
+        return m_present_mode == RHI_Present_Mode::Fifo;
+    }
+
+    RHI_Image_Layout RHI_SwapChain::GetLayout() const
+    {
+        return m_layouts[m_image_index];
+    }
+}
@@ -0,0 +1,201 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture2D.h"
+#include "../RHI_CommandList.h"
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    namespace
+    {
+        void stage(RHI_Texture* texture)
+        {
+            SP_ASSERT_MSG(texture->HasData(), "No data to stage");
+
+            // only mappable textures have memory which the cpu can read back, so only those are filled
+            if (void* mapped_data = texture->GetMappedData())
+            {
+                const uint32_t width        = texture->GetWidth();
+                const uint32_t height       = texture->GetHeight();
+                const uint32_t depth        = texture->GetDepth();
+                const uint32_t array_length = texture->GetArrayLength();
+                const uint32_t mip_count    = texture->GetMipCount();
+
+                size_t offset = 0;
+                for (uint32_t array_index = 0; array_index < array_length; array_index++)
+                {
+                    for (uint32_t mip_index = 0; mip_index < mip_count; mip_index++)
+                    {
+                        uint32_t mip_width  = max(1u, width >> mip_index);
+                        uint32_t mip_height = max(1u, height >> mip_index);
+                        uint32_t mip_depth  = (texture->GetResourceType() == ResourceType::Texture3d) ? max(1u, depth >> mip_index) : 1;
+                        size_t size         = RHI_Texture::CalculateMipSize(mip_width, mip_height, mip_depth, texture->GetFormat(), texture->GetBitsPerChannel(), texture->GetChannelCount());
+
+                        if (texture->GetMip(array_index, mip_index).bytes.size() != 0)
+                        {
+                            memcpy(static_cast<std::byte*>(mapped_data) + offset, texture->GetMip(array_index, mip_index).bytes.data(), size);
+                        }
+
+                        offset += size;
+                    }
+                }
+            }
+
+            // keep the layout transitions (and barrier counts) identical to the other backends
+            if (RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Graphics))
+            {
+                RHI_Image_Layout layout = RHI_Image_Layout::Transfer_Destination;
+                cmd_list->InsertBarrierTexture(texture, 0, texture->GetMipCount(), texture->GetArrayLength(), texture->GetLayout(0), layout);
+                RHI_Device::CmdImmediateSubmit(cmd_list);
+
+                texture->SetLayout(layout, nullptr);
+            }
+        }
+
+        RHI_Image_Layout GetAppropriateLayout(RHI_Texture* texture)
+        {
+            RHI_Image_Layout target_layout = RHI_Image_Layout::Preinitialized;
+
+            if (texture->IsRt())
+            {
+                target_layout = RHI_Image_Layout::Attachment;
+            }
+
+            if (texture->IsUav())
+                target_layout = RHI_Image_Layout::General;
+
+            if (texture->IsSrv())
+                target_layout = RHI_Image_Layout::Shader_Read;
+
+            return target_layout;
+        }
+    }
+
+    bool RHI_Texture::RHI_CreateResource()
+    {
+        SP_ASSERT_MSG(m_width  != 0, "Width can't be zero");
+        SP_ASSERT_MSG(m_height != 0, "Height can't be zero");
+
+        RHI_Image_Layout initial_layout = HasExternalMemory() ? RHI_Image_Layout::Max : RHI_Image_Layout::Preinitialized;
+        SetLayout(initial_layout, nullptr);
+
+        // create image
+        RHI_Device::MemoryTextureCreate(this);
+
+        // if the texture has any data, stage it
+        if (HasData())
+        {
+            stage(this);
+            if ((m_flags & RHI_Texture_KeepData) == 0)
+            { 
+                m_slices.clear();
+            }
+        }
+
+        // transition to target layout
+        if (RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Graphics))
+        {
+            RHI_Image_Layout target_layout = GetAppropriateLayout(this);
+
+            // transition to the final layout
+            cmd_list->InsertBarrierTexture(this, 0, m_mip_count, m_array_length, m_layout[0], target_layout);
+        
+            // flush
+            RHI_Device::CmdImmediateSubmit(cmd_list);
+
+            // update this texture with the new layout
+            for (uint32_t i = 0; i < m_mip_count; i++)
+            {
+                m_layout[i] = target_layout;
+            }
+        }
+
+        // views, there is nothing to create so they all point to the image
+        {
+            if (IsSrv())
+            {
+                m_rhi_srv = m_rhi_resource;
+
+                if (HasPerMipViews())
+                {
+                    for (uint32_t i = 0; i < m_mip_count; i++)
+                    {
+                        m_rhi_srv_mips[i] = m_rhi_resource;
+                    }
+                }
+            }
+
+            const uint32_t view_count = m_resource_type != ResourceType::Texture3d ? m_array_length : 1;
+            for (uint32_t i = 0; i < view_count; i++)
+            {
+                m_rhi_rtv[i] = IsRtv() ? m_rhi_resource : nullptr;
+                m_rhi_dsv[i] = IsDsv() ? m_rhi_resource : nullptr;
+            }
+
+            if (m_resource_type == ResourceType::Texture2dArray && m_array_length > 1)
+            {
+                m_rhi_rtv_array = IsRtv() ? m_rhi_resource : nullptr;
+                m_rhi_dsv_array = IsDsv() ? m_rhi_resource : nullptr;
+            }
+
+            RHI_Device::SetResourceName(m_rhi_resource, RHI_Resource_Type::Texture, m_object_name);
+        }
+
+        return true;
+    }
+
+    void RHI_Texture::RHI_DestroyResource(const bool destroy_main, const bool destroy_per_view)
+    {
+        // views don't own anything
+        if (destroy_main)
+        {
+            m_rhi_srv = nullptr;
+            m_rhi_dsv.fill(nullptr);
+            m_rhi_rtv.fill(nullptr);
+            m_rhi_rtv_array = nullptr;
+            m_rhi_dsv_array = nullptr;
+        }
+
+        if (destroy_per_view)
+        {
+            for (uint32_t i = 0; i < m_mip_count; i++)
+            {
+                m_rhi_srv_mips[i] = nullptr;
+            }
+        }
+
+        if (destroy_main)
+        {
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::Texture, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+    }
+}
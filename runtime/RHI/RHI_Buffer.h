@@ -30,7 +30,8 @@ namespace Spartan
     enum RHI_Buffer_Usage : uint32_t
     {
         RHI_Buffer_Transfer_Src = 1 << 0,
-        RHI_Buffer_Transfer_Dst = 1 << 1
+        RHI_Buffer_Transfer_Dst = 1 << 1,
+        RHI_Buffer_Indirect     = 1 << 2
     };
 
     class RHI_Buffer : public SpartanObject
@@ -43,6 +44,7 @@ namespace Spartan
         void ResetOffset()           { m_offset = 0; first_update = true; }
         uint32_t GetStride()   const { return m_stride; }
         uint32_t GetOffset()   const { return m_offset; }
+        void* GetMappedData()  const { return m_mapped_data; }
         void* GetRhiResource() const { return m_rhi_resource; }
 
     private:
@@ -81,6 +81,7 @@ namespace Spartan
         // dispatch
         void Dispatch(uint32_t x, uint32_t y, uint32_t z = 1);
         void Dispatch(RHI_Texture* texture);
+        void DispatchIndirect(RHI_Buffer* buffer, const uint32_t offset = 0); // offset in bytes, relative to the buffer's current offset
 
         // blit
         void Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips, const float source_scaling = 1.0f);
@@ -90,6 +91,14 @@ namespace Spartan
         void Copy(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips);
         void Copy(RHI_Texture* source, RHI_SwapChain* destination);
 
+        // copy to buffer, offsets and size are in bytes, a width/height of 0 means the whole mip
+        void Copy(RHI_Texture* source, RHI_Buffer* destination, const uint64_t destination_offset, const uint32_t mip_index = 0, const uint32_t array_index = 0, const uint32_t x = 0, const uint32_t y = 0, uint32_t width = 0, uint32_t height = 0);
+        void Copy(RHI_Buffer* source, const uint64_t source_offset, RHI_Buffer* destination, const uint64_t destination_offset, const uint64_t size);
+        void Copy(RHI_GeometryBuffer* source, const uint32_t element_offset, const uint32_t element_count, RHI_Buffer* destination, const uint64_t destination_offset); // the source range is in elements
+
+        // copy to geometry, the ranges are (element offset, element count) and their elements sit back to back in the source, from source_offset
+        void Copy(RHI_Buffer* source, const uint64_t source_offset, RHI_GeometryBuffer* destination, const std::vector<std::pair<uint32_t, uint32_t>>& ranges);
+
         // viewport
         void SetViewport(const RHI_Viewport& viewport) const;
         
@@ -128,6 +137,8 @@ namespace Spartan
         // buffer
         void SetBuffer(const uint32_t slot, RHI_Buffer* buffer) const;
         void SetBuffer(const Renderer_BindingsUav slot, const std::shared_ptr<RHI_Buffer>& buffer) const { SetBuffer(static_cast<uint32_t>(slot), buffer.get()); }
+        void SetBuffer(const uint32_t slot, RHI_GeometryBuffer* buffer) const;
+        void SetBuffer(const Renderer_BindingsUav slot, RHI_GeometryBuffer* buffer) const { SetBuffer(static_cast<uint32_t>(slot), buffer); }
 
         // markers
         void BeginMarker(const char* name);
@@ -161,11 +172,13 @@ namespace Spartan
         );
         void InsertBarrierTexture(RHI_Texture* texture, const uint32_t mip_start, const uint32_t mip_range, const uint32_t array_length, const RHI_Image_Layout layout_old, const RHI_Image_Layout layout_new);
         void InsertBarrierTextureReadWrite(RHI_Texture* texture);
+        void InsertBarrierBufferReadWrite(RHI_Buffer* buffer);
         void InsertPendingBarrierGroup();
 
         // misc
         void SetIgnoreClearValues(const bool ignore_clear_values) { m_ignore_clear_values = ignore_clear_values; }
         RHI_Semaphore* GetRenderingCompleteSemaphore()            { return m_rendering_complete_semaphore.get(); }
+        RHI_Semaphore* GetRenderingCompleteSemaphoreTimeline()    { return m_rendering_complete_semaphore_timeline.get(); }
         void* GetRhiResource() const                              { return m_rhi_resource; }
         const RHI_CommandListState GetState() const               { return m_state; }
         uint64_t GetSwapchainId() const                           { return m_swapchain_id; }
@@ -77,6 +77,7 @@ namespace Spartan
     {
         D3d12,
         Vulkan,
+        Null,
         Max
     };
 
@@ -72,6 +72,7 @@ namespace Spartan
         uint32_t struct_size     = 0;
         uint32_t array_length    = 0;
         bool as_array            = false;
+        bool is_geometry_buffer  = false; // data is an RHI_GeometryBuffer instead of an RHI_Buffer
 
         // debugging
         std::string name;
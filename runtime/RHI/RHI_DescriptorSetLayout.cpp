@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RHI_DescriptorSetLayout.h"
 #include "RHI_ConstantBuffer.h"
 #include "RHI_Buffer.h"
+#include "RHI_GeometryBuffer.h"
 #include "RHI_Texture.h"
 #include "RHI_DescriptorSet.h"
 #include "RHI_Device.h"
@@ -73,9 +74,27 @@ namespace Spartan
         {
             if (descriptor.slot == slot + rhi_shader_shift_register_u)
             {
-                descriptor.data           = static_cast<void*>(buffer);
-                descriptor.range          = buffer->GetStride();
-                descriptor.dynamic_offset = buffer->GetOffset();
+                descriptor.data               = static_cast<void*>(buffer);
+                descriptor.range              = buffer->GetStride();
+                descriptor.dynamic_offset     = buffer->GetOffset();
+                descriptor.is_geometry_buffer = false;
+
+                return;
+            }
+        }
+    }
+
+    void RHI_DescriptorSetLayout::SetBuffer(const uint32_t slot, RHI_GeometryBuffer* buffer)
+    {
+        for (RHI_Descriptor& descriptor : m_descriptors)
+        {
+            if (descriptor.slot == slot + rhi_shader_shift_register_u)
+            {
+                // the whole buffer is visible, shaders index it directly
+                descriptor.data               = static_cast<void*>(buffer);
+                descriptor.range              = static_cast<uint64_t>(buffer->GetStride()) * buffer->GetElementCount();
+                descriptor.dynamic_offset     = 0;
+                descriptor.is_geometry_buffer = true;
 
                 return;
             }
@@ -126,7 +145,8 @@ namespace Spartan
             descriptor.data           = nullptr;
             descriptor.mip            = 0;
             descriptor.mip_range      = 0;
-            descriptor.dynamic_offset = 0;
+            descriptor.dynamic_offset     = 0;
+            descriptor.is_geometry_buffer = false;
         }
     }
 
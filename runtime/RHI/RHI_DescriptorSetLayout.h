@@ -47,6 +47,7 @@ namespace Spartan
         // set
         void SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer);
         void SetBuffer(const uint32_t slot, RHI_Buffer* buffer);
+        void SetBuffer(const uint32_t slot, RHI_GeometryBuffer* buffer);
         void SetSampler(const uint32_t slot, RHI_Sampler* sampler);
         void SetTexture(const uint32_t slot, RHI_Texture* texture, const uint32_t mip_index, const uint32_t mip_range);
 
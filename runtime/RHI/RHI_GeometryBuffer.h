@@ -77,6 +77,29 @@ namespace Spartan
             RHI_CreateResource(nullptr);
         }
 
+        // device local buffer without initial data, filled in ranges via Update()
+        template<typename T>
+        void CreateEmpty(const uint32_t element_count)
+        {
+            m_stride        = sizeof(T);
+            m_element_count = element_count;
+            m_object_size   = static_cast<uint64_t>(m_stride) * static_cast<uint64_t>(m_element_count);
+            m_is_empty      = true;
+
+            RHI_CreateResource(nullptr);
+        }
+
+        void Update(const void* data, const uint32_t element_offset, const uint32_t element_count);
+
+        // several ranges (element offset, element count) in one submission, data holds their elements back to back
+        void Update(const void* data, const std::vector<std::pair<uint32_t, uint32_t>>& ranges);
+
+        // gpu side copy of the first element_count elements of another buffer, both created with CreateEmpty()
+        void Copy(const RHI_GeometryBuffer* source, const uint32_t element_count);
+
+        // blocking gpu readback, only for buffers created with CreateEmpty()
+        void Read(void* data, const uint32_t element_offset, const uint32_t element_count) const;
+
         void* GetMappedData() const      { return m_mapped_data; }
         void* GetRhiResource() const     { return m_rhi_resource; }
         uint32_t GetElementCount() const { return m_element_count; }
@@ -86,6 +109,7 @@ namespace Spartan
         RHI_Buffer_Type m_type   = RHI_Buffer_Type::Max;
         void* m_mapped_data      = nullptr;
         bool m_is_mappable       = false;
+        bool m_is_empty          = false;
         uint32_t m_stride        = 0;
         uint32_t m_element_count = 0;
 
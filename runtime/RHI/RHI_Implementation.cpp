@@ -41,6 +41,9 @@ namespace Spartan
     VkInstance       RHI_Context::instance        = nullptr;
     VkPhysicalDevice RHI_Context::device_physical = nullptr;
     VkDevice         RHI_Context::device          = nullptr;
+#elif defined(API_GRAPHICS_NULL)
+    RHI_Api_Type RHI_Context::api_type     = RHI_Api_Type::Null;
+    string       RHI_Context::api_type_str = "Null";
 #endif
 
     // api agnostic
@@ -119,6 +119,7 @@ namespace Spartan
                 }
 
                 hash = rhi_hash_combine(hash, pso.render_target_array_index);
+                hash = rhi_hash_combine(hash, pso.render_target_view_count);
             }
 
             return hash;
@@ -159,6 +160,7 @@ namespace Spartan
     RHI_PipelineState::RHI_PipelineState()
     {
         clear_color.fill(rhi_color_load);
+        store_color.fill(true);
         render_target_color_textures.fill(nullptr);
     }
 
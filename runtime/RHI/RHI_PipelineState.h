@@ -57,6 +57,7 @@ namespace Spartan
         RHI_Texture* render_target_depth_texture = nullptr;
         RHI_Texture* vrs_input_texture           = nullptr;
         uint32_t render_target_array_index       = 0;
+        uint32_t render_target_view_count        = 1; // above 1, that many array slices are rendered at once (multiview) and shaders read theirs from SV_ViewID
         //=================================================================================
 
         // dynamic properties, changing these will not create a new PSO
@@ -66,6 +67,11 @@ namespace Spartan
         std::array<Color, rhi_max_render_target_count> clear_color;
         std::string name; // used by the validation layer
 
+        // store hints, clear them for attachments that nothing reads after the pass, a pass that switches
+        // pipelines restarts its render pass and loads what it stored, so these only fit single pipeline passes
+        std::array<bool, rhi_max_render_target_count> store_color;
+        bool store_depth = true;
+
     private:
         bool HasShader(const RHI_Shader_Type shader_stage) const;
 
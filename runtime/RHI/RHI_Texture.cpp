@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RHI_CommandList.h"
 #include "../IO/FileStream.h"
 #include "../Rendering/Renderer.h"
+#include "../Resource/ResourceCache.h"
 #include "../Resource/Import/ImageImporterExporter.h"
 SP_WARNINGS_OFF
 #include "compressonator.h"
@@ -115,6 +116,218 @@ namespace Spartan
         }
     }
 
+    namespace cooked
+    {
+        // compressed textures are written to the cache as a dds (dx10 header), a warm load maps
+        // the file and hands the block compressed mips to the staging path, no decoding or compression
+        const uint32_t magic          = 0x20534444; // "DDS "
+        const uint32_t magic_engine   = 0x54525053; // "SPRT", written into the reserved header fields
+        const uint32_t version        = 1;
+        const uint32_t flags_restored = RHI_Texture_Greyscale | RHI_Texture_Transparent | RHI_Texture_Srgb;
+
+        struct dds_pixel_format
+        {
+            uint32_t size          = sizeof(dds_pixel_format);
+            uint32_t flags         = 0x4;        // DDPF_FOURCC
+            uint32_t four_cc       = 0x30315844; // "DX10"
+            uint32_t rgb_bit_count = 0;
+            uint32_t bit_mask[4]   = {};
+        };
+
+        struct dds_header
+        {
+            uint32_t size                 = sizeof(dds_header);
+            uint32_t flags                = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; // caps, height, width, pixel format, mip count, linear size
+            uint32_t height               = 0;
+            uint32_t width                = 0;
+            uint32_t pitch_or_linear_size = 0;
+            uint32_t depth                = 0;
+            uint32_t mip_count            = 0;
+            uint32_t reserved[11]         = {}; // magic_engine, version, flags, channel count, bits per channel
+            dds_pixel_format pixel_format;
+            uint32_t caps                 = 0x1000 | 0x400000 | 0x8; // texture, mipmap, complex
+            uint32_t caps_2               = 0;
+            uint32_t caps_3               = 0;
+            uint32_t caps_4               = 0;
+            uint32_t reserved_2           = 0;
+        };
+
+        struct dds_header_dx10
+        {
+            uint32_t dxgi_format        = 0;
+            uint32_t resource_dimension = 3; // texture2d
+            uint32_t misc_flags         = 0;
+            uint32_t array_size         = 1;
+            uint32_t misc_flags_2       = 0;
+        };
+
+        static_assert(sizeof(dds_header) == 124, "dds header size mismatch");
+        static_assert(sizeof(dds_header_dx10) == 20, "dds dx10 header size mismatch");
+
+        uint32_t to_dxgi_format(const RHI_Format format)
+        {
+            switch (format)
+            {
+                case RHI_Format::BC1_Unorm: return 71;
+                case RHI_Format::BC3_Unorm: return 77;
+                case RHI_Format::BC5_Unorm: return 83;
+                case RHI_Format::BC7_Unorm: return 98;
+                default:                    return 0;
+            }
+        }
+
+        RHI_Format to_rhi_format(const uint32_t dxgi_format)
+        {
+            switch (dxgi_format)
+            {
+                case 71: return RHI_Format::BC1_Unorm;
+                case 77: return RHI_Format::BC3_Unorm;
+                case 83: return RHI_Format::BC5_Unorm;
+                case 98: return RHI_Format::BC7_Unorm;
+                default: return RHI_Format::Max;
+            }
+        }
+
+        bool is_cookable(const RHI_Texture* texture, const string& file_path)
+        {
+            // dds sources are already block compressed, there is nothing to gain
+            return (texture->GetFlags() & RHI_Texture_Compress) != 0 &&
+                   texture->GetResourceType() == ResourceType::Texture2d &&
+                   FileSystem::GetExtensionFromFilePath(file_path) != ".dds";
+        }
+
+        // keyed by the source file content, so an edited image invalidates the cooked one
+        string get_file_path(const RHI_Texture* texture, const hash_128& content_hash)
+        {
+            // requested dimensions are part of the key since the importer rescales to them
+            hash_128 key = hash_compute(texture->GetFlags() & ~flags_restored, content_hash);
+            key          = hash_compute(texture->GetWidth(), key);
+            key          = hash_compute(texture->GetHeight(), key);
+            key          = hash_compute(version, key);
+
+            char key_hex[33];
+            snprintf(key_hex, sizeof(key_hex), "%016llx%016llx", static_cast<unsigned long long>(key.high), static_cast<unsigned long long>(key.low));
+
+            return ResourceCache::GetResourceDirectory(ResourceDirectory::Cache) + "\\texture_" + key_hex + ".dds";
+        }
+
+        void save(RHI_Texture* texture, const string& file_path)
+        {
+            const uint32_t dxgi_format = to_dxgi_format(texture->GetFormat());
+            if (dxgi_format == 0 || texture->GetArrayLength() != 1)
+                return;
+
+            // the loader derives mip sizes from the dimensions, so the chain has to agree with them
+            for (uint32_t mip_index = 0; mip_index < texture->GetMipCount(); mip_index++)
+            {
+                const uint32_t width  = max(1u, texture->GetWidth() >> mip_index);
+                const uint32_t height = max(1u, texture->GetHeight() >> mip_index);
+                if (texture->GetMip(0, mip_index).bytes.size() != RHI_Texture::CalculateMipSize(width, height, 1, texture->GetFormat(), texture->GetBitsPerChannel(), texture->GetChannelCount()))
+                    return;
+            }
+
+            string directory = ResourceCache::GetResourceDirectory(ResourceDirectory::Cache);
+            if (!FileSystem::Exists(directory))
+            {
+                FileSystem::CreateDirectory(directory);
+            }
+
+            FileStream stream(file_path, FileStream_Write);
+            if (!stream.IsOpen())
+                return;
+
+            dds_header header           = {};
+            header.width                = texture->GetWidth();
+            header.height               = texture->GetHeight();
+            header.mip_count            = texture->GetMipCount();
+            header.pitch_or_linear_size = static_cast<uint32_t>(texture->GetMip(0, 0).bytes.size());
+            header.reserved[0]          = magic_engine;
+            header.reserved[1]          = version;
+            header.reserved[2]          = texture->GetFlags() & flags_restored;
+            header.reserved[3]          = texture->GetChannelCount();
+            header.reserved[4]          = texture->GetBitsPerChannel();
+
+            dds_header_dx10 header_dx10 = {};
+            header_dx10.dxgi_format     = dxgi_format;
+
+            stream.Write(magic);
+            stream.Write(reinterpret_cast<const std::byte*>(&header), sizeof(header));
+            stream.Write(reinterpret_cast<const std::byte*>(&header_dx10), sizeof(header_dx10));
+            for (RHI_Texture_Mip& mip : texture->GetSlice(0).mips)
+            {
+                stream.Write(mip.bytes.data(), mip.bytes.size());
+            }
+        }
+
+        bool load(RHI_Texture* texture, const string& file_path)
+        {
+            if (!FileSystem::Exists(file_path))
+                return false;
+
+            uint64_t size    = 0;
+            const byte* data = FileSystem::MapFile(file_path, &size);
+            if (!data)
+                return false;
+
+            uint32_t file_magic         = 0;
+            dds_header header           = {};
+            dds_header_dx10 header_dx10 = {};
+            const uint64_t data_offset  = sizeof(file_magic) + sizeof(header) + sizeof(header_dx10);
+            if (size >= data_offset)
+            {
+                memcpy(&file_magic, data, sizeof(file_magic));
+                memcpy(&header, data + sizeof(file_magic), sizeof(header));
+                memcpy(&header_dx10, data + sizeof(file_magic) + sizeof(header), sizeof(header_dx10));
+            }
+
+            const RHI_Format format = to_rhi_format(header_dx10.dxgi_format);
+            bool is_valid =
+                file_magic == magic                   &&
+                header.reserved[0] == magic_engine    &&
+                header.reserved[1] == version         &&
+                format != RHI_Format::Max             &&
+                header.width != 0 && header.height != 0 && header.mip_count != 0;
+
+            if (is_valid)
+            {
+                texture->SetWidth(header.width);
+                texture->SetHeight(header.height);
+                texture->SetChannelCount(header.reserved[3]);
+                texture->SetBitsPerChannel(header.reserved[4]);
+                texture->SetFormat(format);
+                texture->SetFlag(flags_restored, false);
+                texture->SetFlag(header.reserved[2] & flags_restored);
+
+                // the mip sizes follow from the dimensions, so validate the whole chain before copying
+                uint64_t offset = data_offset;
+                for (uint32_t mip_index = 0; mip_index < header.mip_count && is_valid; mip_index++)
+                {
+                    const uint32_t width  = max(1u, header.width >> mip_index);
+                    const uint32_t height = max(1u, header.height >> mip_index);
+                    offset               += RHI_Texture::CalculateMipSize(width, height, 1, format, header.reserved[4], header.reserved[3]);
+                    is_valid              = offset <= size;
+                }
+
+                offset = data_offset;
+                for (uint32_t mip_index = 0; mip_index < header.mip_count && is_valid; mip_index++)
+                {
+                    RHI_Texture_Mip& mip = texture->CreateMip(0);
+                    memcpy(mip.bytes.data(), data + offset, mip.bytes.size());
+                    offset += mip.bytes.size();
+                }
+            }
+
+            FileSystem::UnmapFile(data, size);
+
+            if (!is_valid)
+            {
+                SP_LOG_WARNING("Cooked texture \"%s\" is invalid, recooking", file_path.c_str());
+            }
+
+            return is_valid;
+        }
+    }
+
     RHI_Texture::RHI_Texture() : IResource(ResourceType::Texture)
     {
         m_layout.fill(RHI_Image_Layout::Max);
@@ -179,28 +392,53 @@ namespace Spartan
         }
         else
         {
-            ComputeMemoryUsage();
+            SaveData(file.get());
+        }
+
+        SaveProperties(file.get());
 
-            // write mip info
-            file->Write(m_object_size);
-            file->Write(m_array_length);
-            file->Write(m_mip_count);
+        return true;
+    }
 
-            // write mip data
-            for (RHI_Texture_Slice& slice : m_slices)
+    bool RHI_Texture::SaveToMemory(vector<byte>* data)
+    {
+        // without the bytes, the file that has them is left as it is
+        if (!HasData())
+            return false;
+
+        FileStream stream;
+        SaveData(&stream);
+        SaveProperties(&stream);
+        *data = stream.GetData();
+
+        return true;
+    }
+
+    void RHI_Texture::SaveData(FileStream* file)
+    {
+        ComputeMemoryUsage();
+
+        // write mip info
+        file->Write(m_object_size);
+        file->Write(m_array_length);
+        file->Write(m_mip_count);
+
+        // write mip data
+        for (RHI_Texture_Slice& slice : m_slices)
+        {
+            for (RHI_Texture_Mip& mip : slice.mips)
             {
-                for (RHI_Texture_Mip& mip : slice.mips)
-                {
-                    file->Write(mip.bytes);
-                }
+                file->Write(mip.bytes);
             }
-
-            // the bytes have been saved, so we can now free some memory
-            m_slices.clear();
-            m_slices.shrink_to_fit();
         }
 
-        // write properties
+        // the bytes have been saved, so we can now free some memory
+        m_slices.clear();
+        m_slices.shrink_to_fit();
+    }
+
+    void RHI_Texture::SaveProperties(FileStream* file) const
+    {
         file->Write(m_width);
         file->Write(m_height);
         file->Write(m_channel_count);
@@ -209,8 +447,6 @@ namespace Spartan
         file->Write(m_flags);
         file->Write(GetObjectId());
         file->Write(GetResourceFilePath());
-
-        return true;
     }
 
     bool RHI_Texture::LoadFromFile(const string& file_path)
@@ -266,41 +502,76 @@ namespace Spartan
             }
             else if (FileSystem::IsSupportedImageFile(file_path))
             {
-                vector<string> file_paths = { file_path };
+                const Stopwatch timer;
 
-                // if this is an array, try to find all the textures
-                if (m_resource_type == ResourceType::Texture2dArray)
+                // look for a cooked version of this image
+                string cooked_path;
+                if (cooked::is_cookable(this, file_path))
                 {
-                    string file_path_extension    = FileSystem::GetExtensionFromFilePath(file_path);
-                    string file_path_no_extension = FileSystem::GetFilePathWithoutExtension(file_path);
-                    string file_path_no_digit     = file_path_no_extension.substr(0, file_path_no_extension.size() - 1);
-
-                    uint32_t index = 1;
-                    string file_path_guess = file_path_no_digit + to_string(index) + file_path_extension;
-                    while (FileSystem::Exists(file_path_guess))
+                    uint64_t size = 0;
+                    if (const std::byte* data = FileSystem::MapFile(file_path, &size))
                     {
-                        file_paths.emplace_back(file_path_guess);
-                        file_path_guess = file_path_no_digit + to_string(++index) + file_path_extension;
+                        const hash_128 content_hash = hash_compute(data, size);
+                        FileSystem::UnmapFile(data, size);
+
+                        if (!GetContentHash().IsDefined())
+                        {
+                            SetContentHash(content_hash);
+                        }
+
+                        cooked_path = cooked::get_file_path(this, content_hash);
                     }
                 }
 
-                // load texture
-                for (uint32_t slice_index = 0; slice_index < static_cast<uint32_t>(file_paths.size()); slice_index++)
+                if (!cooked_path.empty() && cooked::load(this, cooked_path))
+                {
+                    SetResourceFilePath(file_path);
+                    SP_LOG_INFO("Loaded cooked \"%s\" in %.2f ms", FileSystem::GetFileNameFromFilePath(file_path).c_str(), timer.GetElapsedTimeMs());
+                }
+                else
                 {
-                    if (!ImageImporterExporter::Load(file_paths[slice_index], slice_index, this))
+                    vector<string> file_paths = { file_path };
+
+                    // if this is an array, try to find all the textures
+                    if (m_resource_type == ResourceType::Texture2dArray)
                     {
-                        SP_LOG_ERROR("Failed to load \"%s\".", file_path.c_str());
-                        return false;
+                        string file_path_extension    = FileSystem::GetExtensionFromFilePath(file_path);
+                        string file_path_no_extension = FileSystem::GetFilePathWithoutExtension(file_path);
+                        string file_path_no_digit     = file_path_no_extension.substr(0, file_path_no_extension.size() - 1);
+
+                        uint32_t index = 1;
+                        string file_path_guess = file_path_no_digit + to_string(index) + file_path_extension;
+                        while (FileSystem::Exists(file_path_guess))
+                        {
+                            file_paths.emplace_back(file_path_guess);
+                            file_path_guess = file_path_no_digit + to_string(++index) + file_path_extension;
+                        }
+                    }
+
+                    // load texture
+                    for (uint32_t slice_index = 0; slice_index < static_cast<uint32_t>(file_paths.size()); slice_index++)
+                    {
+                        if (!ImageImporterExporter::Load(file_paths[slice_index], slice_index, this))
+                        {
+                            SP_LOG_ERROR("Failed to load \"%s\".", file_path.c_str());
+                            return false;
+                        }
                     }
-                }
 
-                // set resource file path so it can be used by the resource cache.
-                SetResourceFilePath(file_path);
+                    // set resource file path so it can be used by the resource cache.
+                    SetResourceFilePath(file_path);
 
-                // compress texture (if not alraedy compressed)
-                if (compress && !IsCompressedFormat(m_format))
-                {
-                    compressonator::compress(this);
+                    // compress texture (if not alraedy compressed)
+                    if (compress && !IsCompressedFormat(m_format))
+                    {
+                        compressonator::compress(this);
+
+                        if (!cooked_path.empty())
+                        {
+                            cooked::save(this, cooked_path);
+                            SP_LOG_INFO("Cooked \"%s\" in %.2f ms", FileSystem::GetFileNameFromFilePath(file_path).c_str(), timer.GetElapsedTimeMs());
+                        }
+                    }
                 }
             }
         }
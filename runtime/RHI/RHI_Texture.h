@@ -31,6 +31,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
+    class FileStream;
+
     enum RHI_Texture_Flags : uint32_t
     {
         RHI_Texture_Srv            = 1U << 0,
@@ -68,6 +70,7 @@ namespace Spartan
         //= IResource ===========================================
         bool SaveToFile(const std::string& file_path) override;
         bool LoadFromFile(const std::string& file_path) override;
+        bool SaveToMemory(std::vector<std::byte>* data) override;
         //=======================================================
 
         uint32_t GetWidth()                                const { return m_width; }
@@ -142,6 +145,8 @@ namespace Spartan
         void* GetRhiDsv(const uint32_t i = 0)         const { return i < m_rhi_dsv.size()           ? m_rhi_dsv[i]           : nullptr; }
         void* GetRhiDsvReadOnly(const uint32_t i = 0) const { return i < m_rhi_dsv_read_only.size() ? m_rhi_dsv_read_only[i] : nullptr; }
         void* GetRhiRtv(const uint32_t i = 0)         const { return i < m_rhi_rtv.size()           ? m_rhi_rtv[i]           : nullptr; }
+        void* GetRhiRtvArray()                        const { return m_rhi_rtv_array; } // all slices, for layered rendering
+        void* GetRhiDsvArray()                        const { return m_rhi_dsv_array; } // all slices, for layered rendering
         void RHI_DestroyResource(const bool destroy_main, const bool destroy_per_view);
         void*& GetMappedData() { return m_mapped_data; }
 
@@ -170,9 +175,13 @@ namespace Spartan
         std::array<void*, rhi_max_render_target_count> m_rhi_rtv;
         std::array<void*, rhi_max_render_target_count> m_rhi_dsv;
         std::array<void*, rhi_max_render_target_count> m_rhi_dsv_read_only;
-        void* m_mapped_data = nullptr;
+        void* m_rhi_rtv_array = nullptr;
+        void* m_rhi_dsv_array = nullptr;
+        void* m_mapped_data   = nullptr;
 
     private:
         void ComputeMemoryUsage();
+        void SaveData(FileStream* file);
+        void SaveProperties(FileStream* file) const;
     };
 }
@@ -54,6 +54,8 @@ namespace Spartan
             vk_usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
         if (m_usage & RHI_Buffer_Transfer_Dst)
             vk_usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        if (m_usage & RHI_Buffer_Indirect)
+            vk_usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
 
         SP_ASSERT(vk_usage != 0);
 
@@ -70,6 +70,17 @@ namespace Spartan
             return VK_ATTACHMENT_LOAD_OP_CLEAR;
         };
 
+        // render pass clears are counted with the explicit ones
+        VkAttachmentLoadOp count_clear(const VkAttachmentLoadOp load_op)
+        {
+            if (load_op == VK_ATTACHMENT_LOAD_OP_CLEAR)
+            {
+                Profiler::m_rhi_clears++;
+            }
+
+            return load_op;
+        }
+
         uint32_t get_aspect_mask(const RHI_Texture* texture, const bool only_depth = false, const bool only_stencil = false)
         {
             uint32_t aspect_mask = 0;
@@ -94,6 +105,27 @@ namespace Spartan
             return aspect_mask;
         }
 
+        namespace memory_barrier
+        {
+            void insert(void* cmd_buffer, const VkPipelineStageFlags2 stage_src, const VkAccessFlags2 access_src, const VkPipelineStageFlags2 stage_dst, const VkAccessFlags2 access_dst)
+            {
+                VkMemoryBarrier2 barrier = {};
+                barrier.sType            = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+                barrier.srcStageMask     = stage_src;
+                barrier.srcAccessMask    = access_src;
+                barrier.dstStageMask     = stage_dst;
+                barrier.dstAccessMask    = access_dst;
+
+                VkDependencyInfo dependency_info   = {};
+                dependency_info.sType              = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+                dependency_info.memoryBarrierCount = 1;
+                dependency_info.pMemoryBarriers    = &barrier;
+
+                vkCmdPipelineBarrier2(static_cast<VkCommandBuffer>(cmd_buffer), &dependency_info);
+                Profiler::m_rhi_pipeline_barriers++;
+            }
+        }
+
         namespace image_barrier
         { 
             VkAccessFlags2 layout_to_access_mask(const VkImageLayout layout, const bool is_destination_mask, const bool is_depth)
@@ -712,6 +744,7 @@ namespace Spartan
         rendering_info.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
         rendering_info.renderArea           = { 0, 0, m_pso.GetWidth(), m_pso.GetHeight() };
         rendering_info.layerCount           = 1;
+        rendering_info.viewMask             = m_pso.render_target_view_count > 1 ? (1U << m_pso.render_target_view_count) - 1 : 0;
         rendering_info.colorAttachmentCount = 0;
         rendering_info.pColorAttachments    = nullptr;
         rendering_info.pDepthAttachment     = nullptr;
@@ -754,10 +787,10 @@ namespace Spartan
 
                     VkRenderingAttachmentInfo color_attachment = {};
                     color_attachment.sType                     = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
-                    color_attachment.imageView                 = static_cast<VkImageView>(rt->GetRhiRtv(m_pso.render_target_array_index));
+                    color_attachment.imageView                 = static_cast<VkImageView>(rendering_info.viewMask != 0 ? rt->GetRhiRtvArray() : rt->GetRhiRtv(m_pso.render_target_array_index));
                     color_attachment.imageLayout               = vulkan_image_layout[static_cast<uint8_t>(rt->GetLayout(0))];
-                    color_attachment.loadOp                    = m_ignore_clear_values ? VK_ATTACHMENT_LOAD_OP_LOAD : get_color_load_op(m_pso.clear_color[i]);
-                    color_attachment.storeOp                   = VK_ATTACHMENT_STORE_OP_STORE;
+                    color_attachment.loadOp                    = count_clear(m_ignore_clear_values ? VK_ATTACHMENT_LOAD_OP_LOAD : get_color_load_op(m_pso.clear_color[i]));
+                    color_attachment.storeOp                   = m_pso.store_color[i] ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
                     color_attachment.clearValue.color          = { m_pso.clear_color[i].r, m_pso.clear_color[i].g, m_pso.clear_color[i].b, m_pso.clear_color[i].a };
 
                     SP_ASSERT(color_attachment.imageView != nullptr);
@@ -785,10 +818,10 @@ namespace Spartan
             rt->SetLayout(layout, this);
 
             attachment_depth_stencil.sType                           = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
-            attachment_depth_stencil.imageView                       = static_cast<VkImageView>(rt->GetRhiDsv(m_pso.render_target_array_index));
+            attachment_depth_stencil.imageView                       = static_cast<VkImageView>(rendering_info.viewMask != 0 ? rt->GetRhiDsvArray() : rt->GetRhiDsv(m_pso.render_target_array_index));
             attachment_depth_stencil.imageLayout                     = vulkan_image_layout[static_cast<uint8_t>(rt->GetLayout(0))];
-            attachment_depth_stencil.loadOp                          = m_ignore_clear_values ? VK_ATTACHMENT_LOAD_OP_LOAD : get_depth_load_op(m_pso.clear_depth);
-            attachment_depth_stencil.storeOp                         = m_pso.depth_stencil_state->GetDepthWriteEnabled() ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_NONE;
+            attachment_depth_stencil.loadOp                          = count_clear(m_ignore_clear_values ? VK_ATTACHMENT_LOAD_OP_LOAD : get_depth_load_op(m_pso.clear_depth));
+            attachment_depth_stencil.storeOp                         = !m_pso.store_depth ? VK_ATTACHMENT_STORE_OP_DONT_CARE : m_pso.depth_stencil_state->GetDepthWriteEnabled() ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_NONE;
             attachment_depth_stencil.clearValue.depthStencil.depth   = m_pso.clear_depth;
             attachment_depth_stencil.clearValue.depthStencil.stencil = m_pso.clear_stencil;
 
@@ -907,6 +940,7 @@ namespace Spartan
             return;
 
         vkCmdClearAttachments(static_cast<VkCommandBuffer>(m_rhi_resource), attachment_count, attachments.data(), 1, &clear_rect);
+        Profiler::m_rhi_clears += attachment_count;
     }
 
     void RHI_CommandList::ClearTexture(
@@ -959,6 +993,8 @@ namespace Spartan
                 1,
                 &image_subresource_range);
         }
+
+        Profiler::m_rhi_clears++;
     }
 
     void RHI_CommandList::Draw(const uint32_t vertex_count, const uint32_t vertex_start_index /*= 0*/)
@@ -1003,6 +1039,16 @@ namespace Spartan
         vkCmdDispatch(static_cast<VkCommandBuffer>(m_rhi_resource), x, y, z);
     }
 
+    void RHI_CommandList::DispatchIndirect(RHI_Buffer* buffer, const uint32_t offset)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(buffer != nullptr);
+
+        PreDraw();
+
+        vkCmdDispatchIndirect(static_cast<VkCommandBuffer>(m_rhi_resource), static_cast<VkBuffer>(buffer->GetRhiResource()), buffer->GetOffset() + offset);
+    }
+
     void RHI_CommandList::Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips, const float source_scaling)
     {
         SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0,      "The texture needs the RHI_Texture_ClearOrBlit flag");
@@ -1061,6 +1107,7 @@ namespace Spartan
             blit_region_count, &blit_regions[0],
             vulkan_filter[static_cast<uint32_t>(destination->IsDepthFormat() ? RHI_Filter::Nearest : RHI_Filter::Linear)]
         );
+        Profiler::m_rhi_transfers++;
 
         // transition to the initial layouts
         if (blit_mips)
@@ -1128,6 +1175,7 @@ namespace Spartan
             1, &blit_region,
             vulkan_filter[static_cast<uint32_t>(filter)]
         );
+        Profiler::m_rhi_transfers++;
 
         // transition to the initial layouts
         source->SetLayout(source_layout_initial, this);
@@ -1177,6 +1225,7 @@ namespace Spartan
             static_cast<VkImage>(destination->GetRhiResource()), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
             copy_region_count, &copy_regions[0]
         );
+        Profiler::m_rhi_transfers++;
 
         // transition to the initial layouts
         if (blit_mips)
@@ -1224,12 +1273,150 @@ namespace Spartan
             static_cast<VkImage>(destination->GetRhiRt()),  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
             1, &copy_region
         );
+        Profiler::m_rhi_transfers++;
 
         // Transition to the initial layout
         source->SetLayout(layout_initial_source, this);
         destination->SetLayout(RHI_Image_Layout::Present_Source, this);
     }
 
+    void RHI_CommandList::Copy(RHI_Texture* source, RHI_Buffer* destination, const uint64_t destination_offset, const uint32_t mip_index, const uint32_t array_index, const uint32_t x, const uint32_t y, uint32_t width, uint32_t height)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT(mip_index < source->GetMipCount() && array_index < source->GetArrayLength());
+
+        const uint32_t mip_width  = max(1u, source->GetWidth() >> mip_index);
+        const uint32_t mip_height = max(1u, source->GetHeight() >> mip_index);
+        width                     = width  != 0 ? width  : mip_width;
+        height                    = height != 0 ? height : mip_height;
+        SP_ASSERT(x + width <= mip_width && y + height <= mip_height);
+
+        // flush deferred barriers first so that the transition below happens after them
+        InsertPendingBarrierGroup();
+
+        // transition the mip to a transfer layout, the tracked layout is restored afterwards
+        RHI_Image_Layout layout_initial = source->GetLayout(mip_index);
+        InsertBarrierTexture(source, mip_index, 1, source->GetArrayLength(), layout_initial, RHI_Image_Layout::Transfer_Source);
+
+        VkBufferImageCopy region               = {};
+        region.bufferOffset                    = destination_offset;
+        region.bufferRowLength                 = 0; // tightly packed
+        region.bufferImageHeight               = 0;
+        region.imageSubresource.aspectMask     = get_aspect_mask(source, true); // a single aspect can be copied at a time
+        region.imageSubresource.mipLevel       = mip_index;
+        region.imageSubresource.baseArrayLayer = array_index;
+        region.imageSubresource.layerCount     = 1;
+        region.imageOffset                     = { static_cast<int32_t>(x), static_cast<int32_t>(y), 0 };
+        region.imageExtent                     = { width, height, 1 };
+
+        vkCmdCopyImageToBuffer(
+            static_cast<VkCommandBuffer>(m_rhi_resource),
+            static_cast<VkImage>(source->GetRhiResource()), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            static_cast<VkBuffer>(destination->GetRhiResource()),
+            1, &region
+        );
+        Profiler::m_rhi_transfers++;
+
+        // make the copy visible to the cpu
+        memory_barrier::insert(m_rhi_resource, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT);
+
+        InsertBarrierTexture(source, mip_index, 1, source->GetArrayLength(), RHI_Image_Layout::Transfer_Source, layout_initial);
+    }
+
+    void RHI_CommandList::Copy(RHI_Buffer* source, const uint64_t source_offset, RHI_Buffer* destination, const uint64_t destination_offset, const uint64_t size)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(source != nullptr && destination != nullptr);
+        SP_ASSERT(size != 0);
+
+        RenderPassEnd(); // transfers can't happen inside a render pass
+
+        // shader writes become visible to the transfer
+        memory_barrier::insert(m_rhi_resource, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+
+        VkBufferCopy region = {};
+        region.srcOffset    = source_offset;
+        region.dstOffset    = destination_offset;
+        region.size         = size;
+
+        vkCmdCopyBuffer(
+            static_cast<VkCommandBuffer>(m_rhi_resource),
+            static_cast<VkBuffer>(source->GetRhiResource()),
+            static_cast<VkBuffer>(destination->GetRhiResource()),
+            1, &region
+        );
+        Profiler::m_rhi_transfers++;
+
+        // make the copy visible to the cpu
+        memory_barrier::insert(m_rhi_resource, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT);
+    }
+
+    void RHI_CommandList::Copy(RHI_GeometryBuffer* source, const uint32_t element_offset, const uint32_t element_count, RHI_Buffer* destination, const uint64_t destination_offset)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(source != nullptr && destination != nullptr);
+        SP_ASSERT(element_count != 0 && element_offset + element_count <= source->GetElementCount());
+
+        RenderPassEnd(); // transfers can't happen inside a render pass
+
+        // geometry is written by transfers (uploads, copies) and read as vertex/index input, both are ordered before this read
+        memory_barrier::insert(m_rhi_resource, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+
+        VkBufferCopy region = {};
+        region.srcOffset    = static_cast<uint64_t>(element_offset) * source->GetStride();
+        region.dstOffset    = destination_offset;
+        region.size         = static_cast<uint64_t>(element_count) * source->GetStride();
+
+        vkCmdCopyBuffer(
+            static_cast<VkCommandBuffer>(m_rhi_resource),
+            static_cast<VkBuffer>(source->GetRhiResource()),
+            static_cast<VkBuffer>(destination->GetRhiResource()),
+            1, &region
+        );
+        Profiler::m_rhi_transfers++;
+
+        // make the copy visible to the cpu
+        memory_barrier::insert(m_rhi_resource, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT);
+    }
+
+    void RHI_CommandList::Copy(RHI_Buffer* source, const uint64_t source_offset, RHI_GeometryBuffer* destination, const vector<pair<uint32_t, uint32_t>>& ranges)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(source != nullptr && destination != nullptr);
+        SP_ASSERT(!ranges.empty());
+
+        RenderPassEnd(); // transfers can't happen inside a render pass
+
+        vector<VkBufferCopy> regions;
+        regions.reserve(ranges.size());
+        uint64_t offset = source_offset;
+        for (const auto& [element_offset, element_count] : ranges)
+        {
+            SP_ASSERT_MSG(element_offset + element_count <= destination->GetElementCount(), "Copy is out of bounds");
+
+            VkBufferCopy& region = regions.emplace_back();
+            region.srcOffset     = offset;
+            region.dstOffset     = static_cast<uint64_t>(element_offset) * destination->GetStride();
+            region.size          = static_cast<uint64_t>(element_count) * destination->GetStride();
+            offset              += region.size;
+        }
+
+        // earlier submissions may still be drawing with the old contents
+        memory_barrier::insert(m_rhi_resource, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+        vkCmdCopyBuffer(
+            static_cast<VkCommandBuffer>(m_rhi_resource),
+            static_cast<VkBuffer>(source->GetRhiResource()),
+            static_cast<VkBuffer>(destination->GetRhiResource()),
+            static_cast<uint32_t>(regions.size()), regions.data()
+        );
+        Profiler::m_rhi_transfers++;
+
+        // make the copy visible to the draws that follow
+        memory_barrier::insert(m_rhi_resource, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+    }
+
     void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
     {
         SP_ASSERT(m_state == RHI_CommandListState::Recording);
@@ -1496,6 +1683,21 @@ namespace Spartan
         descriptor_sets::bind_dynamic = true;
     }
 
+    void RHI_CommandList::SetBuffer(const uint32_t slot, RHI_GeometryBuffer* buffer) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting buffer \"%s\" within a render pass", buffer->GetObjectName().c_str());
+            return;
+        }
+
+        m_descriptor_layout_current->SetBuffer(slot, buffer);
+
+        descriptor_sets::bind_dynamic = true;
+    }
+
     void RHI_CommandList::BeginMarker(const char* name)
     {
         if (Profiler::IsGpuMarkingEnabled())
@@ -1710,6 +1912,34 @@ namespace Spartan
         InsertBarrierTexture(texture->GetRhiResource(), get_aspect_mask(texture), 0, 1, 1, texture->GetLayout(0), texture->GetLayout(0), texture->IsDsv());
     }
 
+    void RHI_CommandList::InsertBarrierBufferReadWrite(RHI_Buffer* buffer)
+    {
+        SP_ASSERT(buffer != nullptr);
+
+        // compute writes become visible to later compute reads and to indirect arguments
+        VkBufferMemoryBarrier2 barrier = {};
+        barrier.sType                  = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        barrier.srcStageMask           = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barrier.srcAccessMask          = VK_ACCESS_2_SHADER_WRITE_BIT;
+        barrier.dstStageMask           = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+        barrier.dstAccessMask          = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+        barrier.srcQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex    = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer                 = static_cast<VkBuffer>(buffer->GetRhiResource());
+        barrier.offset                 = 0;
+        barrier.size                   = VK_WHOLE_SIZE;
+
+        VkDependencyInfo dependency_info         = {};
+        dependency_info.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+        dependency_info.bufferMemoryBarrierCount = 1;
+        dependency_info.pBufferMemoryBarriers    = &barrier;
+
+        RenderPassEnd();
+        vkCmdPipelineBarrier2(static_cast<VkCommandBuffer>(m_rhi_resource), &dependency_info);
+
+        Profiler::m_rhi_pipeline_barriers++;
+    }
+
     void RHI_CommandList::InsertPendingBarrierGroup()
     {
         if (!m_image_barriers.empty())
@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI_Sampler.h"
 #include "../RHI_ConstantBuffer.h"
 #include "../RHI_Buffer.h"
+#include "../RHI_GeometryBuffer.h"
 #include "../Rendering/Renderer.h"
 //=====================================
 
@@ -153,7 +154,8 @@ namespace Spartan
             }
             else if (descriptor.type == RHI_Descriptor_Type::StructuredBuffer)
             {
-                info_buffers[index].buffer = static_cast<VkBuffer>(static_cast<RHI_Buffer*>(descriptor.data)->GetRhiResource());
+                void* resource             = descriptor.is_geometry_buffer ? static_cast<RHI_GeometryBuffer*>(descriptor.data)->GetRhiResource() : static_cast<RHI_Buffer*>(descriptor.data)->GetRhiResource();
+                info_buffers[index].buffer = static_cast<VkBuffer>(resource);
                 info_buffers[index].offset = 0;
                 info_buffers[index].range  = descriptor.range;
 
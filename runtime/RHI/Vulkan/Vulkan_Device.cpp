@@ -1069,6 +1069,7 @@ namespace Spartan
         VkPhysicalDeviceRobustness2FeaturesEXT features_robustness  = {};
         VkPhysicalDeviceVulkan13Features features_1_3               = {};
         VkPhysicalDeviceVulkan12Features features_1_2               = {};
+        VkPhysicalDeviceVulkan11Features features_1_1               = {};
         VkPhysicalDeviceFragmentShadingRateFeaturesKHR features_vrs = {};
 
         void detect(bool* is_shading_rate_supported)
@@ -1081,8 +1082,10 @@ namespace Spartan
             features_1_3.pNext        = &features_robustness;
             features_1_2.sType        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
             features_1_2.pNext        = &features_1_3;
+            features_1_1.sType        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+            features_1_1.pNext        = &features_1_2;
             features.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-            features.pNext            = &features_1_2;
+            features.pNext            = &features_1_1;
 
             // features which are supported
             VkPhysicalDeviceFragmentShadingRateFeaturesKHR support_vrs = {};
@@ -1096,9 +1099,12 @@ namespace Spartan
             VkPhysicalDeviceVulkan12Features support_1_2               = {};
             support_1_2.sType                                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
             support_1_2.pNext                                          = &support_1_3;
+            VkPhysicalDeviceVulkan11Features support_1_1               = {};
+            support_1_1.sType                                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+            support_1_1.pNext                                          = &support_1_2;
             VkPhysicalDeviceFeatures2 support                          = {};
             support.sType                                              = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-            support.pNext                                              = &support_1_2;
+            support.pNext                                              = &support_1_1;
             vkGetPhysicalDeviceFeatures2(RHI_Context::device_physical, &support);
 
             // check if certain features are supported and enable them
@@ -1157,6 +1163,10 @@ namespace Spartan
                     SP_ASSERT(support_1_2.timelineSemaphore == VK_TRUE);
                     features_1_2.timelineSemaphore = VK_TRUE;
 
+                    // layered rendering of shadow slices in a single pass
+                    SP_ASSERT(support_1_1.multiview == VK_TRUE);
+                    features_1_1.multiview = VK_TRUE;
+
                     // timeline semaphore counter
                     SP_ASSERT(support.features.shaderFloat64 == VK_TRUE);
                     features.features.shaderFloat64 = VK_TRUE;
@@ -1822,11 +1832,11 @@ namespace Spartan
         bool is_buffer_constant      = (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) != 0;
         bool is_buffer_index         = (usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT) != 0;
         bool is_buffer_vertex        = (usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) != 0;
-        bool is_buffer_staging       = (usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) != 0;
         bool is_mappable             = (memory_property_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
         bool is_transfer_source      = (usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) != 0;
         bool is_transfer_destination = (usage & VK_BUFFER_USAGE_TRANSFER_DST_BIT) != 0;
         bool is_transfer_buffer      = is_transfer_source || is_transfer_destination;
+        bool is_buffer_staging       = is_transfer_buffer && is_mappable; // uploads and readbacks, device local buffers can be a copy source too
         bool map_on_creation         = is_buffer_storage || is_buffer_constant || is_buffer_index || is_buffer_vertex;
 
         // Buffer info
@@ -1845,6 +1855,9 @@ namespace Spartan
         if (is_buffer_staging)
         {
             allocation_create_info.flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+
+            // staging rings (RHI_Buffer) stay mapped, one-off staging buffers are mapped on demand
+            allocation_create_info.flags |= map_on_creation ? VMA_ALLOCATION_CREATE_MAPPED_BIT : 0;
         }
         else
         {
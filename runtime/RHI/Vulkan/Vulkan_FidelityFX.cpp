@@ -382,9 +382,10 @@ namespace Spartan
            {
                FfxBrixelizerInstanceDescription desc = {};
                shared_ptr<Renderable> renderable     = entity->GetComponent<Renderable>();
+               const renderable_proxy& proxy         = renderable->GetProxy();
            
                // aabb: world space, pre-transformed
-               const BoundingBox& aabb = renderable->HasInstancing() ? renderable->GetBoundingBox(BoundingBoxType::TransformedInstance, instance_index) : renderable->GetBoundingBox(BoundingBoxType::Transformed);
+               const BoundingBox aabb  = renderable->HasInstancing() ? proxy.bounding_box_mesh.Transform(proxy.transform * proxy.instances[instance_index]) : proxy.bounding_box_transformed;
                desc.aabb.min[0]        = aabb.GetMin().x;
                desc.aabb.min[1]        = aabb.GetMin().y;
                desc.aabb.min[2]        = aabb.GetMin().z;
@@ -393,7 +394,7 @@ namespace Spartan
                desc.aabb.max[2]        = aabb.GetMax().z;
            
                // transform: world space, row-major
-               Matrix transform = renderable->HasInstancing() ? renderable->GetInstanceTransform(instance_index) : entity->GetMatrix();
+               Matrix transform = renderable->HasInstancing() ? proxy.instances[instance_index] : proxy.transform;
                set_ffx_float16(desc.transform, transform);
            
                // vertex buffer
@@ -410,7 +411,7 @@ namespace Spartan
                desc.indexFormat       = (renderable->GetIndexBuffer()->GetStride() == sizeof(uint16_t)) ? FFX_INDEX_TYPE_UINT16 : FFX_INDEX_TYPE_UINT32;
            
                // misc
-               desc.flags           = entity->IsMoving() ? FFX_BRIXELIZER_INSTANCE_FLAG_DYNAMIC : FFX_BRIXELIZER_INSTANCE_FLAG_NONE;
+               desc.flags           = proxy.is_moving ? FFX_BRIXELIZER_INSTANCE_FLAG_DYNAMIC : FFX_BRIXELIZER_INSTANCE_FLAG_NONE;
                uint64_t instance_id = renderable->HasInstancing() ? (entity->GetObjectId() | (static_cast<uint64_t>(instance_index) << 32)) : entity->GetObjectId();
                desc.outInstanceID   = &get_or_create_id(instance_id);
            
@@ -681,7 +682,7 @@ namespace Spartan
             {
                 uint32_t flags = RHI_Texture_Srv | RHI_Texture_Rtv | RHI_Texture_ClearBlit;
                 brixelizer_gi::texture_depth_previous  = make_shared<RHI_Texture2D>(width, height, 1, RHI_Format::D32_Float,          flags, "ffx_depth_previous");
-                brixelizer_gi::texture_normal_previous = make_shared<RHI_Texture2D>(width, height, 1, RHI_Format::R16G16B16A16_Float, flags, "ffx_normal_previous");
+                brixelizer_gi::texture_normal_previous = make_shared<RHI_Texture2D>(width, height, 1, RHI_Format::R10G10B10A2_Unorm,  flags, "ffx_normal_previous");
             }
 
             brixelizer_gi::context_created = true;
@@ -812,9 +813,9 @@ namespace Spartan
             fsr3::description_dispatch.preExposure            = exposure;                    // the exposure value if not using FFX_FSR3_ENABLE_AUTO_EXPOSURE
             fsr3::description_dispatch.renderSize.width       = fsr3::description_reactive_mask.renderSize.width;
             fsr3::description_dispatch.renderSize.height      = fsr3::description_reactive_mask.renderSize.height;
-            fsr3::description_dispatch.cameraNear             = camera->GetFarPlane();       // far as near because we are using reverse-z
-            fsr3::description_dispatch.cameraFar              = camera->GetNearPlane();      // near as far because we are using reverse-z
-            fsr3::description_dispatch.cameraFovAngleVertical = camera->GetFovVerticalRad();
+            fsr3::description_dispatch.cameraNear             = camera->GetProxy().far_plane;  // far as near because we are using reverse-z
+            fsr3::description_dispatch.cameraFar              = camera->GetProxy().near_plane; // near as far because we are using reverse-z
+            fsr3::description_dispatch.cameraFovAngleVertical = camera->GetProxy().fov_vertical_rad;
 
             // dispatch
             SP_ASSERT(ffxFsr3UpscalerContextDispatch(&fsr3::context, &fsr3::description_dispatch) == FFX_OK);
@@ -859,8 +860,8 @@ namespace Spartan
         // set sssr specific parameters
         sssr::description_dispatch.motionVectorScale.x                  = -0.5f; // expects [-0.5, 0.5] range
         sssr::description_dispatch.motionVectorScale.y                  = -0.5f; // expects [-0.5, 0.5] range, +Y as top-down
-        sssr::description_dispatch.normalUnPackMul                      = 1.0f;
-        sssr::description_dispatch.normalUnPackAdd                      = 0.0f;
+        sssr::description_dispatch.normalUnPackMul                      = 2.0f; // gbuffer_normal_unpacked is r10g10b10a2, [0, 1] to [-1, 1]
+        sssr::description_dispatch.normalUnPackAdd                      = -1.0f;
         sssr::description_dispatch.depthBufferThickness                 = 0.08f; // hit acceptance bias, larger values can cause streaks, lower values can cause holes
         sssr::description_dispatch.varianceThreshold                    = 0.0f;  // luminance differences between history results will trigger an additional ray if they are greater than this threshold value
         sssr::description_dispatch.maxTraversalIntersections            = 32;    // caps the maximum number of lookups that are performed from the depth buffer hierarchy, most rays should end after about 20 lookups
@@ -916,17 +917,21 @@ namespace Spartan
                 auto& entity                         = entities[i];
                 uint64_t entity_id                   = entity->GetObjectId();
                 brixelizer_gi::entity_map[entity_id] = entity;
-                bool is_dynamic                      = entity->IsMoving();
+                shared_ptr<Renderable> renderable    = entity->GetComponent<Renderable>();
+                bool is_dynamic                      = renderable->GetProxy().is_moving;
                 auto static_it                       = brixelizer_gi::static_instances.find(entity_id);
                 bool was_static                      = static_it != brixelizer_gi::static_instances.end();
-                shared_ptr<Renderable> renderable    = entity->GetComponent<Renderable>();
 
                 if (is_dynamic)
                 {
                     if (renderable->HasInstancing())
                     {
-                        for (uint32_t instance_index = 0; instance_index < renderable->GetInstanceCount(); instance_index++)
+                        const renderable_proxy& proxy = renderable->GetProxy();
+                        for (uint32_t instance_index = 0; instance_index < static_cast<uint32_t>(proxy.instance_slot_used.size()); instance_index++)
                         {
+                            if (!proxy.instance_slot_used[instance_index])
+                                continue;
+
                             uint64_t instance_id = entity_id | (static_cast<uint64_t>(instance_index) << 32);
                             brixelizer_gi::instances_to_create.push_back(brixelizer_gi::create_instance_description(entity, instance_index));
                             
@@ -961,8 +966,12 @@ namespace Spartan
                 {
                     if (renderable->HasInstancing())
                     {
-                        for (uint32_t instance_index = 0; instance_index < renderable->GetInstanceCount(); instance_index++)
+                        const renderable_proxy& proxy = renderable->GetProxy();
+                        for (uint32_t instance_index = 0; instance_index < static_cast<uint32_t>(proxy.instance_slot_used.size()); instance_index++)
                         {
+                            if (!proxy.instance_slot_used[instance_index])
+                                continue;
+
                             uint64_t instance_id = entity_id | (static_cast<uint64_t>(instance_index) << 32);
                             brixelizer_gi::instances_to_create.push_back(brixelizer_gi::create_instance_description(entity, instance_index));
                             brixelizer_gi::static_instances.insert(instance_id);
@@ -1126,8 +1135,8 @@ namespace Spartan
         brixelizer_gi::description_dispatch_gi.specularSDFSolveEps     = brixelizer_gi::sdf_ray_epsilon;
         brixelizer_gi::description_dispatch_gi.tMin                    = brixelizer_gi::t_min;
         brixelizer_gi::description_dispatch_gi.tMax                    = brixelizer_gi::t_max;
-        brixelizer_gi::description_dispatch_gi.normalsUnpackMul        = 1.0f;                            // a multiply factor to transform the normal to the space expected by brixelizer gi
-        brixelizer_gi::description_dispatch_gi.normalsUnpackAdd        = 0.0f;                            // an offset to transform the normal to the space expected by brixelizer gi
+        brixelizer_gi::description_dispatch_gi.normalsUnpackMul        = 2.0f;                            // a multiply factor to transform the normal to the space expected by brixelizer gi
+        brixelizer_gi::description_dispatch_gi.normalsUnpackAdd        = -1.0f;                           // an offset to transform the normal to the space expected by brixelizer gi
         brixelizer_gi::description_dispatch_gi.isRoughnessPerceptual   = true;                            // if false, we assume roughness squared was stored in the Gbuffer
         brixelizer_gi::description_dispatch_gi.roughnessChannel        = 0;                               // the channel to read the roughness from the roughness texture
         brixelizer_gi::description_dispatch_gi.roughnessThreshold      = 1.0f;                            // regions with a roughness value greater than this threshold won't spawn specular rays
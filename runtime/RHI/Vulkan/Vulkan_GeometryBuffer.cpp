@@ -54,9 +54,16 @@ namespace Spartan
 
         bool vertex                = m_type == RHI_Buffer_Type::Vertex || m_type == RHI_Buffer_Type::Instance;
         VkBufferUsageFlagBits type = vertex ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT : VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-        m_is_mappable              = indices == nullptr;
+        m_is_mappable              = indices == nullptr && !m_is_empty;
 
-        if (m_is_mappable)
+        if (m_is_empty)
+        {
+            // device local, the contents are written later with Update() and can be read back with Read()
+            // storage usage lets shaders fetch geometry directly (visibility buffer resolve)
+            uint32_t usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | type;
+            RHI_Device::MemoryBufferCreate(m_rhi_resource, m_object_size, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr, m_object_name.c_str());
+        }
+        else if (m_is_mappable)
         {
             // define memory properties
             uint32_t flags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT; // mappable
@@ -101,4 +108,112 @@ namespace Spartan
         // set debug name
         RHI_Device::SetResourceName(m_rhi_resource, RHI_Resource_Type::Buffer, m_object_name);
     }
+
+    void RHI_GeometryBuffer::Update(const void* data, const uint32_t element_offset, const uint32_t element_count)
+    {
+        SP_ASSERT(m_rhi_resource != nullptr);
+        SP_ASSERT(data != nullptr && element_count != 0);
+        SP_ASSERT_MSG(element_offset + element_count <= m_element_count, "Update is out of bounds");
+
+        const uint64_t size = static_cast<uint64_t>(element_count) * m_stride;
+
+        // create staging/source buffer and copy the data to it
+        void* staging_buffer = nullptr;
+        RHI_Device::MemoryBufferCreate(staging_buffer, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, data, m_object_name.c_str());
+
+        // copy staging buffer to the requested range of the destination buffer
+        {
+            RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Copy);
+
+            VkBufferCopy copy_region = {};
+            copy_region.dstOffset    = static_cast<uint64_t>(element_offset) * m_stride;
+            copy_region.size         = size;
+            vkCmdCopyBuffer(static_cast<VkCommandBuffer>(cmd_list->GetRhiResource()), static_cast<VkBuffer>(staging_buffer), static_cast<VkBuffer>(m_rhi_resource), 1, &copy_region);
+
+            RHI_Device::CmdImmediateSubmit(cmd_list);
+        }
+
+        RHI_Device::MemoryBufferDestroy(staging_buffer);
+    }
+
+    void RHI_GeometryBuffer::Update(const void* data, const vector<pair<uint32_t, uint32_t>>& ranges)
+    {
+        SP_ASSERT(m_rhi_resource != nullptr);
+        SP_ASSERT(data != nullptr && !ranges.empty());
+
+        // one staging buffer and one copy command for all the ranges
+        vector<VkBufferCopy> copy_regions;
+        copy_regions.reserve(ranges.size());
+        uint64_t size = 0;
+        for (const auto& [element_offset, element_count] : ranges)
+        {
+            SP_ASSERT_MSG(element_offset + element_count <= m_element_count, "Update is out of bounds");
+
+            VkBufferCopy& copy_region = copy_regions.emplace_back();
+            copy_region.srcOffset     = size;
+            copy_region.dstOffset     = static_cast<uint64_t>(element_offset) * m_stride;
+            copy_region.size          = static_cast<uint64_t>(element_count) * m_stride;
+            size                     += copy_region.size;
+        }
+
+        void* staging_buffer = nullptr;
+        RHI_Device::MemoryBufferCreate(staging_buffer, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, data, m_object_name.c_str());
+
+        {
+            RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Copy);
+            vkCmdCopyBuffer(static_cast<VkCommandBuffer>(cmd_list->GetRhiResource()), static_cast<VkBuffer>(staging_buffer), static_cast<VkBuffer>(m_rhi_resource), static_cast<uint32_t>(copy_regions.size()), copy_regions.data());
+            RHI_Device::CmdImmediateSubmit(cmd_list);
+        }
+
+        RHI_Device::MemoryBufferDestroy(staging_buffer);
+    }
+
+    void RHI_GeometryBuffer::Copy(const RHI_GeometryBuffer* source, const uint32_t element_count)
+    {
+        SP_ASSERT(m_rhi_resource != nullptr && m_is_empty);
+        SP_ASSERT(source != nullptr && source->m_rhi_resource != nullptr && source->m_is_empty);
+        SP_ASSERT(source->m_stride == m_stride && element_count != 0);
+        SP_ASSERT_MSG(element_count <= m_element_count && element_count <= source->m_element_count, "Copy is out of bounds");
+
+        RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Copy);
+
+        VkBufferCopy copy_region = {};
+        copy_region.size         = static_cast<uint64_t>(element_count) * m_stride;
+        vkCmdCopyBuffer(static_cast<VkCommandBuffer>(cmd_list->GetRhiResource()), static_cast<VkBuffer>(source->m_rhi_resource), static_cast<VkBuffer>(m_rhi_resource), 1, &copy_region);
+
+        RHI_Device::CmdImmediateSubmit(cmd_list);
+    }
+
+    void RHI_GeometryBuffer::Read(void* data, const uint32_t element_offset, const uint32_t element_count) const
+    {
+        SP_ASSERT(m_rhi_resource != nullptr && m_is_empty);
+        SP_ASSERT(data != nullptr && element_count != 0);
+        SP_ASSERT_MSG(element_offset + element_count <= m_element_count, "Read is out of bounds");
+
+        const uint64_t size = static_cast<uint64_t>(element_count) * m_stride;
+
+        // create a host visible destination buffer
+        void* readback_buffer = nullptr;
+        RHI_Device::MemoryBufferCreate(readback_buffer, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, nullptr, m_object_name.c_str());
+
+        // copy the requested range to it
+        {
+            RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Copy);
+
+            VkBufferCopy copy_region = {};
+            copy_region.srcOffset    = static_cast<uint64_t>(element_offset) * m_stride;
+            copy_region.size         = size;
+            vkCmdCopyBuffer(static_cast<VkCommandBuffer>(cmd_list->GetRhiResource()), static_cast<VkBuffer>(m_rhi_resource), static_cast<VkBuffer>(readback_buffer), 1, &copy_region);
+
+            RHI_Device::CmdImmediateSubmit(cmd_list);
+        }
+
+        // copy to the cpu
+        void* mapped_data = nullptr;
+        RHI_Device::MemoryMap(readback_buffer, mapped_data);
+        memcpy(data, mapped_data, size);
+        RHI_Device::MemoryUnmap(readback_buffer);
+
+        RHI_Device::MemoryBufferDestroy(readback_buffer);
+    }
 }
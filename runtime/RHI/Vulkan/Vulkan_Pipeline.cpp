@@ -417,6 +417,7 @@ namespace Spartan
                     pipeline_rendering_create_info.pColorAttachmentFormats = attachment_formats_color.data();
                     pipeline_rendering_create_info.depthAttachmentFormat   = attachment_format_depth;
                     pipeline_rendering_create_info.stencilAttachmentFormat = attachment_format_stencil;
+                    pipeline_rendering_create_info.viewMask                = m_state.render_target_view_count > 1 ? (1U << m_state.render_target_view_count) - 1 : 0;
                 }
 
                 // create
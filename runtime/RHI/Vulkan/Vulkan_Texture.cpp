@@ -357,6 +357,20 @@ namespace Spartan
                         create_image_view(m_rhi_resource, m_rhi_dsv[i], this, ResourceType::Texture2d, i, 1, 0, 1, true, false);
                     }
                 }
+
+                // arrays can also be rendered on all at once, with multiview
+                if (m_resource_type == ResourceType::Texture2dArray && m_array_length > 1)
+                {
+                    if (IsRtv())
+                    {
+                        create_image_view(m_rhi_resource, m_rhi_rtv_array, this, ResourceType::Texture2dArray, 0, m_array_length, 0, 1, false, false);
+                    }
+
+                    if (IsDsv())
+                    {
+                        create_image_view(m_rhi_resource, m_rhi_dsv_array, this, ResourceType::Texture2dArray, 0, m_array_length, 0, 1, true, false);
+                    }
+                }
             }
             else
             {
@@ -390,6 +404,12 @@ namespace Spartan
                 RHI_Device::DeletionQueueAdd(RHI_Resource_Type::TextureView, m_rhi_rtv[i]);
                 m_rhi_rtv[i] = nullptr;
             }
+
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::TextureView, m_rhi_rtv_array);
+            m_rhi_rtv_array = nullptr;
+
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::TextureView, m_rhi_dsv_array);
+            m_rhi_dsv_array = nullptr;
         }
 
         if (destroy_per_view)
@@ -159,11 +159,13 @@ namespace Spartan
         }
 
         // store the generated data for this text
+        lock_guard lock(m_mutex_text_data);
         m_text_data.emplace_back(vertices, indices, position);
     }
 
     bool Font::HasText() const
     {
+        lock_guard lock(m_mutex_text_data);
         return !m_text_data.empty();
     }
 
@@ -176,6 +178,9 @@ namespace Spartan
     {
         SP_ASSERT(m_vertex_buffer && m_index_buffer);
 
+        // text can be added from the main thread while the render thread is here
+        lock_guard lock(m_mutex_text_data);
+
         if (m_text_data.empty())
             return;
 
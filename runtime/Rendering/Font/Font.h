@@ -121,6 +121,7 @@ namespace Spartan
         uint32_t m_char_max_height;
         std::unordered_map<uint32_t, Glyph> m_glyphs;
         std::vector<TextData> m_text_data;
+        mutable std::mutex m_mutex_text_data;
         std::shared_ptr<RHI_GeometryBuffer> m_vertex_buffer;
         std::shared_ptr<RHI_GeometryBuffer> m_index_buffer;
         std::shared_ptr<RHI_Texture> m_atlas;
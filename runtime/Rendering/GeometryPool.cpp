@@ -0,0 +1,268 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ===========================
+#include "pch.h"
+#include "GeometryPool.h"
+#include "../RHI/RHI_GeometryBuffer.h"
+#include "../RHI/RHI_Vertex.h"
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        struct page
+        {
+            shared_ptr<RHI_GeometryBuffer> buffer;
+            map<uint32_t, uint32_t> free_ranges; // offset -> count, sorted so that neighbours can be merged
+            uint32_t capacity = 0;
+            uint32_t used     = 0;
+        };
+
+        // default page sizes, geometry that doesn't fit gets a page of its own
+        const uint32_t page_size_vertices = 1024 * 1024;       // 44 MB
+        const uint32_t page_size_indices  = 4 * 1024 * 1024;   // 8 MB (16-bit) or 16 MB (32-bit)
+
+        array<vector<page>, static_cast<uint32_t>(GeometryPool_Type::Max)> pages;
+        vector<geometry_allocation> pending_frees;
+        mutex mutex_pool;
+
+        uint32_t get_stride(const GeometryPool_Type type)
+        {
+            if (type == GeometryPool_Type::Vertex)
+                return static_cast<uint32_t>(sizeof(RHI_Vertex_PosTexNorTan));
+
+            return type == GeometryPool_Type::Index16 ? static_cast<uint32_t>(sizeof(uint16_t)) : static_cast<uint32_t>(sizeof(uint32_t));
+        }
+
+        page& create_page(const GeometryPool_Type type, const uint32_t element_count)
+        {
+            vector<page>& type_pages = pages[static_cast<uint32_t>(type)];
+            const uint32_t page_size = type == GeometryPool_Type::Vertex ? page_size_vertices : page_size_indices;
+            const string name        = string("geometry_pool_") + (type == GeometryPool_Type::Vertex ? "vertex_" : "index_") + to_string(type_pages.size());
+
+            page& new_page    = type_pages.emplace_back();
+            new_page.capacity = max(page_size, element_count);
+
+            if (type == GeometryPool_Type::Vertex)
+            {
+                new_page.buffer = make_shared<RHI_GeometryBuffer>(RHI_Buffer_Type::Vertex, false, name.c_str());
+                new_page.buffer->CreateEmpty<RHI_Vertex_PosTexNorTan>(new_page.capacity);
+            }
+            else if (type == GeometryPool_Type::Index16)
+            {
+                new_page.buffer = make_shared<RHI_GeometryBuffer>(RHI_Buffer_Type::Index, false, name.c_str());
+                new_page.buffer->CreateEmpty<uint16_t>(new_page.capacity);
+            }
+            else
+            {
+                new_page.buffer = make_shared<RHI_GeometryBuffer>(RHI_Buffer_Type::Index, false, name.c_str());
+                new_page.buffer->CreateEmpty<uint32_t>(new_page.capacity);
+            }
+
+            new_page.free_ranges.emplace(0, new_page.capacity);
+
+            return new_page;
+        }
+
+        bool allocate_from_page(page& p, const uint32_t element_count, uint32_t* offset_out)
+        {
+            // first fit
+            for (auto it = p.free_ranges.begin(); it != p.free_ranges.end(); it++)
+            {
+                if (it->second < element_count)
+                    continue;
+
+                *offset_out               = it->first;
+                const uint32_t remaining  = it->second - element_count;
+                p.free_ranges.erase(it);
+                if (remaining > 0)
+                {
+                    p.free_ranges.emplace(*offset_out + element_count, remaining);
+                }
+
+                p.used += element_count;
+                return true;
+            }
+
+            return false;
+        }
+
+        void free_to_page(page& p, const uint32_t offset, const uint32_t count)
+        {
+            auto it = p.free_ranges.emplace(offset, count).first;
+
+            // merge with the next range
+            auto it_next = next(it);
+            if (it_next != p.free_ranges.end() && it->first + it->second == it_next->first)
+            {
+                it->second += it_next->second;
+                p.free_ranges.erase(it_next);
+            }
+
+            // merge with the previous range
+            if (it != p.free_ranges.begin())
+            {
+                auto it_previous = prev(it);
+                if (it_previous->first + it_previous->second == it->first)
+                {
+                    it_previous->second += it->second;
+                    p.free_ranges.erase(it);
+                }
+            }
+
+            p.used -= count;
+        }
+    }
+
+    void GeometryPool::Shutdown()
+    {
+        lock_guard lock(mutex_pool);
+
+        pending_frees.clear();
+        for (vector<page>& type_pages : pages)
+        {
+            type_pages.clear();
+        }
+    }
+
+    geometry_allocation GeometryPool::Allocate(const GeometryPool_Type type, const void* data, const uint32_t element_count)
+    {
+        SP_ASSERT(type != GeometryPool_Type::Max);
+        SP_ASSERT(data != nullptr && element_count != 0);
+
+        geometry_allocation allocation;
+        allocation.type  = type;
+        allocation.count = element_count;
+
+        {
+            lock_guard lock(mutex_pool);
+
+            vector<page>& type_pages = pages[static_cast<uint32_t>(type)];
+            bool found               = false;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(type_pages.size()) && !found; i++)
+            {
+                if (allocate_from_page(type_pages[i], element_count, &allocation.offset))
+                {
+                    allocation.page = i;
+                    found           = true;
+                }
+            }
+
+            if (!found)
+            {
+                allocation.page = static_cast<uint32_t>(type_pages.size());
+                allocate_from_page(create_page(type, element_count), element_count, &allocation.offset);
+            }
+
+            allocation.buffer = type_pages[allocation.page].buffer.get();
+        }
+
+        // the range is owned by the caller now, so the upload can happen outside of the lock
+        allocation.buffer->Update(data, allocation.offset, element_count);
+
+        return allocation;
+    }
+
+    void GeometryPool::Free(geometry_allocation& allocation)
+    {
+        if (!allocation.IsValid())
+            return;
+
+        lock_guard lock(mutex_pool);
+
+        // the pool might have already been shut down
+        if (allocation.page < pages[static_cast<uint32_t>(allocation.type)].size())
+        {
+            pending_frees.emplace_back(allocation);
+        }
+
+        allocation = geometry_allocation();
+    }
+
+    bool GeometryPool::HasPendingFrees()
+    {
+        lock_guard lock(mutex_pool);
+        return !pending_frees.empty();
+    }
+
+    void GeometryPool::ReleasePendingFrees()
+    {
+        lock_guard lock(mutex_pool);
+
+        for (const geometry_allocation& allocation : pending_frees)
+        {
+            free_to_page(pages[static_cast<uint32_t>(allocation.type)][allocation.page], allocation.offset, allocation.count);
+        }
+        pending_frees.clear();
+    }
+
+    uint32_t GeometryPool::GetPageCount()
+    {
+        lock_guard lock(mutex_pool);
+
+        uint32_t count = 0;
+        for (const vector<page>& type_pages : pages)
+        {
+            count += static_cast<uint32_t>(type_pages.size());
+        }
+
+        return count;
+    }
+
+    uint64_t GeometryPool::GetMemoryAllocated()
+    {
+        lock_guard lock(mutex_pool);
+
+        uint64_t size = 0;
+        for (uint32_t type = 0; type < static_cast<uint32_t>(GeometryPool_Type::Max); type++)
+        {
+            for (const page& p : pages[type])
+            {
+                size += static_cast<uint64_t>(p.capacity) * get_stride(static_cast<GeometryPool_Type>(type));
+            }
+        }
+
+        return size;
+    }
+
+    uint64_t GeometryPool::GetMemoryUsed()
+    {
+        lock_guard lock(mutex_pool);
+
+        uint64_t size = 0;
+        for (uint32_t type = 0; type < static_cast<uint32_t>(GeometryPool_Type::Max); type++)
+        {
+            for (const page& p : pages[type])
+            {
+                size += static_cast<uint64_t>(p.used) * get_stride(static_cast<GeometryPool_Type>(type));
+            }
+        }
+
+        return size;
+    }
+}
@@ -0,0 +1,73 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES =====================
+#include "../Core/Definitions.h"
+//================================
+
+namespace Spartan
+{
+    class RHI_GeometryBuffer;
+
+    enum class GeometryPool_Type
+    {
+        Vertex,
+        Index16,
+        Index32,
+        Max
+    };
+
+    // a range within one of the pool's pages
+    struct geometry_allocation
+    {
+        RHI_GeometryBuffer* buffer = nullptr;
+        GeometryPool_Type type     = GeometryPool_Type::Max;
+        uint32_t page              = 0;
+        uint32_t offset            = 0; // in elements
+        uint32_t count             = 0; // in elements
+
+        bool IsValid() const { return buffer != nullptr; }
+    };
+
+    // geometry of all meshes lives in a few large device local buffers (pages), so
+    // that the renderer can draw most of the scene with a single vertex and index binding
+    class GeometryPool
+    {
+    public:
+        static void Shutdown();
+
+        // allocates a range and uploads the data to it, a page is created if none can fit it
+        static geometry_allocation Allocate(const GeometryPool_Type type, const void* data, const uint32_t element_count);
+
+        // the range is only reusable after ReleasePendingFrees(), since the gpu might still be reading it
+        static void Free(geometry_allocation& allocation);
+        static bool HasPendingFrees();
+        static void ReleasePendingFrees();
+
+        // stats
+        static uint32_t GetPageCount();
+        static uint64_t GetMemoryAllocated();
+        static uint64_t GetMemoryUsed();
+    };
+}
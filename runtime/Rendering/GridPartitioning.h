@@ -24,7 +24,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===============
 #include <unordered_map>
 #include "../Math/Vector3.h"
-#include "../Math/Matrix.h"
 //==========================
 
 namespace grid_partitioning
@@ -73,27 +72,10 @@ namespace grid_partitioning
         }
     };
 
-    void reorder_instances_into_cell_chunks(std::vector<Spartan::Math::Matrix>& instance_transforms, std::vector<uint32_t>& cell_end_indices)
+    // packs the cell key into 64 bits, 21 bits per axis, which covers far more than any world we load
+    inline uint64_t get_cell(const Spartan::Math::Vector3& position)
     {
-        // populate the grid map
-        std::unordered_map<GridKey, std::vector<Spartan::Math::Matrix>, GridKeyHash> grid_map;
-        for (const auto& instance : instance_transforms)
-        {
-            Spartan::Math::Vector3 position = instance.GetTranslation();
-
-            GridKey key = GridKeyHash::get_key(position);
-            grid_map[key].push_back(instance);
-        }
-
-        // reorder instances based on grid map
-        instance_transforms.clear();
-        cell_end_indices.clear();
-        uint32_t index = 0;
-        for (const auto& [key, transforms] : grid_map)
-        {
-            instance_transforms.insert(instance_transforms.end(), transforms.begin(), transforms.end());
-            index += static_cast<uint32_t>(transforms.size());
-            cell_end_indices.push_back(index);
-        }
+        GridKey key = GridKeyHash::get_key(position);
+        return (static_cast<uint64_t>(key.x & 0x1FFFFF)) | (static_cast<uint64_t>(key.y & 0x1FFFFF) << 21) | (static_cast<uint64_t>(key.z & 0x1FFFFF) << 42);
     }
 }
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_Texture2D.h"
 #include "../RHI/RHI_TextureCube.h"
 #include "../World/World.h"
+#include "../IO/FileStream.h"
 SP_WARNINGS_OFF
 #include "../IO/pugixml.hpp"
 SP_WARNINGS_ON
@@ -152,6 +153,20 @@ namespace Spartan
     {
         SetResourceFilePath(file_path);
 
+        vector<byte> data;
+        SaveToMemory(&data);
+
+        auto file = make_unique<FileStream>(file_path, FileStream_Write);
+        if (!file->IsOpen())
+            return false;
+
+        file->Write(data.data(), data.size());
+
+        return true;
+    }
+
+    bool Material::SaveToMemory(vector<byte>* data)
+    {
         pugi::xml_document doc;
         pugi::xml_node materialNode = doc.append_child("Material");
 
@@ -176,7 +191,13 @@ namespace Spartan
             textureNode.append_attribute("texture_path").set_value(m_textures[i] ? m_textures[i]->GetResourceFilePathNative().c_str() : "");
         }
 
-        return doc.save_file(file_path.c_str());
+        ostringstream stream;
+        doc.save(stream);
+        const string xml  = stream.str();
+        const byte* begin = reinterpret_cast<const byte*>(xml.data());
+        data->assign(begin, begin + xml.size());
+
+        return true;
     }
 
     void Material::SetTexture(const MaterialTexture texture_type, RHI_Texture* texture)
@@ -100,6 +100,7 @@ namespace Spartan
         // iresource
         bool LoadFromFile(const std::string& file_path) override;
         bool SaveToFile(const std::string& file_path) override;
+        bool SaveToMemory(std::vector<std::byte>* data) override;
 
         // textures
         void SetTexture(const MaterialTexture texture_type, RHI_Texture* texture);
@@ -42,6 +42,31 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+    namespace
+    {
+        void read_indices(const geometry_allocation& allocation, const uint32_t offset, const uint32_t count, vector<uint32_t>* indices)
+        {
+            indices->resize(count);
+
+            if (allocation.type == GeometryPool_Type::Index16)
+            {
+                vector<uint16_t> indices_16(count);
+                allocation.buffer->Read(indices_16.data(), allocation.offset + offset, count);
+                copy(indices_16.begin(), indices_16.end(), indices->begin());
+            }
+            else
+            {
+                allocation.buffer->Read(indices->data(), allocation.offset + offset, count);
+            }
+        }
+
+        void read_vertices(const geometry_allocation& allocation, const uint32_t offset, const uint32_t count, vector<RHI_Vertex_PosTexNorTan>* vertices)
+        {
+            vertices->resize(count);
+            allocation.buffer->Read(vertices->data(), allocation.offset + offset, count);
+        }
+    }
+
     Mesh::Mesh() : IResource(ResourceType::Mesh)
     {
         m_flags = GetDefaultFlags();
@@ -49,8 +74,8 @@ namespace Spartan
 
     Mesh::~Mesh()
     {
-        m_index_buffer  = nullptr;
-        m_vertex_buffer = nullptr;
+        GeometryPool::Free(m_index_allocation);
+        GeometryPool::Free(m_vertex_allocation);
     }
 
     void Mesh::Clear()
@@ -100,10 +125,10 @@ namespace Spartan
 
         // compute memory usage
         {
-            if (m_vertex_buffer && m_index_buffer)
+            if (m_vertex_allocation.IsValid() && m_index_allocation.IsValid())
             {
-                m_object_size = m_vertex_buffer->GetObjectSize();
-                m_object_size += m_index_buffer->GetObjectSize();
+                m_object_size  = static_cast<uint64_t>(m_vertex_allocation.count) * m_vertex_allocation.buffer->GetStride();
+                m_object_size += static_cast<uint64_t>(m_index_allocation.count)  * m_index_allocation.buffer->GetStride();
             }
         }
 
@@ -114,19 +139,37 @@ namespace Spartan
 
     bool Mesh::SaveToFile(const string& file_path)
     {
+        // serialize before opening, the data might have to be re-read from this very file
+        vector<byte> data;
+        if (!SaveToMemory(&data))
+            return false;
+
         auto file = make_unique<FileStream>(file_path, FileStream_Write);
         if (!file->IsOpen())
             return false;
 
-        file->Write(GetResourceFilePath());
-        file->Write(m_indices);
-        file->Write(m_vertices);
-
+        file->Write(data.data(), data.size());
         file->Close();
 
         return true;
     }
 
+    bool Mesh::SaveToMemory(vector<byte>* data)
+    {
+        AddCpuDataUser();
+
+        FileStream stream;
+        stream.Write(GetResourceFilePath());
+        stream.Write(m_indices);
+        stream.Write(m_vertices);
+
+        RemoveCpuDataUser();
+
+        *data = stream.GetData();
+
+        return true;
+    }
+
     uint32_t Mesh::GetMemoryUsage() const
     {
         uint32_t size = 0;
@@ -136,30 +179,28 @@ namespace Spartan
         return size;
     }
 
-    void Mesh::GetGeometry(uint32_t index_offset, uint32_t index_count, uint32_t vertex_offset, uint32_t vertex_count, vector<uint32_t>* indices, vector<RHI_Vertex_PosTexNorTan>* vertices)
+    geometry_view Mesh::GetGeometryView(const uint32_t index_offset, const uint32_t index_count, const uint32_t vertex_offset, const uint32_t vertex_count) const
     {
-        SP_ASSERT_MSG(indices != nullptr || vertices != nullptr, "Indices and vertices vectors can't both be null");
+        geometry_view view;
 
-        if (indices)
+        if (!IsCpuDataResident())
         {
-            SP_ASSERT_MSG(index_count != 0, "Index count can't be 0");
-
-            const auto index_first = m_indices.begin() + index_offset;
-            const auto index_last  = m_indices.begin() + index_offset + index_count;
-            *indices               = vector<uint32_t>(index_first, index_last);
+            SP_LOG_WARNING("The cpu data of \"%s\" is not resident, register as a user first", m_object_name.c_str());
+            return view;
         }
 
-        if (vertices)
-        {
-            SP_ASSERT_MSG(vertex_count != 0, "Index count can't be 0");
+        SP_ASSERT_MSG(index_offset + index_count <= m_indices.size(), "Index range is out of bounds");
+        SP_ASSERT_MSG(vertex_offset + vertex_count <= m_vertices.size(), "Vertex range is out of bounds");
 
-            const auto vertex_first = m_vertices.begin() + vertex_offset;
-            const auto vertex_last  = m_vertices.begin() + vertex_offset + vertex_count;
-            *vertices               = vector<RHI_Vertex_PosTexNorTan>(vertex_first, vertex_last);
-        }
+        view.indices       = span<const uint32_t>(m_indices.data() + index_offset, index_count);
+        view.vertices      = span<const RHI_Vertex_PosTexNorTan>(m_vertices.data() + vertex_offset, vertex_count);
+        view.index_offset  = index_offset;
+        view.vertex_offset = vertex_offset;
+
+        return view;
     }
 
-    void Mesh::AddVertices(const vector<RHI_Vertex_PosTexNorTan>& vertices, uint32_t* vertex_offset_out /*= nullptr*/)
+    void Mesh::AddVertices(span<const RHI_Vertex_PosTexNorTan> vertices, uint32_t* vertex_offset_out /*= nullptr*/)
     {
         lock_guard lock(m_mutex_vertices);
 
@@ -171,7 +212,7 @@ namespace Spartan
         m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
     }
 
-    void Mesh::AddIndices(const vector<uint32_t>& indices, uint32_t* index_offset_out /*= nullptr*/)
+    void Mesh::AddIndices(span<const uint32_t> indices, uint32_t* index_offset_out /*= nullptr*/)
     {
         lock_guard lock(m_mutex_vertices);
 
@@ -185,12 +226,70 @@ namespace Spartan
 
     uint32_t Mesh::GetVertexCount() const
     {
-        return static_cast<uint32_t>(m_vertices.size());
+        // once the cpu data is released, the gpu copy is what's left
+        return m_vertices.empty() ? m_vertex_allocation.count : static_cast<uint32_t>(m_vertices.size());
     }
 
     uint32_t Mesh::GetIndexCount() const
     {
-        return static_cast<uint32_t>(m_indices.size());
+        return m_indices.empty() ? m_index_allocation.count : static_cast<uint32_t>(m_indices.size());
+    }
+
+    void Mesh::AddCpuDataUser()
+    {
+        lock_guard lock(m_mutex_vertices);
+
+        m_cpu_data_users++;
+        RestoreCpuData();
+    }
+
+    void Mesh::RemoveCpuDataUser()
+    {
+        {
+            lock_guard lock(m_mutex_vertices);
+
+            SP_ASSERT(m_cpu_data_users > 0);
+            m_cpu_data_users--;
+        }
+
+        ReleaseCpuData();
+    }
+
+    void Mesh::RestoreCpuData()
+    {
+        if (!m_vertices.empty() || !m_vertex_allocation.IsValid() || !m_index_allocation.IsValid())
+            return;
+
+        // prefer the engine file, it's cheaper than a gpu round trip
+        const string& file_path = GetResourceFilePathNative();
+        if (FileSystem::GetExtensionFromFilePath(file_path) == EXTENSION_MODEL && FileSystem::Exists(file_path))
+        {
+            auto file = make_unique<FileStream>(file_path, FileStream_Read);
+            if (file->IsOpen())
+            {
+                file->ReadAs<string>();
+                file->Read(&m_indices);
+                file->Read(&m_vertices);
+
+                // the file could be from an older version of this mesh
+                if (m_indices.size() == m_index_allocation.count && m_vertices.size() == m_vertex_allocation.count)
+                    return;
+            }
+        }
+
+        read_indices(m_index_allocation, 0, m_index_allocation.count, &m_indices);
+        read_vertices(m_vertex_allocation, 0, m_vertex_allocation.count, &m_vertices);
+    }
+
+    void Mesh::ReleaseCpuData()
+    {
+        lock_guard lock(m_mutex_vertices);
+
+        // only release if there is a gpu copy to restore from
+        if (m_cpu_data_users != 0 || !m_vertex_allocation.IsValid() || !m_index_allocation.IsValid())
+            return;
+
+        Clear();
     }
 
     void Mesh::ComputeAabb()
@@ -254,12 +353,28 @@ namespace Spartan
     void Mesh::CreateGpuBuffers()
     {
         SP_ASSERT_MSG(!m_indices.empty(), "There are no indices");
-        m_index_buffer = make_shared<RHI_GeometryBuffer>(RHI_Buffer_Type::Index, false, (string("mesh_index_buffer_") + m_object_name).c_str());
-        m_index_buffer->Create(m_indices);
-
         SP_ASSERT_MSG(!m_vertices.empty(), "There are no vertices");
-        m_vertex_buffer = make_shared<RHI_GeometryBuffer>(RHI_Buffer_Type::Vertex, false, (string("mesh_vertex_buffer_") + m_object_name).c_str());
-        m_vertex_buffer->Create(m_vertices);
+
+        // release any previous ranges, meshes like terrain tiles can be re-created
+        GeometryPool::Free(m_index_allocation);
+        GeometryPool::Free(m_vertex_allocation);
+
+        // indices are relative to the vertex offset of each sub-mesh, so most meshes fit in 16 bits
+        uint32_t index_max = *max_element(m_indices.begin(), m_indices.end());
+        if (index_max < numeric_limits<uint16_t>::max())
+        {
+            vector<uint16_t> indices(m_indices.begin(), m_indices.end());
+            m_index_allocation = GeometryPool::Allocate(GeometryPool_Type::Index16, indices.data(), static_cast<uint32_t>(indices.size()));
+        }
+        else
+        {
+            m_index_allocation = GeometryPool::Allocate(GeometryPool_Type::Index32, m_indices.data(), static_cast<uint32_t>(m_indices.size()));
+        }
+
+        m_vertex_allocation = GeometryPool::Allocate(GeometryPool_Type::Vertex, m_vertices.data(), static_cast<uint32_t>(m_vertices.size()));
+
+        // the cpu copy is no longer needed by the renderer
+        ReleaseCpuData();
     }
 
     void Mesh::SetMaterial(shared_ptr<Material>& material, Entity* entity) const
@@ -23,10 +23,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =====================
 #include <vector>
+#include <span>
+#include <memory>
 #include "Material.h"
 #include "../Resource/IResource.h"
 #include "../Math/BoundingBox.h"
 #include "../RHI/RHI_Vertex.h"
+#include "GeometryPool.h"
 //================================
 
 namespace Spartan
@@ -54,7 +57,29 @@ namespace Spartan
         Max
     };
 
-    class Mesh : public IResource
+    // read-only view of a range of a mesh's cpu data, nothing is copied, so it's only valid
+    // while the data is resident (see Mesh::AddCpuDataUser()) and the mesh is not modified
+    struct geometry_view
+    {
+        std::span<const uint32_t> indices;                 // relative to the first vertex of the view
+        std::span<const RHI_Vertex_PosTexNorTan> vertices;
+        uint32_t index_offset  = 0;                        // where the range starts within the mesh
+        uint32_t vertex_offset = 0;                        // where the range starts within the mesh
+
+        bool IsEmpty() const              { return indices.empty() || vertices.empty(); }
+        uint32_t GetTriangleCount() const { return static_cast<uint32_t>(indices.size() / 3); }
+
+        // strided position stream, for consumers that only need positions
+        const float* GetPositions() const                  { return vertices.empty() ? nullptr : vertices.front().pos; }
+        static constexpr uint32_t GetPositionStride()      { return static_cast<uint32_t>(sizeof(RHI_Vertex_PosTexNorTan)); }
+        Math::Vector3 GetPosition(const uint32_t i) const
+        {
+            const float* pos = vertices[indices[i]].pos;
+            return Math::Vector3(pos[0], pos[1], pos[2]);
+        }
+    };
+
+    class Mesh : public IResource, public std::enable_shared_from_this<Mesh>
     {
     public:
         Mesh();
@@ -63,22 +88,16 @@ namespace Spartan
         // iresource
         bool LoadFromFile(const std::string& file_path) override;
         bool SaveToFile(const std::string& file_path) override;
+        bool SaveToMemory(std::vector<std::byte>* data) override;
 
         // geometry
         void Clear();
-        void GetGeometry(
-            uint32_t indexOffset,
-            uint32_t indexCount,
-            uint32_t vertexOffset,
-            uint32_t vertexCount,
-            std::vector<uint32_t>* indices,
-            std::vector<RHI_Vertex_PosTexNorTan>* vertices
-        );
+        geometry_view GetGeometryView(const uint32_t index_offset, const uint32_t index_count, const uint32_t vertex_offset, const uint32_t vertex_count) const;
         uint32_t GetMemoryUsage() const;
 
         // add geometry
-        void AddVertices(const std::vector<RHI_Vertex_PosTexNorTan>& vertices, uint32_t* vertex_offset_out = nullptr);
-        void AddIndices(const std::vector<uint32_t>& indices, uint32_t* index_offset_out = nullptr);
+        void AddVertices(std::span<const RHI_Vertex_PosTexNorTan> vertices, uint32_t* vertex_offset_out = nullptr);
+        void AddIndices(std::span<const uint32_t> indices, uint32_t* index_offset_out = nullptr);
 
         // get geometry
         std::vector<RHI_Vertex_PosTexNorTan>& GetVertices() { return m_vertices; }
@@ -88,14 +107,23 @@ namespace Spartan
         uint32_t GetVertexCount() const;
         uint32_t GetIndexCount() const;
 
+        // cpu data residency - the cpu copy is released once the gpu buffers are created, unless
+        // a user needs it resident, in which case it's re-read from the engine file or the gpu
+        void AddCpuDataUser();
+        void RemoveCpuDataUser();
+        bool IsCpuDataResident() const { return !m_vertices.empty(); }
+
         // aabb
-        const Math::BoundingBox& GetAabb() const { return m_aabb; }
+        const Math::BoundingBox& GetAabb() const      { return m_aabb; }
+        void SetAabb(const Math::BoundingBox& aabb) { m_aabb = aabb; }
         void ComputeAabb();
 
         // gpu buffers
         void CreateGpuBuffers();
-        RHI_GeometryBuffer* GetIndexBuffer()  { return m_index_buffer.get();  }
-        RHI_GeometryBuffer* GetVertexBuffer() { return m_vertex_buffer.get(); }
+        RHI_GeometryBuffer* GetIndexBuffer()  { return m_index_allocation.buffer;  }
+        RHI_GeometryBuffer* GetVertexBuffer() { return m_vertex_allocation.buffer; }
+        uint32_t GetIndexBufferOffset() const  { return m_index_allocation.offset; }
+        uint32_t GetVertexBufferOffset() const { return m_vertex_allocation.offset; }
 
         // root entity
         std::weak_ptr<Entity> GetRootEntity() { return m_root_entity; }
@@ -114,13 +142,16 @@ namespace Spartan
         void AddTexture(std::shared_ptr<Material>& material, MaterialTexture texture_type, const std::string& file_path, bool is_gltf);
 
     private:
+        void RestoreCpuData();
+        void ReleaseCpuData();
+
         // geometry
         std::vector<RHI_Vertex_PosTexNorTan> m_vertices;
         std::vector<uint32_t> m_indices;
 
-        // gpu buffers
-        std::shared_ptr<RHI_GeometryBuffer> m_vertex_buffer;
-        std::shared_ptr<RHI_GeometryBuffer> m_index_buffer;
+        // gpu buffers (ranges within the geometry pool)
+        geometry_allocation m_vertex_allocation;
+        geometry_allocation m_index_allocation;
 
         // aabb
         Math::BoundingBox m_aabb;
@@ -130,6 +161,7 @@ namespace Spartan
         std::mutex m_mutex_vertices;
 
         // misc
+        uint32_t m_cpu_data_users = 0;
         std::weak_ptr<Entity> m_root_entity;
         MeshType m_type = MeshType::Custom;
     };
@@ -0,0 +1,347 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =================
+#include "pch.h"
+#include "OcclusionBuffer.h"
+#include "../Core/ThreadPool.h"
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define OCCLUSION_BUFFER_SSE2
+#endif
+//============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    namespace
+    {
+        const uint32_t tile_size = 8;
+        const float w_min        = 0.01f; // anything closer than this (or behind the camera) is not clipped, it's rejected
+
+        float edge(const Vector2& a, const Vector2& b, const float x, const float y)
+        {
+            return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+        }
+    }
+
+    OcclusionBuffer::OcclusionBuffer(const uint32_t width, const uint32_t height)
+    {
+        SP_ASSERT(width % tile_size == 0 && height % tile_size == 0);
+
+        m_width   = width;
+        m_height  = height;
+        m_tiles_x = width / tile_size;
+        m_tiles_y = height / tile_size;
+        m_depth.resize(m_width * m_height, 0.0f);
+        m_depth_tile.resize(m_tiles_x * m_tiles_y, 0.0f);
+    }
+
+    void OcclusionBuffer::Clear(const Matrix& view_projection)
+    {
+        m_view_projection = view_projection;
+        fill(m_depth.begin(), m_depth.end(), 0.0f);
+        fill(m_depth_tile.begin(), m_depth_tile.end(), 0.0f);
+        m_triangles.clear();
+    }
+
+    void OcclusionBuffer::AddOccluder(const vector<Vector3>& positions, const vector<uint32_t>& indices, const Matrix& transform)
+    {
+        const Matrix world_view_projection = transform * m_view_projection;
+        const float width                  = static_cast<float>(m_width);
+        const float height                 = static_cast<float>(m_height);
+
+        for (uint32_t i = 0; i + 2 < static_cast<uint32_t>(indices.size()); i += 3)
+        {
+            Vector2 screen[3];
+            float depth[3];
+            bool rejected = false;
+
+            for (uint32_t v = 0; v < 3; v++)
+            {
+                const Vector3& position = positions[indices[i + v]];
+                Vector4 clip            = Vector4(position.x, position.y, position.z, 1.0f) * world_view_projection;
+
+                // rejecting (instead of clipping) is conservative, the triangle just doesn't occlude
+                if (clip.w < w_min)
+                {
+                    rejected = true;
+                    break;
+                }
+
+                const float w_inv = 1.0f / clip.w;
+                screen[v].x       = (clip.x * w_inv * 0.5f + 0.5f) * width;
+                screen[v].y       = (0.5f - clip.y * w_inv * 0.5f) * height;
+                depth[v]          = w_inv;
+            }
+
+            if (rejected)
+                continue;
+
+            // skip degenerate triangles
+            const float area = edge(screen[0], screen[1], screen[2].x, screen[2].y);
+            if (area == 0.0f)
+                continue;
+
+            triangle t;
+            t.min_x = max(static_cast<int32_t>(floor(min({ screen[0].x, screen[1].x, screen[2].x }))), 0);
+            t.min_y = max(static_cast<int32_t>(floor(min({ screen[0].y, screen[1].y, screen[2].y }))), 0);
+            t.max_x = min(static_cast<int32_t>(ceil(max({ screen[0].x, screen[1].x, screen[2].x }))), static_cast<int32_t>(m_width) - 1);
+            t.max_y = min(static_cast<int32_t>(ceil(max({ screen[0].y, screen[1].y, screen[2].y }))), static_cast<int32_t>(m_height) - 1);
+            if (t.min_x > t.max_x || t.min_y > t.max_y)
+                continue;
+
+            // the edge opposite of each vertex, divided by the area so that it's that vertex's barycentric coordinate
+            // the sign of the area tells the winding, occluders are rasterized double sided
+            const float area_inv = 1.0f / area;
+            t.depth_a = t.depth_b = t.depth_c = 0.0f;
+            for (uint32_t v = 0; v < 3; v++)
+            {
+                const Vector2& a = screen[(v + 1) % 3];
+                const Vector2& b = screen[(v + 2) % 3];
+                t.edge_a[v]      = (a.y - b.y) * area_inv;
+                t.edge_b[v]      = (b.x - a.x) * area_inv;
+                t.edge_c[v]      = ((b.y - a.y) * a.x - (b.x - a.x) * a.y) * area_inv;
+
+                t.depth_a += t.edge_a[v] * depth[v];
+                t.depth_b += t.edge_b[v] * depth[v];
+                t.depth_c += t.edge_c[v] * depth[v];
+            }
+
+            m_triangles.emplace_back(t);
+        }
+    }
+
+    void OcclusionBuffer::Rasterize(const bool multithreaded)
+    {
+        if (m_triangles.empty())
+            return;
+
+        // each worker owns whole rows of tiles, so there is no contention and no ordering dependency
+        if (multithreaded && ThreadPool::GetIdleThreadCount() > 1)
+        {
+            ThreadPool::ParallelLoop([this](uint32_t tile_row_start, uint32_t tile_row_end)
+            {
+                RasterizeRows(tile_row_start * tile_size, tile_row_end * tile_size);
+                ComputeTileDepth(tile_row_start, tile_row_end);
+            }, m_tiles_y);
+        }
+        else
+        {
+            RasterizeRows(0, m_height);
+            ComputeTileDepth(0, m_tiles_y);
+        }
+    }
+
+    void OcclusionBuffer::RasterizeRows(const uint32_t row_start, const uint32_t row_end)
+    {
+        for (const triangle& t : m_triangles)
+        {
+            const int32_t y_start = max(t.min_y, static_cast<int32_t>(row_start));
+            const int32_t y_end   = min(t.max_y, static_cast<int32_t>(row_end) - 1);
+            if (y_start > y_end)
+                continue;
+
+        #ifdef OCCLUSION_BUFFER_SSE2
+            // four pixels at a time, starting at a multiple of four so that the last group still fits within
+            // the row (the width is a multiple of the tile size), pixels outside the triangle are masked out
+            const int32_t x_start   = t.min_x & ~3;
+            const __m128 lane       = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 edge_a0    = _mm_set1_ps(t.edge_a[0]);
+            const __m128 edge_a1    = _mm_set1_ps(t.edge_a[1]);
+            const __m128 edge_a2    = _mm_set1_ps(t.edge_a[2]);
+            const __m128 depth_a    = _mm_set1_ps(t.depth_a);
+            const __m128 zero       = _mm_setzero_ps();
+
+            for (int32_t y = y_start; y <= y_end; y++)
+            {
+                const float py     = static_cast<float>(y) + 0.5f;
+                const __m128 row_0 = _mm_set1_ps(t.edge_b[0] * py + t.edge_c[0]);
+                const __m128 row_1 = _mm_set1_ps(t.edge_b[1] * py + t.edge_c[1]);
+                const __m128 row_2 = _mm_set1_ps(t.edge_b[2] * py + t.edge_c[2]);
+                const __m128 row_z = _mm_set1_ps(t.depth_b * py + t.depth_c);
+                float* row         = &m_depth[y * m_width];
+
+                for (int32_t x = x_start; x <= t.max_x; x += 4)
+                {
+                    const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane);
+                    const __m128 b0 = _mm_add_ps(_mm_mul_ps(edge_a0, px), row_0);
+                    const __m128 b1 = _mm_add_ps(_mm_mul_ps(edge_a1, px), row_1);
+                    const __m128 b2 = _mm_add_ps(_mm_mul_ps(edge_a2, px), row_2);
+
+                    __m128 inside = _mm_and_ps(_mm_cmpge_ps(b0, zero), _mm_cmpge_ps(b1, zero));
+                    inside        = _mm_and_ps(inside, _mm_cmpge_ps(b2, zero));
+                    if (_mm_movemask_ps(inside) == 0)
+                        continue;
+
+                    // 1/w is positive, so masked out lanes become 0 and leave the max untouched
+                    const __m128 depth = _mm_and_ps(_mm_add_ps(_mm_mul_ps(depth_a, px), row_z), inside);
+                    _mm_storeu_ps(row + x, _mm_max_ps(_mm_loadu_ps(row + x), depth));
+                }
+            }
+        #else
+            for (int32_t y = y_start; y <= y_end; y++)
+            {
+                const float py    = static_cast<float>(y) + 0.5f;
+                const float row_0 = t.edge_b[0] * py + t.edge_c[0];
+                const float row_1 = t.edge_b[1] * py + t.edge_c[1];
+                const float row_2 = t.edge_b[2] * py + t.edge_c[2];
+                const float row_z = t.depth_b * py + t.depth_c;
+                float* row        = &m_depth[y * m_width];
+
+                for (int32_t x = t.min_x; x <= t.max_x; x++)
+                {
+                    const float px = static_cast<float>(x) + 0.5f;
+                    const float b0 = t.edge_a[0] * px + row_0;
+                    const float b1 = t.edge_a[1] * px + row_1;
+                    const float b2 = t.edge_a[2] * px + row_2;
+                    if (b0 < 0.0f || b1 < 0.0f || b2 < 0.0f)
+                        continue;
+
+                    row[x] = max(row[x], t.depth_a * px + row_z);
+                }
+            }
+        #endif
+        }
+    }
+
+    void OcclusionBuffer::ComputeTileDepth(const uint32_t tile_row_start, const uint32_t tile_row_end)
+    {
+        for (uint32_t tile_y = tile_row_start; tile_y < tile_row_end; tile_y++)
+        {
+            for (uint32_t tile_x = 0; tile_x < m_tiles_x; tile_x++)
+            {
+                float depth_farthest = numeric_limits<float>::max();
+                for (uint32_t y = tile_y * tile_size; y < (tile_y + 1) * tile_size; y++)
+                {
+                    for (uint32_t x = tile_x * tile_size; x < (tile_x + 1) * tile_size; x++)
+                    {
+                        depth_farthest = min(depth_farthest, m_depth[y * m_width + x]);
+                    }
+                }
+
+                m_depth_tile[tile_y * m_tiles_x + tile_x] = depth_farthest;
+            }
+        }
+    }
+
+    bool OcclusionBuffer::IsOccluded(const BoundingBox& box) const
+    {
+        if (m_triangles.empty())
+            return false;
+
+        // project the corners, keeping the screen rectangle and the closest depth
+        const Vector3& box_min = box.GetMin();
+        const Vector3& box_max = box.GetMax();
+        float x_min = numeric_limits<float>::max(), x_max = numeric_limits<float>::lowest();
+        float y_min = numeric_limits<float>::max(), y_max = numeric_limits<float>::lowest();
+        float depth_closest = 0.0f;
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            Vector4 corner = Vector4(
+                (i & 1) ? box_max.x : box_min.x,
+                (i & 2) ? box_max.y : box_min.y,
+                (i & 4) ? box_max.z : box_min.z,
+                1.0f
+            );
+            Vector4 clip = corner * m_view_projection;
+
+            // crosses the near plane, treat as visible
+            if (clip.w < w_min)
+                return false;
+
+            const float w_inv = 1.0f / clip.w;
+            const float x     = (clip.x * w_inv * 0.5f + 0.5f) * static_cast<float>(m_width);
+            const float y     = (0.5f - clip.y * w_inv * 0.5f) * static_cast<float>(m_height);
+            x_min             = min(x_min, x);
+            x_max             = max(x_max, x);
+            y_min             = min(y_min, y);
+            y_max             = max(y_max, y);
+            depth_closest     = max(depth_closest, w_inv);
+        }
+
+        // the rectangle is expanded to whole pixels, so partially covered pixels are tested too
+        const int32_t px_min = max(static_cast<int32_t>(floor(x_min)), 0);
+        const int32_t py_min = max(static_cast<int32_t>(floor(y_min)), 0);
+        const int32_t px_max = min(static_cast<int32_t>(ceil(x_max)), static_cast<int32_t>(m_width) - 1);
+        const int32_t py_max = min(static_cast<int32_t>(ceil(y_max)), static_cast<int32_t>(m_height) - 1);
+        if (px_min > px_max || py_min > py_max)
+            return false; // off screen, that's for frustum culling to decide
+
+        for (int32_t tile_y = py_min / static_cast<int32_t>(tile_size); tile_y <= py_max / static_cast<int32_t>(tile_size); tile_y++)
+        {
+            for (int32_t tile_x = px_min / static_cast<int32_t>(tile_size); tile_x <= px_max / static_cast<int32_t>(tile_size); tile_x++)
+            {
+                // the whole tile is in front of the box
+                if (m_depth_tile[tile_y * m_tiles_x + tile_x] > depth_closest)
+                    continue;
+
+                // otherwise check the pixels of the tile that the rectangle covers
+                const int32_t y_start = max(py_min, tile_y * static_cast<int32_t>(tile_size));
+                const int32_t y_end   = min(py_max, (tile_y + 1) * static_cast<int32_t>(tile_size) - 1);
+                const int32_t x_start = max(px_min, tile_x * static_cast<int32_t>(tile_size));
+                const int32_t x_end   = min(px_max, (tile_x + 1) * static_cast<int32_t>(tile_size) - 1);
+                for (int32_t y = y_start; y <= y_end; y++)
+                {
+                    for (int32_t x = x_start; x <= x_end; x++)
+                    {
+                        if (m_depth[y * m_width + x] <= depth_closest)
+                            return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool OcclusionBuffer::SelfTest()
+    {
+        // a camera at the origin looking down +z, and a 2x2 quad 5 units away, covering the middle of the screen
+        const Matrix view            = Matrix::CreateLookAtLH(Vector3::Zero, Vector3::Forward, Vector3::Up);
+        const Matrix projection      = Matrix::CreatePerspectiveFieldOfViewLH(1.0f, 2.0f, 0.1f, 100.0f);
+        const vector<Vector3> quad   = { Vector3(-1.0f, -1.0f, 0.0f), Vector3(-1.0f, 1.0f, 0.0f), Vector3(1.0f, 1.0f, 0.0f), Vector3(1.0f, -1.0f, 0.0f) };
+        const vector<uint32_t> quad_indices = { 0, 1, 2, 0, 2, 3 };
+
+        OcclusionBuffer buffer;
+        buffer.Clear(view * projection);
+        buffer.AddOccluder(quad, quad_indices, Matrix::CreateTranslation(Vector3(0.0f, 0.0f, 5.0f)));
+        buffer.Rasterize(false);
+
+        // the pixels under the quad hold its depth, the ones outside of it are empty
+        const float depth_quad = 1.0f / 5.0f;
+        const float center     = buffer.m_depth[(buffer.m_height / 2) * buffer.m_width + buffer.m_width / 2];
+        const float corner     = buffer.m_depth[0];
+        if (abs(center - depth_quad) > 0.001f || corner != 0.0f)
+            return false;
+
+        const BoundingBox behind       = BoundingBox(Vector3(-0.5f, -0.5f, 8.0f), Vector3(0.5f, 0.5f, 9.0f));
+        const BoundingBox in_front     = BoundingBox(Vector3(-0.5f, -0.5f, 2.0f), Vector3(0.5f, 0.5f, 3.0f));
+        const BoundingBox intersecting = BoundingBox(Vector3(-0.5f, -0.5f, 4.0f), Vector3(0.5f, 0.5f, 6.0f));
+        const BoundingBox around       = BoundingBox(Vector3(-3.0f, -0.5f, 8.0f), Vector3(3.0f, 0.5f, 9.0f)); // behind, but wider than the quad
+
+        return buffer.IsOccluded(behind) && !buffer.IsOccluded(in_front) && !buffer.IsOccluded(intersecting) && !buffer.IsOccluded(around);
+    }
+}
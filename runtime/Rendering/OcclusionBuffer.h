@@ -0,0 +1,87 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===================
+#include <vector>
+#include "../Math/Matrix.h"
+#include "../Math/Vector2.h"
+#include "../Math/BoundingBox.h"
+//==============================
+
+namespace Spartan
+{
+    // a low resolution depth buffer that occluders are rasterized into on the cpu and
+    // that bounding boxes are tested against, before any gpu work is recorded for them
+    // - depth is stored as 1/w (larger is closer), which interpolates linearly in screen space
+    // - rows are split across worker threads, and since each pixel keeps the max depth
+    //   written to it, the result is the same regardless of thread count or triangle order
+    // - a per tile (8x8) farthest depth allows most boxes to be rejected without touching pixels
+    // - pixels are rasterized four at a time with sse2, with a scalar path for other targets
+    // - occluders must not extend past the surface they stand for, or visible objects get culled
+    class OcclusionBuffer
+    {
+    public:
+        OcclusionBuffer(const uint32_t width = 256, const uint32_t height = 128);
+
+        // resets the depth and sets the matrix that the following calls project with
+        void Clear(const Math::Matrix& view_projection);
+
+        // queues the triangles of an occluder, positions are in object space
+        void AddOccluder(const std::vector<Math::Vector3>& positions, const std::vector<uint32_t>& indices, const Math::Matrix& transform);
+
+        // rasterizes all queued occluders
+        void Rasterize(const bool multithreaded = true);
+
+        // true if the box is entirely behind what has been rasterized
+        bool IsOccluded(const Math::BoundingBox& box) const;
+
+        // rasterizes a known quad and checks boxes in front of, behind and around it
+        static bool SelfTest();
+
+        uint32_t GetWidth() const                  { return m_width; }
+        uint32_t GetHeight() const                 { return m_height; }
+        uint32_t GetTriangleCount() const          { return static_cast<uint32_t>(m_triangles.size()); }
+        const std::vector<float>& GetDepth() const { return m_depth; }
+
+    private:
+        // plane equations in screen space, evaluated at pixel centers as a * x + b * y + c
+        struct triangle
+        {
+            float edge_a[3], edge_b[3], edge_c[3]; // barycentric coordinates, positive inside for either winding
+            float depth_a, depth_b, depth_c;       // 1/w
+            int32_t min_x, max_x, min_y, max_y;
+        };
+
+        void RasterizeRows(const uint32_t row_start, const uint32_t row_end);
+        void ComputeTileDepth(const uint32_t tile_row_start, const uint32_t tile_row_end);
+
+        uint32_t m_width       = 0;
+        uint32_t m_height      = 0;
+        uint32_t m_tiles_x     = 0;
+        uint32_t m_tiles_y     = 0;
+        Math::Matrix m_view_projection;
+        std::vector<float> m_depth;      // per pixel, closest occluder
+        std::vector<float> m_depth_tile; // per tile, farthest pixel
+        std::vector<triangle> m_triangles;
+    };
+}
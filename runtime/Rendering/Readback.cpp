@@ -0,0 +1,307 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =========================
+#include "pch.h"
+#include "Readback.h"
+#include "../RHI/RHI_Buffer.h"
+#include "../RHI/RHI_CommandList.h"
+#include "../RHI/RHI_GeometryBuffer.h"
+#include "../RHI/RHI_Semaphore.h"
+#include "../RHI/RHI_Texture.h"
+//====================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        struct request
+        {
+            RHI_CommandList* cmd_list = nullptr;
+            readback_callback callback;
+            uint64_t offset           = 0;
+            uint64_t size             = 0;
+            uint64_t wait_value       = 0; // captured once the command list is submitted
+            bool completed            = false;
+        };
+
+        // copy offsets have to be a multiple of the texel size and of 4, this covers every format
+        const uint64_t ring_alignment = 256;
+        const uint64_t ring_size      = 64 * 1024 * 1024;
+
+        shared_ptr<RHI_Buffer> ring;
+        uint64_t ring_head = 0;
+        deque<request> requests; // in allocation order, so the front marks the ring's tail
+        mutex mutex_readback;
+
+        struct request_geometry
+        {
+            vector<readback_geometry_range> ranges;
+            readback_callback callback;
+            uint64_t size = 0;
+        };
+        vector<request_geometry> requests_geometry; // waiting for Record()
+
+        uint64_t align_range(const uint64_t size)
+        {
+            return (size + Readback::GetGeometryRangeAlignment() - 1) & ~(Readback::GetGeometryRangeAlignment() - 1);
+        }
+
+        bool allocate(const uint64_t size, uint64_t* offset_out)
+        {
+            if (!ring)
+            {
+                ring = make_shared<RHI_Buffer>(static_cast<uint32_t>(ring_size), 1, RHI_Buffer_Transfer_Dst, "readback_ring");
+            }
+
+            if (size > ring_size)
+                return false;
+
+            if (requests.empty())
+            {
+                ring_head = 0;
+            }
+
+            // requests never have a size of zero, so the head only trails (or meets) the tail once it has wrapped around
+            const uint64_t head = (ring_head + ring_alignment - 1) & ~(ring_alignment - 1);
+            const uint64_t tail = requests.empty() ? ring_size : requests.front().offset;
+            const bool wrapped  = !requests.empty() && ring_head <= tail;
+
+            if (!wrapped && head + size <= ring_size)
+            {
+                *offset_out = head;
+            }
+            else if (!wrapped && size <= tail)
+            {
+                *offset_out = 0; // the space at the end is left unused and reclaimed along with the tail
+            }
+            else if (wrapped && head + size <= tail)
+            {
+                *offset_out = head;
+            }
+            else
+            {
+                return false;
+            }
+
+            ring_head = *offset_out + size;
+            return true;
+        }
+
+        bool is_complete(request& r)
+        {
+            if (r.wait_value == 0)
+            {
+                const RHI_CommandListState state = r.cmd_list->GetState();
+
+                // still recording, or already waited for and reset
+                if (state == RHI_CommandListState::Recording)
+                    return false;
+
+                if (state == RHI_CommandListState::Idle)
+                    return true;
+
+                r.wait_value = r.cmd_list->GetRenderingCompleteSemaphoreTimeline()->GetWaitValue();
+            }
+
+            return r.cmd_list->GetRenderingCompleteSemaphoreTimeline()->GetValue() >= r.wait_value;
+        }
+
+        bool add_request(RHI_CommandList* cmd_list, readback_callback& callback, const uint64_t size, uint64_t* offset_out)
+        {
+            SP_ASSERT(cmd_list != nullptr && cmd_list->GetState() == RHI_CommandListState::Recording);
+            SP_ASSERT(size != 0);
+
+            lock_guard lock(mutex_readback);
+
+            if (!allocate(size, offset_out))
+                return false;
+
+            request& r  = requests.emplace_back();
+            r.cmd_list  = cmd_list;
+            r.callback  = move(callback);
+            r.offset    = *offset_out;
+            r.size      = size;
+
+            return true;
+        }
+    }
+
+    void Readback::Tick()
+    {
+        // find finished copies, the callbacks run outside of the lock so that they can issue new requests
+        vector<request*> finished;
+        {
+            lock_guard lock(mutex_readback);
+
+            for (request& r : requests)
+            {
+                if (!r.completed && is_complete(r))
+                {
+                    finished.emplace_back(&r);
+                }
+            }
+        }
+
+        // the ring memory can't be reclaimed until the completed flag is set, so the data stays valid here
+        for (request* r : finished)
+        {
+            if (r->callback)
+            {
+                r->callback(static_cast<std::byte*>(ring->GetMappedData()) + r->offset, r->size);
+            }
+        }
+
+        lock_guard lock(mutex_readback);
+
+        for (request* r : finished)
+        {
+            r->completed = true;
+        }
+
+        // reclaim in allocation order, a finished request behind a pending one waits for it
+        while (!requests.empty() && requests.front().completed)
+        {
+            requests.pop_front();
+        }
+    }
+
+    void Readback::Shutdown()
+    {
+        lock_guard lock(mutex_readback);
+
+        requests.clear();
+        requests_geometry.clear();
+        ring      = nullptr;
+        ring_head = 0;
+    }
+
+    bool Readback::RequestTexture(RHI_CommandList* cmd_list, RHI_Texture* texture, readback_callback callback, const uint32_t mip_index, const uint32_t array_index, const uint32_t x, const uint32_t y, uint32_t width, uint32_t height)
+    {
+        SP_ASSERT(texture != nullptr);
+
+        width  = width  != 0 ? width  : max(1u, texture->GetWidth()  >> mip_index);
+        height = height != 0 ? height : max(1u, texture->GetHeight() >> mip_index);
+
+        const uint64_t size = RHI_Texture::CalculateMipSize(width, height, 1, texture->GetFormat(), texture->GetBitsPerChannel(), texture->GetChannelCount());
+        uint64_t offset     = 0;
+        if (!add_request(cmd_list, callback, size, &offset))
+            return false;
+
+        cmd_list->Copy(texture, ring.get(), offset, mip_index, array_index, x, y, width, height);
+
+        return true;
+    }
+
+    bool Readback::RequestBuffer(RHI_CommandList* cmd_list, RHI_Buffer* buffer, const uint64_t offset, const uint64_t size, readback_callback callback)
+    {
+        SP_ASSERT(buffer != nullptr);
+
+        uint64_t offset_ring = 0;
+        if (!add_request(cmd_list, callback, size, &offset_ring))
+            return false;
+
+        cmd_list->Copy(buffer, offset, ring.get(), offset_ring, size);
+
+        return true;
+    }
+
+    bool Readback::RequestGeometry(const vector<readback_geometry_range>& ranges, readback_callback callback)
+    {
+        SP_ASSERT(!ranges.empty());
+
+        request_geometry r;
+        for (const readback_geometry_range& range : ranges)
+        {
+            SP_ASSERT(range.buffer != nullptr && range.element_count != 0);
+            r.size += align_range(static_cast<uint64_t>(range.element_count) * range.buffer->GetStride());
+        }
+
+        if (r.size > ring_size)
+            return false;
+
+        r.ranges   = ranges;
+        r.callback = move(callback);
+
+        lock_guard lock(mutex_readback);
+        requests_geometry.emplace_back(move(r));
+
+        return true;
+    }
+
+    void Readback::Record(RHI_CommandList* cmd_list)
+    {
+        // swap the queue out so that the copies are recorded without holding the lock
+        vector<request_geometry> pending;
+        {
+            lock_guard lock(mutex_readback);
+            pending.swap(requests_geometry);
+        }
+
+        for (size_t i = 0; i < pending.size(); i++)
+        {
+            request_geometry& r = pending[i];
+
+            // the ring is full, try the rest on the next frame
+            uint64_t offset = 0;
+            if (!add_request(cmd_list, r.callback, r.size, &offset))
+            {
+                lock_guard lock(mutex_readback);
+                requests_geometry.insert(requests_geometry.begin(), make_move_iterator(pending.begin() + i), make_move_iterator(pending.end()));
+                break;
+            }
+
+            for (const readback_geometry_range& range : r.ranges)
+            {
+                cmd_list->Copy(range.buffer, range.element_offset, range.element_count, ring.get(), offset);
+                offset += align_range(static_cast<uint64_t>(range.element_count) * range.buffer->GetStride());
+            }
+        }
+    }
+
+    uint32_t Readback::GetPendingCount()
+    {
+        lock_guard lock(mutex_readback);
+        return static_cast<uint32_t>(requests.size() + requests_geometry.size());
+    }
+
+    uint64_t Readback::GetMemoryUsed()
+    {
+        lock_guard lock(mutex_readback);
+
+        if (requests.empty())
+            return 0;
+
+        const uint64_t tail = requests.front().offset;
+        return ring_head > tail ? ring_head - tail : ring_size - tail + ring_head;
+    }
+
+    uint64_t Readback::GetMemoryAllocated()
+    {
+        lock_guard lock(mutex_readback);
+        return ring ? ring_size : 0;
+    }
+}
@@ -0,0 +1,71 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <functional>
+#include <vector>
+#include "../Core/Definitions.h"
+//================================
+
+namespace Spartan
+{
+    class RHI_CommandList;
+    class RHI_Texture;
+    class RHI_Buffer;
+    class RHI_GeometryBuffer;
+
+    // invoked on the main thread once the gpu has finished the copy, the data is only valid during the call
+    using readback_callback = std::function<void(const void* data, const uint64_t size)>;
+
+    // a range of elements (indices or vertices) in a geometry buffer
+    struct readback_geometry_range
+    {
+        RHI_GeometryBuffer* buffer = nullptr;
+        uint32_t element_offset    = 0;
+        uint32_t element_count     = 0;
+    };
+
+    // gpu to cpu copies without stalls, the copy is recorded into the given command list and lands in a
+    // persistently mapped staging ring, Tick() polls for completion and hands the data to the callback
+    class Readback
+    {
+    public:
+        static void Tick();
+        static void Shutdown();
+
+        // false if the staging ring can't fit the request, try again on a later frame
+        static bool RequestTexture(RHI_CommandList* cmd_list, RHI_Texture* texture, readback_callback callback, const uint32_t mip_index = 0, const uint32_t array_index = 0, const uint32_t x = 0, const uint32_t y = 0, uint32_t width = 0, uint32_t height = 0);
+        static bool RequestBuffer(RHI_CommandList* cmd_list, RHI_Buffer* buffer, const uint64_t offset, const uint64_t size, readback_callback callback);
+
+        // for callers without a command list, the copies are recorded by Record() on the next frame, all ranges
+        // land in a single allocation, in order, each starting at a multiple of GetGeometryRangeAlignment() bytes
+        static bool RequestGeometry(const std::vector<readback_geometry_range>& ranges, readback_callback callback);
+        static void Record(RHI_CommandList* cmd_list);
+        static constexpr uint64_t GetGeometryRangeAlignment() { return 16; }
+
+        // stats
+        static uint32_t GetPendingCount();
+        static uint64_t GetMemoryUsed();
+        static uint64_t GetMemoryAllocated();
+    };
+}
@@ -19,11 +19,14 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ===============================
+//= INCLUDES =========================================
 #include "pch.h"
 #include "Renderer.h"
 #include "ThreadPool.h"
 #include "ProgressTracker.h"
+#include "GeometryPool.h"
+#include "Readback.h"
+#include "OcclusionBuffer.h"
 #include "../Profiling/Profiler.h"
 #include "../Core/Window.h"
 #include "../Input/Input.h"
@@ -36,11 +39,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_Buffer.h"
 #include "../RHI/RHI_FidelityFX.h"
 #include "../RHI/RHI_OpenImageDenoise.h"
+#include "../Resource/Import/ImageImporterExporter.h"
 #include "../World/Entity.h"
 #include "../World/Components/Light.h"
 #include "../World/Components/Camera.h"
 #include "../World/Components/AudioSource.h"
-//==========================================
+#include "../World/Components/Renderable.h"
+//===================================================
 
 //= NAMESPACES ===============
 using namespace std;
@@ -66,7 +71,9 @@ namespace Spartan
     atomic<bool> Renderer::m_initialized_third_party              = false;
     atomic<uint32_t> Renderer::m_environment_mips_to_filter_count = 0;
     unordered_map<Renderer_Entity, vector<shared_ptr<Entity>>> Renderer::m_renderables;
+    vector<Vector3> Renderer::m_audio_source_positions;
     mutex Renderer::m_mutex_renderables;
+    mutex Renderer::m_mutex_lines;
 
     namespace
     {
@@ -81,7 +88,38 @@ namespace Spartan
 
         // bindless
         static array<RHI_Texture*, rhi_max_array_size> bindless_textures;
-        bool bindless_materials_dirty = true;
+        bool bindless_materials_dirty           = true;
+        atomic<bool> bindless_materials_pending = false;
+        atomic<bool> bindless_lights_pending    = false;
+
+        // renderables submitted by the world, swapped in at the sync point
+        unordered_map<Renderer_Entity, vector<shared_ptr<Entity>>> renderables_pending;
+        bool renderables_pending_dirty = false;
+
+        // render thread
+        thread render_thread;
+        thread::id render_thread_id;
+        mutex render_thread_mutex;
+        condition_variable render_thread_condition;
+        RHI_CommandList* render_thread_cmd_list_graphics = nullptr;
+        RHI_CommandList* render_thread_cmd_list_compute  = nullptr;
+        bool render_thread_frame_pending                 = false;
+        bool render_thread_exit                          = false;
+
+        // on-demand rendering (editor only), the scene is only rendered when something that affects it changed
+        atomic<bool> scene_dirty            = true;
+        uint32_t frames_since_scene_change  = 0;
+        const uint32_t frames_to_converge   = 64; // temporal effects (taa/upscaling, ssr, gi) keep refining for a while after the last change
+        atomic<uint32_t> frames_ui_pending  = 0;
+        const uint32_t frames_ui            = 8;  // imgui needs a few frames to settle hover states and animations after an input event
+        uint64_t selected_entity_id         = 0;
+        uint64_t frame_num_scene            = 0;
+        bool produce_scene                  = true;
+        bool is_idle                        = false;
+
+        // screenshots are read back without stalling and saved once the gpu is done with the frame
+        string screenshot_path;
+        mutex screenshot_mutex;
 
         // misc
         unordered_map<Renderer_Option, float> m_options;
@@ -92,6 +130,16 @@ namespace Spartan
         float far_plane                      = 1.0f;
         bool dirty_orthographic_projection   = true;
 
+        void fill_missing_options()
+        {
+            // reading an option that was never set would insert it into the map, which
+            // is not safe while the render thread is reading options as well
+            for (uint32_t i = 0; i < static_cast<uint32_t>(Renderer_Option::Max); i++)
+            {
+                m_options.emplace(static_cast<Renderer_Option>(i), 0.0f);
+            }
+        }
+
         float get_directional_light_intensity_lumens(const vector<shared_ptr<Entity>>& lights)
         {
             float intensity = 0.0f;
@@ -113,6 +161,11 @@ namespace Spartan
 
     void Renderer::Initialize()
     {
+        // a broken occlusion buffer culls visible objects, so catch it early in debug builds
+        #ifdef DEBUG
+        SP_ASSERT_MSG(OcclusionBuffer::SelfTest(), "The occlusion buffer failed its self test");
+        #endif
+
         RHI_Device::Initialize();
 
         // resolution
@@ -183,8 +236,10 @@ namespace Spartan
             // subscribe
             SP_SUBSCRIBE_TO_EVENT(EventType::WorldClear,              SP_EVENT_HANDLER_STATIC(OnClear));
             SP_SUBSCRIBE_TO_EVENT(EventType::WindowFullScreenToggled, SP_EVENT_HANDLER_STATIC(OnFullScreenToggled));
-            SP_SUBSCRIBE_TO_EVENT(EventType::MaterialOnChanged,       SP_EVENT_HANDLER_STATIC(BindlessUpdateMaterials));
-            SP_SUBSCRIBE_TO_EVENT(EventType::LightOnChanged,          SP_EVENT_HANDLER_STATIC(BindlessUpdateLights));
+            SP_SUBSCRIBE_TO_EVENT(EventType::MaterialOnChanged,       SP_EVENT_HANDLER_EXPRESSION_STATIC( bindless_materials_pending = true; scene_dirty = true; ));
+            SP_SUBSCRIBE_TO_EVENT(EventType::LightOnChanged,          SP_EVENT_HANDLER_EXPRESSION_STATIC( bindless_lights_pending    = true; scene_dirty = true; ));
+            SP_SUBSCRIBE_TO_EVENT(EventType::WindowResized,           SP_EVENT_HANDLER_EXPRESSION_STATIC( scene_dirty = true; ));
+            SP_SUBSCRIBE_TO_EVENT(EventType::Sdl,                     SP_EVENT_HANDLER_EXPRESSION_STATIC( frames_ui_pending = frames_ui; ));
 
             // fire
             SP_FIRE_EVENT(EventType::RendererOnInitialized);
@@ -219,17 +274,36 @@ namespace Spartan
         SetOption(Renderer_Option::Lights,                      1.0f);
         SetOption(Renderer_Option::Physics,                     0.0f);
         SetOption(Renderer_Option::PerformanceMetrics,          1.0f);
-        SetOption(Renderer_Option::OcclusionCulling,            0.0f); // disabled by default as it's a WIP (you can see the query delays)
+        SetOption(Renderer_Option::OcclusionCulling,            0.0f); // opt-in
+        SetOption(Renderer_Option::RenderThread,                0.0f); // opt-in, only takes effect outside of the editor
+        SetOption(Renderer_Option::VisibilityBuffer,            0.0f);
+        SetOption(Renderer_Option::OnDemandRendering,           1.0f); // only takes effect in the editor
+        fill_missing_options();
     }
 
     void Renderer::Shutdown()
     {
+        // stop the render thread
+        if (render_thread.joinable())
+        {
+            Synchronize();
+
+            {
+                lock_guard lock(render_thread_mutex);
+                render_thread_exit = true;
+            }
+            render_thread_condition.notify_all();
+            render_thread.join();
+        }
+
         SP_FIRE_EVENT(EventType::RendererOnShutdown);
 
         // manually invoke the deconstructors so that ParseDeletionQueue()
         // releases their rhi resources before device destruction
         {
             DestroyResources();
+            GeometryPool::Shutdown();
+            Readback::Shutdown();
 
             m_renderables.clear();
             swap_chain            = nullptr;
@@ -243,10 +317,28 @@ namespace Spartan
 
     void Renderer::Tick()
     {
+        // hand finished gpu readbacks to their callbacks, even when no frame is rendered
+        Readback::Tick();
+
         // don't waste cpu/gpu time if nothing can be seen
+        is_idle = false;
         if (Window::IsMinimized() || !m_initialized_resources)
             return;
 
+        // don't waste cpu/gpu time if nothing changed, when only the ui changed the editor re-draws it on top of the previous frame
+        const bool on_demand = Engine::IsFlagSet(EngineMode::Editor) && GetOption<bool>(Renderer_Option::OnDemandRendering);
+        produce_scene        = !on_demand || IsSceneChanging();
+        if (!produce_scene && frames_ui_pending == 0 && Readback::GetPendingCount() == 0)
+        {
+            is_idle = true;
+            return;
+        }
+
+        if (frames_ui_pending > 0)
+        {
+            frames_ui_pending--;
+        }
+
         if (frame_num == 1)
         {
             SP_FIRE_EVENT(EventType::RendererOnFirstFrameCompleted);
@@ -267,22 +359,197 @@ namespace Spartan
         //cmd_list_compute->Begin(queue_compute);
 
         OnSyncPoint(cmd_list_graphics);
-        ProduceFrame(cmd_list_graphics, cmd_list_compute);
 
-        // blit to back buffer when not in editor mode
-        bool is_standalone = !Engine::IsFlagSet(EngineMode::Editor);
-        if (is_standalone)
+        if (IsRenderThreadEnabled())
         {
-            BlitToBackBuffer(cmd_list_graphics, GetRenderTarget(Renderer_RenderTarget::frame_output).get());
+            if (!render_thread.joinable())
+            {
+                render_thread_exit = false;
+                render_thread      = thread(RenderThreadLoop);
+                render_thread_id   = render_thread.get_id();
+            }
+
+            // hand the frame over, the engine waits for it via Synchronize()
+            {
+                lock_guard lock(render_thread_mutex);
+                render_thread_cmd_list_graphics = cmd_list_graphics;
+                render_thread_cmd_list_compute  = cmd_list_compute;
+                render_thread_frame_pending     = true;
+            }
+            render_thread_condition.notify_all();
+        }
+        else
+        {
+            RecordFrame(cmd_list_graphics, cmd_list_compute);
         }
 
-        // present
-        if (is_standalone)
+        frame_num++;
+    }
+
+    void Renderer::RecordFrame(RHI_CommandList* cmd_list_graphics, RHI_CommandList* cmd_list_compute)
+    {
+        // when only the ui changed, the previous frame is still valid and the editor displays it as is
+        if (produce_scene)
+        {
+            ProduceFrame(cmd_list_graphics, cmd_list_compute);
+            frames_since_scene_change = min(frames_since_scene_change + 1, frames_to_converge);
+            frame_num_scene++;
+        }
+
+        {
+            lock_guard lock(screenshot_mutex);
+            if (!screenshot_path.empty())
+            {
+                RHI_Texture* texture            = GetRenderTarget(Renderer_RenderTarget::frame_output).get();
+                const uint32_t width            = texture->GetWidth();
+                const uint32_t height           = texture->GetHeight();
+                const uint32_t channel_count    = texture->GetChannelCount();
+                const uint32_t bits_per_channel = texture->GetBitsPerChannel();
+                auto save = [file_path = screenshot_path, width, height, channel_count, bits_per_channel](const void* data, const uint64_t size)
+                {
+                    // the exporter reads width * height pixels, so a short readback would read past the staging memory
+                    const uint64_t size_expected = static_cast<uint64_t>(width) * height * channel_count * (bits_per_channel / 8);
+                    if (size < size_expected)
+                    {
+                        SP_LOG_ERROR("Screenshot readback is %llu bytes, expected %llu", size, size_expected);
+                        return;
+                    }
+
+                    ImageImporterExporter::Save(file_path, width, height, channel_count, bits_per_channel, const_cast<void*>(data));
+                    SP_LOG_INFO("Screenshot has been saved");
+                };
+
+                // if the staging ring is full, try again next frame
+                if (Readback::RequestTexture(cmd_list_graphics, texture, save))
+                {
+                    screenshot_path.clear();
+                }
+            }
+        }
+
+        // blit to back buffer and present when not in editor mode
+        if (!Engine::IsFlagSet(EngineMode::Editor))
         {
+            BlitToBackBuffer(cmd_list_graphics, GetRenderTarget(Renderer_RenderTarget::frame_output).get());
             Present();
         }
+    }
 
-        frame_num++;
+    void Renderer::RenderThreadLoop()
+    {
+        while (true)
+        {
+            unique_lock<mutex> lock(render_thread_mutex);
+            render_thread_condition.wait(lock, [] { return render_thread_frame_pending || render_thread_exit; });
+
+            if (render_thread_exit)
+                break;
+
+            lock.unlock();
+            RecordFrame(render_thread_cmd_list_graphics, render_thread_cmd_list_compute);
+            lock.lock();
+
+            render_thread_frame_pending = false;
+            lock.unlock();
+            render_thread_condition.notify_all();
+        }
+    }
+
+    void Renderer::Synchronize()
+    {
+        SP_ASSERT_MSG(!IsCallerRenderThread(), "The render thread can't wait on itself");
+
+        if (!render_thread.joinable())
+            return;
+
+        unique_lock<mutex> lock(render_thread_mutex);
+        render_thread_condition.wait(lock, [] { return !render_thread_frame_pending; });
+    }
+
+    bool Renderer::IsRenderThreadEnabled()
+    {
+        // the editor records imgui into the frame's command list on the main thread, so it always renders in sequence
+        return GetOption<bool>(Renderer_Option::RenderThread) && !Engine::IsFlagSet(EngineMode::Editor);
+    }
+
+    bool Renderer::IsCallerRenderThread()
+    {
+        return render_thread.joinable() && this_thread::get_id() == render_thread_id;
+    }
+
+    void Renderer::SetSceneDirty()
+    {
+        scene_dirty = true;
+    }
+
+    bool Renderer::IsIdle()
+    {
+        return is_idle;
+    }
+
+    uint64_t Renderer::GetFrameNumScene()
+    {
+        return frame_num_scene;
+    }
+
+    bool Renderer::IsSceneChanging()
+    {
+        if (scene_dirty.exchange(false))
+        {
+            frames_since_scene_change = 0;
+        }
+
+        // explicit changes (options, resolution, materials, lights, renderables) and their convergence
+        if (frames_since_scene_change < frames_to_converge || renderables_pending_dirty)
+            return true;
+
+        // time based effects and work which is still in flight
+        if (Engine::IsFlagSet(EngineMode::Game) || ProgressTracker::IsLoading() || m_environment_mips_to_filter_count > 0)
+            return true;
+
+        // debug lines
+        {
+            lock_guard lock(m_mutex_lines);
+            if (!m_line_vertices.empty())
+                return true;
+        }
+
+        // camera and selection (the outline)
+        if (shared_ptr<Camera> camera = GetCamera())
+        {
+            if (camera->GetEntity()->IsMoving())
+                return true;
+
+            shared_ptr<Entity> selected = camera->GetSelectedEntity();
+            uint64_t id                 = selected ? selected->GetObjectId() : 0;
+            if (id != selected_entity_id)
+            {
+                selected_entity_id        = id;
+                frames_since_scene_change = 0;
+                return true;
+            }
+        }
+
+        // entities which moved recently (the two second window also lets temporal effects converge), and animated materials
+        for (const shared_ptr<Entity>& entity : m_renderables[Renderer_Entity::Mesh])
+        {
+            if (entity->IsMoving())
+                return true;
+
+            if (Material* material = entity->GetComponent<Renderable>()->GetMaterial())
+            {
+                if (material->GetProperty(MaterialProperty::VertexAnimateWind) != 0.0f || material->GetProperty(MaterialProperty::VertexAnimateWater) != 0.0f)
+                    return true;
+            }
+        }
+
+        for (const shared_ptr<Entity>& entity : m_renderables[Renderer_Entity::Light])
+        {
+            if (entity->IsMoving())
+                return true;
+        }
+
+        return false;
     }
 
     const RHI_Viewport& Renderer::GetViewport()
@@ -300,6 +567,7 @@ namespace Spartan
             m_viewport.width              = width;
             m_viewport.height             = height;
             dirty_orthographic_projection = true;
+            scene_dirty                   = true;
         }
     }
 
@@ -321,6 +589,7 @@ namespace Spartan
 
         m_resolution_render.x = static_cast<float>(width);
         m_resolution_render.y = static_cast<float>(height);
+        scene_dirty           = true;
 
         if (recreate_resources)
         {
@@ -349,6 +618,7 @@ namespace Spartan
 
         m_resolution_output.x = static_cast<float>(width);
         m_resolution_output.y = static_cast<float>(height);
+        scene_dirty           = true;
 
         if (recreate_resources)
         {
@@ -431,6 +701,7 @@ namespace Spartan
         m_cb_frame_cpu.hdr_max_nits                = Display::GetLuminanceMax();
         m_cb_frame_cpu.hdr_white_point             = GetOption<float>(Renderer_Option::WhitePoint);
         m_cb_frame_cpu.directional_light_intensity = get_directional_light_intensity_lumens(m_renderables[Renderer_Entity::Light]);
+        m_cb_frame_cpu.material_texture_count      = static_cast<uint32_t>(MaterialTexture::Max);
 
         // these must match what common_buffer.hlsl is reading
         m_cb_frame_cpu.set_bit(GetOption<bool>(Renderer_Option::ScreenSpaceReflections),      1 << 0);
@@ -444,10 +715,10 @@ namespace Spartan
 
     void Renderer::SetEntities(unordered_map<uint64_t, shared_ptr<Entity>>& entities)
     {
-        m_mutex_renderables.lock();
+        lock_guard lock(m_mutex_renderables);
 
-        // clear previous state
-        m_renderables.clear();
+        // this is swapped in at the next sync point, so the renderables never change while a frame is recorded
+        renderables_pending.clear();
 
         for (auto it : entities)
         {
@@ -466,7 +737,7 @@ namespace Spartan
                         // but we don't keep anything uninitialized in what the renderer is processing
                         if (renderable->GetVertexBuffer() && renderable->GetIndexBuffer())
                         { 
-                            m_renderables[Renderer_Entity::Mesh].emplace_back(entity);
+                            renderables_pending[Renderer_Entity::Mesh].emplace_back(entity);
                         }
                     }
                 }
@@ -474,27 +745,21 @@ namespace Spartan
 
             if (shared_ptr<Light> light = entity->GetComponent<Light>())
             {
-                m_renderables[Renderer_Entity::Light].emplace_back(entity);
+                renderables_pending[Renderer_Entity::Light].emplace_back(entity);
             }
 
             if (shared_ptr<Camera> camera = entity->GetComponent<Camera>())
             {
-                m_renderables[Renderer_Entity::Camera].emplace_back(entity);
+                renderables_pending[Renderer_Entity::Camera].emplace_back(entity);
             }
 
             if (shared_ptr<AudioSource> audio_source = entity->GetComponent<AudioSource>())
             {
-                m_renderables[Renderer_Entity::AudioSource].emplace_back(entity);
+                renderables_pending[Renderer_Entity::AudioSource].emplace_back(entity);
             }
         }
 
-        m_mutex_renderables.unlock();
-
-        // update structures that rely on the renderables
-        {
-            BindlessUpdateMaterials();
-            BindlessUpdateLights();
-        }
+        renderables_pending_dirty = true;
     }
 
     bool Renderer::CanUseCmdList()
@@ -505,7 +770,12 @@ namespace Spartan
 
     void Renderer::OnClear()
     {
+        Synchronize();
+
+        lock_guard lock(m_mutex_renderables);
         m_renderables.clear();
+        renderables_pending.clear();
+        renderables_pending_dirty = false;
     }
 
     void Renderer::OnFullScreenToggled()
@@ -539,6 +809,12 @@ namespace Spartan
 
     void Renderer::OnSyncPoint(RHI_CommandList* cmd_list_graphics)
     {
+        // nothing is being recorded at this point, so swap in what the world submitted and snapshot what the passes read
+        UpdateRenderables();
+
+        // copies requested by callers that don't own a command list
+        Readback::Record(cmd_list_graphics);
+
         // is_sync_point: the command pool has exhausted its command lists and 
         // is about to reset them, this is an opportune moment for us to perform
         // certain operations, knowing that no rendering commands are currently
@@ -550,15 +826,18 @@ namespace Spartan
             m_resource_index = 0;
 
             // delete any rhi resources that have accumulated
-            if (RHI_Device::DeletionQueueNeedsToParse())
+            if (RHI_Device::DeletionQueueNeedsToParse() || GeometryPool::HasPendingFrees())
             {
                 RHI_Device::QueueWaitAll();
                 RHI_Device::DeletionQueueParse();
+                GeometryPool::ReleasePendingFrees();
                 SP_LOG_INFO("Parsed deletion queue");
             }
 
             // reset dynamic buffer offsets
             GetBuffer(Renderer_Buffer::Spd)->ResetOffset();
+            GetBuffer(Renderer_Buffer::VisibilityDraws)->ResetOffset();
+            GetBuffer(Renderer_Buffer::LightTileArgs)->ResetOffset();
             GetConstantBufferFrame()->ResetOffset();
 
             if (bindless_materials_dirty)
@@ -568,6 +847,17 @@ namespace Spartan
             }
         }
 
+        // dirty instances are staged in this frame's slot and copied by this frame's command list, so nothing waits on the gpu
+        {
+            RHI_Buffer* staging     = GetBuffer(Renderer_Buffer::InstanceUpload).get();
+            uint64_t staging_offset = static_cast<uint64_t>(m_resource_index) * staging->GetStride();
+            uint64_t staging_end    = staging_offset + staging->GetStride();
+            for (shared_ptr<Entity>& entity : m_renderables[Renderer_Entity::Mesh])
+            {
+                entity->GetComponent<Renderable>()->InstanceBufferUpdate(cmd_list_graphics, staging, &staging_offset, staging_end);
+            }
+        }
+
         UpdateConstantBufferFrame(cmd_list_graphics);
         AddLinesToBeRendered();
 
@@ -600,6 +890,64 @@ namespace Spartan
         }
     }
 
+    void Renderer::UpdateRenderables()
+    {
+        {
+            lock_guard lock(m_mutex_renderables);
+
+            if (renderables_pending_dirty)
+            {
+                m_renderables.swap(renderables_pending);
+                renderables_pending_dirty  = false;
+                bindless_materials_pending = true;
+                bindless_lights_pending    = true;
+            }
+
+            // make sure all the types exist, so that reading them never inserts into the map
+            m_renderables.try_emplace(Renderer_Entity::Mesh);
+            m_renderables.try_emplace(Renderer_Entity::Light);
+            m_renderables.try_emplace(Renderer_Entity::Camera);
+            m_renderables.try_emplace(Renderer_Entity::AudioSource);
+        }
+
+        // update structures that rely on the renderables
+        const bool materials_changed = bindless_materials_pending.exchange(false);
+        if (materials_changed)
+        {
+            BindlessUpdateMaterials();
+        }
+
+        // nothing is being recorded, so this is where the pipelines of new materials are built, rather than mid-pass
+        CreateGbufferPipelines(materials_changed);
+
+        if (bindless_lights_pending.exchange(false))
+        {
+            BindlessUpdateLights();
+        }
+
+        // proxies
+        for (shared_ptr<Entity>& entity : m_renderables[Renderer_Entity::Mesh])
+        {
+            entity->GetComponent<Renderable>()->UpdateProxy();
+        }
+
+        for (shared_ptr<Entity>& entity : m_renderables[Renderer_Entity::Light])
+        {
+            entity->GetComponent<Light>()->UpdateProxy();
+        }
+
+        if (shared_ptr<Camera> camera = GetCamera())
+        {
+            camera->UpdateProxy();
+        }
+
+        m_audio_source_positions.clear();
+        for (shared_ptr<Entity>& entity : m_renderables[Renderer_Entity::AudioSource])
+        {
+            m_audio_source_positions.emplace_back(entity->GetPosition());
+        }
+    }
+
     void Renderer::DrawString(const string& text, const Vector2& position_screen_percentage)
 	{
         if (shared_ptr<Font>& font = GetFont())
@@ -660,6 +1008,7 @@ namespace Spartan
 
         // set new value
         m_options[option] = value;
+        scene_dirty       = true;
 
         // handle cascading changes
         {
@@ -761,6 +1110,7 @@ namespace Spartan
     void Renderer::SetOptions(const unordered_map<Renderer_Option, float>& options)
     {
         m_options = options;
+        fill_missing_options();
     }
 
     RHI_SwapChain* Renderer::GetSwapChain()
@@ -1021,6 +1371,8 @@ namespace Spartan
 
     void Renderer::Screenshot(const string& file_path)
     {
-        GetFrameTexture()->SaveAsImage(file_path);
+        lock_guard lock(screenshot_mutex);
+        screenshot_path   = file_path;
+        frames_ui_pending = frames_ui; // make sure a frame gets recorded, even when idle
     }
 }
@@ -57,6 +57,16 @@ namespace Spartan
         static void Shutdown();
         static void Tick();
 
+        // render thread
+        static void Synchronize();
+        static bool IsRenderThreadEnabled();
+        static bool IsCallerRenderThread();
+
+        // on-demand rendering
+        static void SetSceneDirty();
+        static bool IsIdle();
+        static uint64_t GetFrameNumScene();
+
         // primitive rendering (useful for debugging)
         static void DrawLine(const Math::Vector3& from, const Math::Vector3& to, const Color& color_from = Color::standard_renderer_lines, const Color& color_to = Color::standard_renderer_lines, const float duration = 0.0f, const bool depth = true);
         static void DrawTriangle(const Math::Vector3& v0, const Math::Vector3& v1, const Math::Vector3& v2, const Color& color = Color::standard_renderer_lines, const float duration = 0.0f, const bool depth = true);
@@ -118,6 +128,7 @@ namespace Spartan
         static std::shared_ptr<RHI_BlendState> GetBlendState(const Renderer_BlendState type);
         static std::shared_ptr<RHI_Texture> GetRenderTarget(const Renderer_RenderTarget type);
         static std::shared_ptr<RHI_Shader> GetShader(const Renderer_Shader type);
+        static std::shared_ptr<RHI_Shader> GetShaderGbuffer(const uint32_t features);
         static std::shared_ptr<RHI_Sampler> GetSampler(const Renderer_Sampler type);
         static std::shared_ptr<RHI_ConstantBuffer>& GetConstantBufferFrame();
         static std::shared_ptr<RHI_Buffer> GetBuffer(const Renderer_Buffer type);
@@ -143,19 +154,25 @@ namespace Spartan
         static void CreateStandardMeshes();
         static void CreateStandardTextures();
         static void CreateStandardMaterials();
+        static void CreateGbufferPipelines(const bool materials_changed);
 
         // passes - core
+        static void RecordFrame(RHI_CommandList* cmd_list_graphics, RHI_CommandList* cmd_list_compute);
+        static void RenderThreadLoop();
         static void ProduceFrame(RHI_CommandList* cmd_list_graphics, RHI_CommandList* cmd_list_compute);
         static void Pass_VariableRateShading(RHI_CommandList* cmd_list);
         static void Pass_ShadowMaps(RHI_CommandList* cmd_list, const bool is_transparent_pass = false);
         static void Pass_Visibility(RHI_CommandList* cmd_list);
         static void Pass_Depth_Prepass(RHI_CommandList* cmd_list, const bool is_transparent_pass = false);
         static void Pass_GBuffer(RHI_CommandList* cmd_list, const bool is_transparent_pass = false);
+        static void Pass_VisibilityBuffer(RHI_CommandList* cmd_list);
+        static void Pass_GBuffer_NormalUnpack(RHI_CommandList* cmd_list);
         static void Pass_Ssao(RHI_CommandList* cmd_list);
         static void Pass_Ssr(RHI_CommandList* cmd_list);
         static void Pass_Sss(RHI_CommandList* cmd_list);
         static void Pass_Skysphere(RHI_CommandList* cmd_list);
         // passes - lighting
+        static void Pass_Light_TileClassification(RHI_CommandList* cmd_list);
         static void Pass_Light(RHI_CommandList* cmd_list, const bool is_transparent_pass = false);
         static void Pass_Light_GlobalIllumination(RHI_CommandList* cmd_list);
         static void Pass_Light_Composition(RHI_CommandList* cmd_list, RHI_Texture* tex_out, const bool is_transparent_pass = false);
@@ -167,7 +184,7 @@ namespace Spartan
         static void Pass_Lines(RHI_CommandList* cmd_list, RHI_Texture* tex_out);
         static void Pass_Outline(RHI_CommandList* cmd_list, RHI_Texture* tex_out);
         static void Pass_Icons(RHI_CommandList* cmd_list, RHI_Texture* tex_out);
-        static void Pass_Text(RHI_CommandList* cmd_list, RHI_Texture* tex_out);
+        static void Pass_Text(RHI_CommandList* cmd_list, RHI_Texture* tex_out, const bool clear = false);
         // passes - post-process
         static void Pass_PostProcess(RHI_CommandList* cmd_list);
         static void Pass_Output(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
@@ -176,6 +193,7 @@ namespace Spartan
         static void Pass_ChromaticAberration(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
         static void Pass_MotionBlur(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
         static void Pass_DepthOfField(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
+        static void Pass_TiledHalfResolution(RHI_CommandList* cmd_list, const std::array<RHI_Shader*, 4>& shaders, RHI_Texture* tex_in, RHI_Texture* tex_out);
         static void Pass_Bloom(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
         static void Pass_Sharpening(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);     
         static void Pass_Upscale(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
@@ -189,6 +207,8 @@ namespace Spartan
         static void OnSyncPoint(RHI_CommandList* cmd_list);
 
         // misc
+        static void UpdateRenderables();
+        static bool IsSceneChanging();
         static void AddLinesToBeRendered();
         static void SetGbufferTextures(RHI_CommandList* cmd_list);
         static void DestroyResources();
@@ -199,6 +219,7 @@ namespace Spartan
 
         // misc
         static std::unordered_map<Renderer_Entity, std::vector<std::shared_ptr<Entity>>> m_renderables;
+        static std::vector<Math::Vector3> m_audio_source_positions; // copied at the sync point, for the icons
         static Cb_Frame m_cb_frame_cpu;
         static Pcb_Pass m_pcb_pass_cpu;
         static std::shared_ptr<RHI_GeometryBuffer> m_vertex_buffer_lines;
@@ -211,5 +232,6 @@ namespace Spartan
         static std::atomic<bool> m_initialized_third_party;
         static std::atomic<uint32_t> m_environment_mips_to_filter_count;
         static std::mutex m_mutex_renderables;
+        static std::mutex m_mutex_lines;
     };
 }
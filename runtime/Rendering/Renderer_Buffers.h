@@ -71,7 +71,8 @@ namespace Spartan
         float resolution_scale;
 
         double time;
-        Math::Vector2 padding;
+        uint32_t material_texture_count;
+        float padding;
 
         void set_bit(const bool set, const uint32_t bit)
         {
@@ -106,6 +107,7 @@ namespace Spartan
                 hdr_max_nits                == rhs.hdr_max_nits               &&
                 hdr_white_point             == rhs.hdr_white_point            &&
                 directional_light_intensity == rhs.directional_light_intensity &&
+                material_texture_count      == rhs.material_texture_count     &&
                 options                     == rhs.options;
         }
 
@@ -213,6 +215,17 @@ namespace Spartan
         float clearcoat_roughness;
     };
 
+    struct Sb_VisibilityDraw
+    {
+        Math::Matrix transform;
+        Math::Matrix transform_previous;
+
+        uint32_t material_index = 0;
+        uint32_t index_offset   = 0;
+        uint32_t vertex_offset  = 0;
+        uint32_t geometry       = 0; // which vertex/index page pair the draw lives in
+    };
+
     struct Sb_Light
     {
         Math::Matrix view_projection[2];
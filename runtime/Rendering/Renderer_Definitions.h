@@ -30,6 +30,23 @@ namespace Spartan
     // we are using double buffering so 5 is enough
     constexpr uint8_t resources_frame_lifetime = 5;
 
+    // the visibility buffer packs the draw index (+1) into 12 bits, so one less than this can be drawn
+    constexpr uint32_t renderer_max_visibility_draws = 4096;
+
+    // 8x8 light tiles, enough for an 8k render resolution
+    constexpr uint32_t renderer_light_tile_capacity = (7680 / 8) * (4320 / 8);
+
+    // material features the g-buffer pixel shader is specialized on, one permutation per combination
+    enum Renderer_GbufferFeature : uint32_t
+    {
+        Renderer_GbufferFeature_Albedo    = 1U << 0,
+        Renderer_GbufferFeature_Normal    = 1U << 1,
+        Renderer_GbufferFeature_Surface   = 1U << 2, // roughness, metalness and occlusion
+        Renderer_GbufferFeature_Emission  = 1U << 3,
+        Renderer_GbufferFeature_AlphaTest = 1U << 4
+    };
+    constexpr uint32_t renderer_gbuffer_permutation_count = 1U << 5;
+
     enum class Renderer_Option : uint32_t
     {
         Aabb,
@@ -66,6 +83,9 @@ namespace Spartan
         ResolutionScale,
         DynamicResolution,
         OcclusionCulling,
+        RenderThread,
+        VisibilityBuffer,
+        OnDemandRendering,
         Max
     };
 
@@ -141,20 +161,28 @@ namespace Spartan
         sss              = 24,
 
         // bindless
-        materials = 25
+        materials = 25,
+
+        // visibility buffer
+        visibility = 26
     };
 
     enum class Renderer_BindingsUav
     {
-        sb_materials      = 0,
-        sb_lights         = 1,
-        tex               = 2,
-        tex2              = 3,
-        tex3              = 4,
-        tex4              = 5,
-        tex_sss           = 6,
-        sb_spd            = 7,
-        tex_spd           = 8,
+        sb_materials           = 0,
+        sb_lights              = 1,
+        tex                    = 2,
+        tex2                   = 3,
+        tex3                   = 4,
+        tex4                   = 5,
+        tex_sss                = 6,
+        sb_spd                 = 7,
+        tex_spd                = 8, // up to 19, one per mip
+        sb_visibility_indices  = 20,
+        sb_visibility_vertices = 21,
+        sb_visibility_draws    = 22,
+        sb_light_tiles         = 23,
+        sb_light_tile_args     = 24,
     };
 
     enum class Renderer_Shader : uint8_t
@@ -163,6 +191,10 @@ namespace Spartan
         tessellation_d,
         gbuffer_v,
         gbuffer_p,
+        gbuffer_normal_unpack_c,
+        visibility_buffer_v,
+        visibility_buffer_p,
+        visibility_buffer_resolve_c,
         depth_prepass_v,
         depth_prepass_alpha_test_p,
         depth_light_v,
@@ -171,8 +203,14 @@ namespace Spartan
         quad_p,
         fxaa_c,
         film_grain_c,
+        motion_blur_tile_max_c,
+        motion_blur_tile_dilate_c,
         motion_blur_c,
+        motion_blur_upsample_c,
+        depth_of_field_tile_max_c,
+        depth_of_field_tile_dilate_c,
         depth_of_field_c,
+        depth_of_field_upsample_c,
         chromatic_aberration_c,
         bloom_luminance_c,
         bloom_downsample_c,
@@ -182,8 +220,12 @@ namespace Spartan
         light_integration_brdf_specular_lut_c,
         light_integration_environment_filter_c,
         light_c,
+        light_tile_classification_c,
+        light_tiled_c,
+        light_tiled_simple_c,
         light_composition_c,
         light_image_based_c,
+        light_image_based_tiled_c,
         line_v,
         line_p,
         grid_v,
@@ -209,8 +251,10 @@ namespace Spartan
     {
         gbuffer_color,
         gbuffer_normal,
+        gbuffer_normal_unpacked,
         gbuffer_material,
         gbuffer_velocity,
+        gbuffer_visibility,
         gbuffer_depth,
         gbuffer_depth_opaque,
         gbuffer_depth_backface,
@@ -233,6 +277,9 @@ namespace Spartan
         skysphere,
         bloom,
         blur,
+        post_process_half,
+        post_process_tile,
+        post_process_tile_dilated,
         outline,
         shading_rate,
         reactive,
@@ -266,6 +313,10 @@ namespace Spartan
         Spd,
         Materials,
         Lights,
+        VisibilityDraws,
+        LightTiles,
+        LightTileArgs,
+        InstanceUpload,
         Max
     };
 
@@ -312,6 +363,15 @@ namespace Spartan
         Additive
     };
 
+    // tile lists produced by the light tile classification
+    enum class Renderer_LightTile : uint32_t
+    {
+        Simple,  // isotropic specular and diffuse only
+        Complex, // anisotropy, clearcoat, sheen or subsurface scattering
+        Sky,     // only volumetric lighting
+        Max
+    };
+
     enum class Renderer_DownsampleFilter
     {
         Max,
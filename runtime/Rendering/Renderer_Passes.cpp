@@ -23,6 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "pch.h"
 #include "Renderer.h"
 #include "ProgressTracker.h"
+#include "OcclusionBuffer.h"
+#include "../Core/ThreadPool.h"
 #include "../Display/Display.h"
 #include "../Profiling/Profiler.h"
 #include "../World/Entity.h"
@@ -30,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Light.h"
 #include "../RHI/RHI_Device.h"
 #include "../RHI/RHI_CommandList.h"
+#include "../RHI/RHI_Buffer.h"
 #include "../RHI/RHI_GeometryBuffer.h"
 #include "../RHI/RHI_Shader.h"
 #include "../RHI/RHI_FidelityFX.h"
@@ -59,19 +62,15 @@ namespace Spartan
         namespace visibility
         {
             unordered_map<uint64_t, float> distances_squared;
-            unordered_map<uint64_t, Rectangle> rectangles;
-            unordered_map<uint64_t, BoundingBox> boxes;
 
             void clear()
             {
                 distances_squared.clear();
-                rectangles.clear();
-                boxes.clear();
             }
 
             float get_squared_distance(const shared_ptr<Entity>& entity)
             {
-                Vector3 camera_position = Renderer::GetCamera()->GetEntity()->GetPosition();
+                Vector3 camera_position = Renderer::GetCamera()->GetProxy().position;
                 uint64_t entity_id      = entity->GetObjectId();
 
                 auto it = distances_squared.find(entity_id);
@@ -82,7 +81,7 @@ namespace Spartan
                 else
                 {
                     shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
-                    Vector3 position                  = renderable->GetBoundingBox(BoundingBoxType::Transformed).GetCenter();
+                    Vector3 position                  = renderable->GetProxy().bounding_box_transformed.GetCenter();
                     float distance_squared            = (position - camera_position).LengthSquared();
                     distances_squared[entity_id]      = distance_squared;
 
@@ -96,6 +95,7 @@ namespace Spartan
                 {
                     shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
                     renderable->SetFlag(RenderableFlags::OccludedCpu, !Renderer::GetCamera()->IsInViewFrustum(renderable));
+                    renderable->SetFlag(RenderableFlags::Occluded, false);
                     renderable->SetFlag(RenderableFlags::Occluder, false);
                 }
             }
@@ -189,153 +189,415 @@ namespace Spartan
                 }
             }
 
-            void determine_occluders(vector<shared_ptr<Entity>>& renderables)
+            void occlusion_culling(vector<shared_ptr<Entity>>& renderables, const Matrix& view_projection)
             {
+                static OcclusionBuffer occlusion_buffer;
+                const uint32_t occluder_count_max    = 32;
+                const uint32_t occluder_requests_max = 4; // occluders are built on the thread pool, spread them over a few frames
+
+                Stopwatch timer;
+                Camera* camera = Renderer::GetCamera().get();
+                occlusion_buffer.Clear(view_projection);
+
+                // 1. pick occluders, renderables are sorted front to back so the closest ones are considered first
                 uint32_t occluder_count = 0;
+                uint32_t request_count  = 0;
                 for (shared_ptr<Entity>& entity : renderables)
                 {
                     shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
-                    if (!renderable || renderable->HasFlag(RenderableFlags::OccludedCpu))
+                    if (occluder_count >= occluder_count_max || renderable->HasFlag(RenderableFlags::OccludedCpu))
                         continue;
 
-                    // compute screen space rectangle
-                    BoundingBox box                   = renderable->GetBoundingBox(BoundingBoxType::Transformed);
-                    Rectangle rectangle               = Renderer::GetCamera()->WorldToScreenCoordinates(box);
-                    boxes[entity->GetObjectId()]      = box;
-                    rectangles[entity->GetObjectId()] = rectangle;
+                    // transparent and instanced (vegetation) geometry is a poor occluder
+                    if (renderable->GetMaterial()->IsTransparent() || renderable->HasInstancing())
+                        continue;
 
-                    bool factor_screen_size = rectangle.Area() >= 65536.0f;
-                    bool factor_inside      = box.Contains(Renderer::GetCamera()->GetEntity()->GetPosition()); // say we are in a building
-                    bool factor_count       = occluder_count < 32;
-                    if (factor_count && factor_screen_size && !factor_inside)
+                    const BoundingBox& box  = renderable->GetProxy().bounding_box_transformed;
+                    bool factor_screen_size = camera->GetProxy().WorldToScreenCoordinates(box).Area() >= 65536.0f;
+                    bool factor_inside      = box.Contains(camera->GetProxy().position); // say we are in a building
+                    if (!factor_screen_size || factor_inside)
+                        continue;
+
+                    if (!renderable->HasOccluderGeometry())
                     {
-                        renderable->SetFlag(RenderableFlags::Occluder, true);
-                        occluder_count++;
+                        if (!renderable->IsOccluderGeometryRequested() && request_count < occluder_requests_max)
+                        {
+                            renderable->RequestOccluderGeometry();
+                            request_count++;
+                        }
+
+                        continue;
                     }
+
+                    occlusion_buffer.AddOccluder(renderable->GetOccluderPositions(), renderable->GetOccluderIndices(), renderable->GetProxy().transform);
+                    renderable->SetFlag(RenderableFlags::Occluder, true);
+                    occluder_count++;
                 }
+
+                // 2. rasterize
+                occlusion_buffer.Rasterize();
+
+                // 3. test everything that survived frustum culling, except the occluders themselves
+                uint32_t tested_count = 0;
+                uint32_t culled_count = 0;
+                if (occluder_count > 0)
+                {
+                    for (shared_ptr<Entity>& entity : renderables)
+                    {
+                        shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
+                        if (renderable->HasFlag(RenderableFlags::OccludedCpu) || renderable->HasFlag(RenderableFlags::Occluder))
+                            continue;
+
+                        bool occluded = occlusion_buffer.IsOccluded(renderable->GetProxy().bounding_box_transformed);
+                        renderable->SetFlag(RenderableFlags::Occluded, occluded);
+                        tested_count++;
+                        culled_count += occluded ? 1 : 0;
+                    }
+                }
+
+                Profiler::m_occlusion_occluders = occluder_count;
+                Profiler::m_occlusion_tested    = tested_count;
+                Profiler::m_occlusion_culled    = culled_count;
+                Profiler::m_occlusion_time      = timer.GetElapsedTimeMs();
             }
+        }
 
-            void remove_false_gpu_occlusion(shared_ptr<Entity>& entity_occludee, vector<shared_ptr<Entity>>& entities)
+        namespace shadows
+        {
+            const float caster_size_min = 2.0f; // in texels, smaller casters wouldn't make a visible difference in a slice
+
+            struct caster
             {
-                // if this entity is outside of the view frustum, don't bother
-                shared_ptr<Renderable> renderable_occludee = entity_occludee->GetComponent<Renderable>();
-                if (!renderable_occludee || renderable_occludee->HasFlag(OccludedCpu))
-                    return;
+                uint32_t index      = 0; // into the mesh renderables
+                uint32_t slice_mask = 0; // the slices it's drawn in
+            };
 
-                bool is_visible         = true;
-                uint32_t occluder_count = 0;
-                for (shared_ptr<Entity>& entity_occluder : entities)
+            // per light (object id) and slice, ascending indices into the mesh renderables
+            unordered_map<uint64_t, array<vector<uint32_t>, 2>> casters_per_slice;
+
+            // per light (object id), the above merged so that all slices are drawn in one pass
+            unordered_map<uint64_t, vector<caster>> casters;
+            atomic<uint32_t> caster_count_considered = 0;
+            atomic<uint32_t> caster_count_drawn      = 0;
+
+            float distance_to_box(const Vector3& position, const BoundingBox& box)
+            {
+                Vector3 closest = Vector3(
+                    Helper::Clamp(position.x, box.GetMin().x, box.GetMax().x),
+                    Helper::Clamp(position.y, box.GetMin().y, box.GetMax().y),
+                    Helper::Clamp(position.z, box.GetMin().z, box.GetMax().z)
+                );
+
+                return Vector3::Distance(position, closest);
+            }
+
+            void build_caster_list(Light* light, const uint32_t slice, vector<shared_ptr<Entity>>& meshes, vector<uint32_t>& list)
+            {
+                const light_proxy& proxy = light->GetProxy();
+                const LightType type     = light->GetLightType();
+                const float resolution   = static_cast<float>(light->GetDepthTexture()->GetWidth());
+
+                // volumetric lights also shadow the air between the camera and the receivers, so they keep every caster
+                const bool cull_by_receivers = !light->IsFlagSet(LightFlags::Volumetric);
+
+                // 1. bound the receivers, the camera visible renderables that fall within this slice
+                // directional lights bound them in light space, where the light looks down +z
+                BoundingBox receivers = BoundingBox::Undefined;
+                if (cull_by_receivers)
                 {
-                    shared_ptr<Renderable> renderable_occluder = entity_occluder->GetComponent<Renderable>();
-                    if (!renderable_occluder || entity_occludee->GetObjectId() == entity_occluder->GetObjectId())
+                    for (shared_ptr<Entity>& entity : meshes)
+                    {
+                        shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
+                        if (!renderable->IsVisible() || !light->IsInViewFrustum(renderable.get(), slice))
+                            continue;
+
+                        const BoundingBox& box = renderable->GetProxy().bounding_box_transformed;
+                        receivers.Merge(type == LightType::Directional ? box.Transform(proxy.view[slice]) : box);
+                    }
+
+                    // nothing visible receives shadows from this slice
+                    if (receivers == BoundingBox::Undefined)
+                        return;
+                }
+
+                // the farthest a receiver can be from a local light
+                float receiver_distance_max = numeric_limits<float>::max();
+                if (cull_by_receivers && type != LightType::Directional)
+                {
+                    receiver_distance_max = 0.0f;
+                    for (const Vector3& corner : receivers.GetCorners())
+                    {
+                        receiver_distance_max = max(receiver_distance_max, Vector3::Distance(proxy.position, corner));
+                    }
+                }
+
+                // 2. keep the casters whose shadow volume can reach the receivers
+                for (uint32_t i = 0; i < static_cast<uint32_t>(meshes.size()); i++)
+                {
+                    shared_ptr<Renderable> renderable = meshes[i]->GetComponent<Renderable>();
+                    if (!renderable->HasFlag(RenderableFlags::CastsShadows))
+                        continue;
+
+                    caster_count_considered++;
+
+                    if (!light->IsInViewFrustum(renderable.get(), slice))
                         continue;
 
-                    if (renderable_occluder->HasFlag(Occluder))
+                    const BoundingBox& box = renderable->GetProxy().bounding_box_transformed;
+                    if (type == LightType::Directional)
                     {
-                        // project world space axis-aligned bounding boxes into screen space
-                        Rectangle& rectangle_occludee = rectangles[entity_occludee->GetObjectId()];
-                        Rectangle& rectangle_occluder = rectangles[entity_occluder->GetObjectId()];
+                        // the shadow volume is the caster's light space box, extruded along +z
+                        BoundingBox box_light = box.Transform(proxy.view[slice]);
+                        const Vector3& c_min  = box_light.GetMin();
+                        const Vector3& c_max  = box_light.GetMax();
 
-                        // if it's contained by at least one occluder, it's not visible
-                        if (rectangle_occluder.Contains(rectangle_occludee))
+                        if (cull_by_receivers)
                         {
-                            is_visible = false;
-                            break;
+                            const Vector3& r_min = receivers.GetMin();
+                            const Vector3& r_max = receivers.GetMax();
+                            bool overlaps_xy     = c_max.x >= r_min.x && c_min.x <= r_max.x && c_max.y >= r_min.y && c_min.y <= r_max.y;
+                            bool behind          = c_min.z > r_max.z;
+                            if (!overlaps_xy || behind)
+                                continue;
                         }
 
-                        occluder_count++;
+                        // orthographic, so the size in texels only depends on the cascade extent
+                        float size = max(c_max.x - c_min.x, c_max.y - c_min.y) * proxy.projection[slice].m00 * 0.5f * resolution;
+                        if (size < caster_size_min)
+                            continue;
+                    }
+                    else
+                    {
+                        // a caster farther than every receiver shadows nothing visible
+                        float distance = distance_to_box(proxy.position, box);
+                        if (distance > receiver_distance_max)
+                            continue;
+
+                        // perspective, paraboloids are left alone as their projection isn't linear
+                        if (type == LightType::Spot)
+                        {
+                            Vector3 box_size = box.GetSize();
+                            float size       = max({ box_size.x, box_size.y, box_size.z }) * proxy.projection[slice].m00 * 0.5f * resolution / max(distance, 0.01f);
+                            if (size < caster_size_min)
+                                continue;
+                        }
                     }
 
-                    // use the 4 first (and front most) occluders
-                    if (occluder_count > 4)
-                        break;
+                    list.emplace_back(i);
                 }
 
-                if (is_visible)
-                {
-                    renderable_occludee->SetFlag(RenderableFlags::OccludedGpu, false);
-                }
+                caster_count_drawn += static_cast<uint32_t>(list.size());
             }
 
-            void get_gpu_occlusion_query_results(RHI_CommandList* cmd_list, unordered_map<Renderer_Entity, vector<shared_ptr<Entity>>>& renderables)
+            void build_caster_lists(vector<shared_ptr<Entity>>& lights, vector<shared_ptr<Entity>>& meshes)
             {
-                cmd_list->UpdateOcclusionQueries();
+                caster_count_considered = 0;
+                caster_count_drawn      = 0;
 
-                bool is_transparent_pass = false;
-                uint32_t start_index     = !is_transparent_pass ? 0 : 2;
-                uint32_t end_index       = !is_transparent_pass ? 2 : 4;
-                for (uint32_t i = start_index; i < end_index; i++)
+                // one job per light slice, each writing only to its own list
+                vector<Light*> lights_shadowed;
+                vector<tuple<Light*, uint32_t, vector<uint32_t>*>> jobs;
+                for (shared_ptr<Entity>& entity : lights)
                 {
-                    auto& entities = renderables[static_cast<Renderer_Entity>(i)];
-                    if (entities.empty())
+                    Light* light = entity->GetComponent<Light>().get();
+                    if (!light || !light->IsFlagSet(LightFlags::Shadows) || light->GetProxy().intensity_watt == 0.0f || !light->GetDepthTexture())
                         continue;
 
-                    for (shared_ptr<Entity>& entity : entities)
+                    lights_shadowed.emplace_back(light);
+                    array<vector<uint32_t>, 2>& light_casters = casters_per_slice[light->GetObjectId()];
+                    for (uint32_t slice = 0; slice < light->GetSliceCount(); slice++)
                     {
-                        shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
-                        if (!renderable)
-                            continue;
+                        light_casters[slice].clear();
+                        jobs.emplace_back(light, slice, &light_casters[slice]);
+                    }
+                }
 
-                        bool occluded = cmd_list->GetOcclusionQueryResult(entity->GetObjectId());
-                        renderable->SetFlag(RenderableFlags::OccludedGpu, occluded);
+                auto build = [&jobs, &meshes](uint32_t job_start, uint32_t job_end)
+                {
+                    for (uint32_t i = job_start; i < job_end; i++)
+                    {
+                        auto& [light, slice, list] = jobs[i];
+                        build_caster_list(light, slice, meshes, *list);
+                    }
+                };
 
-                        // counter occlusion query latency by removing false gpu occlusions
-                        if (occluded)
-                        {
-                            remove_false_gpu_occlusion(entity, entities);
-                        }
+                uint32_t job_count = static_cast<uint32_t>(jobs.size());
+                if (job_count > 1 && ThreadPool::GetIdleThreadCount() > 0)
+                {
+                    ThreadPool::ParallelLoop(build, job_count);
+                }
+                else
+                {
+                    build(0, job_count);
+                }
+
+                // merge the (ascending) slice lists, a caster in both slices becomes a single draw
+                for (Light* light : lights_shadowed)
+                {
+                    const array<vector<uint32_t>, 2>& slices = casters_per_slice[light->GetObjectId()];
+                    vector<caster>& merged                   = casters[light->GetObjectId()];
+                    merged.clear();
+
+                    size_t i = 0, j = 0;
+                    while (i < slices[0].size() || j < slices[1].size())
+                    {
+                        uint32_t index_a = i < slices[0].size() ? slices[0][i] : numeric_limits<uint32_t>::max();
+                        uint32_t index_b = j < slices[1].size() ? slices[1][j] : numeric_limits<uint32_t>::max();
+                        uint32_t index   = min(index_a, index_b);
+                        uint32_t mask    = (index_a == index ? 1U : 0U) | (index_b == index ? 2U : 0U);
+                        i               += index_a == index ? 1 : 0;
+                        j               += index_b == index ? 1 : 0;
+
+                        merged.push_back({ index, mask });
                     }
                 }
+
+                Profiler::m_shadow_casters_considered = caster_count_considered;
+                Profiler::m_shadow_casters_drawn      = caster_count_drawn;
             }
         }
 
-        void draw_renderable(RHI_CommandList* cmd_list, RHI_PipelineState& pso, Camera* camera, Renderable* renderable, Light* light = nullptr, uint32_t array_index = 0)
+        namespace visibility_buffer
         {
-            uint32_t instance_start_index = 0;
-            bool draw_instanced           = pso.instancing && renderable->HasInstancing();
+            // filled by the g-buffer pass, shaded by the visibility buffer pass
+            vector<shared_ptr<Renderable>> draws;
+            vector<Sb_VisibilityDraw> draw_data;
+            vector<pair<RHI_GeometryBuffer*, RHI_GeometryBuffer*>> geometry; // vertex and index page pairs
+
+            // only what the resolve can reproduce exactly, everything else goes through the g-buffer pass
+            bool is_compatible(Renderable* renderable)
+            {
+                Material* material = renderable->GetMaterial();
+                if (!material || renderable->HasInstancing() || !renderable->GetVertexBuffer() || !renderable->GetIndexBuffer())
+                    return false;
+
+                // the triangle index has to fit in 20 bits
+                if (renderable->GetIndexCount() / 3 > (1U << 20))
+                    return false;
+
+                return !material->IsTessellated()                                   &&
+                       !material->IsAlphaTested()                                   &&
+                       !material->GetProperty(MaterialProperty::TextureSlopeBased)  &&
+                       !material->GetProperty(MaterialProperty::VertexAnimateWind)  &&
+                       !material->GetProperty(MaterialProperty::VertexAnimateWater);
+            }
+
+            uint32_t get_geometry_index(RHI_GeometryBuffer* vertex_buffer, RHI_GeometryBuffer* index_buffer)
+            {
+                for (uint32_t i = 0; i < static_cast<uint32_t>(geometry.size()); i++)
+                {
+                    if (geometry[i].first == vertex_buffer && geometry[i].second == index_buffer)
+                        return i;
+                }
+
+                geometry.emplace_back(vertex_buffer, index_buffer);
+                return static_cast<uint32_t>(geometry.size()) - 1;
+            }
+        }
+
+        namespace gbuffer
+        {
+            // draws of the current pass, ordered by sort key
+            vector<pair<uint32_t, shared_ptr<Renderable>>> draws;
+
+            uint32_t get_features(Material* material)
+            {
+                uint32_t features = 0;
+                features |= material->HasTexture(MaterialTexture::Color)     ? static_cast<uint32_t>(Renderer_GbufferFeature_Albedo)    : 0;
+                features |= material->HasTexture(MaterialTexture::Normal)    ? static_cast<uint32_t>(Renderer_GbufferFeature_Normal)    : 0;
+                features |= material->HasTexture(MaterialTexture::Roughness) ? static_cast<uint32_t>(Renderer_GbufferFeature_Surface)   : 0;
+                features |= material->HasTexture(MaterialTexture::Metalness) ? static_cast<uint32_t>(Renderer_GbufferFeature_Surface)   : 0;
+                features |= material->HasTexture(MaterialTexture::Occlusion) ? static_cast<uint32_t>(Renderer_GbufferFeature_Surface)   : 0;
+                features |= material->HasTexture(MaterialTexture::Emission)  ? static_cast<uint32_t>(Renderer_GbufferFeature_Emission)  : 0;
+                features |= material->IsAlphaTested()                        ? static_cast<uint32_t>(Renderer_GbufferFeature_AlphaTest) : 0;
+
+                return features;
+            }
+
+            // groups draws that share a pipeline: instancing, tessellation and the pixel shader permutation
+            uint32_t get_sort_key(Renderable* renderable)
+            {
+                Material* material = renderable->GetMaterial();
+                if (!material)
+                    return 0;
+
+                uint32_t key  = get_features(material);
+                key          |= material->IsTessellated()   ? renderer_gbuffer_permutation_count      : 0;
+                key          |= renderable->HasInstancing() ? renderer_gbuffer_permutation_count << 1 : 0;
+
+                return key;
+            }
+
+            // the sort keys the scene's materials use, and those whose pipeline hasn't been built yet
+            unordered_set<uint32_t> keys;
+            unordered_set<uint32_t> keys_pending;
+            uint64_t pipeline_base_hash = 0;
+
+            // everything but the permutation, which the sort key selects
+            void set_pipeline_state(RHI_PipelineState& pso, const bool is_transparent_pass)
+            {
+                pso.name                              = is_transparent_pass ? "g_buffer_transparent" : "g_buffer";
+                pso.shaders[RHI_Shader_Type::Vertex]  = Renderer::GetShader(Renderer_Shader::gbuffer_v).get();
+                pso.shaders[RHI_Shader_Type::Pixel]   = Renderer::GetShader(Renderer_Shader::gbuffer_p).get();
+                pso.blend_state                       = Renderer::GetBlendState(Renderer_BlendState::Off).get();
+                pso.rasterizer_state                  = Renderer::GetRasterizerState(Renderer::GetOption<bool>(Renderer_Option::Wireframe) ? Renderer_RasterizerState::Wireframe : Renderer_RasterizerState::Solid).get();
+                pso.depth_stencil_state               = Renderer::GetDepthStencilState(Renderer_DepthStencilState::Read).get();
+                pso.vrs_input_texture                 = Renderer::GetOption<bool>(Renderer_Option::VariableRateShading) ? Renderer::GetRenderTarget(Renderer_RenderTarget::shading_rate).get() : nullptr;
+                pso.resolution_scale                  = true;
+                pso.render_target_color_textures[0]   = Renderer::GetRenderTarget(Renderer_RenderTarget::gbuffer_color).get();
+                pso.render_target_color_textures[1]   = Renderer::GetRenderTarget(Renderer_RenderTarget::gbuffer_normal).get();
+                pso.render_target_color_textures[2]   = Renderer::GetRenderTarget(Renderer_RenderTarget::gbuffer_material).get();
+                pso.render_target_color_textures[3]   = Renderer::GetRenderTarget(Renderer_RenderTarget::gbuffer_velocity).get();
+                pso.render_target_depth_texture       = Renderer::GetRenderTarget(Renderer_RenderTarget::gbuffer_depth).get();
+                pso.clear_color[0]                    = !is_transparent_pass ? Color::standard_transparent : rhi_color_load;
+                pso.clear_color[1]                    = !is_transparent_pass ? Color::standard_transparent : rhi_color_load;
+                pso.clear_color[2]                    = !is_transparent_pass ? Color::standard_transparent : rhi_color_load;
+                pso.clear_color[3]                    = !is_transparent_pass ? Color::standard_transparent : rhi_color_load;
+            }
+        }
+
+        void draw_renderable(RHI_CommandList* cmd_list, RHI_PipelineState& pso, Camera* camera, Renderable* renderable, Light* light = nullptr, const uint32_t slice_mask = 1)
+        {
+            bool draw_instanced = pso.instancing && renderable->HasInstancing();
 
             if (draw_instanced)
             {
-                for (uint32_t group_index = 0; group_index < renderable->GetInstancePartitionCount(); group_index++)
+                const renderable_proxy& proxy = renderable->GetProxy();
+                for (uint32_t group_index = 0; group_index < static_cast<uint32_t>(proxy.instance_groups.size()); group_index++)
                 {
-                    uint32_t group_end_index = renderable->GetBoundingBoxGroupEndIndices()[group_index];
-                    uint32_t instance_count  = group_end_index - instance_start_index;
+                    const instance_group& group = proxy.instance_groups[group_index];
+                    if (group.count == 0)
+                        continue;
 
                     // skip instance groups outside of the view frustum
                     {
-                        const BoundingBox& bounding_box_group = renderable->GetBoundingBox(BoundingBoxType::TransformedInstanceGroup, group_index);
+                        const BoundingBox& bounding_box_group = proxy.bounding_box_instance_group[group_index];
 
                         if (light)
                         {
-                            if (!light->IsInViewFrustum(renderable, array_index))
+                            // all the light's slices are drawn at once, so keep the group if any of them sees it
+                            bool visible = false;
+                            for (uint32_t slice = 0; slice < light->GetSliceCount(); slice++)
                             {
-                                instance_start_index = group_end_index;
-                                continue;
+                                visible |= (slice_mask & (1U << slice)) && light->IsInViewFrustum(bounding_box_group, slice);
                             }
+
+                            if (!visible)
+                                continue;
                         }
                         else if (!camera->IsInViewFrustum(bounding_box_group))
                         {
-                            instance_start_index = group_end_index;
                             continue;
                         }
                     }
 
-                    // skip this iteration if we've reached the total number of instances
-                    if (instance_start_index + instance_count >= renderable->GetInstanceCount())
-                        continue;
-
-                    if (instance_count > 0)
-                    {
-                        cmd_list->DrawIndexed(
-                            renderable->GetIndexCount(),
-                            renderable->GetIndexOffset(),
-                            renderable->GetVertexOffset(),
-                            instance_start_index,
-                            instance_count
-                        );
-                    }
-
-                    instance_start_index = group_end_index;
+                    cmd_list->DrawIndexed(
+                        renderable->GetIndexCount(),
+                        renderable->GetIndexOffset(),
+                        renderable->GetVertexOffset(),
+                        group.start,
+                        group.count
+                    );
                 }
             }
             else 
@@ -439,8 +701,12 @@ namespace Spartan
             }
         }
 
-        if (shared_ptr<Camera> camera = GetCamera())
+        shared_ptr<Camera> camera = GetCamera();
+        if (camera)
         { 
+            // cull and sort first, shadow casters are culled against what the camera sees
+            Pass_Visibility(cmd_list_graphics);
+
             // shadow maps
             {
                 Pass_ShadowMaps(cmd_list_graphics, false);
@@ -452,12 +718,14 @@ namespace Spartan
  
             // opaque
             {
-                Pass_Visibility(cmd_list_graphics);
                 Pass_Depth_Prepass(cmd_list_graphics, false);
                 Pass_GBuffer(cmd_list_graphics);
+                Pass_VisibilityBuffer(cmd_list_graphics);
+                Pass_GBuffer_NormalUnpack(cmd_list_graphics);
                 Pass_Ssr(cmd_list_graphics);
                 Pass_Ssao(cmd_list_graphics);
                 Pass_Sss(cmd_list_graphics);
+                Pass_Light_TileClassification(cmd_list_graphics);     // sort screen tiles by the lighting features they need
                 Pass_Light(cmd_list_graphics);                        // compute diffuse and specular buffers
                 Pass_Light_GlobalIllumination(cmd_list_graphics);     // compute global illumination
                 Pass_Light_Composition(cmd_list_graphics, rt_render); // compose diffuse, specular, ssgi, volumetric etc.
@@ -496,12 +764,9 @@ namespace Spartan
             Pass_Outline(cmd_list_graphics, rt_output);
             Pass_Icons(cmd_list_graphics, rt_output);
         }
-        else
-        {
-            cmd_list_graphics->ClearTexture(rt_output, Color::standard_black);
-        }
 
-        Pass_Text(cmd_list_graphics, rt_output);
+        // without a camera nothing wrote the output, so the text pass clears it
+        Pass_Text(cmd_list_graphics, rt_output, !camera);
 
         // transition the render target to a readable state so it can be rendered
         // within the viewport or copied to the swap chain back buffer
@@ -549,6 +814,12 @@ namespace Spartan
         lock_guard lock(m_mutex_renderables);
         cmd_list->BeginTimeblock(is_transparent_pass ? "shadow_maps_alpha_color" : "shadow_maps_depth");
 
+        // the caster lists are shared by the opaque and the transparent pass
+        if (!is_transparent_pass)
+        {
+            shadows::build_caster_lists(lights, m_renderables[Renderer_Entity::Mesh]);
+        }
+
         // set pso
         static RHI_PipelineState pso;
         pso.shaders[RHI_Shader_Type::Vertex] = shader_v;
@@ -562,7 +833,7 @@ namespace Spartan
         for (shared_ptr<Entity>& light_entity : lights)
         {
             shared_ptr<Light> light = light_entity->GetComponent<Light>();
-            if (!light || !light->IsFlagSet(LightFlags::Shadows) || light->GetIntensityWatt() == 0.0f)
+            if (!light || !light->IsFlagSet(LightFlags::Shadows) || light->GetProxy().intensity_watt == 0.0f)
                 continue;
 
             // skip lights that don't cast transparent shadows (if this is a transparent pass)
@@ -584,29 +855,40 @@ namespace Spartan
                 }
             }
 
-            // iterate over light cascade/faces
-            for (uint32_t array_index = 0; array_index < pso.render_target_depth_texture->GetArrayLength(); array_index++)
+            auto it = shadows::casters.find(light->GetObjectId());
+            if (it == shadows::casters.end())
+                continue;
+
+            // casters in every slice are drawn in all of them at once with multiview, the rest are drawn per
+            // slice, so that multiview never pays vertex work for a slice that a draw has been culled from
+            const uint32_t slice_mask_all = (1U << light->GetSliceCount()) - 1;
+            int64_t index_start           = get_mesh_indices(m_renderables[Renderer_Entity::Mesh], is_transparent_pass, true);
+            int64_t index_end             = get_mesh_indices(m_renderables[Renderer_Entity::Mesh], is_transparent_pass, false);
+            cmd_list->SetIgnoreClearValues(is_transparent_pass);
+
+            // iterate over the casters, within the opaque or transparent range, which are drawn in the given slices
+            auto draw_casters = [&](const uint32_t slice_start, const uint32_t slice_count)
             {
-                pso.render_target_array_index = array_index;
-                cmd_list->SetIgnoreClearValues(is_transparent_pass);
+                pso.render_target_array_index = slice_start;
+                pso.render_target_view_count  = slice_count;
+                const uint32_t slice_mask     = ((1U << slice_count) - 1) << slice_start;
+                const bool is_multiview       = slice_mask == slice_mask_all;
 
-                // iterate over entities
-                int64_t index_start = get_mesh_indices(m_renderables[Renderer_Entity::Mesh], is_transparent_pass, true);
-                int64_t index_end   = get_mesh_indices(m_renderables[Renderer_Entity::Mesh], is_transparent_pass, false);
-                for (int64_t i = index_start; i < index_end; i++)
+                bool drawn = false;
+                for (const shadows::caster& caster : it->second)
                 {
-                    // this can happen during async loading
-                    if (i >= static_cast<int64_t>(m_renderables[Renderer_Entity::Mesh].size()))
+                    if (caster.index < index_start || caster.index >= index_end)
                         continue;
 
-                    shared_ptr<Entity>& entity        = m_renderables[Renderer_Entity::Mesh][i];
-                    shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
-                    if (!renderable || !renderable->HasFlag(RenderableFlags::CastsShadows))
+                    if (is_multiview ? caster.slice_mask != slice_mask_all : (caster.slice_mask == slice_mask_all || (caster.slice_mask & slice_mask) == 0))
                         continue;
 
-                    if (!light->IsInViewFrustum(renderable.get(), array_index))
+                    // this can happen during async loading
+                    if (caster.index >= static_cast<uint32_t>(m_renderables[Renderer_Entity::Mesh].size()))
                         continue;
 
+                    shared_ptr<Renderable> renderable = m_renderables[Renderer_Entity::Mesh][caster.index]->GetComponent<Renderable>();
+
                     cmd_list->SetCullMode(static_cast<RHI_CullMode>(renderable->GetMaterial()->GetProperty(MaterialProperty::CullMode)));
 
                     // set pipeline
@@ -633,8 +915,8 @@ namespace Spartan
                     // set pass constants
                     {
                         // for the vertex shader
-                        m_pcb_pass_cpu.set_f3_value2(static_cast<float>(light->GetIndex()), static_cast<float>(array_index), 0.0f);
-                        m_pcb_pass_cpu.transform = entity->GetMatrix();
+                        m_pcb_pass_cpu.set_f3_value2(static_cast<float>(light->GetIndex()), static_cast<float>(slice_start), 0.0f);
+                        m_pcb_pass_cpu.transform = renderable->GetProxy().transform;
 
                         // for the pixel shader
                         if (Material* material = renderable->GetMaterial())
@@ -650,7 +932,25 @@ namespace Spartan
                         cmd_list->PushConstants(m_pcb_pass_cpu);
                     }
 
-                    draw_renderable(cmd_list, pso, GetCamera().get(), renderable.get(), light.get(), array_index);
+                    draw_renderable(cmd_list, pso, GetCamera().get(), renderable.get(), light.get(), slice_mask);
+                    drawn = true;
+                }
+
+                return drawn;
+            };
+
+            // a light without casters in every slice still has to be cleared, which starting the render pass does
+            if (!draw_casters(0, light->GetSliceCount()) && !is_transparent_pass)
+            {
+                cmd_list->SetPipelineState(pso);
+                cmd_list->SetIgnoreClearValues(true);
+            }
+
+            if (light->GetSliceCount() > 1)
+            {
+                for (uint32_t slice = 0; slice < light->GetSliceCount(); slice++)
+                {
+                    draw_casters(slice, 1);
                 }
             }
         }
@@ -670,7 +970,7 @@ namespace Spartan
 
         if (GetOption<bool>(Renderer_Option::OcclusionCulling))
         {
-            visibility::determine_occluders(m_renderables[Renderer_Entity::Mesh]);
+            visibility::occlusion_culling(m_renderables[Renderer_Entity::Mesh], m_cb_frame_cpu.view_projection_unjittered);
         }
 
         cmd_list->EndTimeblock();
@@ -703,7 +1003,7 @@ namespace Spartan
 
                 shared_ptr<Entity>& entity        = m_renderables[Renderer_Entity::Mesh][i];
                 shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
-                if (!renderable || renderable->HasFlag(RenderableFlags::OccludedCpu))
+                if (!renderable || !renderable->IsVisible())
                     continue;
 
                 // toggles
@@ -768,21 +1068,11 @@ namespace Spartan
                         m_pcb_pass_cpu.set_is_transparent_and_material_index(is_transparent_pass, material->GetIndex());
                     }
 
-                    m_pcb_pass_cpu.transform = entity->GetMatrix();
+                    m_pcb_pass_cpu.transform = renderable->GetProxy().transform;
                     cmd_list->PushConstants(m_pcb_pass_cpu);
                 }
 
-                if (GetOption<bool>(Renderer_Option::OcclusionCulling) && !is_transparent_pass)
-                {
-                    cmd_list->BeginOcclusionQuery(entity->GetObjectId());
-                }
-
                 draw_renderable(cmd_list, pso, GetCamera().get(), renderable.get());
-
-                if (GetOption<bool>(Renderer_Option::OcclusionCulling) && !is_transparent_pass)
-                {
-                    cmd_list->EndOcclusionQuery();
-                }
             }
         };
 
@@ -810,7 +1100,6 @@ namespace Spartan
         {
             cmd_list->SetIgnoreClearValues(false);
             pass(pso, false, false);
-            visibility::get_gpu_occlusion_query_results(cmd_list, m_renderables);
             cmd_list->Blit(tex_depth, tex_depth_opaque, false);
         }
         else // transparent
@@ -818,7 +1107,8 @@ namespace Spartan
             pass(pso, true ,false);
         }
 
-        // back face
+        // back face, drawn from opaque meshes only, so the transparent pass would redraw what the opaque pass stored
+        if (!is_transparent_pass)
         {
             pso.render_target_depth_texture = tex_depth_backface;
             cmd_list->SetIgnoreClearValues(false);
@@ -837,46 +1127,102 @@ namespace Spartan
         cmd_list->EndTimeblock();
     }
 
+    void Renderer::CreateGbufferPipelines(const bool materials_changed)
+    {
+        // collect the permutations that the scene's materials use and start compiling them, ahead of their first draw
+        if (materials_changed)
+        {
+            lock_guard lock(m_mutex_renderables);
+
+            gbuffer::keys.clear();
+            for (shared_ptr<Entity>& entity : m_renderables[Renderer_Entity::Mesh])
+            {
+                shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>();
+                if (!renderable || !renderable->GetMaterial())
+                    continue;
+
+                const uint32_t key = gbuffer::get_sort_key(renderable.get());
+                if (gbuffer::keys.insert(key).second)
+                {
+                    GetShaderGbuffer(key & (renderer_gbuffer_permutation_count - 1));
+                }
+            }
+
+            gbuffer::keys_pending = gbuffer::keys;
+        }
+
+        RHI_Shader* shader_v = GetShader(Renderer_Shader::gbuffer_v).get();
+        RHI_Shader* shader_h = GetShader(Renderer_Shader::tessellation_h).get();
+        RHI_Shader* shader_d = GetShader(Renderer_Shader::tessellation_d).get();
+        RHI_Shader* shader_p = GetShader(Renderer_Shader::gbuffer_p).get();
+        if (gbuffer::keys.empty() || !shader_v->IsCompiled() || !shader_h->IsCompiled() || !shader_d->IsCompiled() || !shader_p->IsCompiled())
+            return;
+
+        // render targets and options (resolution, wireframe, vrs) are part of the pipelines, so a change rebuilds them all
+        RHI_PipelineState pso;
+        gbuffer::set_pipeline_state(pso, false);
+        pso.Prepare();
+        if (pso.GetHash() != gbuffer::pipeline_base_hash)
+        {
+            gbuffer::pipeline_base_hash = pso.GetHash();
+            gbuffer::keys_pending       = gbuffer::keys;
+        }
+
+        // build the pipelines of the permutations that have finished compiling, the pass then only has to bind them
+        for (auto it = gbuffer::keys_pending.begin(); it != gbuffer::keys_pending.end();)
+        {
+            RHI_Shader* shader_permutation = GetShaderGbuffer(*it & (renderer_gbuffer_permutation_count - 1)).get();
+            if (!shader_permutation->IsCompiled())
+            {
+                it++;
+                continue;
+            }
+
+            const bool is_tessellated                        = (*it & renderer_gbuffer_permutation_count) != 0;
+            RHI_PipelineState pso_permutation                = pso;
+            pso_permutation.shaders[RHI_Shader_Type::Pixel]  = shader_permutation;
+            pso_permutation.shaders[RHI_Shader_Type::Hull]   = is_tessellated ? shader_h : nullptr;
+            pso_permutation.shaders[RHI_Shader_Type::Domain] = is_tessellated ? shader_d : nullptr;
+            pso_permutation.instancing                       = (*it & (renderer_gbuffer_permutation_count << 1)) != 0;
+
+            RHI_Pipeline* pipeline                         = nullptr;
+            RHI_DescriptorSetLayout* descriptor_set_layout = nullptr;
+            RHI_Device::GetOrCreatePipeline(pso_permutation, pipeline, descriptor_set_layout);
+
+            it = gbuffer::keys_pending.erase(it);
+        }
+    }
+
     void Renderer::Pass_GBuffer(RHI_CommandList* cmd_list, const bool is_transparent_pass)
     {
         // acquire resources
-        RHI_Shader* shader_v      = GetShader(Renderer_Shader::gbuffer_v).get();
-        RHI_Shader* shader_h      = GetShader(Renderer_Shader::tessellation_h).get();
-        RHI_Shader* shader_d      = GetShader(Renderer_Shader::tessellation_d).get();
-        RHI_Shader* shader_p      = GetShader(Renderer_Shader::gbuffer_p).get();
-        RHI_Texture* tex_color    = GetRenderTarget(Renderer_RenderTarget::gbuffer_color).get();
-        RHI_Texture* tex_normal   = GetRenderTarget(Renderer_RenderTarget::gbuffer_normal).get();
-        RHI_Texture* tex_material = GetRenderTarget(Renderer_RenderTarget::gbuffer_material).get();
-        RHI_Texture* tex_velocity = GetRenderTarget(Renderer_RenderTarget::gbuffer_velocity).get();
-        RHI_Texture* tex_depth    = GetRenderTarget(Renderer_RenderTarget::gbuffer_depth).get();
+        RHI_Shader* shader_v = GetShader(Renderer_Shader::gbuffer_v).get();
+        RHI_Shader* shader_h = GetShader(Renderer_Shader::tessellation_h).get();
+        RHI_Shader* shader_d = GetShader(Renderer_Shader::tessellation_d).get();
+        RHI_Shader* shader_p = GetShader(Renderer_Shader::gbuffer_p).get();
+        if (!is_transparent_pass)
+        {
+            visibility_buffer::draws.clear();
+        }
         if (!shader_v->IsCompiled() || !shader_h->IsCompiled() || !shader_d->IsCompiled() || !shader_p->IsCompiled())
             return;
 
         cmd_list->BeginTimeblock(is_transparent_pass ? "g_buffer_transparent" : "g_buffer");
 
-        // deduce rasterizer state
-        bool is_wireframe                     = GetOption<bool>(Renderer_Option::Wireframe);
-        RHI_RasterizerState* rasterizer_state = is_wireframe ? GetRasterizerState(Renderer_RasterizerState::Wireframe).get() : GetRasterizerState(Renderer_RasterizerState::Solid).get();
+        bool is_wireframe = GetOption<bool>(Renderer_Option::Wireframe);
+
+        // simple opaque meshes can be deferred to the visibility buffer pass
+        bool use_visibility_buffer =
+            !is_transparent_pass                                                    &&
+            !is_wireframe                                                           &&
+            GetOption<bool>(Renderer_Option::VisibilityBuffer)                      &&
+            GetShader(Renderer_Shader::visibility_buffer_v)->IsCompiled()           &&
+            GetShader(Renderer_Shader::visibility_buffer_p)->IsCompiled()           &&
+            GetShader(Renderer_Shader::visibility_buffer_resolve_c)->IsCompiled();
 
         // set pipeline state
         static RHI_PipelineState pso;
-        pso.name                              = is_transparent_pass ? "g_buffer_transparent" : "g_buffer";
-        pso.shaders[RHI_Shader_Type::Vertex]  = shader_v;
-        pso.shaders[RHI_Shader_Type::Pixel]   = shader_p;
-        pso.blend_state                       = GetBlendState(Renderer_BlendState::Off).get();
-        pso.rasterizer_state                  = rasterizer_state;
-        pso.depth_stencil_state               = GetDepthStencilState(Renderer_DepthStencilState::Read).get();
-        pso.vrs_input_texture                 = GetOption<bool>(Renderer_Option::VariableRateShading) ? GetRenderTarget(Renderer_RenderTarget::shading_rate).get() : nullptr;
-        pso.resolution_scale                  = true;
-        pso.render_target_color_textures[0]   = tex_color;
-        pso.render_target_color_textures[1]   = tex_normal;
-        pso.render_target_color_textures[2]   = tex_material;
-        pso.render_target_color_textures[3]   = tex_velocity;
-        pso.render_target_depth_texture       = tex_depth;
-        pso.clear_color[0]                    = !is_transparent_pass ? Color::standard_transparent : rhi_color_load;
-        pso.clear_color[1]                    = !is_transparent_pass ? Color::standard_transparent : rhi_color_load;
-        pso.clear_color[2]                    = !is_transparent_pass ? Color::standard_transparent : rhi_color_load;
-        pso.clear_color[3]                    = !is_transparent_pass ? Color::standard_transparent : rhi_color_load;
+        gbuffer::set_pipeline_state(pso, is_transparent_pass);
         cmd_list->SetIgnoreClearValues(false);
         cmd_list->SetPipelineState(pso);
 
@@ -894,6 +1240,27 @@ namespace Spartan
             if (!renderable || !renderable->IsVisible())
                 continue;
 
+            gbuffer::draws.emplace_back(gbuffer::get_sort_key(renderable.get()), renderable);
+        }
+
+        // batch opaque draws by pipeline, the sort is stable so each batch stays front-to-back
+        // transparent draws keep their order since they blend
+        if (!is_transparent_pass)
+        {
+            stable_sort(gbuffer::draws.begin(), gbuffer::draws.end(), [](const auto& a, const auto& b)
+            {
+                return a.first < b.first;
+            });
+        }
+
+        for (auto& [sort_key, renderable] : gbuffer::draws)
+        {
+            if (use_visibility_buffer && visibility_buffer::draws.size() < renderer_max_visibility_draws - 1 && visibility_buffer::is_compatible(renderable.get()))
+            {
+                visibility_buffer::draws.push_back(renderable);
+                continue;
+            }
+
             // toggles
             {
                 bool toggled = false;
@@ -905,6 +1272,15 @@ namespace Spartan
                     toggled        = true;
                 }
 
+                // material feature permutation, the base shader covers permutations that are still compiling
+                RHI_Shader* shader_permutation = GetShaderGbuffer(sort_key & (renderer_gbuffer_permutation_count - 1)).get();
+                RHI_Shader* shader_pixel       = (shader_permutation && shader_permutation->IsCompiled()) ? shader_permutation : shader_p;
+                if (pso.shaders[RHI_Shader_Type::Pixel] != shader_pixel)
+                {
+                    pso.shaders[RHI_Shader_Type::Pixel] = shader_pixel;
+                    toggled                             = true;
+                }
+
                 // tessellation & culling
                 if (Material* material = renderable->GetMaterial())
                 {
@@ -940,16 +1316,150 @@ namespace Spartan
 
             // set pass constants
             {
-                m_pcb_pass_cpu.transform = entity->GetMatrix();
-                m_pcb_pass_cpu.set_transform_previous(entity->GetMatrixPrevious());
+                m_pcb_pass_cpu.transform = renderable->GetProxy().transform;
+                m_pcb_pass_cpu.set_transform_previous(renderable->GetProxy().transform_previous);
                 m_pcb_pass_cpu.set_is_transparent_and_material_index(is_transparent_pass, renderable->GetMaterial()->GetIndex());
                 cmd_list->PushConstants(m_pcb_pass_cpu);
-
-                entity->SetMatrixPrevious(m_pcb_pass_cpu.transform);
             }
 
             draw_renderable(cmd_list, pso, GetCamera().get(), renderable.get());
         }
+        gbuffer::draws.clear();
+
+        cmd_list->EndTimeblock();
+    }
+
+    void Renderer::Pass_VisibilityBuffer(RHI_CommandList* cmd_list)
+    {
+        // acquire resources
+        RHI_Shader* shader_v        = GetShader(Renderer_Shader::visibility_buffer_v).get();
+        RHI_Shader* shader_p        = GetShader(Renderer_Shader::visibility_buffer_p).get();
+        RHI_Shader* shader_c        = GetShader(Renderer_Shader::visibility_buffer_resolve_c).get();
+        RHI_Texture* tex_visibility = GetRenderTarget(Renderer_RenderTarget::gbuffer_visibility).get();
+        RHI_Texture* tex_depth      = GetRenderTarget(Renderer_RenderTarget::gbuffer_depth).get();
+        Profiler::m_visibility_buffer_draws = static_cast<uint32_t>(visibility_buffer::draws.size());
+        if (visibility_buffer::draws.empty() || !shader_v->IsCompiled() || !shader_p->IsCompiled() || !shader_c->IsCompiled())
+            return;
+
+        cmd_list->BeginTimeblock("visibility_buffer");
+
+        // per draw data, the resolve fetches transforms, materials and geometry offsets from it
+        {
+            visibility_buffer::geometry.clear();
+            visibility_buffer::draw_data.resize(visibility_buffer::draws.size());
+            for (size_t i = 0; i < visibility_buffer::draws.size(); i++)
+            {
+                Renderable* renderable  = visibility_buffer::draws[i].get();
+                Sb_VisibilityDraw& draw = visibility_buffer::draw_data[i];
+
+                draw.transform          = renderable->GetProxy().transform;
+                draw.transform_previous = renderable->GetProxy().transform_previous;
+                draw.material_index     = renderable->GetMaterial()->GetIndex();
+                draw.index_offset       = renderable->GetIndexOffset();
+                draw.vertex_offset      = renderable->GetVertexOffset();
+                draw.geometry           = visibility_buffer::get_geometry_index(renderable->GetVertexBuffer(), renderable->GetIndexBuffer());
+            }
+
+            uint32_t update_size = static_cast<uint32_t>(sizeof(Sb_VisibilityDraw) * visibility_buffer::draw_data.size());
+            GetBuffer(Renderer_Buffer::VisibilityDraws)->Update(visibility_buffer::draw_data.data(), update_size);
+        }
+
+        // raster: draw and triangle ids, the depth prepass already resolved visibility so there is no overdraw
+        {
+            static RHI_PipelineState pso;
+            pso.name                             = "visibility_buffer";
+            pso.shaders[RHI_Shader_Type::Vertex] = shader_v;
+            pso.shaders[RHI_Shader_Type::Pixel]  = shader_p;
+            pso.blend_state                      = GetBlendState(Renderer_BlendState::Off).get();
+            pso.rasterizer_state                 = GetRasterizerState(Renderer_RasterizerState::Solid).get();
+            pso.depth_stencil_state              = GetDepthStencilState(Renderer_DepthStencilState::Read).get();
+            pso.resolution_scale                 = true;
+            pso.render_target_color_textures[0]  = tex_visibility;
+            pso.render_target_depth_texture      = tex_depth;
+            pso.clear_color[0]                   = Color::standard_transparent;
+            cmd_list->SetIgnoreClearValues(false);
+            cmd_list->SetPipelineState(pso);
+
+            for (size_t i = 0; i < visibility_buffer::draws.size(); i++)
+            {
+                Renderable* renderable = visibility_buffer::draws[i].get();
+                Material* material     = renderable->GetMaterial();
+
+                cmd_list->SetCullMode(static_cast<RHI_CullMode>(material->GetProperty(MaterialProperty::CullMode)));
+                cmd_list->SetBufferVertex(renderable->GetVertexBuffer());
+                cmd_list->SetBufferIndex(renderable->GetIndexBuffer());
+
+                m_pcb_pass_cpu.transform = renderable->GetProxy().transform;
+                m_pcb_pass_cpu.set_f3_value(static_cast<float>(i));
+                m_pcb_pass_cpu.set_is_transparent_and_material_index(false, material->GetIndex());
+                cmd_list->PushConstants(m_pcb_pass_cpu);
+
+                cmd_list->DrawIndexed(renderable->GetIndexCount(), renderable->GetIndexOffset(), renderable->GetVertexOffset());
+            }
+
+            cmd_list->SetIgnoreClearValues(true);
+        }
+
+        // resolve: reconstruct the surface of each pixel and write it to the g-buffer
+        {
+            static RHI_PipelineState pso;
+            pso.name             = "visibility_buffer_resolve";
+            pso.shaders[Compute] = shader_c;
+            cmd_list->SetPipelineState(pso);
+
+            cmd_list->SetTexture(Renderer_BindingsSrv::visibility, tex_visibility);
+            cmd_list->SetTexture(Renderer_BindingsUav::tex,  GetRenderTarget(Renderer_RenderTarget::gbuffer_color));
+            cmd_list->SetTexture(Renderer_BindingsUav::tex2, GetRenderTarget(Renderer_RenderTarget::gbuffer_normal));
+            cmd_list->SetTexture(Renderer_BindingsUav::tex3, GetRenderTarget(Renderer_RenderTarget::gbuffer_material));
+            cmd_list->SetTexture(Renderer_BindingsUav::tex4, GetRenderTarget(Renderer_RenderTarget::gbuffer_velocity));
+            cmd_list->SetBuffer(Renderer_BindingsUav::sb_visibility_draws, GetBuffer(Renderer_Buffer::VisibilityDraws));
+
+            // one dispatch per geometry page pair, there is typically only one
+            for (uint32_t i = 0; i < static_cast<uint32_t>(visibility_buffer::geometry.size()); i++)
+            {
+                cmd_list->SetBuffer(Renderer_BindingsUav::sb_visibility_vertices, visibility_buffer::geometry[i].first);
+                cmd_list->SetBuffer(Renderer_BindingsUav::sb_visibility_indices,  visibility_buffer::geometry[i].second);
+
+                m_pcb_pass_cpu.set_f3_value(static_cast<float>(i), static_cast<float>(visibility_buffer::geometry[i].second->GetStride()));
+                cmd_list->PushConstants(m_pcb_pass_cpu);
+
+                cmd_list->Dispatch(tex_visibility);
+            }
+        }
+
+        visibility_buffer::draws.clear();
+
+        cmd_list->EndTimeblock();
+    }
+
+    void Renderer::Pass_GBuffer_NormalUnpack(RHI_CommandList* cmd_list)
+    {
+        // only fidelityfx needs world space normals
+        bool is_needed =
+            GetOption<bool>(Renderer_Option::ScreenSpaceReflections) ||
+            (GetOption<bool>(Renderer_Option::GlobalIllumination) && m_initialized_third_party);
+        if (!is_needed)
+            return;
+
+        // acquire resources
+        RHI_Shader* shader_c = GetShader(Renderer_Shader::gbuffer_normal_unpack_c).get();
+        RHI_Texture* tex_out = GetRenderTarget(Renderer_RenderTarget::gbuffer_normal_unpacked).get();
+        if (!shader_c->IsCompiled())
+            return;
+
+        cmd_list->BeginTimeblock("g_buffer_normal_unpack");
+
+        // set pipeline state
+        static RHI_PipelineState pso;
+        pso.shaders[Compute] = shader_c;
+        cmd_list->SetPipelineState(pso);
+
+        // set textures
+        SetGbufferTextures(cmd_list);
+        cmd_list->SetTexture(Renderer_BindingsUav::tex, tex_out);
+
+        // render
+        cmd_list->Dispatch(tex_out);
 
         cmd_list->EndTimeblock();
     }
@@ -996,7 +1506,7 @@ namespace Spartan
                 GetRenderTarget(Renderer_RenderTarget::frame_render).get(), // reflect from the previous frame
                 GetRenderTarget(Renderer_RenderTarget::gbuffer_depth).get(),
                 GetRenderTarget(Renderer_RenderTarget::gbuffer_velocity).get(),
-                GetRenderTarget(Renderer_RenderTarget::gbuffer_normal).get(),
+                GetRenderTarget(Renderer_RenderTarget::gbuffer_normal_unpacked).get(),
                 GetRenderTarget(Renderer_RenderTarget::gbuffer_material).get(),
                 GetRenderTarget(Renderer_RenderTarget::brdf_specular_lut).get(),
                 GetRenderTarget(Renderer_RenderTarget::ssr).get()
@@ -1042,7 +1552,7 @@ namespace Spartan
             {
                 if (shared_ptr<Light> light = entity->GetComponent<Light>())
                 {
-                    if (!light->IsFlagSet(LightFlags::ShadowsScreenSpace) || light->GetIntensityWatt() == 0.0f)
+                    if (!light->IsFlagSet(LightFlags::ShadowsScreenSpace) || light->GetProxy().intensity_watt == 0.0f)
                         continue;
 
                     if (array_slice_index == tex_sss->GetArrayLength())
@@ -1053,16 +1563,16 @@ namespace Spartan
 
                     float near = 1.0f;
                     float far  = 0.0f;
-                    Math::Matrix view_projection = GetCamera()->GetViewProjectionMatrix();
+                    Math::Matrix view_projection = m_cb_frame_cpu.view_projection_unjittered;
                     Vector4 p = {};
                     if (light->GetLightType() == LightType::Directional)
                     {
                         // todo: Why do we need to flip sign?
-                        p = Vector4(-light->GetEntity()->GetForward(), 0.0f) * view_projection;
+                        p = Vector4(-light->GetProxy().forward, 0.0f) * view_projection;
                     }
                     else
                     {
-                        p = Vector4(light->GetEntity()->GetPosition(), 1.0f) * view_projection;
+                        p = Vector4(light->GetProxy().position, 1.0f) * view_projection;
                     }
 
                     float in_light_projection[]      = { p.x, p.y, p.z, p.w };
@@ -1145,10 +1655,64 @@ namespace Spartan
         cmd_list->EndTimeblock();
     }
 
+    void Renderer::Pass_Light_TileClassification(RHI_CommandList* cmd_list)
+    {
+        // acquire resources
+        RHI_Shader* shader_c   = GetShader(Renderer_Shader::light_tile_classification_c).get();
+        RHI_Buffer* tile_args  = GetBuffer(Renderer_Buffer::LightTileArgs).get();
+        RHI_Buffer* tile_lists = GetBuffer(Renderer_Buffer::LightTiles).get();
+        if (!shader_c->IsCompiled())
+            return;
+
+        // reset the indirect arguments, one thread group count (x, y, z) per tile type
+        array<uint32_t, 4 * static_cast<uint32_t>(Renderer_LightTile::Max)> args_reset;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(Renderer_LightTile::Max); i++)
+        {
+            args_reset[i * 4 + 0] = 0;
+            args_reset[i * 4 + 1] = 1;
+            args_reset[i * 4 + 2] = 1;
+            args_reset[i * 4 + 3] = 0;
+        }
+        tile_args->Update(args_reset.data());
+
+        // read back the tile counts of the oldest frame, which the gpu has already completed
+        {
+            uint32_t slot_completed = (tile_args->GetOffset() / tile_args->GetStride() + 1) % resources_frame_lifetime;
+            const uint32_t* args    = reinterpret_cast<const uint32_t*>(reinterpret_cast<std::byte*>(tile_args->GetMappedData()) + slot_completed * tile_args->GetStride());
+
+            Profiler::m_light_tiles_simple  = args[static_cast<uint32_t>(Renderer_LightTile::Simple)  * 4];
+            Profiler::m_light_tiles_complex = args[static_cast<uint32_t>(Renderer_LightTile::Complex) * 4];
+            Profiler::m_light_tiles_sky     = args[static_cast<uint32_t>(Renderer_LightTile::Sky)     * 4];
+        }
+
+        cmd_list->BeginTimeblock("light_tile_classification");
+
+        // set pipeline state
+        static RHI_PipelineState pso;
+        pso.shaders[Compute] = shader_c;
+        cmd_list->SetPipelineState(pso);
+
+        // set resources
+        SetGbufferTextures(cmd_list);
+        cmd_list->SetBuffer(Renderer_BindingsUav::sb_light_tiles,     GetBuffer(Renderer_Buffer::LightTiles));
+        cmd_list->SetBuffer(Renderer_BindingsUav::sb_light_tile_args, GetBuffer(Renderer_Buffer::LightTileArgs));
+
+        // render
+        cmd_list->Dispatch(GetRenderTarget(Renderer_RenderTarget::light_diffuse).get());
+
+        // make the tile lists and counts visible to the lighting passes
+        cmd_list->InsertBarrierBufferReadWrite(tile_lists);
+        cmd_list->InsertBarrierBufferReadWrite(tile_args);
+
+        cmd_list->EndTimeblock();
+    }
+
     void Renderer::Pass_Light(RHI_CommandList* cmd_list, const bool is_transparent_pass)
     {
         // get resources
         RHI_Shader* shader_c        = GetShader(Renderer_Shader::light_c).get();
+        RHI_Shader* shader_tiled_c  = GetShader(Renderer_Shader::light_tiled_c).get();
+        RHI_Shader* shader_simple_c = GetShader(Renderer_Shader::light_tiled_simple_c).get();
         RHI_Texture* tex_diffuse    = GetRenderTarget(Renderer_RenderTarget::light_diffuse).get();
         RHI_Texture* tex_specular   = GetRenderTarget(Renderer_RenderTarget::light_specular).get();
         RHI_Texture* tex_shadow     = GetRenderTarget(Renderer_RenderTarget::light_shadow).get();
@@ -1161,7 +1725,8 @@ namespace Spartan
         if (light_count == 0)
             return;
 
-        cmd_list->BeginTimeblock(is_transparent_pass ? "light_transparent" : "light");
+        // the opaque pass only lights the tiles found by the classification, using the cheapest shader that can light them
+        bool is_tiled = !is_transparent_pass && shader_tiled_c->IsCompiled() && shader_simple_c->IsCompiled() && GetShader(Renderer_Shader::light_tile_classification_c)->IsCompiled();
 
         // clear render targets the first time around (opaque pas)
         if (!is_transparent_pass)
@@ -1172,50 +1737,89 @@ namespace Spartan
             cmd_list->ClearTexture(tex_volumetric, Color::standard_black);
         }
 
-        // set pipeline state
-        static RHI_PipelineState pso;
-        pso.shaders[Compute] = shader_c;
-        cmd_list->SetPipelineState(pso);
-
-        // iterate through all the lights
-        for (uint32_t light_index = 0; light_index < light_count; light_index++)
+        auto dispatch_lights = [&](RHI_Shader* shader, const Renderer_LightTile tile_type)
         {
-            // read from these
-            SetGbufferTextures(cmd_list);
-            cmd_list->SetTexture(Renderer_BindingsSrv::ssao, GetRenderTarget(Renderer_RenderTarget::ssao));
-
-            // write to these
-            cmd_list->SetTexture(Renderer_BindingsUav::tex,  tex_diffuse);
-            cmd_list->SetTexture(Renderer_BindingsUav::tex2, tex_specular);
-            cmd_list->SetTexture(Renderer_BindingsUav::tex3, tex_shadow);
-            cmd_list->SetTexture(Renderer_BindingsUav::tex4, tex_volumetric);
+            // set pipeline state
+            static array<RHI_PipelineState, static_cast<uint32_t>(Renderer_LightTile::Max) + 1> pso;
+            RHI_PipelineState& pso_tile = pso[static_cast<uint32_t>(tile_type)];
+            pso_tile.shaders[Compute]   = shader;
+            cmd_list->SetPipelineState(pso_tile);
 
-            if (shared_ptr<Light> light = entities[light_index]->GetComponent<Light>())
+            // iterate through all the lights
+            for (uint32_t light_index = 0; light_index < light_count; light_index++)
             {
-                if (light->GetIntensityWatt() == 0.0f)
-                    continue;
+                // read from these
+                SetGbufferTextures(cmd_list);
+                cmd_list->SetTexture(Renderer_BindingsSrv::ssao, GetRenderTarget(Renderer_RenderTarget::ssao));
+
+                // write to these
+                cmd_list->SetTexture(Renderer_BindingsUav::tex,  tex_diffuse);
+                cmd_list->SetTexture(Renderer_BindingsUav::tex2, tex_specular);
+                cmd_list->SetTexture(Renderer_BindingsUav::tex3, tex_shadow);
+                cmd_list->SetTexture(Renderer_BindingsUav::tex4, tex_volumetric);
 
-                // set shadow maps
+                if (shared_ptr<Light> light = entities[light_index]->GetComponent<Light>())
                 {
-                    RHI_Texture* tex_depth = light->IsFlagSet(LightFlags::Shadows)            ? light->GetDepthTexture() : nullptr;
-                    RHI_Texture* tex_color = light->IsFlagSet(LightFlags::ShadowsTransparent) ? light->GetColorTexture() : nullptr;
+                    if (light->GetProxy().intensity_watt == 0.0f)
+                        continue;
 
-                    cmd_list->SetTexture(Renderer_BindingsSrv::light_depth, tex_depth);
-                    cmd_list->SetTexture(Renderer_BindingsSrv::light_color, tex_color);
-                    cmd_list->SetTexture(Renderer_BindingsSrv::sss,         GetRenderTarget(Renderer_RenderTarget::sss));
-                }
+                    // sky pixels only receive volumetric fog
+                    if (tile_type == Renderer_LightTile::Sky && !light->IsFlagSet(LightFlags::Volumetric))
+                        continue;
 
-                // push pass constants
-                m_pcb_pass_cpu.set_is_transparent_and_material_index(is_transparent_pass);
-                m_pcb_pass_cpu.set_f3_value2(static_cast<float>(light->GetIndex()), 0.0f, 0.0f);
-                m_pcb_pass_cpu.set_f3_value(GetOption<float>(Renderer_Option::Fog), GetOption<float>(Renderer_Option::ShadowResolution), 0.0f);
-                cmd_list->PushConstants(m_pcb_pass_cpu);
-                
-                cmd_list->Dispatch(tex_diffuse);
+                    // set shadow maps
+                    {
+                        RHI_Texture* tex_depth = light->IsFlagSet(LightFlags::Shadows)            ? light->GetDepthTexture() : nullptr;
+                        RHI_Texture* tex_color = light->IsFlagSet(LightFlags::ShadowsTransparent) ? light->GetColorTexture() : nullptr;
+
+                        cmd_list->SetTexture(Renderer_BindingsSrv::light_depth, tex_depth);
+                        cmd_list->SetTexture(Renderer_BindingsSrv::light_color, tex_color);
+                        cmd_list->SetTexture(Renderer_BindingsSrv::sss,         GetRenderTarget(Renderer_RenderTarget::sss));
+                    }
+
+                    // push pass constants
+                    m_pcb_pass_cpu.set_is_transparent_and_material_index(is_transparent_pass);
+                    m_pcb_pass_cpu.set_f3_value2(static_cast<float>(light->GetIndex()), 0.0f, 0.0f);
+                    m_pcb_pass_cpu.set_f3_value(GetOption<float>(Renderer_Option::Fog), GetOption<float>(Renderer_Option::ShadowResolution), 0.0f);
+                    m_pcb_pass_cpu.set_f2_value(static_cast<float>(tile_type), 0.0f);
+                    cmd_list->PushConstants(m_pcb_pass_cpu);
+
+                    // max means full screen, it's what the transparent pass uses
+                    if (tile_type == Renderer_LightTile::Max)
+                    {
+                        cmd_list->Dispatch(tex_diffuse);
+                    }
+                    else
+                    {
+                        cmd_list->SetBuffer(Renderer_BindingsUav::sb_light_tiles,     GetBuffer(Renderer_Buffer::LightTiles));
+                        cmd_list->SetBuffer(Renderer_BindingsUav::sb_light_tile_args, GetBuffer(Renderer_Buffer::LightTileArgs));
+                        cmd_list->DispatchIndirect(GetBuffer(Renderer_Buffer::LightTileArgs).get(), static_cast<uint32_t>(tile_type) * 4 * sizeof(uint32_t));
+                    }
+                }
             }
-        }
+        };
 
-        cmd_list->EndTimeblock();
+        // timeblocks can't nest, so each tile type gets its own, which also gives per permutation timings
+        if (is_tiled)
+        {
+            cmd_list->BeginTimeblock("light_tiles_simple");
+            dispatch_lights(shader_simple_c, Renderer_LightTile::Simple);
+            cmd_list->EndTimeblock();
+
+            cmd_list->BeginTimeblock("light_tiles_complex");
+            dispatch_lights(shader_tiled_c, Renderer_LightTile::Complex);
+            cmd_list->EndTimeblock();
+
+            cmd_list->BeginTimeblock("light_tiles_sky");
+            dispatch_lights(shader_simple_c, Renderer_LightTile::Sky);
+            cmd_list->EndTimeblock();
+        }
+        else
+        {
+            cmd_list->BeginTimeblock(is_transparent_pass ? "light_transparent" : "light");
+            dispatch_lights(shader_c, Renderer_LightTile::Max);
+            cmd_list->EndTimeblock();
+        }
     }
 
     void Renderer::Pass_Light_GlobalIllumination(RHI_CommandList* cmd_list)
@@ -1262,7 +1866,7 @@ namespace Spartan
                     GetRenderTarget(Renderer_RenderTarget::frame_render).get(), // previous lit output
                     GetRenderTarget(Renderer_RenderTarget::gbuffer_depth).get(),
                     GetRenderTarget(Renderer_RenderTarget::gbuffer_velocity).get(),
-                    GetRenderTarget(Renderer_RenderTarget::gbuffer_normal).get(),
+                    GetRenderTarget(Renderer_RenderTarget::gbuffer_normal_unpacked).get(),
                     GetRenderTarget(Renderer_RenderTarget::gbuffer_material).get(),
                     noise_textures,
                     GetRenderTarget(Renderer_RenderTarget::light_diffuse_gi).get(),
@@ -1322,8 +1926,10 @@ namespace Spartan
 
     void Renderer::Pass_Light_ImageBased(RHI_CommandList* cmd_list, RHI_Texture* tex_out, const bool is_transparent_pass)
     {
-        // acquire shader
-        RHI_Shader* shader = GetShader(Renderer_Shader::light_image_based_c).get();
+        // acquire shader, the opaque pass skips the sky tiles since there is nothing to apply there
+        RHI_Shader* shader       = GetShader(Renderer_Shader::light_image_based_c).get();
+        RHI_Shader* shader_tiled = GetShader(Renderer_Shader::light_image_based_tiled_c).get();
+        bool is_tiled            = !is_transparent_pass && shader_tiled->IsCompiled() && GetShader(Renderer_Shader::light_tile_classification_c)->IsCompiled();
         if (!shader->IsCompiled())
             return;
 
@@ -1331,7 +1937,7 @@ namespace Spartan
 
         // set pipeline state
         static RHI_PipelineState pso;
-        pso.shaders[Compute] = shader;
+        pso.shaders[Compute] = is_tiled ? shader_tiled : shader;
         cmd_list->SetPipelineState(pso);
 
         // set textures
@@ -1350,10 +1956,26 @@ namespace Spartan
         m_pcb_pass_cpu.set_is_transparent_and_material_index(is_transparent_pass);
         uint32_t mip_count_skysphere = GetRenderTarget(Renderer_RenderTarget::skysphere)->GetMipCount();
         m_pcb_pass_cpu.set_f3_value(static_cast<float>(mip_count_skysphere));
-        cmd_list->PushConstants(m_pcb_pass_cpu);
 
         // render
-        cmd_list->Dispatch(tex_out);
+        if (is_tiled)
+        {
+            RHI_Buffer* tile_args = GetBuffer(Renderer_Buffer::LightTileArgs).get();
+            cmd_list->SetBuffer(Renderer_BindingsUav::sb_light_tiles,     GetBuffer(Renderer_Buffer::LightTiles));
+            cmd_list->SetBuffer(Renderer_BindingsUav::sb_light_tile_args, GetBuffer(Renderer_Buffer::LightTileArgs));
+
+            for (Renderer_LightTile tile_type : { Renderer_LightTile::Simple, Renderer_LightTile::Complex })
+            {
+                m_pcb_pass_cpu.set_f2_value(static_cast<float>(tile_type), 0.0f);
+                cmd_list->PushConstants(m_pcb_pass_cpu);
+                cmd_list->DispatchIndirect(tile_args, static_cast<uint32_t>(tile_type) * 4 * sizeof(uint32_t));
+            }
+        }
+        else
+        {
+            cmd_list->PushConstants(m_pcb_pass_cpu);
+            cmd_list->Dispatch(tex_out);
+        }
         cmd_list->EndTimeblock();
     }
 
@@ -1395,7 +2017,7 @@ namespace Spartan
             {
                 if (light->GetLightType() == LightType::Directional)
                 {
-                    if (light->GetEntity()->IsMoving())
+                    if (light->GetProxy().is_moving)
                         return;
                 }
             }
@@ -1705,7 +2327,7 @@ namespace Spartan
         cmd_list->SetPipelineState(pso);
 
         // set pass constants
-        m_pcb_pass_cpu.set_f3_value(GetCamera()->GetAperture(), 0.0f, 0.0f);
+        m_pcb_pass_cpu.set_f3_value(GetCamera()->GetProxy().aperture, 0.0f, 0.0f);
         cmd_list->PushConstants(m_pcb_pass_cpu);
 
         // set textures
@@ -1718,63 +2340,100 @@ namespace Spartan
         cmd_list->EndTimeblock();
     }
 
+    void Renderer::Pass_TiledHalfResolution(RHI_CommandList* cmd_list, const array<RHI_Shader*, 4>& shaders, RHI_Texture* tex_in, RHI_Texture* tex_out)
+    {
+        // the shaders are, in order: tile max, tile dilation, half resolution effect, bilateral upsample
+        RHI_Texture* tex_tile         = GetRenderTarget(Renderer_RenderTarget::post_process_tile).get();
+        RHI_Texture* tex_tile_dilated = GetRenderTarget(Renderer_RenderTarget::post_process_tile_dilated).get();
+        RHI_Texture* tex_half         = GetRenderTarget(Renderer_RenderTarget::post_process_half).get();
+
+        static array<RHI_PipelineState, 4> pso;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(shaders.size()); i++)
+        {
+            pso[i].shaders[Compute] = shaders[i];
+            cmd_list->SetPipelineState(pso[i]);
+            cmd_list->PushConstants(m_pcb_pass_cpu);
+
+            SetGbufferTextures(cmd_list);
+            cmd_list->SetTexture(Renderer_BindingsSrv::tex, tex_in);
+
+            if (i == 0) // max per tile, a thread group reduces a tile
+            {
+                cmd_list->SetTexture(Renderer_BindingsUav::tex, tex_tile);
+                cmd_list->Dispatch(tex_tile->GetWidth(), tex_tile->GetHeight());
+            }
+            else if (i == 1) // 3x3 tile neighbourhood max
+            {
+                cmd_list->SetTexture(Renderer_BindingsSrv::tex2, tex_tile);
+                cmd_list->SetTexture(Renderer_BindingsUav::tex,  tex_tile_dilated);
+                cmd_list->Dispatch(tex_tile_dilated);
+            }
+            else if (i == 2) // effect, tiles that don't need it take an early out
+            {
+                cmd_list->SetTexture(Renderer_BindingsSrv::tex2, tex_tile_dilated);
+                cmd_list->SetTexture(Renderer_BindingsUav::tex,  tex_half);
+                cmd_list->Dispatch(tex_half);
+            }
+            else // upsample, tiles that don't need it are copied through
+            {
+                cmd_list->SetTexture(Renderer_BindingsSrv::tex2,  tex_tile_dilated);
+                cmd_list->SetTexture(Renderer_BindingsSrv::frame, tex_half);
+                cmd_list->SetTexture(Renderer_BindingsUav::tex,   tex_out);
+                cmd_list->Dispatch(tex_out);
+            }
+        }
+    }
+
     void Renderer::Pass_MotionBlur(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out)
     {
         // acquire shaders
-        RHI_Shader* shader_c = GetShader(Renderer_Shader::motion_blur_c).get();
-        if (!shader_c->IsCompiled())
-            return;
+        array<RHI_Shader*, 4> shaders =
+        {
+            GetShader(Renderer_Shader::motion_blur_tile_max_c).get(),
+            GetShader(Renderer_Shader::motion_blur_tile_dilate_c).get(),
+            GetShader(Renderer_Shader::motion_blur_c).get(),
+            GetShader(Renderer_Shader::motion_blur_upsample_c).get()
+        };
+        for (RHI_Shader* shader : shaders)
+        {
+            if (!shader->IsCompiled())
+                return;
+        }
 
         cmd_list->BeginTimeblock("motion_blur");
 
-        // define pipeline state
-        static RHI_PipelineState pso;
-        pso.shaders[Compute] = shader_c;
-
-        // set pipeline state
-        cmd_list->SetPipelineState(pso);
-
         // set pass constants
-        m_pcb_pass_cpu.set_f3_value(GetCamera()->GetShutterSpeed(), 0.0f, 0.0f);
-        cmd_list->PushConstants(m_pcb_pass_cpu);
-
-        // set textures
-        SetGbufferTextures(cmd_list);
-        cmd_list->SetTexture(Renderer_BindingsUav::tex, tex_out);
-        cmd_list->SetTexture(Renderer_BindingsSrv::tex, tex_in);
+        m_pcb_pass_cpu.set_f3_value(GetCamera()->GetProxy().shutter_speed, 0.0f, 0.0f);
 
         // render
-        cmd_list->Dispatch(tex_out);
+        Pass_TiledHalfResolution(cmd_list, shaders, tex_in, tex_out);
 
         cmd_list->EndTimeblock();
     }
 
     void Renderer::Pass_DepthOfField(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out)
     {
-        // acquire shader
-        RHI_Shader* shader_c = GetShader(Renderer_Shader::depth_of_field_c).get();
-        if (!shader_c->IsCompiled())
-            return;
+        // acquire shaders
+        array<RHI_Shader*, 4> shaders =
+        {
+            GetShader(Renderer_Shader::depth_of_field_tile_max_c).get(),
+            GetShader(Renderer_Shader::depth_of_field_tile_dilate_c).get(),
+            GetShader(Renderer_Shader::depth_of_field_c).get(),
+            GetShader(Renderer_Shader::depth_of_field_upsample_c).get()
+        };
+        for (RHI_Shader* shader : shaders)
+        {
+            if (!shader->IsCompiled())
+                return;
+        }
 
         cmd_list->BeginTimeblock("depth_of_field");
 
-        // set pipeline state
-        static RHI_PipelineState pso;
-        pso.shaders[Compute] = shader_c;
-        cmd_list->SetPipelineState(pso);
-
         // set pass constants
-        m_pcb_pass_cpu.set_f3_value(GetCamera()->GetAperture(), 0.0f, 0.0f);
-        cmd_list->PushConstants(m_pcb_pass_cpu);
-
-        // set textures
-        SetGbufferTextures(cmd_list);
-        cmd_list->SetTexture(Renderer_BindingsSrv::tex, tex_in);
-        cmd_list->SetTexture(Renderer_BindingsUav::tex, tex_out);
-        
+        m_pcb_pass_cpu.set_f3_value(GetCamera()->GetProxy().aperture, 0.0f, 0.0f);
 
         // render
-        cmd_list->Dispatch(tex_out);
+        Pass_TiledHalfResolution(cmd_list, shaders, tex_in, tex_out);
 
         cmd_list->EndTimeblock();
     }
@@ -1794,7 +2453,7 @@ namespace Spartan
         cmd_list->SetPipelineState(pso);
 
         // set pass constants
-        m_pcb_pass_cpu.set_f3_value(GetCamera()->GetIso(), 0.0f, 0.0f);
+        m_pcb_pass_cpu.set_f3_value(GetCamera()->GetProxy().iso, 0.0f, 0.0f);
         cmd_list->PushConstants(m_pcb_pass_cpu);
 
         // set textures
@@ -1981,9 +2640,8 @@ namespace Spartan
             return;
 
         // acquire entities
-        auto& lights        = m_renderables[Renderer_Entity::Light];
-        auto& audio_sources = m_renderables[Renderer_Entity::AudioSource];
-        if ((lights.empty() && audio_sources.empty()) || !GetCamera())
+        auto& lights = m_renderables[Renderer_Entity::Light];
+        if ((lights.empty() && m_audio_source_positions.empty()) || !GetCamera())
             return;
 
         cmd_list->BeginTimeblock("icons");
@@ -2000,12 +2658,11 @@ namespace Spartan
 
         cmd_list->SetCullMode(RHI_CullMode::Back);
 
-        auto draw_icon = [&cmd_list](Entity* entity, RHI_Texture* texture)
+        auto draw_icon = [&cmd_list](const Vector3& pos_world, RHI_Texture* texture)
         {
-            const Vector3 pos_world        = entity->GetPosition();
-            const Vector3 pos_world_camera = GetCamera()->GetEntity()->GetPosition();
+            const Vector3 pos_world_camera = m_cb_frame_cpu.camera_position;
             const Vector3 camera_to_light  = (pos_world - pos_world_camera).Normalized();
-            const float v_dot_l            = Vector3::Dot(GetCamera()->GetEntity()->GetForward(), camera_to_light);
+            const float v_dot_l            = Vector3::Dot(m_cb_frame_cpu.camera_direction, camera_to_light);
 
             // only draw if it's inside our view
             if (v_dot_l > 0.5f)
@@ -2031,16 +2688,17 @@ namespace Spartan
 
                 // draw rectangle
                 cmd_list->SetTexture(Renderer_BindingsSrv::tex, texture);
-                cmd_list->SetBufferVertex(GetStandardMesh(MeshType::Quad)->GetVertexBuffer());
-                cmd_list->SetBufferIndex(GetStandardMesh(MeshType::Quad)->GetIndexBuffer());
-                cmd_list->DrawIndexed(6);
+                Mesh* quad = GetStandardMesh(MeshType::Quad).get();
+                cmd_list->SetBufferVertex(quad->GetVertexBuffer());
+                cmd_list->SetBufferIndex(quad->GetIndexBuffer());
+                cmd_list->DrawIndexed(6, quad->GetIndexBufferOffset(), quad->GetVertexBufferOffset());
             }
         };
 
         // draw audio source icons
-        for (shared_ptr<Entity> entity : audio_sources)
+        for (const Vector3& position : m_audio_source_positions)
         {
-            draw_icon(entity.get(), GetStandardTexture(Renderer_StandardTexture::Gizmo_audio_source).get());
+            draw_icon(position, GetStandardTexture(Renderer_StandardTexture::Gizmo_audio_source).get());
         }
 
         // draw light icons
@@ -2055,9 +2713,9 @@ namespace Spartan
                 if (light->GetLightType() == LightType::Directional) texture = GetStandardTexture(Renderer_StandardTexture::Gizmo_light_directional).get();
                 else if (light->GetLightType() == LightType::Point)  texture = GetStandardTexture(Renderer_StandardTexture::Gizmo_light_point).get();
                 else if (light->GetLightType() == LightType::Spot)   texture = GetStandardTexture(Renderer_StandardTexture::Gizmo_light_spot).get();
-            }
 
-            draw_icon(entity.get(), texture);
+                draw_icon(light->GetProxy().position, texture);
+            }
         }
 
         cmd_list->EndTimeblock();
@@ -2091,7 +2749,7 @@ namespace Spartan
         {
             // follow camera in world unit increments so that the grid appears stationary in relation to the camera
             const float grid_spacing       = 1.0f;
-            const Vector3& camera_position = GetCamera()->GetEntity()->GetPosition();
+            const Vector3& camera_position = m_cb_frame_cpu.camera_position;
             const Vector3 translation      = Vector3(
                 floor(camera_position.x / grid_spacing) * grid_spacing,
                 0.0f,
@@ -2103,9 +2761,10 @@ namespace Spartan
         }
 
         cmd_list->SetCullMode(RHI_CullMode::Back);
-        cmd_list->SetBufferVertex(GetStandardMesh(MeshType::Quad)->GetVertexBuffer());
-        cmd_list->SetBufferIndex(GetStandardMesh(MeshType::Quad)->GetIndexBuffer());
-        cmd_list->DrawIndexed(6);
+        Mesh* quad = GetStandardMesh(MeshType::Quad).get();
+        cmd_list->SetBufferVertex(quad->GetVertexBuffer());
+        cmd_list->SetBufferIndex(quad->GetIndexBuffer());
+        cmd_list->DrawIndexed(6, quad->GetIndexBufferOffset(), quad->GetVertexBufferOffset());
 
         cmd_list->EndTimeblock();
     }
@@ -2134,6 +2793,9 @@ namespace Spartan
         m_pcb_pass_cpu.transform = Matrix::Identity;
         cmd_list->PushConstants(m_pcb_pass_cpu);
 
+        // the simulation can add lines while this pass runs on the render thread
+        lock_guard lock(m_mutex_lines);
+
         // draw independent lines
         const bool draw_lines_depth_off = m_lines_index_depth_off != numeric_limits<uint32_t>::max();
         const bool draw_lines_depth_on  = m_lines_index_depth_on > ((m_line_vertices.size() / 2) - 1);
@@ -2208,7 +2870,7 @@ namespace Spartan
 
         if (shared_ptr<Camera> camera = Renderer::GetCamera())
         {
-            if (shared_ptr<Entity> entity_selected = camera->GetSelectedEntity())
+            if (const shared_ptr<Entity>& entity_selected = camera->GetProxy().selected_entity)
             {
                 cmd_list->BeginTimeblock("outline");
                 {
@@ -2234,7 +2896,7 @@ namespace Spartan
                             {
                                 // push draw data
                                 m_pcb_pass_cpu.set_f4_value(Color::standard_renderer_lines);
-                                m_pcb_pass_cpu.transform = entity_selected->GetMatrix();
+                                m_pcb_pass_cpu.transform = renderable->GetProxy().transform;
                                 cmd_list->PushConstants(m_pcb_pass_cpu);
                         
                                 cmd_list->SetBufferVertex(renderable->GetVertexBuffer());
@@ -2273,7 +2935,7 @@ namespace Spartan
         }
     }
 
-    void Renderer::Pass_Text(RHI_CommandList* cmd_list, RHI_Texture* tex_out)
+    void Renderer::Pass_Text(RHI_CommandList* cmd_list, RHI_Texture* tex_out, const bool clear)
     {
         // acquire resources
         const bool draw       = GetOption<bool>(Renderer_Option::PerformanceMetrics);
@@ -2281,7 +2943,14 @@ namespace Spartan
         const auto& shader_p  = GetShader(Renderer_Shader::font_p);
         shared_ptr<Font> font = GetFont();
         if (!shader_v || !shader_v->IsCompiled() || !shader_p || !shader_p->IsCompiled() || !draw || !font->HasText())
+        {
+            if (clear)
+            {
+                cmd_list->ClearTexture(tex_out, Color::standard_black);
+            }
+
             return;
+        }
 
         cmd_list->BeginMarker("text");
 
@@ -2293,8 +2962,9 @@ namespace Spartan
         pso.blend_state                       = GetBlendState(Renderer_BlendState::Alpha).get();
         pso.depth_stencil_state               = GetDepthStencilState(Renderer_DepthStencilState::Off).get();
         pso.render_target_color_textures[0]   = tex_out;
-        pso.clear_color[0]                    = rhi_color_load;
+        pso.clear_color[0]                    = clear ? Color::standard_black : rhi_color_load; // clearing as the render pass begins saves a separate clear
         pso.name                              = "Pass_Text";
+        cmd_list->SetIgnoreClearValues(false);
         cmd_list->SetPipelineState(pso);
 
         font->UpdateVertexAndIndexBuffers();
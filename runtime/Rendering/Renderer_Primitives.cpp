@@ -44,6 +44,8 @@ namespace Spartan
 
     void Renderer::DrawLine(const Vector3& from, const Vector3& to, const Color& color_from, const Color& color_to, const float duration /*= 0.0f*/, const bool depth /*= true*/)
     {
+        lock_guard lock(m_mutex_lines);
+
         // get vertex index
         uint32_t& index = depth ? m_lines_index_depth_on : m_lines_index_depth_off;
 
@@ -338,8 +340,7 @@ namespace Spartan
                 {
                     if (shared_ptr<Renderable> renderable = entity->GetComponent<Renderable>())
                     {
-                        uint32_t group_count = static_cast<uint32_t>(renderable->GetBoundingBoxGroupEndIndices().size());
-                        for (uint32_t group_index = 0; group_index < group_count; group_index++)
+                        for (uint32_t group_index = 0; group_index < renderable->GetInstancePartitionCount(); group_index++)
                         {
                             const BoundingBox& bounding_box_group = renderable->GetBoundingBox(BoundingBoxType::TransformedInstanceGroup, group_index);
                             DrawBox(bounding_box_group, get_color(renderable.get()));
@@ -59,6 +59,8 @@ namespace Spartan
         // renderer resources
         array<shared_ptr<RHI_Texture>, static_cast<uint32_t>(Renderer_RenderTarget::max)>    render_targets;
         array<shared_ptr<RHI_Shader>,  static_cast<uint32_t>(Renderer_Shader::max)>          shaders;
+        array<shared_ptr<RHI_Shader>,  renderer_gbuffer_permutation_count>                   shaders_gbuffer;
+        mutex                                                                                mutex_shaders_gbuffer;
         array<shared_ptr<RHI_Sampler>, static_cast<uint32_t>(Renderer_Sampler::Max)>         samplers;
         shared_ptr<RHI_ConstantBuffer>                                                       constant_buffer_frame;
         array<shared_ptr<RHI_Buffer>, static_cast<uint32_t>(Renderer_Buffer::Max)> buffers;
@@ -96,6 +98,20 @@ namespace Spartan
 
         stride = static_cast<uint32_t>(sizeof(Sb_Light)) * rhi_max_array_size_lights;
         buffer(Renderer_Buffer::Lights) = make_shared<RHI_Buffer>(stride, 1, 0, "lights");
+
+        // updates once per frame
+        stride = static_cast<uint32_t>(sizeof(Sb_VisibilityDraw)) * renderer_max_visibility_draws;
+        buffer(Renderer_Buffer::VisibilityDraws) = make_shared<RHI_Buffer>(stride, element_count, 0, "visibility_draws");
+
+        // light tiles, the indirect arguments are reset from the cpu every frame
+        stride = static_cast<uint32_t>(sizeof(uint32_t)) * 4 * static_cast<uint32_t>(Renderer_LightTile::Max);
+        buffer(Renderer_Buffer::LightTileArgs) = make_shared<RHI_Buffer>(stride, element_count, RHI_Buffer_Indirect, "light_tile_args");
+        stride = static_cast<uint32_t>(sizeof(uint32_t)) * renderer_light_tile_capacity * static_cast<uint32_t>(Renderer_LightTile::Max);
+        buffer(Renderer_Buffer::LightTiles) = make_shared<RHI_Buffer>(stride, 1, 0, "light_tiles");
+
+        // instance uploads, one slot per frame, what doesn't fit in a frame's slot is uploaded on the next one
+        stride = 4 * 1024 * 1024;
+        buffer(Renderer_Buffer::InstanceUpload) = make_shared<RHI_Buffer>(stride, element_count, RHI_Buffer_Transfer_Src, "instance_upload");
     }
 
     void Renderer::CreateDepthStencilStates()
@@ -200,7 +216,10 @@ namespace Spartan
         }
 
         // notes:
-        // - gbuffer_normal: any format with or below 8 bits per channel, will produce banding
+        // - gbuffer_normal: octahedral encoding, any format with or below 8 bits per channel, will produce banding
+        // - g-buffer bytes per pixel: 16 (color 4, normal 4, material 4, velocity 4), was 20 with an rgba16f normal
+        // - gbuffer_normal_unpacked: world space normals for fidelityfx (sssr, brixelizer gi), written when either is enabled (both are by default),
+        //   r10g10b10a2 so that the default cost is 16 + 4 (write) bytes per pixel, plus a full screen read of the packed normal
         #define render_target(x) render_targets[static_cast<uint8_t>(x)]
 
         // typical flags
@@ -221,13 +240,15 @@ namespace Spartan
 
             // g-buffer
             {
-                render_target(Renderer_RenderTarget::gbuffer_color)          = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R8G8B8A8_Unorm,     flags_rt_clearable, "gbuffer_color");
-                render_target(Renderer_RenderTarget::gbuffer_normal)         = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R16G16B16A16_Float, flags_rt_clearable, "gbuffer_normal");
-                render_target(Renderer_RenderTarget::gbuffer_material)       = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R8G8B8A8_Unorm,     flags_rt_clearable, "gbuffer_material");
-                render_target(Renderer_RenderTarget::gbuffer_velocity)       = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R16G16_Float,       flags_rt_clearable, "gbuffer_velocity");
-                render_target(Renderer_RenderTarget::gbuffer_depth)          = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::D32_Float,          flags_rt_depth,     "gbuffer_depth");
-                render_target(Renderer_RenderTarget::gbuffer_depth_opaque)   = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::D32_Float,          flags_rt_depth,     "gbuffer_depth_opaque");
-                render_target(Renderer_RenderTarget::gbuffer_depth_backface) = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::D32_Float,          flags_rt_depth,     "gbuffer_depth_backface");
+                render_target(Renderer_RenderTarget::gbuffer_color)           = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R8G8B8A8_Unorm,     flags_rt_clearable, "gbuffer_color");
+                render_target(Renderer_RenderTarget::gbuffer_normal)          = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R10G10B10A2_Unorm,  flags_rt_clearable, "gbuffer_normal");
+                render_target(Renderer_RenderTarget::gbuffer_normal_unpacked) = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R10G10B10A2_Unorm,  flags,              "gbuffer_normal_unpacked");
+                render_target(Renderer_RenderTarget::gbuffer_material)        = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R8G8B8A8_Unorm,     flags_rt_clearable, "gbuffer_material");
+                render_target(Renderer_RenderTarget::gbuffer_velocity)        = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R16G16_Float,       flags_rt_clearable, "gbuffer_velocity");
+                render_target(Renderer_RenderTarget::gbuffer_visibility)      = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::R32_Uint,           flags_rt_clearable, "gbuffer_visibility");
+                render_target(Renderer_RenderTarget::gbuffer_depth)           = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::D32_Float,          flags_rt_depth,     "gbuffer_depth");
+                render_target(Renderer_RenderTarget::gbuffer_depth_opaque)    = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::D32_Float,          flags_rt_depth,     "gbuffer_depth_opaque");
+                render_target(Renderer_RenderTarget::gbuffer_depth_backface)  = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format::D32_Float,          flags_rt_depth,     "gbuffer_depth_backface");
             }
 
             // light
@@ -264,6 +285,18 @@ namespace Spartan
             render_target(Renderer_RenderTarget::bloom)                = make_shared<RHI_Texture2D>(width_output, height_output, mip_count, RHI_Format::R11G11B10_Float, flags | RHI_Texture_PerMipViews, "bloom");
             render_target(Renderer_RenderTarget::outline)              = make_unique<RHI_Texture2D>(width_output, height_output, 1,         RHI_Format::R8G8B8A8_Unorm,  flags_rt,                        "outline");
             render_target(Renderer_RenderTarget::gbuffer_depth_output) = make_shared<RHI_Texture2D>(width_output, height_output, 1,         RHI_Format::D32_Float,       flags_rt_depth,                  "gbuffer_depth_output");
+
+            // depth of field and motion blur, they run at half resolution with one 16x16 tile per thread group
+            {
+                uint32_t width_half  = (width_output  + 1) / 2;
+                uint32_t height_half = (height_output + 1) / 2;
+                uint32_t width_tile  = (width_output  + 15) / 16;
+                uint32_t height_tile = (height_output + 15) / 16;
+
+                render_target(Renderer_RenderTarget::post_process_half)         = make_unique<RHI_Texture2D>(width_half, height_half, 1, RHI_Format::R16G16B16A16_Float, flags, "post_process_half");
+                render_target(Renderer_RenderTarget::post_process_tile)         = make_unique<RHI_Texture2D>(width_tile, height_tile, 1, RHI_Format::R16G16_Float,       flags, "post_process_tile");
+                render_target(Renderer_RenderTarget::post_process_tile_dilated) = make_unique<RHI_Texture2D>(width_tile, height_tile, 1, RHI_Format::R16G16_Float,       flags, "post_process_tile_dilated");
+            }
         }
 
         // resolution - fixed (created once)
@@ -340,6 +373,27 @@ namespace Spartan
 
             shader(Renderer_Shader::gbuffer_p) = make_shared<RHI_Shader>();
             shader(Renderer_Shader::gbuffer_p)->Compile(RHI_Shader_Type::Pixel, shader_dir + "g_buffer.hlsl", async);
+
+            shader(Renderer_Shader::gbuffer_normal_unpack_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::gbuffer_normal_unpack_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "g_buffer.hlsl", async);
+
+            // permutations, features a material doesn't use are compiled out, only the ones the scene's materials use are compiled (see CreateGbufferPipelines())
+            {
+                lock_guard lock(mutex_shaders_gbuffer);
+                shaders_gbuffer.fill(nullptr);
+            }
+        }
+
+        // visibility buffer
+        {
+            shader(Renderer_Shader::visibility_buffer_v) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::visibility_buffer_v)->Compile(RHI_Shader_Type::Vertex, shader_dir + "visibility_buffer.hlsl", async, RHI_Vertex_Type::PosUvNorTan);
+
+            shader(Renderer_Shader::visibility_buffer_p) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::visibility_buffer_p)->Compile(RHI_Shader_Type::Pixel, shader_dir + "visibility_buffer.hlsl", async);
+
+            shader(Renderer_Shader::visibility_buffer_resolve_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::visibility_buffer_resolve_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "visibility_buffer.hlsl", async);
         }
 
         // tessellation
@@ -367,6 +421,21 @@ namespace Spartan
             shader(Renderer_Shader::light_c) = make_shared<RHI_Shader>();
             shader(Renderer_Shader::light_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "light.hlsl", async);
 
+            // light - tiled permutations
+            {
+                shader(Renderer_Shader::light_tile_classification_c) = make_shared<RHI_Shader>();
+                shader(Renderer_Shader::light_tile_classification_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "light_tile_classification.hlsl", async);
+
+                shader(Renderer_Shader::light_tiled_c) = make_shared<RHI_Shader>();
+                shader(Renderer_Shader::light_tiled_c)->AddDefine("LIGHT_TILES");
+                shader(Renderer_Shader::light_tiled_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "light.hlsl", async);
+
+                shader(Renderer_Shader::light_tiled_simple_c) = make_shared<RHI_Shader>();
+                shader(Renderer_Shader::light_tiled_simple_c)->AddDefine("LIGHT_TILES");
+                shader(Renderer_Shader::light_tiled_simple_c)->AddDefine("LIGHT_SIMPLE");
+                shader(Renderer_Shader::light_tiled_simple_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "light.hlsl", async);
+            }
+
             // composition
             shader(Renderer_Shader::light_composition_c) = make_shared<RHI_Shader>();
             shader(Renderer_Shader::light_composition_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "light_composition.hlsl", async);
@@ -374,6 +443,10 @@ namespace Spartan
             // image based
             shader(Renderer_Shader::light_image_based_c) = make_shared<RHI_Shader>();
             shader(Renderer_Shader::light_image_based_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "light_image_based.hlsl", async);
+
+            shader(Renderer_Shader::light_image_based_tiled_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::light_image_based_tiled_c)->AddDefine("LIGHT_TILES");
+            shader(Renderer_Shader::light_image_based_tiled_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "light_image_based.hlsl", async);
         }
 
         // quad
@@ -460,8 +533,22 @@ namespace Spartan
         shader(Renderer_Shader::output_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "output.hlsl", async);
 
         // motion blur
-        shader(Renderer_Shader::motion_blur_c) = make_shared<RHI_Shader>();
-        shader(Renderer_Shader::motion_blur_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "motion_blur.hlsl", async);
+        {
+            shader(Renderer_Shader::motion_blur_tile_max_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::motion_blur_tile_max_c)->AddDefine("TILE_MAX");
+            shader(Renderer_Shader::motion_blur_tile_max_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "motion_blur.hlsl", async);
+
+            shader(Renderer_Shader::motion_blur_tile_dilate_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::motion_blur_tile_dilate_c)->AddDefine("TILE_DILATE");
+            shader(Renderer_Shader::motion_blur_tile_dilate_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "motion_blur.hlsl", async);
+
+            shader(Renderer_Shader::motion_blur_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::motion_blur_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "motion_blur.hlsl", async);
+
+            shader(Renderer_Shader::motion_blur_upsample_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::motion_blur_upsample_c)->AddDefine("UPSAMPLE");
+            shader(Renderer_Shader::motion_blur_upsample_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "motion_blur.hlsl", async);
+        }
 
         // screen space global illumination
         shader(Renderer_Shader::ssao_c) = make_shared<RHI_Shader>();
@@ -472,8 +559,22 @@ namespace Spartan
         shader(Renderer_Shader::sss_c_bend)->Compile(RHI_Shader_Type::Compute, shader_dir + "screen_space_shadows\\bend_sss.hlsl", async);
 
         // depth of field
-        shader(Renderer_Shader::depth_of_field_c) = make_shared<RHI_Shader>();
-        shader(Renderer_Shader::depth_of_field_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "depth_of_field.hlsl", async);
+        {
+            shader(Renderer_Shader::depth_of_field_tile_max_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::depth_of_field_tile_max_c)->AddDefine("TILE_MAX");
+            shader(Renderer_Shader::depth_of_field_tile_max_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "depth_of_field.hlsl", async);
+
+            shader(Renderer_Shader::depth_of_field_tile_dilate_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::depth_of_field_tile_dilate_c)->AddDefine("TILE_DILATE");
+            shader(Renderer_Shader::depth_of_field_tile_dilate_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "depth_of_field.hlsl", async);
+
+            shader(Renderer_Shader::depth_of_field_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::depth_of_field_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "depth_of_field.hlsl", async);
+
+            shader(Renderer_Shader::depth_of_field_upsample_c) = make_shared<RHI_Shader>();
+            shader(Renderer_Shader::depth_of_field_upsample_c)->AddDefine("UPSAMPLE");
+            shader(Renderer_Shader::depth_of_field_upsample_c)->Compile(RHI_Shader_Type::Compute, shader_dir + "depth_of_field.hlsl", async);
+        }
 
         // variable rate shading
         shader(Renderer_Shader::variable_rate_shading_c) = make_shared<RHI_Shader>();
@@ -627,6 +728,10 @@ namespace Spartan
     {
         render_targets.fill(nullptr);
         shaders.fill(nullptr);
+        {
+            lock_guard lock(mutex_shaders_gbuffer);
+            shaders_gbuffer.fill(nullptr);
+        }
         samplers.fill(nullptr);
         standard_textures.fill(nullptr);
         standard_meshes.fill(nullptr);
@@ -676,6 +781,22 @@ namespace Spartan
         return shaders[static_cast<uint8_t>(type)];
     }
 
+    shared_ptr<RHI_Shader> Renderer::GetShaderGbuffer(const uint32_t features)
+    {
+        // a scene only uses a handful of the permutations, so they are compiled (async) when a material is found to need them
+        lock_guard lock(mutex_shaders_gbuffer);
+
+        shared_ptr<RHI_Shader>& shader = shaders_gbuffer[features];
+        if (!shader)
+        {
+            shader = make_shared<RHI_Shader>();
+            shader->AddDefine("GBUFFER_FEATURES", to_string(features));
+            shader->Compile(RHI_Shader_Type::Pixel, ResourceCache::GetResourceDirectory(ResourceDirectory::Shaders) + "\\g_buffer.hlsl", true);
+        }
+
+        return shader;
+    }
+
     shared_ptr<RHI_Sampler> Renderer::GetSampler(const Renderer_Sampler type)
     {
         return samplers[static_cast<uint8_t>(type)];
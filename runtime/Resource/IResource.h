@@ -24,7 +24,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =====================
 #include <memory>
 #include <atomic>
+#include <vector>
 #include "../Core/FileSystem.h"
+#include "../Core/Hash.h"
 #include "../Core/SpartanObject.h"
 #include "../Logging/Log.h"
 //================================
@@ -110,6 +112,10 @@ namespace Spartan
         uint32_t GetFlags()           const { return m_flags; }
         void SetFlags(const uint32_t flags) { m_flags = flags; }
 
+        // content hash, set by whoever creates the resource from data that can be hashed (e.g. the model importer)
+        const hash_128& GetContentHash() const         { return m_content_hash; }
+        void SetContentHash(const hash_128& hash)      { m_content_hash = hash; }
+
         // ready to use
         bool IsReadyForUse() const { return m_is_ready_for_use; }
 
@@ -117,6 +123,9 @@ namespace Spartan
         virtual bool SaveToFile(const std::string& file_path) { return true; }
         virtual bool LoadFromFile(const std::string& file_path) { return true; }
 
+        // what SaveToFile() writes, into memory, false when there is nothing to write
+        virtual bool SaveToMemory(std::vector<std::byte>* data) { return false; }
+
         // type
         template <typename T>
         static constexpr ResourceType TypeToEnum();
@@ -125,6 +134,7 @@ namespace Spartan
         ResourceType m_resource_type         = ResourceType::Max;
         std::atomic<bool> m_is_ready_for_use = false;
         uint32_t m_flags                     = 0;
+        hash_128 m_content_hash;
 
     private:
         std::string m_resource_directory;
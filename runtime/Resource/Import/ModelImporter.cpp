@@ -19,11 +19,13 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ==========================
+//= INCLUDES ============================
 #include "pch.h"
 #include "ModelImporter.h"
 #include "../../Core/ProgressTracker.h"
-#include "../../RHI/RHI_Texture.h"
+#include "../../IO/FileStream.h"
+#include "../../RHI/RHI_Texture2D.h"
+#include "../../Resource/ResourceCache.h"
 #include "../../Rendering/Animation.h"
 #include "../../Rendering/Mesh.h"
 #include "../../World/World.h"
@@ -36,7 +38,7 @@ SP_WARNINGS_OFF
 #include "assimp/Importer.hpp"
 #include "assimp/postprocess.h"
 SP_WARNINGS_ON
-//=====================================
+//=======================================
 
 //= NAMESPACES ===============
 using namespace std;
@@ -55,6 +57,30 @@ namespace Spartan
         bool model_is_gltf       = false;
         const aiScene* scene     = nullptr;
 
+        // content deduplication, scoped to a single import
+        struct geometry_range
+        {
+            uint32_t index_offset  = 0;
+            uint32_t index_count   = 0;
+            uint32_t vertex_offset = 0;
+            uint32_t vertex_count  = 0;
+            BoundingBox aabb;
+        };
+
+        struct deduplication_stats
+        {
+            uint32_t textures    = 0;
+            uint32_t materials   = 0;
+            uint32_t meshes      = 0;
+            uint64_t bytes_saved = 0;
+        };
+
+        unordered_map<const aiMesh*, geometry_range> geometry_by_mesh;
+        unordered_map<hash_128, geometry_range, hash_128_hasher> geometry_by_hash;
+        unordered_map<uint32_t, shared_ptr<Material>> material_by_index;
+        unordered_map<hash_128, shared_ptr<Material>, hash_128_hasher> material_by_hash;
+        deduplication_stats deduplication;
+
         Matrix convert_matrix(const aiMatrix4x4& transform)
         {
             return Matrix
@@ -213,6 +239,114 @@ namespace Spartan
             return "";
         }
 
+        // the extension of an image file, from its signature, an empty string if it's not recognized
+        string texture_get_extension(const unsigned char* data, const uint64_t size)
+        {
+            auto starts_with = [data, size](const char* signature, const uint64_t length, const uint64_t offset = 0)
+            {
+                return size >= offset + length && memcmp(data + offset, signature, length) == 0;
+            };
+
+            if (starts_with("\x89PNG", 4))                                  return ".png";
+            if (starts_with("\xFF\xD8\xFF", 3))                             return ".jpg";
+            if (starts_with("DDS ", 4))                                     return ".dds";
+            if (starts_with("BM", 2))                                       return ".bmp";
+            if (starts_with("GIF8", 4))                                     return ".gif";
+            if (starts_with("8BPS", 4))                                     return ".psd";
+            if (starts_with("#?", 2))                                       return ".hdr";
+            if (starts_with("\x76\x2F\x31\x01", 4))                         return ".exr";
+            if (starts_with("II*\0", 4) || starts_with("MM\0*", 4))         return ".tiff";
+            if (starts_with("RIFF", 4) && starts_with("WEBP", 4, 8))        return ".webp";
+
+            return "";
+        }
+
+        string texture_extract_embedded(const aiTexture* texture_embedded)
+        {
+            // only compressed textures (whole image files) are supported, raw texels are rare
+            if (texture_embedded->mHeight != 0)
+                return "";
+
+            const uint64_t size = texture_embedded->mWidth;
+            const hash_128 hash = hash_compute(texture_embedded->pcData, size);
+
+            // the format hint is optional, so the data decides, tga has no signature and falls back to the hint
+            const unsigned char* data = reinterpret_cast<const unsigned char*>(texture_embedded->pcData);
+            string extension          = texture_get_extension(data, size);
+            if (extension.empty() && texture_embedded->achFormatHint[0] != '\0')
+            {
+                extension = string(".") + texture_embedded->achFormatHint;
+            }
+
+            if (extension.empty())
+            {
+                SP_LOG_WARNING("Failed to deduce the format of an embedded texture, skipping it");
+                return "";
+            }
+
+            // name the file after its content, so identical embedded textures end up being the same file, the
+            // model's directory can be read-only or shared between projects, so it's written to the project cache
+            char name[48];
+            snprintf(name, sizeof(name), "embedded_%016llx%016llx", static_cast<unsigned long long>(hash.high), static_cast<unsigned long long>(hash.low));
+            const string directory    = ResourceCache::GetResourceDirectory(ResourceDirectory::Cache);
+            const string texture_path = directory + "\\" + name + extension;
+
+            if (!FileSystem::Exists(texture_path))
+            {
+                if (!FileSystem::Exists(directory))
+                {
+                    FileSystem::CreateDirectory(directory);
+                }
+
+                FileStream file(texture_path, FileStream_Write);
+                if (!file.IsOpen())
+                    return "";
+
+                file.Write(reinterpret_cast<const std::byte*>(texture_embedded->pcData), size);
+                file.Close();
+            }
+
+            return texture_path;
+        }
+
+        void texture_add(Mesh* mesh, shared_ptr<Material>& material, const MaterialTexture texture_type, const string& file_path, const bool is_gltf)
+        {
+            // hash the file instead of the decoded pixels, that way a duplicate is caught before it's decoded, compressed and uploaded
+            hash_128 hash;
+            uint64_t size = 0;
+            if (const std::byte* data = FileSystem::MapFile(file_path, &size))
+            {
+                hash = hash_compute(data, size);
+                FileSystem::UnmapFile(data, size);
+            }
+
+            if (hash.IsDefined())
+            {
+                if (shared_ptr<RHI_Texture2D> texture = ResourceCache::GetByContentHash<RHI_Texture2D>(hash))
+                {
+                    // the same file referenced again is not a duplicate, it would have been found by name anyway
+                    if (texture->GetResourceFilePath() != FileSystem::GetRelativePath(file_path))
+                    {
+                        deduplication.textures++;
+                        deduplication.bytes_saved += texture->GetObjectSize();
+                    }
+
+                    material->SetTexture(texture_type, texture);
+                    return;
+                }
+            }
+
+            mesh->AddTexture(material, texture_type, file_path, is_gltf);
+
+            if (RHI_Texture* texture = material->GetTexture(texture_type))
+            {
+                if (!texture->GetContentHash().IsDefined())
+                {
+                    texture->SetContentHash(hash);
+                }
+            }
+        }
+
         bool load_material_texture(
             Mesh* mesh,
             const string& file_path,
@@ -239,12 +373,13 @@ namespace Spartan
                 return false;
 
             // see if the texture type is supported by the engine
-            const string deduced_path = texture_validate_path(texture_path.data, file_path);
+            const aiTexture* texture_embedded = scene->GetEmbeddedTexture(texture_path.C_Str());
+            const string deduced_path         = texture_embedded ? texture_extract_embedded(texture_embedded) : texture_validate_path(texture_path.data, file_path);
             if (!FileSystem::IsSupportedImageFile(deduced_path))
                 return false;
 
             // add the texture to the model
-            mesh->AddTexture(material, texture_type, texture_validate_path(texture_path.data, file_path), is_gltf);
+            texture_add(mesh, material, texture_type, deduced_path, is_gltf);
 
             // FIX: materials that have a diffuse texture should not be tinted black/gray
             if (type_assimp == aiTextureType_BASE_COLOR || type_assimp == aiTextureType_DIFFUSE)
@@ -384,6 +519,51 @@ namespace Spartan
 
             return material;
         }
+
+        hash_128 material_compute_hash(Material* material)
+        {
+            hash_128 hash;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(MaterialProperty::Max); i++)
+            {
+                hash = hash_compute(material->GetProperty(static_cast<MaterialProperty>(i)), hash);
+            }
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(MaterialTexture::Max); i++)
+            {
+                RHI_Texture* texture = material->GetTexture(static_cast<MaterialTexture>(i));
+                hash                 = hash_compute(texture ? texture->GetObjectId() : 0, hash);
+            }
+
+            return hash;
+        }
+
+        shared_ptr<Material> get_material(Mesh* mesh, const uint32_t material_index)
+        {
+            // meshes that share an assimp material share the engine material
+            auto it = material_by_index.find(material_index);
+            if (it != material_by_index.end())
+                return it->second;
+
+            shared_ptr<Material> material = load_material(mesh, model_file_path, model_is_gltf, scene->mMaterials[material_index]);
+
+            // differently named materials with identical parameters and textures collapse onto the first one
+            const hash_128 hash = material_compute_hash(material.get());
+            auto it_hash        = material_by_hash.find(hash);
+            if (it_hash != material_by_hash.end())
+            {
+                material = it_hash->second;
+                deduplication.materials++;
+            }
+            else
+            {
+                material->SetContentHash(hash);
+                material_by_hash[hash] = material;
+            }
+
+            material_by_index[material_index] = material;
+
+            return material;
+        }
     }
 
     void ModelImporter::Initialize()
@@ -411,6 +591,13 @@ namespace Spartan
         model_is_gltf   = FileSystem::GetExtensionFromFilePath(file_path) == ".gltf";
         mesh->SetObjectName(model_name);
 
+        // deduplication
+        geometry_by_mesh.clear();
+        geometry_by_hash.clear();
+        material_by_index.clear();
+        material_by_hash.clear();
+        deduplication = deduplication_stats();
+
         // set up the importer
         Importer importer;
         {
@@ -505,6 +692,13 @@ namespace Spartan
                 mesh->CreateGpuBuffers();
             }
 
+            if (deduplication.textures != 0 || deduplication.materials != 0 || deduplication.meshes != 0)
+            {
+                SP_LOG_INFO("Deduplicated %u textures, %u materials and %u meshes in \"%s\", saving %.2f MB",
+                    deduplication.textures, deduplication.materials, deduplication.meshes, model_name.c_str(),
+                    static_cast<float>(deduplication.bytes_saved) / (1024.0f * 1024.0f));
+            }
+
             // make the root entity active since it's now thread-safe
             mesh->GetRootEntity().lock()->SetActive(true);
             World::Resolve();
@@ -517,6 +711,10 @@ namespace Spartan
 
         importer.FreeScene();
         mesh = nullptr;
+        geometry_by_mesh.clear();
+        geometry_by_hash.clear();
+        material_by_index.clear();
+        material_by_hash.clear();
 
         return scene != nullptr;
     }
@@ -654,74 +852,101 @@ namespace Spartan
         SP_ASSERT(assimp_mesh != nullptr);
         SP_ASSERT(entity_parent != nullptr);
 
-        const uint32_t vertex_count = assimp_mesh->mNumVertices;
-        const uint32_t index_count  = assimp_mesh->mNumFaces * 3;
-
-        // vertices
-        vector<RHI_Vertex_PosTexNorTan> vertices = vector<RHI_Vertex_PosTexNorTan>(vertex_count);
+        // the same assimp mesh can be referenced by several nodes, and different meshes can hold identical data
+        geometry_range range;
+        auto it = geometry_by_mesh.find(assimp_mesh);
+        if (it != geometry_by_mesh.end())
         {
-            for (uint32_t i = 0; i < vertex_count; i++)
+            range = it->second;
+            deduplication.meshes++;
+            deduplication.bytes_saved += static_cast<uint64_t>(range.vertex_count) * sizeof(RHI_Vertex_PosTexNorTan) + static_cast<uint64_t>(range.index_count) * sizeof(uint32_t);
+        }
+        else
+        {
+            const uint32_t vertex_count = assimp_mesh->mNumVertices;
+            const uint32_t index_count  = assimp_mesh->mNumFaces * 3;
+
+            // vertices
+            vector<RHI_Vertex_PosTexNorTan> vertices = vector<RHI_Vertex_PosTexNorTan>(vertex_count);
             {
-                RHI_Vertex_PosTexNorTan& vertex = vertices[i];
+                for (uint32_t i = 0; i < vertex_count; i++)
+                {
+                    RHI_Vertex_PosTexNorTan& vertex = vertices[i];
 
-                // position
-                const aiVector3D& pos = assimp_mesh->mVertices[i];
-                vertex.pos[0] = pos.x;
-                vertex.pos[1] = pos.y;
-                vertex.pos[2] = pos.z;
+                    // position
+                    const aiVector3D& pos = assimp_mesh->mVertices[i];
+                    vertex.pos[0] = pos.x;
+                    vertex.pos[1] = pos.y;
+                    vertex.pos[2] = pos.z;
 
-                // normal
-                if (assimp_mesh->mNormals)
-                {
-                    const aiVector3D& normal = assimp_mesh->mNormals[i];
-                    vertex.nor[0] = normal.x;
-                    vertex.nor[1] = normal.y;
-                    vertex.nor[2] = normal.z;
-                }
+                    // normal
+                    if (assimp_mesh->mNormals)
+                    {
+                        const aiVector3D& normal = assimp_mesh->mNormals[i];
+                        vertex.nor[0] = normal.x;
+                        vertex.nor[1] = normal.y;
+                        vertex.nor[2] = normal.z;
+                    }
 
-                // tangent
-                if (assimp_mesh->mTangents)
-                {
-                    const aiVector3D& tangent = assimp_mesh->mTangents[i];
-                    vertex.tan[0] = tangent.x;
-                    vertex.tan[1] = tangent.y;
-                    vertex.tan[2] = tangent.z;
+                    // tangent
+                    if (assimp_mesh->mTangents)
+                    {
+                        const aiVector3D& tangent = assimp_mesh->mTangents[i];
+                        vertex.tan[0] = tangent.x;
+                        vertex.tan[1] = tangent.y;
+                        vertex.tan[2] = tangent.z;
+                    }
+
+                    // texture coordinates
+                    const uint32_t uv_channel = 0;
+                    if (assimp_mesh->HasTextureCoords(uv_channel))
+                    {
+                        const auto& tex_coords = assimp_mesh->mTextureCoords[uv_channel][i];
+                        vertex.tex[0] = tex_coords.x;
+                        vertex.tex[1] = tex_coords.y;
+                    }
                 }
+            }
 
-                // texture coordinates
-                const uint32_t uv_channel = 0;
-                if (assimp_mesh->HasTextureCoords(uv_channel))
+            // indices
+            vector<uint32_t> indices = vector<uint32_t>(index_count);
+            {
+                // get indices by iterating through each face of the mesh.
+                for (uint32_t face_index = 0; face_index < assimp_mesh->mNumFaces; face_index++)
                 {
-                    const auto& tex_coords = assimp_mesh->mTextureCoords[uv_channel][i];
-                    vertex.tex[0] = tex_coords.x;
-                    vertex.tex[1] = tex_coords.y;
+                    // if (aiPrimitiveType_LINE | aiPrimitiveType_POINT) && aiProcess_Triangulate) then (face.mNumIndices == 3)
+                    const aiFace& face           = assimp_mesh->mFaces[face_index];
+                    const uint32_t indices_index = (face_index * 3);
+                    indices[indices_index + 0]   = face.mIndices[0];
+                    indices[indices_index + 1]   = face.mIndices[1];
+                    indices[indices_index + 2]   = face.mIndices[2];
                 }
             }
-        }
 
-        // indices
-        vector<uint32_t> indices = vector<uint32_t>(index_count);
-        {
-            // get indices by iterating through each face of the mesh.
-            for (uint32_t face_index = 0; face_index < assimp_mesh->mNumFaces; face_index++)
+            const hash_128 hash = hash_compute(indices.data(), indices.size() * sizeof(uint32_t), hash_compute(vertices.data(), vertices.size() * sizeof(RHI_Vertex_PosTexNorTan)));
+            auto it_hash        = geometry_by_hash.find(hash);
+            if (it_hash != geometry_by_hash.end())
             {
-                // if (aiPrimitiveType_LINE | aiPrimitiveType_POINT) && aiProcess_Triangulate) then (face.mNumIndices == 3)
-                const aiFace& face           = assimp_mesh->mFaces[face_index];
-                const uint32_t indices_index = (face_index * 3);
-                indices[indices_index + 0]   = face.mIndices[0];
-                indices[indices_index + 1]   = face.mIndices[1];
-                indices[indices_index + 2]   = face.mIndices[2];
+                range = it_hash->second;
+                deduplication.meshes++;
+                deduplication.bytes_saved += vertices.size() * sizeof(RHI_Vertex_PosTexNorTan) + indices.size() * sizeof(uint32_t);
             }
-        }
+            else
+            {
+                // compute AABB (before doing move operation on vertices)
+                range.aabb         = BoundingBox(vertices.data(), static_cast<uint32_t>(vertices.size()));
+                range.index_count  = static_cast<uint32_t>(indices.size());
+                range.vertex_count = static_cast<uint32_t>(vertices.size());
+
+                // add vertex and index data to the mesh
+                mesh->AddIndices(indices,  &range.index_offset);
+                mesh->AddVertices(vertices, &range.vertex_offset);
 
-        // compute AABB (before doing move operation on vertices)
-        const BoundingBox aabb = BoundingBox(vertices.data(), static_cast<uint32_t>(vertices.size()));
+                geometry_by_hash[hash] = range;
+            }
 
-        // add vertex and index data to the mesh
-        uint32_t index_offset  = 0;
-        uint32_t vertex_offset = 0;
-        mesh->AddIndices(indices,  &index_offset);
-        mesh->AddVertices(vertices, &vertex_offset);
+            geometry_by_mesh[assimp_mesh] = range;
+        }
 
         // add a renderable component to this entity
         shared_ptr<Renderable> renderable = entity_parent->AddComponent<Renderable>();
@@ -729,22 +954,17 @@ namespace Spartan
         // set the geometry
         renderable->SetGeometry(
             mesh,
-            aabb,
-            index_offset,
-            static_cast<uint32_t>(indices.size()),
-            vertex_offset,
-            static_cast<uint32_t>(vertices.size())
+            range.aabb,
+            range.index_offset,
+            range.index_count,
+            range.vertex_offset,
+            range.vertex_count
         );
 
         // material
         if (scene->HasMaterials())
         {
-            // get aiMaterial
-            const aiMaterial* assimp_material = scene->mMaterials[assimp_mesh->mMaterialIndex];
-
-            // convert it and add it to the model
-            shared_ptr<Material> material = load_material(mesh, model_file_path, model_is_gltf, assimp_material);
-
+            shared_ptr<Material> material = get_material(mesh, assimp_mesh->mMaterialIndex);
             mesh->SetMaterial(material, entity_parent.get());
         }
 
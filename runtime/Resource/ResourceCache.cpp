@@ -40,7 +40,7 @@ namespace Spartan
 {
     namespace
     {
-        array<string, 6> m_standard_resource_directories;
+        array<string, 7> m_standard_resource_directories;
         string m_project_directory;
         vector<shared_ptr<IResource>> m_resources;
         mutex m_mutex;
@@ -54,6 +54,7 @@ namespace Spartan
 
         // add engine standard resource directories
         const string data_dir = "data\\";
+        AddResourceDirectory(ResourceDirectory::Cache,          m_project_directory + "cache");
         AddResourceDirectory(ResourceDirectory::Environment,    m_project_directory + "environment");
         AddResourceDirectory(ResourceDirectory::Fonts,          data_dir + "fonts");
         AddResourceDirectory(ResourceDirectory::Icons,          data_dir + "icons");
@@ -62,7 +63,6 @@ namespace Spartan
         AddResourceDirectory(ResourceDirectory::Textures,       data_dir + "textures");
 
         // subscribe to events
-        SP_SUBSCRIBE_TO_EVENT(EventType::WorldSaveStart, SP_EVENT_HANDLER_STATIC(Serialize));
         SP_SUBSCRIBE_TO_EVENT(EventType::WorldLoadStart, SP_EVENT_HANDLER_STATIC(Deserialize));
         SP_SUBSCRIBE_TO_EVENT(EventType::WorldClear,     SP_EVENT_HANDLER_STATIC(Shutdown));
     }
@@ -112,6 +112,19 @@ namespace Spartan
         return empty;
     }
 
+    shared_ptr<IResource> ResourceCache::GetByContentHash(const hash_128& hash, const ResourceType type)
+    {
+        lock_guard<mutex> guard(m_mutex);
+
+        for (shared_ptr<IResource>& resource : m_resources)
+        {
+            if (resource->GetResourceType() == type && resource->GetContentHash() == hash)
+                return resource;
+        }
+
+        return nullptr;
+    }
+
     vector<shared_ptr<IResource>> ResourceCache::GetByType(const ResourceType type /*= ResourceType::Unknown*/)
     {
         lock_guard<mutex> guard(m_mutex);
@@ -147,41 +160,36 @@ namespace Spartan
         return size;
     }
 
-    void ResourceCache::Serialize()
+    void ResourceCache::Serialize(const string& world_name, vector<pair<string, vector<byte>>>* files)
     {
-        // create resource list file
-        string file_path = GetProjectDirectoryAbsolute() + World::GetName() + ".resource";
-        auto file = make_unique<FileStream>(file_path, FileStream_Write);
-        if (!file->IsOpen())
-        {
-            SP_LOG_ERROR("Failed to open file.");
-            return;
-        }
+        SP_ASSERT(files != nullptr);
 
-        const uint32_t resource_count = GetResourceCount();
+        vector<shared_ptr<IResource>> resources = GetByType();
+        resources.erase(remove_if(resources.begin(), resources.end(), [](const shared_ptr<IResource>& resource) { return !resource->HasFilePathNative(); }), resources.end());
 
-        // start progress report
-        ProgressTracker::GetProgress(ProgressType::Resource).Start(resource_count, "Loading resources...");
+        FileStream list;
+        list.Write(static_cast<uint32_t>(resources.size()));
 
-        // save resource count
-        file->Write(resource_count);
-
-        // save all the currently used resources to disk
-        for (shared_ptr<IResource>& resource : m_resources)
+        for (const shared_ptr<IResource>& resource : resources)
         {
-            if (resource->HasFilePathNative())
-            {
-                SP_ASSERT_MSG(!resource->GetResourceFilePathNative().empty(), "Resources must have a native file path");
-                SP_ASSERT_MSG(resource->GetResourceType() != ResourceType::Max, "Resources must have a type");
+            SP_ASSERT_MSG(resource->GetResourceType() != ResourceType::Max, "Resources must have a type");
 
-                file->Write(resource->GetResourceFilePathNative());              // file path
-                file->Write(static_cast<uint32_t>(resource->GetResourceType())); // type
-                resource->SaveToFile(resource->GetResourceFilePathNative());     // save
-            }
+            const string& file_path = resource->GetResourceFilePathNative();
+            list.Write(file_path);                                          // file path
+            list.Write(static_cast<uint32_t>(resource->GetResourceType())); // type
 
-            // update progress
-            ProgressTracker::GetProgress(ProgressType::Resource).JobDone();
+            // imported data doesn't change once it's on disk, materials do, but they are small
+            if (resource->GetResourceType() == ResourceType::Material || !FileSystem::Exists(file_path))
+            {
+                vector<byte> data;
+                if (resource->SaveToMemory(&data))
+                {
+                    files->emplace_back(file_path, move(data));
+                }
+            }
         }
+
+        files->emplace_back(GetProjectDirectoryAbsolute() + world_name + ".resource", list.GetData());
     }
 
     void ResourceCache::Deserialize()
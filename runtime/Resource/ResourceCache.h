@@ -31,6 +31,7 @@ namespace Spartan
 {
     enum class ResourceDirectory
     {
+        Cache,
         Environment,
         Fonts,
         Icons,
@@ -53,6 +54,14 @@ namespace Spartan
             return std::static_pointer_cast<T>(GetByName(name, IResource::TypeToEnum<T>()));
         }
 
+        // get by content, resources that don't hash their content are never returned
+        static std::shared_ptr<IResource> GetByContentHash(const hash_128& hash, ResourceType type);
+        template <class T>
+        static std::shared_ptr<T> GetByContentHash(const hash_128& hash)
+        {
+            return std::static_pointer_cast<T>(GetByContentHash(hash, IResource::TypeToEnum<T>()));
+        }
+
         // get by type
         static std::vector<std::shared_ptr<IResource>> GetByType(ResourceType type = ResourceType::Max);
 
@@ -158,6 +167,10 @@ namespace Spartan
             );
         }
 
+        // serializes the list of resources that the world with the given name loads, along with the resources that have to be
+        // written, into memory as (file path, bytes), so that the files can be written on any thread while the resources change
+        static void Serialize(const std::string& world_name, std::vector<std::pair<std::string, std::vector<std::byte>>>* files);
+
         // memory
         static uint64_t GetMemoryUsage(ResourceType type = ResourceType::Max);
         static uint32_t GetResourceCount(ResourceType type = ResourceType::Max);
@@ -181,7 +194,6 @@ namespace Spartan
         static bool IsCached(const std::string& resource_name, const ResourceType resource_type);
 
         // event handlers
-        static void Serialize();
         static void Deserialize();
     };
 }
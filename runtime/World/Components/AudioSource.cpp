@@ -80,6 +80,13 @@ namespace Spartan
         if (!m_audio_clip)
             return;
 
+        // play requests made while the clip was still loading
+        if (m_play_pending && m_audio_clip->GetState() != AudioClipState::Loading)
+        {
+            m_play_pending = false;
+            Play();
+        }
+
         m_audio_clip->Update();
     }
     
@@ -143,10 +150,17 @@ namespace Spartan
         return m_audio_clip->IsPlaying();
 	}
 
-	void AudioSource::Play() const
+	void AudioSource::Play()
     {
         if (!m_audio_clip)
             return;
+
+        // don't block on the clip, defer until it's loaded
+        if (!m_audio_clip->IsReady())
+        {
+            m_play_pending = m_audio_clip->GetState() == AudioClipState::Loading;
+            return;
+        }
     
         m_audio_clip->Play(m_loop, m_3d);
         m_audio_clip->SetMute(m_mute);
@@ -155,8 +169,10 @@ namespace Spartan
         m_audio_clip->SetPan(m_pan);
     }
     
-    void AudioSource::Stop() const
+    void AudioSource::Stop()
     {
+        m_play_pending = false;
+
         if (!m_audio_clip)
             return;
     
@@ -51,8 +51,8 @@ namespace Spartan
         std::string GetAudioClipName() const;
 
         bool IsPlaying() const;
-        void Play() const;
-        void Stop() const;
+        void Play();
+        void Stop();
 
         bool GetMute() const { return m_mute; }
         void SetMute(bool mute);
@@ -80,15 +80,15 @@ namespace Spartan
         //================================================================================
 
     private:
-        bool m_mute              = false;
-        bool m_loop              = true;
-        bool m_3d                = false;
-        bool m_audio_clip_loaded = false;
-        bool m_play_on_start     = true;
-        int m_priority           = 128;
-        float m_volume           = 1.0f;
-        float m_pitch            = 1.0f;
-        float m_pan              = 0.0f;
+        bool m_mute          = false;
+        bool m_loop          = true;
+        bool m_3d            = false;
+        bool m_play_pending  = false;
+        bool m_play_on_start = true;
+        int m_priority       = 128;
+        float m_volume       = 1.0f;
+        float m_pitch        = 1.0f;
+        float m_pan          = 0.0f;
         std::shared_ptr<AudioClip> m_audio_clip;
     };
 }
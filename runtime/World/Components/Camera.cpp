@@ -19,7 +19,7 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ========================
+//= INCLUDES ============================
 #include "pch.h"
 #include "Camera.h"
 #include "Renderable.h"
@@ -30,8 +30,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Input/Input.h"
 #include "../../IO/FileStream.h"
 #include "../../Rendering/Renderer.h"
+#include "../../Rendering/Readback.h"
+#include "../../RHI/RHI_GeometryBuffer.h"
 #include "../../Display/Display.h"
-//===================================
+//=======================================
 
 //= NAMESPACES ===============
 using namespace Spartan::Math;
@@ -40,6 +42,62 @@ using namespace std;
 
 namespace Spartan
 {
+    namespace
+    {
+        Vector2 world_to_screen(const Vector3& position_world, const Matrix& view_projection, const RHI_Viewport& viewport)
+        {
+            const Vector3 position_clip = position_world * view_projection;
+
+            // convert clip space position to screen space position
+            float viewport_half_width  = viewport.width  * 0.5f;
+            float viewport_half_height = viewport.height * 0.5f;
+            return Vector2(
+                (position_clip.x / position_clip.z) *  viewport_half_width  + viewport_half_width,
+                (position_clip.y / position_clip.z) * -viewport_half_height + viewport_half_height
+            );
+        }
+
+        struct pick_candidate
+        {
+            weak_ptr<Entity> entity;
+            shared_ptr<Mesh> mesh;
+            Matrix transform;
+            uint32_t index_count   = 0;
+            uint32_t index_stride  = 0;
+            uint32_t vertex_count  = 0;
+            uint32_t vertex_stride = 0;
+        };
+
+        uint64_t align_range(const uint64_t size)
+        {
+            return (size + Readback::GetGeometryRangeAlignment() - 1) & ~(Readback::GetGeometryRangeAlignment() - 1);
+        }
+
+        Rectangle world_to_screen(const BoundingBox& bounding_box, const Matrix& view_projection, const RHI_Viewport& viewport)
+        {
+            const Vector3& min = bounding_box.GetMin();
+            const Vector3& max = bounding_box.GetMax();
+
+            Vector3 corners[8];
+            corners[0] = min;
+            corners[1] = Vector3(max.x, min.y, min.z);
+            corners[2] = Vector3(min.x, max.y, min.z);
+            corners[3] = Vector3(max.x, max.y, min.z);
+            corners[4] = Vector3(min.x, min.y, max.z);
+            corners[5] = Vector3(max.x, min.y, max.z);
+            corners[6] = Vector3(min.x, max.y, max.z);
+            corners[7] = max;
+
+            Math::Rectangle rectangle_screen_Space;
+            for (Vector3& corner : corners)
+            {
+                rectangle_screen_Space.Merge(world_to_screen(corner, view_projection, viewport));
+            }
+
+            return rectangle_screen_Space;
+        }
+    }
+
     Camera::Camera(weak_ptr<Entity> entity) : Component(entity)
     {
         m_entity_ptr->SetPosition(Vector3(0.0f, 3.0f, -5.0f));
@@ -146,15 +204,36 @@ namespace Spartan
         const Vector3 center  = bounding_box.GetCenter();
         const Vector3 extents = bounding_box.GetExtents();
 
-        return m_frustum.IsVisible(center, extents);
+        return m_proxy.frustum.IsVisible(center, extents);
     }
 
     bool Camera::IsInViewFrustum(shared_ptr<Renderable> renderable) const
     {
-        const BoundingBox& box = renderable->GetBoundingBox(BoundingBoxType::Transformed);
+        const BoundingBox& box = renderable->GetProxy().bounding_box_transformed;
         return IsInViewFrustum(box);
     }
 
+    Rectangle camera_proxy::WorldToScreenCoordinates(const BoundingBox& bounding_box) const
+    {
+        return world_to_screen(bounding_box, view_projection_non_reverse_z, viewport);
+    }
+
+    void Camera::UpdateProxy()
+    {
+        m_proxy.frustum                       = m_frustum;
+        m_proxy.view_projection_non_reverse_z = m_view_projection_non_reverse_z;
+        m_proxy.viewport                      = Renderer::GetViewport();
+        m_proxy.position                      = GetEntity()->GetPosition();
+        m_proxy.forward                       = GetEntity()->GetForward();
+        m_proxy.near_plane                    = m_near_plane;
+        m_proxy.far_plane                     = m_far_plane;
+        m_proxy.fov_vertical_rad              = GetFovVerticalRad();
+        m_proxy.aperture                      = m_aperture;
+        m_proxy.shutter_speed                 = m_shutter_speed;
+        m_proxy.iso                           = m_iso;
+        m_proxy.selected_entity               = m_selected_entity.lock();
+    }
+
     const Math::Ray Camera::ComputePickingRay()
     {
         Vector3 ray_start     = GetEntity()->GetPosition();
@@ -164,6 +243,10 @@ namespace Spartan
     
     void Camera::Pick()
     {
+        // results of an older pick that is still in flight are discarded
+        m_pick_id++;
+        m_is_picking = false;
+
         // ensure the mouse is inside the viewport
         if (!Input::GetMouseIsInViewport())
         {
@@ -220,77 +303,131 @@ namespace Spartan
             return;
         }
 
-        // if there are more hits, perform triangle intersection
+        // if there are more hits, perform triangle intersection, meshes with resident cpu data are tested
+        // right away, the geometry of the rest is read back from the gpu in a single batch
         float distance_min = numeric_limits<float>::max();
+        shared_ptr<Entity> entity_min;
+        vector<pick_candidate> candidates;
+        vector<readback_geometry_range> ranges;
         for (RayHit& hit : hits)
         {
-            // Get entity geometry
+            // the aabb distance is a lower bound for the triangle distance, and the hits are sorted
+            if (hit.m_distance > distance_min)
+                break;
+
             shared_ptr<Renderable> renderable = hit.m_entity->GetComponent<Renderable>();
-            vector<uint32_t> indicies;
-            vector<RHI_Vertex_PosTexNorTan> vertices;
-            renderable->GetGeometry(&indicies, &vertices);
-            if (indicies.empty()|| vertices.empty())
-            {
-                SP_LOG_ERROR("Failed to get geometry of entity %s, skipping intersection test.");
+            if (!renderable->HasMesh())
                 continue;
+
+            Mesh* mesh = renderable->GetMesh();
+            if (mesh->IsCpuDataResident())
+            {
+                // other users (e.g. occluder builds) can release the data on another thread, so hold it while it's read
+                mesh->AddCpuDataUser();
+
+                geometry_view geometry  = renderable->GetGeometryView();
+                Matrix vertex_transform = hit.m_entity->GetMatrix();
+                for (uint32_t i = 0; i < geometry.GetTriangleCount() * 3; i += 3)
+                {
+                    Vector3 p1_world = geometry.GetPosition(i)     * vertex_transform;
+                    Vector3 p2_world = geometry.GetPosition(i + 1) * vertex_transform;
+                    Vector3 p3_world = geometry.GetPosition(i + 2) * vertex_transform;
+
+                    float distance = ray.HitDistance(p1_world, p2_world, p3_world);
+                    if (distance < distance_min)
+                    {
+                        entity_min   = hit.m_entity;
+                        distance_min = distance;
+                    }
+                }
+
+                mesh->RemoveCpuDataUser();
+            }
+            else if (shared_ptr<Mesh> mesh_owned = mesh->weak_from_this().lock(); mesh_owned && mesh->GetIndexBuffer() && mesh->GetVertexBuffer() && renderable->GetIndexCount() != 0)
+            {
+                pick_candidate& candidate = candidates.emplace_back();
+                candidate.entity          = hit.m_entity;
+                candidate.mesh            = mesh_owned; // keeps the geometry allocation alive until the copy lands
+                candidate.transform       = hit.m_entity->GetMatrix();
+                candidate.index_count     = renderable->GetIndexCount();
+                candidate.index_stride    = mesh->GetIndexBuffer()->GetStride();
+                candidate.vertex_count    = renderable->GetVertexCount();
+                candidate.vertex_stride   = mesh->GetVertexBuffer()->GetStride();
+
+                ranges.push_back({ mesh->GetIndexBuffer(),  renderable->GetIndexOffset(),  renderable->GetIndexCount() });
+                ranges.push_back({ mesh->GetVertexBuffer(), renderable->GetVertexOffset(), renderable->GetVertexCount() });
             }
+        }
 
-            // Compute matrix which can transform vertices to view space
-            Matrix vertex_transform = hit.m_entity->GetMatrix();
+        m_selected_entity = entity_min;
+        if (candidates.empty())
+            return;
 
-            // Go through each face
-            for (uint32_t i = 0; i < indicies.size(); i += 3)
+        auto on_readback = [camera_entity = weak_ptr<Entity>(GetEntity()->shared_from_this()), pick_id = m_pick_id, ray, candidates, entity_min = weak_ptr<Entity>(entity_min), distance_min](const void* data, const uint64_t size)
+        {
+            shared_ptr<Entity> entity = camera_entity.lock();
+            shared_ptr<Camera> camera = entity ? entity->GetComponent<Camera>() : nullptr;
+            if (!camera || camera->m_pick_id != pick_id)
+                return;
+
+            shared_ptr<Entity> selected = entity_min.lock();
+            float selected_distance     = distance_min;
+            const std::byte* bytes      = static_cast<const std::byte*>(data);
+            uint64_t offset             = 0;
+            for (const pick_candidate& candidate : candidates)
             {
-                Vector3 p1_world = Vector3(vertices[indicies[i]].pos) * vertex_transform;
-                Vector3 p2_world = Vector3(vertices[indicies[i + 1]].pos) * vertex_transform;
-                Vector3 p3_world = Vector3(vertices[indicies[i + 2]].pos) * vertex_transform;
+                const std::byte* indices  = bytes + offset;
+                offset                   += align_range(static_cast<uint64_t>(candidate.index_count) * candidate.index_stride);
+                const std::byte* vertices = bytes + offset;
+                offset                   += align_range(static_cast<uint64_t>(candidate.vertex_count) * candidate.vertex_stride);
+                SP_ASSERT(offset <= size);
+
+                shared_ptr<Entity> candidate_entity = candidate.entity.lock();
+                if (!candidate_entity)
+                    continue;
+
+                // the indices are relative to the first vertex of the renderable
+                auto get_position = [&](const uint32_t i)
+                {
+                    const uint32_t index = candidate.index_stride == sizeof(uint16_t) ? reinterpret_cast<const uint16_t*>(indices)[i] : reinterpret_cast<const uint32_t*>(indices)[i];
+                    const float* pos     = reinterpret_cast<const RHI_Vertex_PosTexNorTan*>(vertices + static_cast<uint64_t>(index) * candidate.vertex_stride)->pos;
+                    return Vector3(pos[0], pos[1], pos[2]) * candidate.transform;
+                };
 
-                float distance = ray.HitDistance(p1_world, p2_world, p3_world);
-                if (distance < distance_min)
+                for (uint32_t i = 0; i + 2 < candidate.index_count; i += 3)
                 {
-                    m_selected_entity = hit.m_entity;
-                    distance_min      = distance;
+                    float distance = ray.HitDistance(get_position(i), get_position(i + 1), get_position(i + 2));
+                    if (distance < selected_distance)
+                    {
+                        selected          = candidate_entity;
+                        selected_distance = distance;
+                    }
                 }
             }
+
+            camera->m_selected_entity = selected;
+            camera->m_is_picking      = false;
+        };
+
+        if (Readback::RequestGeometry(ranges, on_readback))
+        {
+            m_is_picking = true;
+        }
+        else if (!entity_min)
+        {
+            // too much geometry to read back, settle for the nearest bounding box
+            m_selected_entity = candidates.front().entity;
         }
     }
 
     void Camera::WorldToScreenCoordinates(const Vector3& position_world, Vector2& position_screen) const
     {
-        const Vector3 position_clip = position_world * m_view_projection_non_reverse_z;
-
-        // convert clip space position to screen space position
-        const RHI_Viewport& viewport = Renderer::GetViewport();
-        float viewport_half_width    = viewport.width  * 0.5f;
-        float viewport_half_height   = viewport.height * 0.5f;
-        position_screen.x            = (position_clip.x / position_clip.z) *  viewport_half_width  + viewport_half_width;
-        position_screen.y            = (position_clip.y / position_clip.z) * -viewport_half_height + viewport_half_height;
+        position_screen = world_to_screen(position_world, m_view_projection_non_reverse_z, Renderer::GetViewport());
     }
 
     Rectangle Camera::WorldToScreenCoordinates(const BoundingBox& bounding_box) const
     {
-        const Vector3& min = bounding_box.GetMin();
-        const Vector3& max = bounding_box.GetMax();
-
-        Vector3 corners[8];
-        corners[0] = min;
-        corners[1] = Vector3(max.x, min.y, min.z);
-        corners[2] = Vector3(min.x, max.y, min.z);
-        corners[3] = Vector3(max.x, max.y, min.z);
-        corners[4] = Vector3(min.x, min.y, max.z);
-        corners[5] = Vector3(max.x, min.y, max.z);
-        corners[6] = Vector3(min.x, max.y, max.z);
-        corners[7] = max;
-
-        Math::Rectangle rectangle_screen_Space;
-        Vector2 position_screen_space;
-        for (Vector3& corner : corners)
-        {
-            WorldToScreenCoordinates(corner, position_screen_space);
-            rectangle_screen_Space.Merge(position_screen_space);
-        }
-
-        return rectangle_screen_Space;
+        return world_to_screen(bounding_box, m_view_projection_non_reverse_z, Renderer::GetViewport());
     }
 
     Vector3 Camera::ScreenToWorldCoordinates(const Vector2& position_screen, const float z) const
@@ -320,6 +457,9 @@ namespace Spartan
         m_view_projection_non_reverse_z = m_view * m_projection_non_reverse_z;
         m_frustum                       = Frustum(GetViewMatrix(), GetProjectionMatrix(), m_near_plane);
         m_is_dirty                      = false;
+
+        // every setter funnels through here, so the on-demand renderer sees projection, exposure and viewport changes
+        Renderer::SetSceneDirty();
     }
 
     void Camera::ProcessInput()
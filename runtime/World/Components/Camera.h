@@ -53,6 +53,26 @@ namespace Spartan
         Math::Vector3 rotation = Math::Vector3::Zero;
     };
 
+    // what the renderer reads, copied at the renderer's sync point
+    struct camera_proxy
+    {
+        Math::Frustum frustum;
+        Math::Matrix view_projection_non_reverse_z = Math::Matrix::Identity;
+        RHI_Viewport viewport;
+        Math::Vector3 position                     = Math::Vector3::Zero;
+        Math::Vector3 forward                      = Math::Vector3::Forward;
+        float near_plane                           = 0.0f;
+        float far_plane                            = 0.0f;
+        float fov_vertical_rad                     = 0.0f;
+        float aperture                             = 0.0f;
+        float shutter_speed                        = 0.0f;
+        float iso                                  = 0.0f;
+        std::shared_ptr<Entity> selected_entity;
+
+        // converts a world bounding box to a screen rectangle
+        Math::Rectangle WorldToScreenCoordinates(const Math::BoundingBox& bounding_box) const;
+    };
+
     class SP_CLASS Camera : public Component
     {
     public:
@@ -73,8 +93,10 @@ namespace Spartan
         // ray casting
         const Math::Ray ComputePickingRay();
 
-        // picks the nearest entity under the mouse cursor
+        // picks the nearest entity under the mouse cursor, geometry that only lives on the gpu
+        // is read back asynchronously, the selection is final once IsPicking() returns false
         void Pick();
+        bool IsPicking() const { return m_is_picking; }
 
         // converts a world point to a screen point
         void WorldToScreenCoordinates(const Math::Vector3& position_world, Math::Vector2& position_screen) const;
@@ -88,15 +110,15 @@ namespace Spartan
 
         // aperture
         float GetAperture() const              { return m_aperture; }
-        void SetAperture(const float aperture) { m_aperture = aperture; }
+        void SetAperture(const float aperture) { m_aperture = aperture; m_is_dirty = true; }
 
         // shutter speed
         float GetShutterSpeed() const                   { return m_shutter_speed; }
-        void SetShutterSpeed(const float shutter_speed) { m_shutter_speed = shutter_speed; }
+        void SetShutterSpeed(const float shutter_speed) { m_shutter_speed = shutter_speed; m_is_dirty = true; }
 
         // iso
         float GetIso() const         { return m_iso; }
-        void SetIso(const float iso) { m_iso = iso; }
+        void SetIso(const float iso) { m_iso = iso; m_is_dirty = true; }
 
         // exposure
         float GetEv100()    const { return std::log2(m_aperture / m_shutter_speed * 100.0f / m_iso); }
@@ -135,6 +157,10 @@ namespace Spartan
         Math::Matrix ComputeProjection(const float near_plane, const float far_plane);
         void FocusOnSelectedEntity();
 
+        // proxy
+        void UpdateProxy();
+        const camera_proxy& GetProxy() const { return m_proxy; }
+
     private:
         void ComputeMatrices();
         void ProcessInput();
@@ -175,6 +201,9 @@ namespace Spartan
         PhysicsBody* m_physics_body_to_control       = nullptr;
         RHI_Viewport m_last_known_viewport;
         Math::Frustum m_frustum;
+        camera_proxy m_proxy;
         std::weak_ptr<Spartan::Entity> m_selected_entity;
+        uint64_t m_pick_id                           = 0;
+        bool m_is_picking                            = false;
     };
 }
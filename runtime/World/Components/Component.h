@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <string>
 #include <any>
 #include <vector>
+#include <unordered_map>
 #include <functional>
 #include "../../Core/SpartanObject.h"
 //===================================
@@ -83,6 +84,9 @@ namespace Spartan
         // runs when the entity is being loaded
         virtual void Deserialize(FileStream* stream) {}
 
+        // runs when a prefab is instantiated with new entity ids, references to other entities are translated from old to new ids
+        virtual void RemapEntityIds(const std::unordered_map<uint64_t, uint64_t>& ids) {}
+
         //= TYPE ===================================
         template <typename T>
         static constexpr ComponentType TypeToEnum();
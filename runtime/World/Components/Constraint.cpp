@@ -51,6 +51,7 @@ namespace Spartan
         m_errorReduction          = 0.0f;
         m_constraintForceMixing   = 0.0f;
         m_constraintType          = ConstraintType_Point;
+        m_bodyOtherId             = 0;
 
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_errorReduction, float);
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_constraintForceMixing, float);
@@ -103,7 +104,7 @@ namespace Spartan
         stream->Write(m_rotation);
         stream->Write(m_highLimit);
         stream->Write(m_lowLimit);
-        stream->Write(!m_bodyOther.expired() ? m_bodyOther.lock()->GetObjectId() : static_cast<uint32_t>(0));
+        stream->Write(!m_bodyOther.expired() ? m_bodyOther.lock()->GetObjectId() : static_cast<uint64_t>(0));
     }
 
     void Constraint::Deserialize(FileStream* stream)
@@ -116,8 +117,21 @@ namespace Spartan
         stream->Read(&m_highLimit);
         stream->Read(&m_lowLimit);
 
-        const auto body_other_id = stream->ReadAs<uint32_t>();
-        m_bodyOther = World::GetEntityById(body_other_id);
+        // the id is kept, the entity might not exist yet or it might be remapped by a prefab
+        m_bodyOtherId = stream->ReadAs<uint64_t>();
+        m_bodyOther   = World::GetEntityById(m_bodyOtherId);
+
+        Construct();
+    }
+
+    void Constraint::RemapEntityIds(const unordered_map<uint64_t, uint64_t>& ids)
+    {
+        auto it = ids.find(m_bodyOtherId);
+        if (it == ids.end())
+            return;
+
+        m_bodyOtherId = it->second;
+        m_bodyOther   = World::GetEntityById(m_bodyOtherId);
 
         Construct();
     }
@@ -178,7 +192,8 @@ namespace Spartan
             return;
         }
 
-        m_bodyOther = body_other;
+        m_bodyOther   = body_other;
+        m_bodyOtherId = body_other.lock()->GetObjectId();
         Construct();
     }
 
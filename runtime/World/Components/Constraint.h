@@ -58,6 +58,7 @@ namespace Spartan
         void OnTick() override;
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
+        void RemapEntityIds(const std::unordered_map<uint64_t, uint64_t>& ids) override;
         //============================================
 
         ConstraintType GetConstraintType() const { return m_constraintType; }
@@ -106,6 +107,7 @@ namespace Spartan
         Math::Vector2 m_lowLimit;
 
         std::weak_ptr<Entity> m_bodyOther;
+        uint64_t m_bodyOtherId;
         Math::Vector3 m_positionOther;
         Math::Quaternion m_rotationOther;
     
@@ -453,7 +453,7 @@ namespace Spartan
             const Vector3 extents   = bounding_box.GetExtents();
             const bool ignore_depth = m_light_type == LightType::Directional; // orthographic
             
-            return m_frustums[index].IsVisible(center, extents, ignore_depth);
+            return m_proxy.frustums[index].IsVisible(center, extents, ignore_depth);
         }
 
         // paraboloid point light
@@ -462,8 +462,8 @@ namespace Spartan
             array<Vector3, 8> corners = bounding_box.GetCorners();
             for (const Vector3& corner : corners)
             {
-                Vector3 to_corner = corner - m_entity_ptr->GetPosition();
-                if (Vector3::Dot(to_corner, sign * m_entity_ptr->GetForward()) >= 0.0f)
+                Vector3 to_corner = corner - m_proxy.position;
+                if (Vector3::Dot(to_corner, sign * m_proxy.forward) >= 0.0f)
                     return true; // at least one corner is inside
             }
 
@@ -473,7 +473,7 @@ namespace Spartan
 
     bool Light::IsInViewFrustum(Renderable* renderable, uint32_t index) const
     {
-        const BoundingBox& box = renderable->GetBoundingBox(BoundingBoxType::Transformed);
+        const BoundingBox& box = renderable->GetProxy().bounding_box_transformed;
 
         if (box == BoundingBox::Undefined)
         {
@@ -484,6 +484,17 @@ namespace Spartan
         return IsInViewFrustum(box, index);
     }
 
+    void Light::UpdateProxy()
+    {
+        m_proxy.frustums       = m_frustums;
+        m_proxy.view           = m_matrix_view;
+        m_proxy.projection     = m_matrix_projection;
+        m_proxy.position       = GetEntity()->GetPosition();
+        m_proxy.forward        = GetEntity()->GetForward();
+        m_proxy.intensity_watt = GetIntensityWatt();
+        m_proxy.is_moving      = GetEntity()->IsMoving();
+    }
+
     void Light::RefreshShadowMap()
     {
         uint32_t resolution     = Renderer::GetOption<uint32_t>(Renderer_Option::ShadowResolution);
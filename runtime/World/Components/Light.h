@@ -69,6 +69,18 @@ namespace Spartan
         Volumetric         = 1U << 3
     };
 
+    // what the renderer reads, copied at the renderer's sync point
+    struct light_proxy
+    {
+        std::array<Math::Frustum, 2> frustums;
+        std::array<Math::Matrix, 2> view;
+        std::array<Math::Matrix, 2> projection;
+        Math::Vector3 position = Math::Vector3::Zero;
+        Math::Vector3 forward  = Math::Vector3::Forward;
+        float intensity_watt   = 0.0f;
+        bool is_moving         = false;
+    };
+
     class SP_CLASS Light : public Component
     {
     public:
@@ -119,6 +131,7 @@ namespace Spartan
         const Math::Matrix& GetProjectionMatrix(uint32_t index) const { return m_matrix_projection[index]; }
 
         // textures
+        uint32_t GetSliceCount() const       { return m_light_type == LightType::Spot ? 1 : 2; } // cascades or paraboloid faces
         RHI_Texture* GetDepthTexture() const { return m_texture_depth.get(); }
         RHI_Texture* GetColorTexture() const { return m_texture_color.get(); }
         void RefreshShadowMap();
@@ -131,6 +144,10 @@ namespace Spartan
         void SetIndex(const uint32_t index) { m_index = index; }
         uint32_t GetIndex() const           { return m_index; }
 
+        // proxy
+        void UpdateProxy();
+        const light_proxy& GetProxy() const { return m_proxy; }
+
     private:
         void UpdateMatrices();
         void ComputeViewMatrix();
@@ -155,5 +172,6 @@ namespace Spartan
         float m_range              = 0.0f;
         float m_angle_rad          = Math::Helper::DEG_TO_RAD * 30.0f;
         uint32_t m_index           = 0;
+        light_proxy m_proxy;
     };
 }
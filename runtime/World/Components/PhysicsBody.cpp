@@ -799,23 +799,31 @@ namespace Spartan
         }
 
         // get common prerequisites for certain shapes
-        vector<uint32_t> indices;
-        vector<RHI_Vertex_PosTexNorTan> vertices;
-        shared_ptr<Renderable> renderable = nullptr;
+        geometry_view geometry;
+        Mesh* mesh = nullptr;
         if (m_shape_type == PhysicsShape::Mesh || m_shape_type == PhysicsShape::MeshConvexHull)
         {
             // get renderable
-            renderable = GetEntity()->GetComponent<Renderable>();
+            shared_ptr<Renderable> renderable = GetEntity()->GetComponent<Renderable>();
             if (!renderable || !renderable->HasMesh())
             {
                 SP_LOG_WARNING("For a mesh shape to be constructed, there needs to be a Renderable component with a mesh");
                 return;
             }
 
+            mesh = renderable->GetMesh();
+        }
+
+        // bullet copies the triangles and points, so the mesh cpu data is only kept resident while the shape is built
+        if (mesh)
+        {
+            mesh->AddCpuDataUser();
+
             // get geometry
-            renderable->GetGeometry(&indices, &vertices);
-            if (vertices.empty())
+            geometry = GetEntity()->GetComponent<Renderable>()->GetGeometryView();
+            if (geometry.IsEmpty())
             {
+                mesh->RemoveCpuDataUser();
                 SP_LOG_WARNING("A shape can't be constructed without vertices");
                 return;
             }
@@ -864,8 +872,8 @@ namespace Spartan
                 }
 
                 btHeightfieldTerrainShape* shape_local = new btHeightfieldTerrainShape(
-                    terrain->GetHeightMap()->GetWidth(),  // width
-                    terrain->GetHeightMap()->GetHeight(), // length
+                    terrain->GetWidth(),                  // width
+                    terrain->GetDepth(),                  // length
                     terrain->GetHeightData(),             // data - row major
                     1.0f,                                 // height scale
                     terrain->GetMinY(),                   // min height
@@ -891,12 +899,13 @@ namespace Spartan
             case PhysicsShape::Mesh:
             {
                 btTriangleMesh* shape_local = new btTriangleMesh();
-                for (uint32_t i = 0; i < static_cast<uint32_t>(indices.size()); i += 3)
+                for (uint32_t i = 0; i < geometry.GetTriangleCount() * 3; i += 3)
                 {
-                    btVector3 vertex0(vertices[indices[i]].pos[0],     vertices[indices[i]].pos[1],     vertices[indices[i]].pos[2]);
-                    btVector3 vertex1(vertices[indices[i + 1]].pos[0], vertices[indices[i + 1]].pos[1], vertices[indices[i + 1]].pos[2]);
-                    btVector3 vertex2(vertices[indices[i + 2]].pos[0], vertices[indices[i + 2]].pos[1], vertices[indices[i + 2]].pos[2]);
-                    shape_local->addTriangle(vertex0, vertex1, vertex2);
+                    shape_local->addTriangle(
+                        ToBtVector3(geometry.GetPosition(i)),
+                        ToBtVector3(geometry.GetPosition(i + 1)),
+                        ToBtVector3(geometry.GetPosition(i + 2))
+                    );
                 }
                 shape_local->setScaling(ToBtVector3(size));
 
@@ -907,9 +916,9 @@ namespace Spartan
             case PhysicsShape::MeshConvexHull:
             {
                 btConvexHullShape* shape_approximated = new btConvexHullShape(
-                    (btScalar*)&vertices[0],                                 // points
-                    renderable->GetVertexCount(),                            // point count
-                    static_cast<uint32_t>(sizeof(RHI_Vertex_PosTexNorTan))); // stride
+                    geometry.GetPositions(),                            // points
+                    static_cast<uint32_t>(geometry.vertices.size()),    // point count
+                    geometry_view::GetPositionStride());                // stride
 
                 shape_approximated->setLocalScaling(ToBtVector3(size));
 
@@ -920,6 +929,11 @@ namespace Spartan
             }
         }
 
+        if (mesh)
+        {
+            mesh->RemoveCpuDataUser();
+        }
+
         static_cast<btCollisionShape*>(m_shape)->setUserPointer(this);
 
         // re-add the body to the world so it's re-created with the new shape
@@ -25,9 +25,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Entity.h"
 #include "../Rendering/Renderer.h"
 #include "../RHI/RHI_GeometryBuffer.h"
+#include "../RHI/RHI_CommandList.h"
+#include "../RHI/RHI_Buffer.h"
 #include "../../IO/FileStream.h"
 #include "../../Resource/ResourceCache.h"
 #include "../../Rendering/GridPartitioning.h"
+#include "../../Core/ThreadPool.h"
 //===========================================
 
 //= NAMESPACES ===============
@@ -146,6 +149,12 @@ namespace Spartan
         SP_ASSERT(m_geometry_index_count       != 0);
         SP_ASSERT(m_geometry_vertex_count      != 0);
         SP_ASSERT(m_bounding_box != BoundingBox::Undefined);
+
+        m_bounding_box_dirty = true;
+        m_proxy_dirty        = true;
+
+        // the occluder is rebuilt from the new geometry when it's next needed, a build in flight finishes into the old one
+        m_occluder = nullptr;
     }
 
     void Renderable::SetGeometry(const MeshType type)
@@ -153,61 +162,137 @@ namespace Spartan
         SetGeometry(Renderer::GetStandardMesh(type).get());
     }
 
-    void Renderable::GetGeometry(vector<uint32_t>* indices, vector<RHI_Vertex_PosTexNorTan>* vertices) const
+    geometry_view Renderable::GetGeometryView() const
     {
         SP_ASSERT_MSG(m_mesh != nullptr, "invalid mesh");
-        m_mesh->GetGeometry(m_geometry_index_offset, m_geometry_index_count, m_geometry_vertex_offset, m_geometry_vertex_count, indices, vertices);
+        return m_mesh->GetGeometryView(m_geometry_index_offset, m_geometry_index_count, m_geometry_vertex_offset, m_geometry_vertex_count);
     }
 
-    const BoundingBox& Renderable::GetBoundingBox(const BoundingBoxType type, const uint32_t index)
+    void Renderable::RequestOccluderGeometry()
     {
-        // compute if dirty
-        if (m_bounding_box_dirty || m_transform_previous != GetEntity()->GetMatrix())
+        if (m_occluder || !m_mesh)
+            return;
+
+        // a simplified mesh can extend past the silhouette and cull what's visible behind it, so occluders
+        // use the geometry as is, and meshes too dense to rasterize every frame are not used as occluders
+        const uint32_t index_count_max = 3 * 4096;
+
+        m_occluder = make_shared<occluder_geometry>();
+        if (m_geometry_index_count > index_count_max)
         {
-            Matrix transform = GetEntity()->GetMatrix();
+            m_occluder->ready = true;
+            return;
+        }
 
+        // the mesh may have released its cpu data, bringing it back can mean a disk read or a gpu readback
+        ThreadPool::AddTask([occluder = m_occluder, mesh = m_mesh,
+            index_offset = m_geometry_index_offset, index_count = m_geometry_index_count,
+            vertex_offset = m_geometry_vertex_offset, vertex_count = m_geometry_vertex_count]()
+        {
+            mesh->AddCpuDataUser();
+            {
+                geometry_view view = mesh->GetGeometryView(index_offset, index_count, vertex_offset, vertex_count);
+                if (!view.IsEmpty())
+                {
+                    // keep only the positions the triangles reference
+                    vector<uint32_t> remap(view.vertices.size(), numeric_limits<uint32_t>::max());
+                    occluder->indices.reserve(view.indices.size());
+                    for (const uint32_t index_view : view.indices)
+                    {
+                        uint32_t& index = remap[index_view];
+                        if (index == numeric_limits<uint32_t>::max())
+                        {
+                            const float* pos = view.vertices[index_view].pos;
+                            index            = static_cast<uint32_t>(occluder->positions.size());
+                            occluder->positions.emplace_back(pos[0], pos[1], pos[2]);
+                        }
+
+                        occluder->indices.emplace_back(index);
+                    }
+                }
+            }
+            mesh->RemoveCpuDataUser();
+
+            // geometry that can't be read leaves the occluder empty, so it's not requested again
+            occluder->ready = true;
+        });
+    }
+
+    const BoundingBox& Renderable::GetBoundingBox(const BoundingBoxType type, const uint32_t index)
+    {
+        Matrix transform = GetEntity()->GetMatrix();
+
+        // compute everything if the geometry or the entity changed
+        if (m_bounding_box_dirty || m_transform_previous != transform)
+        {
             // bounding box that contains all instances
-            if (m_instances.empty())
+            if (!m_instancing)
             {
                 m_bounding_box_transformed = m_bounding_box.Transform(transform);
             }
             else // transformed instances
             {
                 m_bounding_box_transformed = BoundingBox::Undefined;
-                m_bounding_box_instances.clear();
-                m_bounding_box_instances.reserve(m_instances.size());
                 m_bounding_box_instances.resize(m_instances.size());
-                for (uint32_t i = 0; i < static_cast<uint32_t>(m_instances.size()); i++)
+                m_bounding_box_instance_group.resize(m_instance_groups.size());
+                for (uint32_t group_index = 0; group_index < static_cast<uint32_t>(m_instance_groups.size()); group_index++)
                 {
-                    const Matrix& instance_transform = m_instances[i];
-                    m_bounding_box_instances[i]      = m_bounding_box.Transform(transform * instance_transform ); // 1. bounding box of the instance
-                    m_bounding_box_transformed.Merge(m_bounding_box_instances[i]);                                // 2. bounding box of all instances
-                }
-
-                // 3. bounding boxes of instance groups
-                {
-                    // loop through each group end index
-                    m_bounding_box_instance_group.clear();
-                    uint32_t start_index = 0;
-                    for (const uint32_t group_end_index : m_instance_group_end_indices)
+                    instance_group& group          = m_instance_groups[group_index];
+                    BoundingBox bounding_box_group = BoundingBox::Undefined;
+                    for (uint32_t slot = group.start; slot < group.start + group.count; slot++)
                     {
-                        // loop through the instances in this group
-                        BoundingBox bounding_box_group = BoundingBox::Undefined;
-                        for (uint32_t i = start_index; i < group_end_index; i++)
-                        {
-                            BoundingBox bounding_box_instance = m_bounding_box.Transform(transform * m_instances[i]);
-                            bounding_box_group.Merge(bounding_box_instance);
-                        }
-
-                        m_bounding_box_instance_group.push_back(bounding_box_group);
-                        start_index = group_end_index;
+                        m_bounding_box_instances[slot] = m_bounding_box.Transform(transform * m_instances[slot]); // 1. bounding box of the instance
+                        bounding_box_group.Merge(m_bounding_box_instances[slot]);                                 // 2. bounding box of the group
                     }
+
+                    m_bounding_box_instance_group[group_index] = bounding_box_group;
+                    m_bounding_box_transformed.Merge(bounding_box_group);                                         // 3. bounding box of all instances
+                    group.dirty = false;
                 }
             }
 
+            m_instance_groups_dirty.clear();
+            m_instance_slots_dirty_bounds.clear();
             m_transform_previous = transform;
             m_bounding_box_dirty = false;
         }
+        // otherwise only the instances that changed, and the groups they are in
+        else if (!m_instance_groups_dirty.empty())
+        {
+            m_bounding_box_instances.resize(m_instances.size());
+            m_bounding_box_instance_group.resize(m_instance_groups.size(), BoundingBox::Undefined);
+
+            for (const uint32_t slot : m_instance_slots_dirty_bounds)
+            {
+                if (m_instance_slot_handle[slot] != instance_invalid)
+                {
+                    m_bounding_box_instances[slot] = m_bounding_box.Transform(transform * m_instances[slot]);
+                }
+            }
+
+            for (const uint32_t group_index : m_instance_groups_dirty)
+            {
+                instance_group& group          = m_instance_groups[group_index];
+                BoundingBox bounding_box_group = BoundingBox::Undefined;
+                for (uint32_t slot = group.start; slot < group.start + group.count; slot++)
+                {
+                    bounding_box_group.Merge(m_bounding_box_instances[slot]);
+                }
+
+                m_bounding_box_instance_group[group_index] = bounding_box_group;
+                group.dirty                                = false;
+            }
+
+            // a removal can shrink the total, so merge the groups again, they are far fewer than the instances
+            m_bounding_box_transformed = BoundingBox::Undefined;
+            for (const BoundingBox& bounding_box_group : m_bounding_box_instance_group)
+            {
+                m_bounding_box_transformed.Merge(bounding_box_group);
+            }
+
+            m_instance_groups_dirty.clear();
+            m_instance_slots_dirty_bounds.clear();
+        }
 
         // return
         if (type == BoundingBoxType::Mesh)
@@ -229,6 +314,74 @@ namespace Spartan
 
         return BoundingBox::Undefined;
     }
+
+    void Renderable::UpdateProxy()
+    {
+        // always roll the previous transform forward, so that velocity settles once the entity stops
+        m_proxy.transform_previous = m_proxy.transform;
+        m_proxy.is_moving          = GetEntity()->IsMoving();
+
+        // only copy the rest when something changed
+        const bool transform_changed = m_proxy.transform != GetEntity()->GetMatrix();
+        if (!m_proxy_dirty && !transform_changed)
+            return;
+
+        m_proxy.transform                = GetEntity()->GetMatrix();
+        m_proxy.bounding_box_transformed = GetBoundingBox(BoundingBoxType::Transformed);
+        m_proxy.bounding_box_mesh        = m_bounding_box;
+
+        if (m_proxy_instances_all)
+        {
+            m_proxy.bounding_box_instance_group = m_bounding_box_instance_group;
+            m_proxy.instance_groups             = m_instance_groups;
+            m_proxy.instances                   = m_instances;
+            m_proxy.instance_slot_used.resize(m_instance_slot_handle.size());
+            for (size_t slot = 0; slot < m_instance_slot_handle.size(); slot++)
+            {
+                m_proxy.instance_slot_used[slot] = m_instance_slot_handle[slot] != instance_invalid;
+            }
+        }
+        else
+        {
+            // slots and groups are only ever appended outside of InstanceBuild(), new ones are copied along with the dirty ones
+            const uint32_t group_count_previous = static_cast<uint32_t>(m_proxy.instance_groups.size());
+            m_proxy.instance_groups.resize(m_instance_groups.size());
+            m_proxy.bounding_box_instance_group.resize(m_bounding_box_instance_group.size(), BoundingBox::Undefined);
+            m_proxy.instances.resize(m_instances.size());
+            m_proxy.instance_slot_used.resize(m_instance_slot_handle.size(), false);
+
+            for (const uint32_t slot : m_instance_slots_dirty_proxy)
+            {
+                m_proxy.instances[slot]          = m_instances[slot];
+                m_proxy.instance_slot_used[slot] = m_instance_slot_handle[slot] != instance_invalid;
+            }
+
+            for (uint32_t group_index = group_count_previous; group_index < static_cast<uint32_t>(m_instance_groups.size()); group_index++)
+            {
+                m_instance_groups_dirty_proxy.emplace_back(group_index);
+            }
+
+            for (const uint32_t group_index : m_instance_groups_dirty_proxy)
+            {
+                m_proxy.instance_groups[group_index] = m_instance_groups[group_index];
+                if (group_index < m_bounding_box_instance_group.size())
+                {
+                    m_proxy.bounding_box_instance_group[group_index] = m_bounding_box_instance_group[group_index];
+                }
+            }
+
+            // the group bounding boxes are in world space, so they all move with the entity
+            if (transform_changed)
+            {
+                m_proxy.bounding_box_instance_group = m_bounding_box_instance_group;
+            }
+        }
+
+        m_instance_slots_dirty_proxy.clear();
+        m_instance_groups_dirty_proxy.clear();
+        m_proxy_instances_all = false;
+        m_proxy_dirty         = false;
+    }
     
     shared_ptr<Material> Renderable::SetMaterial(const shared_ptr<Material>& material)
     {
@@ -297,23 +450,342 @@ namespace Spartan
 
     void Renderable::SetInstances(const vector<Matrix>& instances)
     {
-        m_instances = instances;
+        vector<uint32_t> handles(instances.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(handles.size()); i++)
+        {
+            handles[i] = i;
+        }
+
+        m_instance_handle_slot.assign(instances.size(), instance_invalid);
+        m_instance_handles_free.clear();
+        m_instancing = !instances.empty();
+
+        InstanceBuild(instances, handles);
+
+        if (!m_instancing)
+        {
+            m_instance_buffer = nullptr;
+        }
+    }
+
+    uint32_t Renderable::AddInstance(const Matrix& transform)
+    {
+        uint32_t handle = 0;
+        if (!m_instance_handles_free.empty())
+        {
+            handle = m_instance_handles_free.back();
+            m_instance_handles_free.pop_back();
+        }
+        else
+        {
+            handle = static_cast<uint32_t>(m_instance_handle_slot.size());
+            m_instance_handle_slot.emplace_back(instance_invalid);
+        }
+
+        InstanceInsert(InstanceGroupGetOrCreate(grid_partitioning::get_cell(transform.GetTranslation())), transform, handle);
+        m_instance_count++;
+        m_instancing = true;
+
+        return handle;
+    }
+
+    void Renderable::RemoveInstance(const uint32_t handle)
+    {
+        SP_ASSERT_MSG(handle < m_instance_handle_slot.size() && m_instance_handle_slot[handle] != instance_invalid, "Invalid instance handle");
 
-        grid_partitioning::reorder_instances_into_cell_chunks(m_instances, m_instance_group_end_indices);
+        InstanceErase(m_instance_handle_slot[handle]);
+        m_instance_handle_slot[handle] = instance_invalid;
+        m_instance_handles_free.emplace_back(handle);
+        m_instance_count--;
+
+        // once relocations have left more holes than there are instances, lay everything out again
+        if (m_instance_slots_dead > max(m_instance_count, 1024U))
+        {
+            vector<Matrix> transforms;
+            vector<uint32_t> handles;
+            transforms.reserve(m_instance_count);
+            handles.reserve(m_instance_count);
+            for (uint32_t slot = 0; slot < static_cast<uint32_t>(m_instances.size()); slot++)
+            {
+                if (m_instance_slot_handle[slot] != instance_invalid)
+                {
+                    transforms.emplace_back(m_instances[slot]);
+                    handles.emplace_back(m_instance_slot_handle[slot]);
+                }
+            }
+
+            InstanceBuild(transforms, handles);
+        }
+    }
+
+    void Renderable::UpdateInstance(const uint32_t handle, const Matrix& transform)
+    {
+        SP_ASSERT_MSG(handle < m_instance_handle_slot.size() && m_instance_handle_slot[handle] != instance_invalid, "Invalid instance handle");
+
+        uint32_t slot        = m_instance_handle_slot[handle];
+        uint32_t group_index = m_instance_slot_group[slot];
+        uint64_t cell        = grid_partitioning::get_cell(transform.GetTranslation());
+
+        // same cell, update in place
+        if (m_instance_groups[group_index].cell == cell)
+        {
+            m_instances[slot] = transform;
+            InstanceSlotDirty(slot);
+            InstanceGroupDirty(group_index);
+
+            return;
+        }
+
+        // moved to another cell
+        InstanceErase(slot);
+        InstanceInsert(InstanceGroupGetOrCreate(cell), transform, handle);
+    }
+
+    uint32_t Renderable::InstanceGroupGetOrCreate(const uint64_t cell)
+    {
+        auto it = m_instance_cell_to_group.find(cell);
+        if (it != m_instance_cell_to_group.end())
+            return it->second;
+
+        // no slots yet, they are reserved on the first insertion
+        uint32_t group_index  = static_cast<uint32_t>(m_instance_groups.size());
+        instance_group& group = m_instance_groups.emplace_back();
+        group.cell            = cell;
+        group.start           = static_cast<uint32_t>(m_instances.size());
+
+        m_instance_cell_to_group[cell] = group_index;
+
+        return group_index;
+    }
+
+    void Renderable::InstanceGroupRelocate(const uint32_t group_index)
+    {
+        // move the group to the end of the slots with double the capacity, the old slots become holes
+        instance_group& group = m_instance_groups[group_index];
+        uint32_t start        = static_cast<uint32_t>(m_instances.size());
+        uint32_t capacity     = max(group.capacity * 2, 8U);
+        uint32_t slot_count   = start + capacity;
+
+        m_instances.resize(slot_count);
+        m_instance_slot_handle.resize(slot_count, instance_invalid);
+        m_instance_slot_group.resize(slot_count, group_index);
+
+        for (uint32_t i = 0; i < group.count; i++)
+        {
+            uint32_t slot_old = group.start + i;
+            uint32_t slot_new = start + i;
+
+            uint32_t handle = m_instance_slot_handle[slot_old];
+
+            m_instances[slot_new]            = m_instances[slot_old];
+            m_instance_slot_handle[slot_new] = handle;
+            m_instance_slot_handle[slot_old] = instance_invalid;
+            m_instance_handle_slot[handle]   = slot_new;
+            InstanceSlotDirty(slot_new);
+            m_instance_slots_dirty_proxy.emplace_back(slot_old); // now a hole
+        }
+
+        m_instance_slots_dead += group.capacity;
+        group.start            = start;
+        group.capacity         = capacity;
+    }
+
+    void Renderable::InstanceInsert(const uint32_t group_index, const Matrix& transform, const uint32_t handle)
+    {
+        if (m_instance_groups[group_index].count == m_instance_groups[group_index].capacity)
+        {
+            InstanceGroupRelocate(group_index);
+        }
+
+        instance_group& group = m_instance_groups[group_index];
+        uint32_t slot         = group.start + group.count;
+        group.count++;
+
+        m_instances[slot]              = transform;
+        m_instance_slot_handle[slot]   = handle;
+        m_instance_slot_group[slot]    = group_index;
+        m_instance_handle_slot[handle] = slot;
+
+        InstanceSlotDirty(slot);
+        InstanceGroupDirty(group_index);
+    }
+
+    void Renderable::InstanceErase(const uint32_t slot)
+    {
+        // swap the last instance of the group into the hole, so that live instances stay packed
+        uint32_t group_index  = m_instance_slot_group[slot];
+        instance_group& group = m_instance_groups[group_index];
+        uint32_t slot_last    = group.start + group.count - 1;
+
+        if (slot != slot_last)
+        {
+            uint32_t handle = m_instance_slot_handle[slot_last];
+
+            m_instances[slot]              = m_instances[slot_last];
+            m_instance_slot_handle[slot]   = handle;
+            m_instance_handle_slot[handle] = slot;
+            InstanceSlotDirty(slot);
+        }
+
+        m_instance_slot_handle[slot_last] = instance_invalid;
+        m_instance_slots_dirty_proxy.emplace_back(slot_last); // now a hole
+        group.count--;
+
+        InstanceGroupDirty(group_index);
+    }
+
+    void Renderable::InstanceBuild(const vector<Matrix>& transforms, const vector<uint32_t>& handles)
+    {
+        m_instance_groups.clear();
+        m_instance_cell_to_group.clear();
+
+        // count the instances per cell
+        vector<uint32_t> instance_group_indices(transforms.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(transforms.size()); i++)
+        {
+            uint32_t group_index      = InstanceGroupGetOrCreate(grid_partitioning::get_cell(transforms[i].GetTranslation()));
+            instance_group_indices[i] = group_index;
+            m_instance_groups[group_index].count++;
+        }
+
+        // lay the groups out back to back, with some slack so that additions don't relocate right away
+        uint32_t slot_count = 0;
+        for (instance_group& group : m_instance_groups)
+        {
+            group.start     = slot_count;
+            group.capacity  = group.count + max(group.count / 8, 8U);
+            group.count     = 0;
+            slot_count     += group.capacity;
+        }
+
+        m_instances.assign(slot_count, Matrix::Identity);
+        m_instance_slot_handle.assign(slot_count, instance_invalid);
+        m_instance_slot_group.assign(slot_count, 0);
+        for (uint32_t group_index = 0; group_index < static_cast<uint32_t>(m_instance_groups.size()); group_index++)
+        {
+            const instance_group& group = m_instance_groups[group_index];
+            fill(m_instance_slot_group.begin() + group.start, m_instance_slot_group.begin() + group.start + group.capacity, group_index);
+        }
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(transforms.size()); i++)
+        {
+            instance_group& group = m_instance_groups[instance_group_indices[i]];
+            uint32_t slot         = group.start + group.count++;
+
+            m_instances[slot]                  = transforms[i];
+            m_instance_slot_handle[slot]       = handles[i];
+            m_instance_handle_slot[handles[i]] = slot;
+        }
+
+        m_instance_count      = static_cast<uint32_t>(transforms.size());
+        m_instance_slots_dead = 0;
+        m_instance_upload_all = true;
+        m_instance_groups_dirty.clear();
+        m_instance_slots_dirty_bounds.clear();
+        m_instance_slots_dirty_upload.clear();
+        m_instance_slots_dirty_proxy.clear();
+        m_instance_groups_dirty_proxy.clear();
+
+        m_bounding_box_dirty  = true;
+        m_proxy_dirty         = true;
+        m_proxy_instances_all = true;
+    }
+
+    void Renderable::InstanceSlotDirty(const uint32_t slot)
+    {
+        m_instance_slots_dirty_bounds.emplace_back(slot);
+        m_instance_slots_dirty_upload.emplace_back(slot);
+        m_instance_slots_dirty_proxy.emplace_back(slot);
+    }
+
+    void Renderable::InstanceGroupDirty(const uint32_t group_index)
+    {
+        instance_group& group = m_instance_groups[group_index];
+        if (!group.dirty)
+        {
+            group.dirty = true;
+            m_instance_groups_dirty.emplace_back(group_index);
+            m_instance_groups_dirty_proxy.emplace_back(group_index);
+        }
+        m_proxy_dirty = true;
+    }
+
+    void Renderable::InstanceBufferUpdate(RHI_CommandList* cmd_list, RHI_Buffer* staging, uint64_t* staging_offset, const uint64_t staging_end)
+    {
+        uint32_t slot_count = static_cast<uint32_t>(m_instances.size());
+        if (slot_count == 0 || (!m_instance_upload_all && m_instance_slots_dirty_upload.empty()))
+            return;
 
         // we are mapping 4 Vector4s as 4 rows (see vulkan_pipeline.cpp, line 246) in order to get 1 matrix (HLSL side)
         // but the matrix memory layout is column-major, so we need to transpose to get it as row-major
-        vector<Matrix> instances_transposed;
-        instances_transposed.reserve(m_instances.size());
-        for (const auto& instance : m_instances)
+
+        // a buffer that no frame has been recorded with yet can be filled right away, this is a creation, a growth or a rebuild,
+        // grow with some headroom, so that a few additions don't recreate the buffer every frame, the old one goes
+        // through the deletion queue, so it outlives the frames that are still reading it
+        if (m_instance_upload_all || !m_instance_buffer || m_instance_buffer->GetElementCount() < slot_count)
+        {
+            vector<Matrix> instances_transposed(slot_count);
+            for (uint32_t slot = 0; slot < slot_count; slot++)
+            {
+                instances_transposed[slot] = m_instances[slot].Transposed();
+            }
+
+            m_instance_buffer = make_shared<RHI_GeometryBuffer>(RHI_Buffer_Type::Instance, false, "instance_buffer");
+            m_instance_buffer->CreateEmpty<Matrix>(slot_count + slot_count / 2);
+            m_instance_buffer->Update(instances_transposed.data(), 0, slot_count);
+
+            m_instance_slots_dirty_upload.clear();
+            m_instance_upload_all = false;
+
+            return;
+        }
+
+        // merge the dirty slots into ranges, small gaps are cheaper to upload than to split
+        sort(m_instance_slots_dirty_upload.begin(), m_instance_slots_dirty_upload.end());
+        vector<pair<uint32_t, uint32_t>> ranges;
+        for (const uint32_t slot : m_instance_slots_dirty_upload)
+        {
+            if (!ranges.empty() && slot <= ranges.back().first + ranges.back().second + 16)
+            {
+                ranges.back().second = max(ranges.back().second, slot - ranges.back().first + 1);
+            }
+            else
+            {
+                ranges.emplace_back(slot, 1);
+            }
+        }
+
+        // stage as many ranges as fit, the copy is recorded into this frame, so it lands after the frames that are still executing
+        const uint64_t offset_start = *staging_offset;
+        uint32_t range_count        = 0;
+        for (const auto& [offset, count] : ranges)
         {
-            instances_transposed.push_back(instance.Transposed());
+            const uint64_t size = static_cast<uint64_t>(count) * sizeof(Matrix);
+            if (*staging_offset + size > staging_end)
+                break;
+
+            Matrix* staged = reinterpret_cast<Matrix*>(static_cast<std::byte*>(staging->GetMappedData()) + *staging_offset);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                staged[i] = m_instances[offset + i].Transposed();
+            }
+
+            *staging_offset += size;
+            range_count++;
         }
 
-        m_instance_buffer = make_shared<RHI_GeometryBuffer>(RHI_Buffer_Type::Instance, false, "instance_buffer");
-        m_instance_buffer->Create<Matrix>(instances_transposed);
+        if (range_count == 0)
+            return;
 
-        m_bounding_box_dirty = true;
+        ranges.resize(range_count);
+        cmd_list->Copy(staging, offset_start, m_instance_buffer.get(), ranges);
+
+        // the slots that didn't fit stay dirty
+        const uint32_t slot_end = ranges.back().first + ranges.back().second;
+        m_instance_slots_dirty_upload.erase(
+            m_instance_slots_dirty_upload.begin(),
+            lower_bound(m_instance_slots_dirty_upload.begin(), m_instance_slots_dirty_upload.end(), slot_end)
+        );
     }
 
     void Renderable::SetFlag(const RenderableFlags flag, const bool enable /*= true*/)
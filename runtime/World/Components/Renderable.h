@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ======================
 #include "Component.h"
 #include <vector>
+#include <unordered_map>
 #include "../../Math/Matrix.h"
 #include "../../Math/BoundingBox.h"
 #include "../Rendering/Mesh.h"
@@ -32,6 +33,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace Spartan
 {
     class Material;
+    class RHI_Buffer;
+    class RHI_CommandList;
 
     enum class BoundingBoxType
     {
@@ -44,11 +47,46 @@ namespace Spartan
     enum RenderableFlags : uint32_t
     {
         OccludedCpu  = 1U << 0, // frustum culling
-        OccludedGpu  = 1U << 1, // occlusion culling (depth culling)
+        Occluded     = 1U << 1, // occlusion culling (software depth buffer)
         Occluder     = 1U << 2,
         CastsShadows = 1U << 3
     };
 
+    // a copy of the geometry that the cpu rasterizes for occlusion culling, built on a worker
+    // thread since the mesh data may have to be read back, ready is set once it can be read
+    struct occluder_geometry
+    {
+        std::vector<Math::Vector3> positions;
+        std::vector<uint32_t> indices;
+        std::atomic<bool> ready = false;
+    };
+
+    // a contiguous run of instance buffer slots, one per grid cell
+    // live instances are packed at the start, the rest is spare capacity for additions
+    struct instance_group
+    {
+        uint64_t cell     = 0;
+        uint32_t start    = 0;
+        uint32_t count    = 0;
+        uint32_t capacity = 0;
+        bool dirty        = false; // bounding box needs to be recomputed
+    };
+
+    // what the renderer reads, copied from the entity at the renderer's sync point
+    // so that recording a frame never touches transforms the simulation is writing
+    struct renderable_proxy
+    {
+        Math::Matrix transform                     = Math::Matrix::Identity;
+        Math::Matrix transform_previous            = Math::Matrix::Identity;
+        Math::BoundingBox bounding_box_mesh        = Math::BoundingBox::Undefined;
+        Math::BoundingBox bounding_box_transformed = Math::BoundingBox::Undefined;
+        std::vector<Math::BoundingBox> bounding_box_instance_group;
+        std::vector<instance_group> instance_groups;
+        std::vector<Math::Matrix> instances;       // per instance slot, the layout of the instance buffer
+        std::vector<bool> instance_slot_used;
+        bool is_moving                             = false;
+    };
+
     class SP_CLASS Renderable : public Component
     {
     public:
@@ -67,11 +105,9 @@ namespace Spartan
             uint32_t vertex_offset = 0, uint32_t vertex_count = 0
         );
         void SetGeometry(const MeshType type);
-        void GetGeometry(std::vector<uint32_t>* indices, std::vector<RHI_Vertex_PosTexNorTan>* vertices) const;
+        geometry_view GetGeometryView() const;
 
         // bounding box
-        const std::vector<uint32_t>& GetBoundingBoxGroupEndIndices() const { return m_instance_group_end_indices; }
-        uint32_t GetInstancePartitionCount() const                         { return static_cast<uint32_t>(m_instance_group_end_indices.size()); }
         const Math::BoundingBox& GetBoundingBox(const BoundingBoxType type, const uint32_t index = 0);
 
         //= MATERIAL ====================================================================
@@ -92,26 +128,60 @@ namespace Spartan
         RHI_GeometryBuffer* GetVertexBuffer() const;
         const std::string& GetMeshName() const;
 
-        // instancing
-        bool HasInstancing() const                              { return !m_instances.empty(); }
-        RHI_GeometryBuffer* GetInstanceBuffer() const           { return m_instance_buffer.get(); }
-        Math::Matrix GetInstanceTransform(const uint32_t index) { return m_instances[index]; }
-        uint32_t GetInstanceCount()  const                      { return static_cast<uint32_t>(m_instances.size()); }
+        // instancing, handles stay valid until the instance is removed (SetInstances() hands out 0 to n-1)
+        bool HasInstancing() const                                    { return m_instancing; }
+        RHI_GeometryBuffer* GetInstanceBuffer() const                 { return m_instance_buffer.get(); }
+        uint32_t GetInstanceCount() const                             { return m_instance_count; }
+        uint32_t GetInstancePartitionCount() const                    { return static_cast<uint32_t>(m_instance_groups.size()); }
         void SetInstances(const std::vector<Math::Matrix>& instances);
+        uint32_t AddInstance(const Math::Matrix& transform);
+        void RemoveInstance(const uint32_t handle);
+        void UpdateInstance(const uint32_t handle, const Math::Matrix& transform);
+
+        // instance slots, the layout of the instance buffer (not every slot holds an instance)
+        uint32_t GetInstanceSlotCount() const                         { return static_cast<uint32_t>(m_instances.size()); }
+        bool IsInstanceSlotUsed(const uint32_t slot) const            { return m_instance_slot_handle[slot] != instance_invalid; }
+        const Math::Matrix& GetInstanceTransform(const uint32_t slot) { return m_instances[slot]; }
 
         // misc
-        uint32_t GetIndexOffset() const  { return m_geometry_index_offset; }
+        uint32_t GetIndexOffset() const  { return m_geometry_index_offset + (m_mesh ? m_mesh->GetIndexBufferOffset() : 0); }   // within the index buffer
         uint32_t GetIndexCount() const   { return m_geometry_index_count; }
-        uint32_t GetVertexOffset() const { return m_geometry_vertex_offset; }
+        uint32_t GetVertexOffset() const { return m_geometry_vertex_offset + (m_mesh ? m_mesh->GetVertexBufferOffset() : 0); } // within the vertex buffer
         uint32_t GetVertexCount() const  { return m_geometry_vertex_count; }
         bool HasMesh() const             { return m_mesh != nullptr; }
+        Mesh* GetMesh() const            { return m_mesh; }
 
         // flags
         bool HasFlag(const RenderableFlags flag) { return m_flags & flag; }
         void SetFlag(const RenderableFlags flag, const bool enable = true);
-        bool IsVisible() const { return !(m_flags & RenderableFlags::OccludedCpu) && !(m_flags & RenderableFlags::OccludedGpu); }
+        bool IsVisible() const { return !(m_flags & RenderableFlags::OccludedCpu) && !(m_flags & RenderableFlags::Occluded); }
+
+        // occlusion culling, the first request starts building the occluder in the background
+        void RequestOccluderGeometry();
+        bool HasOccluderGeometry() const                               { return m_occluder && m_occluder->ready && !m_occluder->indices.empty(); }
+        bool IsOccluderGeometryRequested() const                       { return m_occluder != nullptr; }
+        const std::vector<Math::Vector3>& GetOccluderPositions() const { return m_occluder->positions; }
+        const std::vector<uint32_t>& GetOccluderIndices() const        { return m_occluder->indices; }
+
+        // proxy
+        void UpdateProxy();
+        const renderable_proxy& GetProxy() const { return m_proxy; }
+
+        // stages dirty instances at staging_offset (advanced past them) and records their copy into the command list,
+        // what doesn't fit before staging_end waits for the next frame, a new or grown buffer is filled right away
+        void InstanceBufferUpdate(RHI_CommandList* cmd_list, RHI_Buffer* staging, uint64_t* staging_offset, const uint64_t staging_end);
 
     private:
+        uint32_t InstanceGroupGetOrCreate(const uint64_t cell);
+        void InstanceGroupRelocate(const uint32_t group_index);
+        void InstanceInsert(const uint32_t group_index, const Math::Matrix& transform, const uint32_t handle);
+        void InstanceErase(const uint32_t slot);
+        void InstanceBuild(const std::vector<Math::Matrix>& transforms, const std::vector<uint32_t>& handles);
+        void InstanceSlotDirty(const uint32_t slot);
+        void InstanceGroupDirty(const uint32_t group_index);
+
+        static constexpr uint32_t instance_invalid = 0xFFFFFFFF;
+
         // geometry/mesh
         uint32_t m_geometry_index_offset             = 0;
         uint32_t m_geometry_index_count              = 0;
@@ -129,12 +199,34 @@ namespace Spartan
         Material* m_material    = nullptr;
 
         // instancing
+        bool m_instancing              = false;
+        bool m_instance_upload_all     = false;
+        uint32_t m_instance_count      = 0;
+        uint32_t m_instance_slots_dead = 0; // slots left behind by relocated groups
         std::vector<Math::Matrix> m_instances;
-        std::vector<uint32_t> m_instance_group_end_indices;
+        std::vector<uint32_t> m_instance_slot_handle;
+        std::vector<uint32_t> m_instance_slot_group;
+        std::vector<uint32_t> m_instance_handle_slot;
+        std::vector<uint32_t> m_instance_handles_free;
+        std::vector<instance_group> m_instance_groups;
+        std::unordered_map<uint64_t, uint32_t> m_instance_cell_to_group;
+        std::vector<uint32_t> m_instance_groups_dirty;
+        std::vector<uint32_t> m_instance_slots_dirty_bounds;
+        std::vector<uint32_t> m_instance_slots_dirty_upload;
+        std::vector<uint32_t> m_instance_slots_dirty_proxy;
+        std::vector<uint32_t> m_instance_groups_dirty_proxy;
         std::shared_ptr<RHI_GeometryBuffer> m_instance_buffer;
 
         // misc
         Math::Matrix m_transform_previous = Math::Matrix::Identity;
         uint32_t m_flags                  = RenderableFlags::CastsShadows;
+
+        // occluder
+        std::shared_ptr<occluder_geometry> m_occluder;
+
+        // proxy
+        renderable_proxy m_proxy;
+        bool m_proxy_dirty         = true;
+        bool m_proxy_instances_all = true; // otherwise only the dirty slots and groups are copied
     };
 }
@@ -30,6 +30,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Resource/ResourceCache.h"
 #include "../../Rendering/Mesh.h"
 #include "../../Core/ThreadPool.h"
+#include "../../Core/Hash.h"
 //=======================================
 
 //= NAMESPACES ===============
@@ -520,6 +521,189 @@ namespace Spartan
                 }
             }
         }
+
+        namespace cache
+        {
+            // generated tiles, bounds and collision heights, keyed by the height map content and the generation parameters
+            const uint32_t magic   = 0x52524554; // "TERR"
+            const uint32_t version = 2;
+
+            // undefined when the height map can't be read
+            hash_128 compute_key(const string& height_map_path, const float min_y, const float max_y, const float vertex_density)
+            {
+                // hash the content rather than the path, so that an edited height map invalidates the cache
+                uint64_t size     = 0;
+                const byte* data = FileSystem::MapFile(height_map_path, &size);
+                if (!data)
+                    return {};
+
+                hash_128 key = hash_compute(data, size);
+                FileSystem::UnmapFile(data, size);
+
+                key = hash_compute(min_y, key);
+                key = hash_compute(max_y, key);
+                key = hash_compute(vertex_density, key);
+                key = hash_compute(smoothing_iterations, key);
+                key = hash_compute(tile_count, key);
+                key = hash_compute(version, key);
+
+                return key;
+            }
+
+            string get_file_path(const hash_128& key)
+            {
+                char key_hex[33];
+                snprintf(key_hex, sizeof(key_hex), "%016llx%016llx", static_cast<unsigned long long>(key.high), static_cast<unsigned long long>(key.low));
+
+                return ResourceCache::GetResourceDirectory(ResourceDirectory::Cache) + "\\terrain_" + key_hex + ".bin";
+            }
+
+            void save(
+                const hash_128& key,
+                const uint32_t width,
+                const uint32_t depth,
+                const vector<float>& height_data,
+                const vector<vector<RHI_Vertex_PosTexNorTan>>& tile_vertices,
+                const vector<vector<uint32_t>>& tile_indices,
+                const vector<shared_ptr<Mesh>>& tile_meshes
+            )
+            {
+                string directory = ResourceCache::GetResourceDirectory(ResourceDirectory::Cache);
+                if (!FileSystem::Exists(directory))
+                {
+                    FileSystem::CreateDirectory(directory);
+                }
+
+                FileStream stream(get_file_path(key), FileStream_Write);
+                if (!stream.IsOpen())
+                    return;
+
+                stream.Write(magic);
+                stream.Write(version);
+                stream.Write(key.low);
+                stream.Write(key.high);
+                stream.Write(width);
+                stream.Write(depth);
+                stream.Write(height_data);
+                stream.Write(static_cast<uint32_t>(tile_vertices.size()));
+                for (uint32_t tile_index = 0; tile_index < static_cast<uint32_t>(tile_vertices.size()); tile_index++)
+                {
+                    stream.Write(tile_meshes[tile_index]->GetAabb());
+                    stream.Write(tile_vertices[tile_index]);
+                    stream.Write(tile_indices[tile_index]);
+                }
+            }
+
+            // the tile geometry points into the mapped file, so it's only valid until unmap()
+            struct mapping
+            {
+                const byte* data = nullptr;
+                uint64_t size    = 0;
+                vector<span<const RHI_Vertex_PosTexNorTan>> tile_vertices;
+                vector<span<const uint32_t>> tile_indices;
+                vector<BoundingBox> tile_aabbs;
+            };
+
+            void unmap(mapping& cached)
+            {
+                if (cached.data)
+                {
+                    FileSystem::UnmapFile(cached.data, cached.size);
+                }
+
+                cached = mapping();
+            }
+
+            bool load(
+                const hash_128& key,
+                uint32_t& width,
+                uint32_t& depth,
+                vector<float>& height_data,
+                mapping& cached
+            )
+            {
+                string file_path = get_file_path(key);
+                if (!FileSystem::Exists(file_path))
+                    return false;
+
+                // the file is mapped and the tile meshes read their geometry straight from it, only the
+                // height data is copied out, since the terrain keeps it around for the physics shape
+                cached.data = FileSystem::MapFile(file_path, &cached.size);
+                if (!cached.data)
+                    return false;
+
+                const byte* data    = cached.data;
+                const uint64_t size = cached.size;
+                uint64_t offset     = 0;
+                auto read = [&](void* destination, const uint64_t byte_count)
+                {
+                    if (offset + byte_count > size)
+                        return false;
+
+                    memcpy(destination, data + offset, byte_count);
+                    offset += byte_count;
+                    return true;
+                };
+
+                auto read_view = [&](auto& view)
+                {
+                    using element = typename remove_reference_t<decltype(view)>::element_type;
+
+                    uint32_t count = 0;
+                    if (!read(&count, sizeof(count)))
+                        return false;
+
+                    const uint64_t byte_count = static_cast<uint64_t>(count) * sizeof(element);
+                    if (offset + byte_count > size || reinterpret_cast<uintptr_t>(data + offset) % alignof(element) != 0)
+                        return false;
+
+                    view    = span<element>(reinterpret_cast<element*>(data + offset), count);
+                    offset += byte_count;
+                    return true;
+                };
+
+                uint32_t file_magic   = 0;
+                uint32_t file_version = 0;
+                hash_128 file_key;
+                uint32_t tile_total   = 0;
+                uint32_t height_count = 0;
+                bool is_valid =
+                    read(&file_magic, sizeof(file_magic))     && file_magic   == magic   &&
+                    read(&file_version, sizeof(file_version)) && file_version == version &&
+                    read(&file_key.low, sizeof(file_key.low)) && read(&file_key.high, sizeof(file_key.high)) && file_key == key &&
+                    read(&width, sizeof(width))               &&
+                    read(&depth, sizeof(depth))               &&
+                    read(&height_count, sizeof(height_count)) && height_count == static_cast<uint64_t>(width) * depth;
+
+                if (is_valid)
+                {
+                    height_data.resize(height_count);
+                    is_valid = read(height_data.data(), static_cast<uint64_t>(height_count) * sizeof(float)) && read(&tile_total, sizeof(tile_total));
+                }
+
+                if (is_valid)
+                {
+                    cached.tile_vertices.resize(tile_total);
+                    cached.tile_indices.resize(tile_total);
+                    cached.tile_aabbs.resize(tile_total);
+                    for (uint32_t tile_index = 0; tile_index < tile_total && is_valid; tile_index++)
+                    {
+                        is_valid =
+                            read(&cached.tile_aabbs[tile_index], sizeof(BoundingBox)) &&
+                            read_view(cached.tile_vertices[tile_index])               &&
+                            read_view(cached.tile_indices[tile_index]);
+                    }
+                }
+
+                if (!is_valid)
+                {
+                    SP_LOG_WARNING("Terrain cache \"%s\" is invalid, regenerating", file_path.c_str());
+                    unmap(cached);
+                }
+
+                return is_valid;
+            }
+        }
     }
 
     Terrain::Terrain(weak_ptr<Entity> entity) : Component(entity)
@@ -550,8 +734,9 @@ namespace Spartan
 
     void Terrain::SetHeightMap(const string& file_path)
     {
+        // decoding is deferred to Generate(), which skips it entirely when the terrain is cached
         m_height_texture = make_shared<RHI_Texture2D>();
-        m_height_texture->LoadFromFile(file_path);
+        m_height_texture->SetResourceFilePath(file_path);
     }
 
     void Terrain::GenerateTransforms(vector<Matrix>* transforms, const uint32_t count, const TerrainProp terrain_prop)
@@ -581,7 +766,20 @@ namespace Spartan
             terrain_offset              = -0.9f;
         }
 
-        *transforms = generate_transforms(m_vertices, m_indices, count, max_slope, rotate_match_surface_normal, terrain_offset);
+        if (m_height_data.empty())
+        {
+            SP_LOG_WARNING("The terrain needs to be generated before generating transforms");
+            return;
+        }
+
+        // rebuild the geometry from the height data, normals are not needed
+        vector<Vector3> positions(m_height_samples);
+        vector<RHI_Vertex_PosTexNorTan> vertices(m_vertex_count);
+        vector<uint32_t> indices(m_index_count);
+        generate_positions(positions, m_height_data, m_width, m_depth);
+        generate_vertices_and_indices(vertices, indices, positions, m_width, m_depth);
+
+        *transforms = generate_transforms(vertices, indices, count, max_slope, rotate_match_surface_normal, terrain_offset);
 	}
 
     void Terrain::Generate()
@@ -601,87 +799,137 @@ namespace Spartan
         }
 
         m_is_generating = true;
+        const Stopwatch timer;
+
+        // try the cache first, it's keyed by the height map content and the generation parameters
+        cache::mapping cached;
+        hash_128 cache_key = cache::compute_key(m_height_texture->GetResourceFilePath(), m_min_y, m_max_y, m_vertex_density);
+        bool is_cached     = cache_key.IsDefined() && cache::load(cache_key, m_width, m_depth, m_height_data, cached);
 
         // star progress tracking
-        uint32_t job_count = 6;
+        uint32_t job_count = is_cached ? 1 : 6;
         ProgressTracker::GetProgress(ProgressType::Terrain).Start(job_count, "Generating terrain...");
 
-        uint32_t width  = 0;
-        uint32_t height = 0;
         vector<Vector3> positions;
+        vector<RHI_Vertex_PosTexNorTan> vertices;
+        vector<uint32_t> indices;
 
-        // 1. process height map
+        if (is_cached)
+        {
+            m_height_samples = m_width * m_depth;
+            m_vertex_count   = m_height_samples;
+            m_index_count    = m_vertex_count * 6;
+            m_triangle_count = m_index_count / 3;
+        }
+        else
         {
-            ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Process height map...");
+            // 1. process height map
+            {
+                ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Process height map...");
+
+                if (!generate_height_points_from_height_map(m_height_data, m_height_texture, m_min_y, m_max_y))
+                {
+                    m_is_generating = false;
+                    return;
+                }
+
+                // deduce some stuff
+                m_width          = m_height_texture->GetWidth();
+                m_depth          = m_height_texture->GetHeight();
+                m_height_samples = m_width * m_depth;
+                m_vertex_count   = m_height_samples;
+                m_index_count    = m_vertex_count * 6;
+                m_triangle_count = m_index_count / 3;
 
-            if (!generate_height_points_from_height_map(m_height_data, m_height_texture, m_min_y, m_max_y))
+                // allocate memory for the calculations that follow
+                positions  = vector<Vector3>(m_height_samples);
+                vertices   = vector<RHI_Vertex_PosTexNorTan>(m_vertex_count);
+                indices    = vector<uint32_t>(m_index_count);
+
+                ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
+            }
+
+            // 2. compute positions
             {
-                m_is_generating = false;
-                return;
+                ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Generating positions...");
+                generate_positions(positions, m_height_data, m_width, m_depth);
+                ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
             }
 
-            // deduce some stuff
-            width            = m_height_texture->GetWidth();
-            height           = m_height_texture->GetHeight();
-            m_height_samples = width * height;
-            m_vertex_count   = m_height_samples;
-            m_index_count    = m_vertex_count * 6;
-            m_triangle_count = m_index_count / 3;
+            // 3. compute vertices and indices
+            {
+                ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Generating vertices and indices...");
+                generate_vertices_and_indices(vertices, indices, positions, m_width, m_depth);
+                ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
+            }
 
-            // allocate memory for the calculations that follow
-            positions  = vector<Vector3>(m_height_samples);
-            m_vertices = vector<RHI_Vertex_PosTexNorTan>(m_vertex_count);
-            m_indices  = vector<uint32_t>(m_index_count);
+            // 4. compute normals and tangents
+            {
+                ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Generating normals...");
+                generate_normals(indices, vertices);
+                ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
+            }
 
-            ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
+            // 5. split into tiles
+            {
+                ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Splitting into tiles...");
+                split_terrain_into_tiles(vertices, indices, m_tile_vertices, m_tile_indices);
+                ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
+            }
         }
 
-        // 2. compute positions
+        // 6. create a mesh for each tile
         {
-            ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Generating positions...");
-            generate_positions(positions, m_height_data, width, height);
-            ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
-        }
+            ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Creating tile meshes");
 
-        // 3. compute vertices and indices
-        {
-            ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Generating vertices and indices...");
-            generate_vertices_and_indices(m_vertices, m_indices, positions, width, height);
-            ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
-        }
+            if (is_cached)
+            {
+                for (uint32_t tile_index = 0; tile_index < static_cast<uint32_t>(cached.tile_vertices.size()); tile_index++)
+                {
+                    UpdateMesh(tile_index, cached.tile_vertices[tile_index], cached.tile_indices[tile_index], &cached.tile_aabbs[tile_index]);
+                }
+
+                cache::unmap(cached);
+            }
+            else
+            {
+                for (uint32_t tile_index = 0; tile_index < static_cast<uint32_t>(m_tile_vertices.size()); tile_index++)
+                {
+                    UpdateMesh(tile_index, m_tile_vertices[tile_index], m_tile_indices[tile_index]);
+                }
+            }
 
-        // 4. compute normals and tangents
-        {
-            ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Generating normals...");
-            generate_normals(m_indices, m_vertices);
             ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
         }
 
-        // 5. split into tiles
+        // cache what was generated, so the next load can skip all of the above
+        if (!is_cached && cache_key.IsDefined())
         {
-            ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Splitting into tiles...");
-            split_terrain_into_tiles(m_vertices, m_indices, m_tile_vertices, m_tile_indices);
-            ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
+            cache::save(cache_key, m_width, m_depth, m_height_data, m_tile_vertices, m_tile_indices, m_tile_meshes);
         }
 
-        // 6. create a mesh for each tile
+        // release the cpu side geometry, the tile meshes live on the gpu now and GenerateTransforms()
+        // rebuilds what it needs from the height data (which is kept since the physics shape reads it)
         {
-            ProgressTracker::GetProgress(ProgressType::Terrain).SetText("Creating tile meshes");
+            m_tile_vertices.clear();
+            m_tile_vertices.shrink_to_fit();
+            m_tile_indices.clear();
+            m_tile_indices.shrink_to_fit();
 
-            for (uint32_t tile_index = 0; tile_index < static_cast<uint32_t>(m_tile_vertices.size()); tile_index++)
+            // the height map is re-read from its file if the terrain is generated again
+            if (FileSystem::Exists(m_height_texture->GetResourceFilePath()))
             {
-                UpdateMesh(tile_index);
+                m_height_texture->GetData().clear();
+                m_height_texture->GetData().shrink_to_fit();
             }
-
-            ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
         }
 
-        // todo: we don't free vertices and indices, we should
+        SP_LOG_INFO("Terrain %s in %.2f ms", is_cached ? "loaded from cache" : "generated", timer.GetElapsedTimeMs());
 
         m_is_generating = false;
     }
     
-    void Terrain::UpdateMesh(const uint32_t tile_index)
+    void Terrain::UpdateMesh(const uint32_t tile_index, span<const RHI_Vertex_PosTexNorTan> vertices, span<const uint32_t> indices, const BoundingBox* aabb)
     {
         string name = "tile_" + to_string(tile_index);
 
@@ -695,11 +943,18 @@ namespace Spartan
         // update with geometry
         shared_ptr<Mesh>& mesh = m_tile_meshes[tile_index];
         mesh->Clear();
-        mesh->AddIndices(m_tile_indices[tile_index]);
-        mesh->AddVertices(m_tile_vertices[tile_index]);
-        mesh->CreateGpuBuffers();
+        mesh->AddIndices(indices);
+        mesh->AddVertices(vertices);
+        if (aabb)
+        {
+            mesh->SetAabb(*aabb);
+        }
+        else
+        {
+            mesh->ComputeAabb();
+        }
         mesh->ComputeNormalizedScale();
-        mesh->ComputeAabb();
+        mesh->CreateGpuBuffers(); // releases the cpu data, so it goes last
 
         // create a child entity, add a renderable, and this mesh tile to it
         {
@@ -725,11 +980,11 @@ namespace Spartan
 
     void Terrain::Clear()
     {
-        m_vertices.clear();
-        m_indices.clear();
         m_tile_meshes.clear();
         m_tile_vertices.clear();
         m_tile_indices.clear();
+        m_width  = 0;
+        m_depth  = 0;
 
         for (auto& mesh : m_tile_meshes)
         {
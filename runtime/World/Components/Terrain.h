@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =========================
 #include "Component.h"
 #include <atomic>
+#include <span>
 #include "../../RHI/RHI_Definitions.h"
 //====================================
 
@@ -34,6 +35,7 @@ namespace Spartan
     namespace Math
     {
         class Vector3;
+        class BoundingBox;
     }
 
     enum class TerrainProp
@@ -67,6 +69,8 @@ namespace Spartan
         void Generate();
         void GenerateTransforms(std::vector<Math::Matrix>* transforms, const uint32_t count, const TerrainProp terrain_prop);
 
+        uint32_t GetWidth() const               { return m_width; }
+        uint32_t GetDepth() const               { return m_depth; }
         uint32_t GetVertexCount() const         { return m_vertex_count; }
         uint32_t GetIndexCount() const          { return m_index_count; }
         uint64_t GetHeightSampleCount() const   { return m_height_samples; }
@@ -74,13 +78,15 @@ namespace Spartan
         std::shared_ptr<Material> GetMaterial() { return m_material; }
  
     private:
-        void UpdateMesh(const uint32_t tile_index);
+        void UpdateMesh(const uint32_t tile_index, std::span<const RHI_Vertex_PosTexNorTan> vertices, std::span<const uint32_t> indices, const Math::BoundingBox* aabb = nullptr);
         void Clear();
 
         float m_min_y                     = -20.0f; // everything below 0.0 is assumed to be below sea level
         float m_max_y                     = 100.0f;
         float m_vertex_density            = 1.0f;
         std::atomic<bool> m_is_generating = false;
+        uint32_t m_width                  = 0; // in height samples
+        uint32_t m_depth                  = 0; // in height samples
         uint32_t m_height_samples         = 0;
         uint32_t m_vertex_count           = 0;
         uint32_t m_index_count            = 0;
@@ -88,8 +94,6 @@ namespace Spartan
         std::shared_ptr<RHI_Texture> m_height_texture;
         std::vector<float> m_height_data;
         std::vector<std::vector<RHI_Vertex_PosTexNorTan>> m_tile_vertices;
-        std::vector<RHI_Vertex_PosTexNorTan> m_vertices;
-        std::vector<uint32_t> m_indices;
         std::vector<std::vector<uint32_t>> m_tile_indices;
         std::vector<std::shared_ptr<Mesh>> m_tile_meshes;
         std::shared_ptr<Material> m_material;
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ========================
 #include "pch.h"
 #include "Entity.h"
+#include "Prefab.h"
 #include "Components/Camera.h"
 #include "Components/Constraint.h"
 #include "Components/Light.h"
@@ -42,12 +43,15 @@ namespace Spartan
 {
     namespace
     {
+        // written after the basic data, where older files have the first component type, which is always smaller
+        const uint32_t format_tag     = 0x53504546; // "SPEF"
+        const uint32_t format_version = 1;          // 1: prefab path and overrides
+
         // input is an entity, output is a clone of that entity (descendant entities are not cloned)
         shared_ptr<Entity> clone_entity(Entity* entity)
         {
             // clone basic properties
             shared_ptr<Entity> clone = World::CreateEntity();
-            clone->SetObjectId(SpartanObject::GenerateObjectId());
             clone->SetObjectName(entity->GetObjectName());
             clone->SetActive(entity->IsActive());
             clone->SetHierarchyVisibility(entity->IsVisibleInHierarchy());
@@ -108,7 +112,10 @@ namespace Spartan
 
     shared_ptr<Entity> Entity::Clone()
     {
-        return clone_entity_and_descendants(this);
+        shared_ptr<Entity> clone = clone_entity_and_descendants(this);
+        clone->SetPrefab(m_prefab); // same hierarchy, so it can be saved as an instance too
+
+        return clone;
     }
 
     void Entity::OnStart()
@@ -163,6 +170,24 @@ namespace Spartan
             stream->Write(!m_parent.expired() ? m_parent.lock()->GetObjectId() : 0);
         }
 
+        // FORMAT
+        {
+            stream->Write(format_tag);
+            stream->Write(format_version);
+        }
+
+        // PREFAB
+        {
+            // instances only store what differs from the prefab, descendants included
+            const bool is_instance = m_prefab && m_prefab->IsInstanceCompatible(this);
+            stream->Write(is_instance ? m_prefab->GetFilePath() : string());
+            if (is_instance)
+            {
+                stream->Write(m_prefab->SerializeOverrides(this));
+                return;
+            }
+        }
+
         // COMPONENTS
         {
             for (shared_ptr<Component>& component : m_components)
@@ -218,7 +243,7 @@ namespace Spartan
             stream->Read(&m_is_active);
             stream->Read(&m_hierarchy_visibility);
             stream->Read(&m_object_id);
-            stream->Read(&m_object_name);
+            SetObjectName(stream->ReadAs<string>());
             stream->Read(&m_position_local);
             stream->Read(&m_rotation_local);
             stream->Read(&m_scale_local);
@@ -236,13 +261,55 @@ namespace Spartan
             UpdateTransform();
         }
 
+        // FORMAT
+        uint32_t version              = 0;
+        uint32_t first_component_type = stream->ReadAs<uint32_t>();
+        if (first_component_type == format_tag)
+        {
+            stream->Read(&version);
+            first_component_type = numeric_limits<uint32_t>::max();
+        }
+
+        // PREFAB
+        if (version >= 1)
+        {
+            const string prefab_path = stream->ReadAs<string>();
+            if (!prefab_path.empty())
+            {
+                vector<byte> overrides;
+                stream->Read(&overrides);
+
+                SetParent(parent);
+
+                m_prefab = Prefab::Load(prefab_path);
+                if (m_prefab)
+                {
+                    m_prefab->DeserializeOverrides(this, overrides);
+                }
+                else
+                {
+                    SP_LOG_ERROR("Failed to load prefab \"%s\", the instance \"%s\" will be empty", prefab_path.c_str(), m_object_name.c_str());
+                }
+
+                World::Resolve();
+                return;
+            }
+        }
+
         // COMPONENTS
         {
             for (uint32_t i = 0; i < static_cast<uint32_t>(m_components.size()); i++)
             {
-                // type
+                // type, files without a format tag have already had the first one read
                 uint32_t component_type = static_cast<uint32_t>(ComponentType::Max);
-                stream->Read(&component_type);
+                if (i == 0 && first_component_type != numeric_limits<uint32_t>::max())
+                {
+                    component_type = first_component_type;
+                }
+                else
+                {
+                    stream->Read(&component_type);
+                }
 
                 if (component_type != static_cast<uint32_t>(ComponentType::Max))
                 {
@@ -279,10 +346,7 @@ namespace Spartan
             vector<weak_ptr<Entity>> children;
             for (uint32_t i = 0; i < children_count; i++)
             {
-                shared_ptr<Entity> child = World::CreateEntity();
-
-                child->SetObjectId(stream->ReadAs<uint64_t>());
-
+                shared_ptr<Entity> child = World::CreateEntity(stream->ReadAs<uint64_t>());
                 children.emplace_back(child);
             }
 
@@ -621,15 +685,10 @@ namespace Spartan
     {
         SP_ASSERT(transform != nullptr);
 
-        if (m_parent.expired())
-            return false;
-
-        if (m_parent.lock()->GetObjectId() == transform->GetObjectId())
-            return true;
-
-        for (Entity* child : transform->GetChildren())
+        // walk up, the depth is far smaller than the size of the subtree
+        for (shared_ptr<Entity> parent = m_parent.lock(); parent; parent = parent->GetParent())
         {
-            if (IsDescendantOf(child))
+            if (parent.get() == transform)
                 return true;
         }
 
@@ -651,16 +710,37 @@ namespace Spartan
 
     Entity* Entity::GetDescendantByName(const string& name)
     {
-        vector<Entity*> descendants;
-        GetDescendants(&descendants);
+        return World::GetEntityByName(name, this);
+    }
 
-        for (Entity* entity : descendants)
-        {
-            if (entity->GetObjectName() == name)
-                return entity;
-        }
+    void Entity::SetObjectName(const string& name)
+    {
+        // the world assigns the name, under the lock that lookups compare it under
+        World::OnEntityRenamed(this, name);
+    }
 
-        return nullptr;
+    void Entity::AddTag(const string& tag)
+    {
+        if (HasTag(tag))
+            return;
+
+        m_tags.emplace_back(tag);
+        World::OnEntityTagged(this, hash_name(tag), true);
+    }
+
+    void Entity::RemoveTag(const string& tag)
+    {
+        auto it = find(m_tags.begin(), m_tags.end(), tag);
+        if (it == m_tags.end())
+            return;
+
+        m_tags.erase(it);
+        World::OnEntityTagged(this, hash_name(tag), false);
+    }
+
+    bool Entity::HasTag(const string_view tag) const
+    {
+        return find(m_tags.begin(), m_tags.end(), tag) != m_tags.end();
     }
 
     bool Entity::IsMoving() const
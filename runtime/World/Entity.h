@@ -21,7 +21,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES ====================
+//= INCLUDES =======================
 #include <atomic>
 #include <array>
 #include <mutex>
@@ -29,12 +29,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Math/Quaternion.h"
 #include "../Math/Matrix.h"
 #include "World.h"
-//===============================
+#include "../Core/PoolAllocator.h"
+//==================================
 
 namespace Spartan
 {
     class FileStream;
     class Renderable;
+    class Prefab;
     
     class SP_CLASS Entity : public SpartanObject, public std::enable_shared_from_this<Entity>
     {
@@ -54,6 +56,19 @@ namespace Spartan
         void Serialize(FileStream* stream);
         void Deserialize(FileStream* stream, std::shared_ptr<Entity> parent);
 
+        // name, kept in the world's name index
+        void SetObjectName(const std::string& name) override;
+
+        // tags, kept in the world's tag index (not serialized)
+        void AddTag(const std::string& tag);
+        void RemoveTag(const std::string& tag);
+        bool HasTag(const std::string_view tag) const;
+        const std::vector<std::string>& GetTags() const { return m_tags; }
+
+        // prefab, only set on the root entity of an instance
+        const std::shared_ptr<Prefab>& GetPrefab() const     { return m_prefab; }
+        void SetPrefab(const std::shared_ptr<Prefab>& prefab) { m_prefab = prefab; }
+
         // active
         bool IsActive() const;
         void SetActive(const bool active) { m_is_active = active; }
@@ -72,8 +87,8 @@ namespace Spartan
             if (std::shared_ptr<T> component = GetComponent<T>())
                 return component;
 
-            // create a new component
-            std::shared_ptr<T> component = std::make_shared<T>(this->shared_from_this());
+            // create a new component, pooled per component type
+            std::shared_ptr<T> component = std::allocate_shared<T>(PoolAllocator<T>(), this->shared_from_this());
 
             // save new component
             m_components[static_cast<uint32_t>(type)] = std::static_pointer_cast<Component>(component);
@@ -164,10 +179,8 @@ namespace Spartan
         std::vector<Entity*>& GetChildren()       { return m_children; }
         //===============================================================================================
 
-        const Math::Matrix& GetMatrix() const              { return m_matrix; }
-        const Math::Matrix& GetLocalMatrix() const         { return m_matrix_local; }
-        const Math::Matrix& GetMatrixPrevious() const      { return m_matrix_previous; }
-        void SetMatrixPrevious(const Math::Matrix& matrix) { m_matrix_previous = matrix; }
+        const Math::Matrix& GetMatrix() const      { return m_matrix; }
+        const Math::Matrix& GetLocalMatrix() const { return m_matrix_local; }
         bool IsMoving() const;
 
     private:
@@ -183,14 +196,15 @@ namespace Spartan
         Math::Quaternion m_rotation_local = Math::Quaternion::Identity;
         Math::Vector3 m_scale_local       = Math::Vector3::One;
 
-        Math::Matrix m_matrix          = Math::Matrix::Identity;
-        Math::Matrix m_matrix_previous = Math::Matrix::Identity;
-        Math::Matrix m_matrix_local    = Math::Matrix::Identity;
+        Math::Matrix m_matrix       = Math::Matrix::Identity;
+        Math::Matrix m_matrix_local = Math::Matrix::Identity;
 
         std::weak_ptr<Entity> m_parent;  // the parent of this entity
         std::vector<Entity*> m_children; // the children of this entity
 
         // misc
+        std::shared_ptr<Prefab> m_prefab;
+        std::vector<std::string> m_tags;
         std::mutex m_mutex_children;
         std::mutex m_mutex_parent;
         float m_time_since_last_transform_sec = 0.0f;
@@ -0,0 +1,458 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ========================
+#include "pch.h"
+#include "Prefab.h"
+#include "Entity.h"
+#include "../IO/FileStream.h"
+//===================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    namespace
+    {
+        unordered_map<string, shared_ptr<Prefab>> prefabs;
+        mutex mutex_prefabs;
+
+        // files without the tag start with the node count and have no node ids
+        const uint32_t format_tag     = 0x53505046; // "SPPF"
+        const uint32_t format_version = 1;          // 1: node ids
+
+        // what an instance changed on the basic data of a node, the root's basic data is always saved by the entity
+        enum node_override : uint32_t
+        {
+            node_override_name      = 1 << 0,
+            node_override_active    = 1 << 1,
+            node_override_visible   = 1 << 2,
+            node_override_transform = 1 << 3
+        };
+
+        void get_hierarchy(Entity* entity, vector<Entity*>* hierarchy)
+        {
+            hierarchy->emplace_back(entity);
+
+            for (Entity* child : entity->GetChildren())
+            {
+                get_hierarchy(child, hierarchy);
+            }
+        }
+
+        vector<byte> serialize_component(Component* component)
+        {
+            FileStream stream;
+            component->Serialize(&stream);
+            return stream.GetData();
+        }
+
+        void deserialize_component(Component* component, const vector<byte>& data)
+        {
+            FileStream stream(data);
+            component->Deserialize(&stream);
+        }
+    }
+
+    shared_ptr<Prefab> Prefab::Create(Entity* root, const string& file_path)
+    {
+        SP_ASSERT(root != nullptr);
+
+        vector<Entity*> hierarchy;
+        get_hierarchy(root, &hierarchy);
+
+        shared_ptr<Prefab> prefab = make_shared<Prefab>();
+        prefab->m_file_path       = file_path;
+        prefab->m_nodes.resize(hierarchy.size());
+
+        unordered_map<Entity*, uint32_t> indices;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(hierarchy.size()); i++)
+        {
+            Entity* entity  = hierarchy[i];
+            node& n         = prefab->m_nodes[i];
+            indices[entity] = i;
+
+            n.id             = entity->GetObjectId();
+            n.name           = entity->GetObjectName();
+            n.active         = entity->IsActive();
+            n.visible        = entity->IsVisibleInHierarchy();
+            n.position       = entity->GetPositionLocal();
+            n.rotation       = entity->GetRotationLocal();
+            n.scale          = entity->GetScaleLocal();
+            n.parent         = i == 0 ? 0 : indices[entity->GetParent().get()];
+            n.children_count = entity->GetChildrenCount();
+
+            for (const shared_ptr<Component>& component : entity->GetAllComponents())
+            {
+                if (component)
+                {
+                    node_component& c = n.components.emplace_back();
+                    c.type            = static_cast<uint32_t>(component->GetType());
+                    c.data            = serialize_component(component.get());
+                }
+            }
+        }
+
+        if (!prefab->SaveToFile())
+            return nullptr;
+
+        {
+            lock_guard lock(mutex_prefabs);
+            prefabs[file_path] = prefab;
+        }
+
+        root->SetPrefab(prefab);
+
+        return prefab;
+    }
+
+    shared_ptr<Prefab> Prefab::Load(const string& file_path)
+    {
+        lock_guard lock(mutex_prefabs);
+
+        auto it = prefabs.find(file_path);
+        if (it != prefabs.end())
+            return it->second;
+
+        shared_ptr<Prefab> prefab = make_shared<Prefab>();
+        prefab->m_file_path       = file_path;
+        if (!prefab->LoadFromFile())
+            return nullptr;
+
+        prefabs[file_path] = prefab;
+
+        return prefab;
+    }
+
+    shared_ptr<Entity> Prefab::Instantiate(const Vector3& position, const Quaternion& rotation, const Vector3& scale)
+    {
+        shared_ptr<Entity> root = World::CreateEntity();
+        root->SetObjectName(m_nodes[0].name);
+        root->SetActive(m_nodes[0].active);
+        root->SetHierarchyVisibility(m_nodes[0].visible);
+        root->SetPositionLocal(position);
+        root->SetRotationLocal(rotation);
+        root->SetScaleLocal(scale);
+
+        Build(root.get(), nullptr);
+        root->SetPrefab(shared_from_this());
+
+        World::Resolve();
+
+        return root;
+    }
+
+    bool Prefab::IsInstanceCompatible(Entity* root) const
+    {
+        vector<Entity*> hierarchy;
+        get_hierarchy(root, &hierarchy);
+
+        if (hierarchy.size() != m_nodes.size())
+            return false;
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(hierarchy.size()); i++)
+        {
+            if (hierarchy[i]->GetChildrenCount() != m_nodes[i].children_count)
+                return false;
+        }
+
+        return true;
+    }
+
+    vector<byte> Prefab::SerializeOverrides(Entity* root) const
+    {
+        SP_ASSERT(IsInstanceCompatible(root));
+
+        vector<Entity*> hierarchy;
+        get_hierarchy(root, &hierarchy);
+
+        FileStream stream;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(hierarchy.size()); i++)
+        {
+            Entity* entity = hierarchy[i];
+            const node& n  = m_nodes[i];
+
+            // basic data
+            if (i != 0)
+            {
+                uint32_t mask = 0;
+                if (entity->GetObjectName() != n.name)           mask |= node_override_name;
+                if (entity->IsActive() != n.active)              mask |= node_override_active;
+                if (entity->IsVisibleInHierarchy() != n.visible) mask |= node_override_visible;
+                if (entity->GetPositionLocal() != n.position || entity->GetRotationLocal() != n.rotation || entity->GetScaleLocal() != n.scale)
+                {
+                    mask |= node_override_transform;
+                }
+
+                // the id is kept so that references to the entity (e.g. constraints) survive a reload
+                stream.Write(entity->GetObjectId());
+                stream.Write(mask);
+                if (mask & node_override_name)      stream.Write(entity->GetObjectName());
+                if (mask & node_override_active)    stream.Write(entity->IsActive());
+                if (mask & node_override_visible)   stream.Write(entity->IsVisibleInHierarchy());
+                if (mask & node_override_transform)
+                {
+                    stream.Write(entity->GetPositionLocal());
+                    stream.Write(entity->GetRotationLocal());
+                    stream.Write(entity->GetScaleLocal());
+                }
+            }
+
+            // components, only the ones that differ from the template are saved, in full
+            uint32_t removed_mask = 0;
+            vector<node_component> changed;
+            const auto& components = entity->GetAllComponents();
+            for (const node_component& c : n.components)
+            {
+                if (!components[c.type])
+                {
+                    removed_mask |= 1 << c.type;
+                }
+            }
+
+            for (const shared_ptr<Component>& component : components)
+            {
+                if (!component)
+                    continue;
+
+                const uint32_t type = static_cast<uint32_t>(component->GetType());
+                vector<byte> data   = serialize_component(component.get());
+
+                auto it = find_if(n.components.begin(), n.components.end(), [type](const node_component& c) { return c.type == type; });
+                if (it == n.components.end() || it->data != data)
+                {
+                    node_component& c = changed.emplace_back();
+                    c.type            = type;
+                    c.data            = move(data);
+                }
+            }
+
+            stream.Write(removed_mask);
+            stream.Write(static_cast<uint32_t>(changed.size()));
+            for (const node_component& c : changed)
+            {
+                stream.Write(c.type);
+                stream.Write(c.data);
+            }
+        }
+
+        return stream.GetData();
+    }
+
+    void Prefab::DeserializeOverrides(Entity* root, const vector<byte>& overrides)
+    {
+        FileStream stream(overrides);
+        Build(root, &stream);
+    }
+
+    void Prefab::Build(Entity* root, FileStream* overrides)
+    {
+        vector<Entity*> hierarchy;
+        hierarchy.reserve(m_nodes.size());
+
+        // template ids to instance ids, for components that reference entities within the template
+        unordered_map<uint64_t, uint64_t> ids;
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_nodes.size()); i++)
+        {
+            const node& n  = m_nodes[i];
+            Entity* entity = root;
+
+            // basic data
+            if (i != 0)
+            {
+                shared_ptr<Entity> child = World::CreateEntity(overrides ? overrides->ReadAs<uint64_t>() : 0);
+                child->SetObjectName(n.name);
+                child->SetActive(n.active);
+                child->SetHierarchyVisibility(n.visible);
+                child->SetParent(hierarchy[n.parent]->shared_from_this());
+
+                Vector3 position    = n.position;
+                Quaternion rotation = n.rotation;
+                Vector3 scale       = n.scale;
+
+                const uint32_t mask = overrides ? overrides->ReadAs<uint32_t>() : 0;
+                if (mask & node_override_name)    child->SetObjectName(overrides->ReadAs<string>());
+                if (mask & node_override_active)  child->SetActive(overrides->ReadAs<bool>());
+                if (mask & node_override_visible) child->SetHierarchyVisibility(overrides->ReadAs<bool>());
+                if (mask & node_override_transform)
+                {
+                    overrides->Read(&position);
+                    overrides->Read(&rotation);
+                    overrides->Read(&scale);
+                }
+
+                child->SetPositionLocal(position);
+                child->SetRotationLocal(rotation);
+                child->SetScaleLocal(scale);
+
+                entity = child.get();
+            }
+            hierarchy.emplace_back(entity);
+
+            if (n.id != 0 && n.id != entity->GetObjectId())
+            {
+                ids[n.id] = entity->GetObjectId();
+            }
+
+            // components
+            uint32_t removed_mask = 0;
+            vector<node_component> changed;
+            if (overrides)
+            {
+                removed_mask = overrides->ReadAs<uint32_t>();
+                changed.resize(overrides->ReadAs<uint32_t>());
+                for (node_component& c : changed)
+                {
+                    c.type = overrides->ReadAs<uint32_t>();
+                    overrides->Read(&c.data);
+                }
+            }
+
+            // like Entity::Deserialize(), all components are added before any is deserialized since they can depend on each other
+            vector<pair<Component*, const vector<byte>*>> to_deserialize;
+            for (const node_component& c : n.components)
+            {
+                if ((removed_mask & (1 << c.type)) == 0)
+                {
+                    to_deserialize.emplace_back(entity->AddComponent(static_cast<ComponentType>(c.type)).get(), &c.data);
+                }
+            }
+
+            for (const node_component& c : changed)
+            {
+                Component* component = entity->AddComponent(static_cast<ComponentType>(c.type)).get();
+                auto it = find_if(to_deserialize.begin(), to_deserialize.end(), [component](const auto& pair) { return pair.first == component; });
+                if (it != to_deserialize.end())
+                {
+                    it->second = &c.data;
+                }
+                else
+                {
+                    to_deserialize.emplace_back(component, &c.data);
+                }
+            }
+
+            for (auto& [component, data] : to_deserialize)
+            {
+                deserialize_component(component, *data);
+            }
+        }
+
+        // only now do all the entities exist, so references can be resolved regardless of the node order
+        if (!ids.empty())
+        {
+            for (Entity* entity : hierarchy)
+            {
+                for (const shared_ptr<Component>& component : entity->GetAllComponents())
+                {
+                    if (component)
+                    {
+                        component->RemapEntityIds(ids);
+                    }
+                }
+            }
+        }
+    }
+
+    bool Prefab::SaveToFile()
+    {
+        FileStream file(m_file_path, FileStream_Write);
+        if (!file.IsOpen())
+        {
+            SP_LOG_ERROR("Failed to open \"%s\" for writing", m_file_path.c_str());
+            return false;
+        }
+
+        file.Write(format_tag);
+        file.Write(format_version);
+        file.Write(static_cast<uint32_t>(m_nodes.size()));
+        for (const node& n : m_nodes)
+        {
+            file.Write(n.id);
+            file.Write(n.name);
+            file.Write(n.active);
+            file.Write(n.visible);
+            file.Write(n.position);
+            file.Write(n.rotation);
+            file.Write(n.scale);
+            file.Write(n.parent);
+            file.Write(n.children_count);
+
+            file.Write(static_cast<uint32_t>(n.components.size()));
+            for (const node_component& c : n.components)
+            {
+                file.Write(c.type);
+                file.Write(c.data);
+            }
+        }
+
+        return true;
+    }
+
+    bool Prefab::LoadFromFile()
+    {
+        FileStream file(m_file_path, FileStream_Read);
+        if (!file.IsOpen())
+        {
+            SP_LOG_ERROR("Failed to open \"%s\" for reading", m_file_path.c_str());
+            return false;
+        }
+
+        uint32_t version    = 0;
+        uint32_t node_count = file.ReadAs<uint32_t>();
+        if (node_count == format_tag)
+        {
+            file.Read(&version);
+            file.Read(&node_count);
+        }
+
+        m_nodes.resize(node_count);
+        for (node& n : m_nodes)
+        {
+            if (version >= 1)
+            {
+                file.Read(&n.id);
+            }
+            file.Read(&n.name);
+            file.Read(&n.active);
+            file.Read(&n.visible);
+            file.Read(&n.position);
+            file.Read(&n.rotation);
+            file.Read(&n.scale);
+            file.Read(&n.parent);
+            file.Read(&n.children_count);
+
+            n.components.resize(file.ReadAs<uint32_t>());
+            for (node_component& c : n.components)
+            {
+                file.Read(&c.type);
+                file.Read(&c.data);
+            }
+        }
+
+        return !m_nodes.empty();
+    }
+}
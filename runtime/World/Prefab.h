@@ -0,0 +1,94 @@
+/*
+Copyright(c) 2016-2024 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==================
+#include <memory>
+#include <string>
+#include <vector>
+#include "Definitions.h"
+#include "../Math/Vector3.h"
+#include "../Math/Quaternion.h"
+//=============================
+
+namespace Spartan
+{
+    class Entity;
+    class FileStream;
+
+    // an entity hierarchy saved as a template, the serialized components (mesh, material, physics shape, light settings)
+    // are immutable and shared by all instances, a world only stores the prefab's path plus what an instance changed
+    class SP_CLASS Prefab : public std::enable_shared_from_this<Prefab>
+    {
+    public:
+        // saves the entity's hierarchy as a prefab, the entity becomes an instance of it
+        static std::shared_ptr<Prefab> Create(Entity* root, const std::string& file_path);
+
+        // returns the prefab if it's already loaded, otherwise loads it
+        static std::shared_ptr<Prefab> Load(const std::string& file_path);
+
+        // creates the entities of the template with new ids, the template is never re-read from disk but every
+        // component still deserializes from its template bytes, so the runtime setup (resource lookups, physics) is paid per instance
+        std::shared_ptr<Entity> Instantiate(
+            const Math::Vector3& position    = Math::Vector3::Zero,
+            const Math::Quaternion& rotation = Math::Quaternion::Identity,
+            const Math::Vector3& scale       = Math::Vector3::One
+        );
+
+        // instances whose hierarchy still matches the template are saved as sparse overrides
+        bool IsInstanceCompatible(Entity* root) const;
+        std::vector<std::byte> SerializeOverrides(Entity* root) const;
+        void DeserializeOverrides(Entity* root, const std::vector<std::byte>& overrides);
+
+        const std::string& GetFilePath() const { return m_file_path; }
+        uint32_t GetNodeCount() const          { return static_cast<uint32_t>(m_nodes.size()); }
+
+    private:
+        struct node_component
+        {
+            uint32_t type = 0;
+            std::vector<std::byte> data;
+        };
+
+        struct node
+        {
+            uint64_t id                 = 0; // of the entity the template was created from, references to it are remapped on instantiation
+            std::string name;
+            bool active                 = true;
+            bool visible                = true;
+            Math::Vector3 position      = Math::Vector3::Zero;
+            Math::Quaternion rotation   = Math::Quaternion::Identity;
+            Math::Vector3 scale         = Math::Vector3::One;
+            uint32_t parent             = 0; // index of the parent node, the root (index 0) has none
+            uint32_t children_count     = 0;
+            std::vector<node_component> components;
+        };
+
+        void Build(Entity* root, FileStream* overrides);
+        bool SaveToFile();
+        bool LoadFromFile();
+
+        std::string m_file_path;
+        std::vector<node> m_nodes; // depth first, in the order of Entity::GetChildren()
+    };
+}
@@ -54,6 +54,51 @@ namespace Spartan
         bool resolve            = false;
         bool was_in_editor_mode = false;
 
+        // name and tag indices, keyed by hash_name() so that lookups don't walk the hierarchy, the
+        // hash only narrows the search down, the strings are compared since different ones can collide
+        unordered_multimap<uint64_t, Entity*> entity_index_name;
+        unordered_multimap<uint64_t, Entity*> entity_index_tag;
+        mutex entity_index_mutex;
+
+        bool entity_index_erase(unordered_multimap<uint64_t, Entity*>& index, const uint64_t key, Entity* entity)
+        {
+            auto [it, end] = index.equal_range(key);
+            for (; it != end; it++)
+            {
+                if (it->second == entity)
+                {
+                    index.erase(it);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool entity_has_name(const Entity* entity, const string_view name) { return entity->GetObjectName() == name; }
+        bool entity_has_tag(const Entity* entity, const string_view tag)   { return entity->HasTag(tag); }
+
+        template<typename Match>
+        Entity* entity_index_find(const unordered_multimap<uint64_t, Entity*>& index, const string_view key, Match match, Entity* ancestor)
+        {
+            lock_guard lock(entity_index_mutex);
+
+            auto [it, end] = index.equal_range(hash_name(key));
+            for (; it != end; it++)
+            {
+                if (match(it->second, key) && (!ancestor || it->second->IsDescendantOf(ancestor)))
+                    return it->second;
+            }
+
+            return nullptr;
+        }
+
+        // saving
+        string save_pending_path;
+        bool is_saving = false;
+        mutex save_mutex;
+        mutex save_write_mutex;
+
         // default worlds resources
         shared_ptr<Entity> m_default_terrain             = nullptr;
         shared_ptr<Entity> m_default_cube                = nullptr;
@@ -152,6 +197,120 @@ namespace Spartan
                 rigid_body->SetShapeType(PhysicsShape::StaticPlane);
             }
         }
+
+        // a world serialized to memory, cheap enough to take on the main thread, the disk is only touched afterwards
+        struct world_snapshot
+        {
+            string name;
+            string file_path;
+            vector<pair<string, vector<byte>>> resource_files;
+            vector<uint64_t> root_ids;
+            vector<vector<byte>> roots;
+            float duration_ms = 0.0f;
+        };
+
+        world_snapshot take_snapshot(const string& file_path_in)
+        {
+            world_snapshot snapshot;
+            snapshot.file_path = file_path_in;
+            if (FileSystem::GetExtensionFromFilePath(snapshot.file_path) != EXTENSION_WORLD)
+            {
+                snapshot.file_path += EXTENSION_WORLD;
+            }
+            snapshot.name = FileSystem::GetFileNameWithoutExtensionFromFilePath(snapshot.file_path);
+
+            // the world takes the new name and path here, on the main thread, not where the file is written
+            name      = snapshot.name;
+            file_path = snapshot.file_path;
+
+            // notify subsystems that need to save data
+            SP_FIRE_EVENT(EventType::WorldSaveStart);
+
+            // resources are edited on the main thread, so they are serialized here and only written in the background
+            ResourceCache::Serialize(snapshot.name, &snapshot.resource_files);
+
+            // only root entities are saved as they also save their descendants
+            vector<shared_ptr<Entity>> roots = World::GetRootEntities();
+            const uint32_t root_count        = static_cast<uint32_t>(roots.size());
+            snapshot.root_ids.resize(root_count);
+            snapshot.roots.resize(root_count);
+
+            // roots only read their own hierarchy, so they can serialize in parallel
+            auto serialize = [&roots, &snapshot](uint32_t start, uint32_t end)
+            {
+                for (uint32_t i = start; i < end; i++)
+                {
+                    FileStream stream;
+                    roots[i]->Serialize(&stream);
+                    snapshot.root_ids[i] = roots[i]->GetObjectId();
+                    snapshot.roots[i]    = stream.GetData();
+                }
+            };
+
+            if (root_count > 1 && ThreadPool::GetIdleThreadCount() > 0)
+            {
+                ThreadPool::ParallelLoop(serialize, root_count);
+            }
+            else
+            {
+                serialize(0, root_count);
+            }
+
+            return snapshot;
+        }
+
+        bool write_snapshot(const world_snapshot& snapshot)
+        {
+            const Stopwatch timer;
+
+            // a synchronous save waits for a background one, so they never write the same files at once
+            lock_guard lock(save_write_mutex);
+
+            for (const auto& [path, data] : snapshot.resource_files)
+            {
+                FileStream file(path, FileStream_Write);
+                if (file.IsOpen())
+                {
+                    file.Write(data.data(), data.size());
+                }
+            }
+
+            // write to a temporary file and swap it in, a crash mid-save never leaves a truncated world behind
+            const string file_path_temp = snapshot.file_path + ".tmp";
+            {
+                FileStream file(file_path_temp, FileStream_Write);
+                if (!file.IsOpen())
+                    return false;
+
+                file.Write(static_cast<uint32_t>(snapshot.roots.size()));
+                for (const uint64_t id : snapshot.root_ids)
+                {
+                    file.Write(id);
+                }
+
+                for (const vector<byte>& root : snapshot.roots)
+                {
+                    file.Write(root.data(), root.size());
+                }
+            }
+
+            error_code error;
+            filesystem::rename(file_path_temp, snapshot.file_path, error);
+            if (error)
+            {
+                SP_LOG_ERROR("Failed to replace \"%s\": %s", snapshot.file_path.c_str(), error.message().c_str());
+                return false;
+            }
+
+            // report the main thread stall (the snapshot), the total time and the size, prefab instances only take up the space of their overrides
+            const float size_kb = static_cast<float>(filesystem::file_size(snapshot.file_path, error)) / 1024.0f;
+            SP_LOG_INFO("World \"%s\" has been saved. Snapshot %.2f ms, total %.2f ms, size %.2f KB", snapshot.file_path.c_str(), snapshot.duration_ms, snapshot.duration_ms + timer.GetElapsedTimeMs(), size_kb);
+
+            // notify subsystems waiting for us to finish
+            SP_FIRE_EVENT(EventType::WorldSavedEnd);
+
+            return true;
+        }
     }
 
     void World::Initialize()
@@ -182,6 +341,28 @@ namespace Spartan
     {
         SP_PROFILE_CPU();
 
+        // snapshot before anything changes this frame, the rest of the save happens in the background
+        {
+            lock_guard lock(save_mutex);
+            if (!save_pending_path.empty() && !is_saving)
+            {
+                const Stopwatch timer;
+                shared_ptr<world_snapshot> snapshot = make_shared<world_snapshot>(take_snapshot(save_pending_path));
+                snapshot->duration_ms               = timer.GetElapsedTimeMs();
+
+                save_pending_path.clear();
+                is_saving = true;
+
+                ThreadPool::AddTask([snapshot]()
+                {
+                    write_snapshot(*snapshot);
+
+                    lock_guard lock(save_mutex);
+                    is_saving = false;
+                });
+            }
+        }
+
         lock_guard<mutex> lock(entity_access_mutex);
 
         // tick entities
@@ -233,58 +414,17 @@ namespace Spartan
 
     bool World::SaveToFile(const string& file_path_in)
     {
-        // Add scene file extension to the filepath if it's missing
-        auto file_path = file_path_in;
-        if (FileSystem::GetExtensionFromFilePath(file_path) != EXTENSION_WORLD)
-        {
-            file_path += EXTENSION_WORLD;
-        }
-
-        name      = FileSystem::GetFileNameWithoutExtensionFromFilePath(file_path);
-        file_path = file_path;
-
-        // Notify subsystems that need to save data
-        SP_FIRE_EVENT(EventType::WorldSaveStart);
-
-        // Create a prefab file
-        auto file = make_unique<FileStream>(file_path, FileStream_Write);
-        if (!file->IsOpen())
-        {
-            SP_LOG_ERROR("Failed to open file.");
-            return false;
-        }
-
-        // Only save root entities as they will also save their descendants
-        vector<shared_ptr<Entity>> root_actors = GetRootEntities();
-        const uint32_t root_entity_count = static_cast<uint32_t>(root_actors.size());
-
-        // Start progress tracking and timing
         const Stopwatch timer;
-        ProgressTracker::GetProgress(ProgressType::World).Start(root_entity_count, "Saving world...");
-
-        // Save root entity count
-        file->Write(root_entity_count);
-
-        // Save root entity IDs
-        for (shared_ptr<Entity>& root : root_actors)
-        {
-            file->Write(root->GetObjectId());
-        }
-
-        // Save root entities
-        for (shared_ptr<Entity>& root : root_actors)
-        {
-            root->Serialize(file.get());
-            ProgressTracker::GetProgress(ProgressType::World).JobDone();
-        }
-
-        // Report time
-        SP_LOG_INFO("World \"%s\" has been saved. Duration %.2f ms", file_path.c_str(), timer.GetElapsedTimeMs());
+        world_snapshot snapshot = take_snapshot(file_path_in);
+        snapshot.duration_ms    = timer.GetElapsedTimeMs();
 
-        // Notify subsystems waiting for us to finish
-        SP_FIRE_EVENT(EventType::WorldSavedEnd);
+        return write_snapshot(snapshot);
+    }
 
-        return true;
+    void World::SaveToFileAsync(const string& file_path_in)
+    {
+        lock_guard lock(save_mutex);
+        save_pending_path = file_path_in;
     }
 
     bool World::LoadFromFile(const string& file_path_)
@@ -321,16 +461,17 @@ namespace Spartan
         const Stopwatch timer;
 
         // load root entity IDs
+        vector<shared_ptr<Entity>> root_entities;
+        root_entities.reserve(root_entity_count);
         for (uint32_t i = 0; i < root_entity_count; i++)
         {
-            shared_ptr<Entity> entity = CreateEntity();
-            entity->SetObjectId(file->ReadAs<uint64_t>());
+            root_entities.emplace_back(CreateEntity(file->ReadAs<uint64_t>()));
         }
 
         // serialize root entities
         for (uint32_t i = 0; i < root_entity_count; i++)
         {
-            entities[i]->Deserialize(file.get(), nullptr);
+            root_entities[i]->Deserialize(file.get(), nullptr);
             ProgressTracker::GetProgress(ProgressType::World).JobDone();
         }
 
@@ -373,14 +514,23 @@ namespace Spartan
         resolve = true;
     }
 
-    shared_ptr<Entity> World::CreateEntity()
+    shared_ptr<Entity> World::CreateEntity(const uint64_t id)
     {
         lock_guard lock(entity_access_mutex);
 
-        shared_ptr<Entity> entity = make_shared<Entity>();
+        shared_ptr<Entity> entity = allocate_shared<Entity>(PoolAllocator<Entity>());
+        if (id != 0)
+        {
+            entity->SetObjectId(id); // loaded entities keep their id, entities are looked up by it
+        }
         entity->Initialize();
         entities[entity->GetObjectId()] = entity;
 
+        {
+            lock_guard lock_index(entity_index_mutex);
+            entity_index_name.emplace(hash_name(entity->GetObjectName()), entity.get());
+        }
+
         return entity;
     }
 
@@ -409,6 +559,19 @@ namespace Spartan
                 ids_to_remove.insert(entity->GetObjectId());
             }
 
+            // remove them from the name and tag indices
+            {
+                lock_guard lock_index(entity_index_mutex);
+                for (Entity* entity : entities_to_remove)
+                {
+                    entity_index_erase(entity_index_name, hash_name(entity->GetObjectName()), entity);
+                    for (const string& tag : entity->GetTags())
+                    {
+                        entity_index_erase(entity_index_tag, hash_name(tag), entity);
+                    }
+                }
+            }
+
             // Remove entities using a single loop
             for (auto it = entities.begin(); it != entities.end(); )
             {
@@ -465,6 +628,65 @@ namespace Spartan
         return entities;
     }
 
+    Entity* World::GetEntityByName(const string_view name, Entity* ancestor)
+    {
+        return entity_index_find(entity_index_name, name, entity_has_name, ancestor);
+    }
+
+    Entity* World::GetEntityByTag(const string_view tag, Entity* ancestor)
+    {
+        return entity_index_find(entity_index_tag, tag, entity_has_tag, ancestor);
+    }
+
+    void World::GetEntitiesByTag(const string_view tag, vector<Entity*>* entities_out)
+    {
+        SP_ASSERT(entities_out != nullptr);
+
+        lock_guard lock(entity_index_mutex);
+
+        auto [it, end] = entity_index_tag.equal_range(hash_name(tag));
+        for (; it != end; it++)
+        {
+            if (it->second->HasTag(tag))
+            {
+                entities_out->emplace_back(it->second);
+            }
+        }
+    }
+
+    void World::OnEntityRenamed(Entity* entity, const string& name)
+    {
+        lock_guard lock(entity_index_mutex);
+
+        // lookups compare names from any thread, so the name only changes under the lock
+        const uint64_t name_hash_old = hash_name(entity->GetObjectName());
+        entity->SpartanObject::SetObjectName(name);
+
+        // entities that are not in the world (yet or anymore) are not indexed
+        if (entity_index_erase(entity_index_name, name_hash_old, entity))
+        {
+            entity_index_name.emplace(hash_name(name), entity);
+        }
+    }
+
+    void World::OnEntityTagged(Entity* entity, const uint64_t tag_hash, const bool added)
+    {
+        lock_guard lock(entity_index_mutex);
+
+        if (!added)
+        {
+            entity_index_erase(entity_index_tag, tag_hash, entity);
+            return;
+        }
+
+        // only index entities that are in the world, which are the ones in the name index
+        auto [it, end] = entity_index_name.equal_range(hash_name(entity->GetObjectName()));
+        if (find_if(it, end, [entity](const auto& pair) { return pair.second == entity; }) != end)
+        {
+            entity_index_tag.emplace(tag_hash, entity);
+        }
+    }
+
     void World::Clear()
     {
         // fire event
@@ -472,6 +694,11 @@ namespace Spartan
 
         // clear
         entities.clear();
+        {
+            lock_guard lock(entity_index_mutex);
+            entity_index_name.clear();
+            entity_index_tag.clear();
+        }
         name.clear();
         file_path.clear();
 
@@ -1388,7 +1615,7 @@ namespace Spartan
             // underwater
             {
                 // sound
-                if (Entity* entity = m_default_terrain->GetDescendantByName("underwater"))
+                if (Entity* entity = GetEntityByName("underwater", m_default_terrain.get()))
                 {
                     if (AudioSource* audio_source = entity->GetComponent<AudioSource>().get())
                     {
@@ -1407,7 +1634,7 @@ namespace Spartan
             // footsteps
             if (!is_below_water_level)
             {
-                if (Entity* entity = m_default_terrain->GetDescendantByName("footsteps"))
+                if (Entity* entity = GetEntityByName("footsteps", m_default_terrain.get()))
                 {
                     if (AudioSource* audio_source = entity->GetComponent<AudioSource>().get())
                     {
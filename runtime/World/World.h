@@ -51,16 +51,26 @@ namespace Spartan
 
         // io
         static bool SaveToFile(const std::string& filePath);
+        static void SaveToFileAsync(const std::string& file_path); // snapshots the world on the next tick, the file is written in the background
         static bool LoadFromFile(const std::string& file_path);
 
         // entities
-        static std::shared_ptr<Entity> CreateEntity();
+        static std::shared_ptr<Entity> CreateEntity(const uint64_t id = 0); // an id of 0 generates a new one
         static bool EntityExists(Entity* entity);
         static void RemoveEntity(Entity* entity);
         static std::vector<std::shared_ptr<Entity>> GetRootEntities();
         static const std::shared_ptr<Entity>& GetEntityById(uint64_t id);
         static const std::unordered_map<uint64_t, std::shared_ptr<Entity>>& GetAllEntities();
 
+        // lookup by name or tag, optionally limited to the descendants of an entity
+        static Entity* GetEntityByName(const std::string_view name, Entity* ancestor = nullptr);
+        static Entity* GetEntityByTag(const std::string_view tag, Entity* ancestor = nullptr);
+        static void GetEntitiesByTag(const std::string_view tag, std::vector<Entity*>* entities_out);
+
+        // index maintenance, called by entities
+        static void OnEntityRenamed(Entity* entity, const std::string& name);
+        static void OnEntityTagged(Entity* entity, const uint64_t tag_hash, const bool added);
+
         // misc
         static void New();
         static void Resolve();